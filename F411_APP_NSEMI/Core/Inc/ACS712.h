@@ -38,7 +38,10 @@ typedef struct {
 /* 函數宣告 */
 HAL_StatusTypeDef ACS712_Init(ACS712_Handle_t *hacs712, ADC_HandleTypeDef *hadc, ACS712_Type_t type);
 HAL_StatusTypeDef ACS712_Calibrate(ACS712_Handle_t *hacs712);
+void ACS712_SetZeroFromRaw(ACS712_Handle_t *hacs712, float average_raw);
+uint32_t ACS712_ReadRaw(ACS712_Handle_t *hacs712);
 float ACS712_ReadCurrent(ACS712_Handle_t *hacs712);
+float ACS712_ConvertRaw(ACS712_Handle_t *hacs712, float raw);
 float ACS712_ReadCurrentFiltered(ACS712_Handle_t *hacs712, uint8_t samples);
 float ACS712_CalculateRMS(ACS712_Handle_t *hacs712, uint16_t samples, uint16_t interval_ms);
 void ACS712_UpdateStats(float current, Current_Stats_t *stats);
@@ -0,0 +1,70 @@
+/*
+ * acquisition.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  ADC1 串流取樣：TIM3 TRGO 觸發、DMA 環形雙緩衝，以區塊為單位交給使用者
+ */
+
+#ifndef INC_ACQUISITION_H_
+#define INC_ACQUISITION_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f4xx_hal.h"
+
+// 每個區塊每通道的樣本數（DMA 半滿/全滿各一個區塊）
+#define ACQ_BLOCK_SAMPLES       64
+// 最多同時掃描的通道數
+#define ACQ_MAX_CHANNELS        2
+// 最多可註冊的區塊使用者
+#define ACQ_MAX_CONSUMERS       4
+// 預設取樣率 (Hz)
+#define ACQ_DEFAULT_RATE_HZ     10000
+
+// 一個取樣區塊，資料交錯排列 data[sample * channels + channel]
+typedef struct {
+    const uint16_t *data;
+    uint16_t samples;           // 每通道樣本數
+    uint8_t  channels;
+    uint32_t sequence;          // 區塊序號，從 0 開始
+    uint32_t first_index;       // 第一個樣本的全域樣本索引
+} Acq_Block_t;
+
+// 區塊使用者：在 DMA 中斷中呼叫，必須在下一個區塊到來前返回
+typedef void (*Acq_Consumer_t)(const Acq_Block_t *block, void *context);
+
+// 取樣設定
+typedef struct {
+    uint32_t sample_rate_hz;
+    uint8_t  channels;
+    uint32_t channel_list[ACQ_MAX_CHANNELS];    // ADC_CHANNEL_x，依掃描順序
+} Acq_Config_t;
+
+// 執行狀態
+typedef struct {
+    uint8_t  running;
+    uint8_t  channels;
+    uint32_t sample_rate_hz;    // 實際取樣率
+    uint32_t blocks;            // 已送出的區塊數
+    uint32_t overruns;          // 使用者處理太久，DMA 已覆寫下一區塊的次數
+} Acq_Status_t;
+
+void Acquisition_GetDefaultConfig(Acq_Config_t *config);
+HAL_StatusTypeDef Acquisition_Start(const Acq_Config_t *config);
+void Acquisition_Stop(void);
+HAL_StatusTypeDef Acquisition_Register(Acq_Consumer_t consumer, void *context);
+void Acquisition_Unregister(Acq_Consumer_t consumer);
+uint8_t Acquisition_IsRunning(void);
+void Acquisition_GetStatus(Acq_Status_t *status);
+uint32_t Acquisition_GetSampleIndex(void);
+void Acquisition_ConvCpltCallback(ADC_HandleTypeDef *hadc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ACQUISITION_H_ */
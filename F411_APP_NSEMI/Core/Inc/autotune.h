@@ -0,0 +1,75 @@
+/*
+ * autotune.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  手機電流迴路繼電器回授自動調諧（Åström–Hägglund relay feedback）
+ */
+
+#ifndef INC_AUTOTUNE_H_
+#define INC_AUTOTUNE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f4xx_hal.h"
+#include "acs712.h"
+
+// 丟棄前幾個振盪週期（等振幅穩定）
+#define AUTOTUNE_SETTLE_CYCLES      2
+// 最多量測的振盪週期數
+#define AUTOTUNE_MAX_CYCLES         16
+// 量測雜訊使用的區塊數
+#define AUTOTUNE_NOISE_BLOCKS       32
+// 卡爾曼濾波器的更新週期 (s)，對應 filter 任務（CurrentMonitor_FilterStep）的週期
+#define AUTOTUNE_FILTER_PERIOD_S    0.1f
+// 卡爾曼濾波器的輸入刻度：CurrentMonitor_FilterStep 把 0~5A 換成 0~4095
+#define AUTOTUNE_FILTER_SCALE       (4095.0f / 5.0f)
+
+// 調諧狀態
+typedef enum {
+    AUTOTUNE_IDLE = 0,
+    AUTOTUNE_NOISE,             // PWM 關閉，量測感測器雜訊
+    AUTOTUNE_RELAY,             // 繼電器振盪中
+    AUTOTUNE_DONE,
+    AUTOTUNE_FAILED
+} Autotune_State_t;
+
+// 調諧設定
+typedef struct {
+    float setpoint;             // 繼電器切換中心電流 (A)
+    float hysteresis;           // 繼電器遲滯 (A)，需大於雜訊
+    uint16_t duty_bias;         // 繼電器中心佔空比 (0~999)
+    uint16_t duty_step;         // 繼電器振幅 d (佔空比)
+    uint8_t cycles;             // 量測的振盪週期數
+    uint32_t timeout_ms;
+} Autotune_Config_t;
+
+// 調諧結果
+typedef struct {
+    float ku;                   // 臨界增益 (duty / A)
+    float tu;                   // 臨界週期 (s)
+    float amplitude;            // 振盪振幅 (A)
+    float kp;                   // PI 增益（Ziegler–Nichols）
+    float ki;
+    float noise_var;            // 感測器雜訊變異數 (A^2)
+    float kalman_q;             // 卡爾曼參數（AUTOTUNE_FILTER_SCALE 刻度）
+    float kalman_r;
+    uint8_t cycles;             // 實際量測的週期數
+} Autotune_Result_t;
+
+void Autotune_GetDefaultConfig(Autotune_Config_t *config);
+HAL_StatusTypeDef Autotune_Start(ACS712_Handle_t *hacs712, const Autotune_Config_t *config);
+Autotune_State_t Autotune_Process(void);
+void Autotune_Abort(void);
+Autotune_State_t Autotune_GetState(void);
+HAL_StatusTypeDef Autotune_GetResult(Autotune_Result_t *result);
+HAL_StatusTypeDef Autotune_SaveResult(uint8_t allow_erase);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_AUTOTUNE_H_ */
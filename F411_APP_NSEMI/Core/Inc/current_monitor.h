@@ -9,10 +9,11 @@ extern "C" {
 #include "acs712.h"
 #include "ssd1306.h"
 
-/* 監控配置 */
+/* 監控配置（門檻值為 Monitor_Config_t 的預設值，執行時可由 shell 調整） */
 #define OVERCURRENT_THRESHOLD   5.0f    // 過電流門檻 (A)
 #define VOLTAGE_NOMINAL         5.0f //220.0f  // 標稱電壓 (V)
 #define UPDATE_INTERVAL_MS      100     // 更新間隔 (ms)
+#define UPDATE_SAMPLES          10      // 每次更新平均的樣本數，每 UPDATE_INTERVAL_MS / UPDATE_SAMPLES 取一個
 #define FILTER_SIZE             10      // 濾波器大小
 
 // 檢查這些值在 current_monitor.h 中的定義
@@ -33,6 +34,16 @@ typedef enum {
 } Fan_Status_t;
 
 
+/* 負載狀態（CurrentMonitor_GetLoadState，數值與遙測 TLM_LOAD_x 相同） */
+typedef enum {
+    LOAD_STOPPED = 0,
+    LOAD_NOISE,
+    LOAD_WEAK,
+    LOAD_DETECTED,
+    LOAD_STARTING,
+    LOAD_RUNNING
+} Load_State_t;
+
 /* 監控狀態 */
 typedef enum {
     MONITOR_NORMAL = 0,
@@ -40,12 +51,23 @@ typedef enum {
     MONITOR_ERROR
 } Monitor_Status_t;
 
+/* 執行時門檻 (A)：CurrentMonitor_SetConfig 會檢查 noise < detection <= startup <= running */
+typedef struct {
+    float deadband;
+    float noise;
+    float detection;
+    float startup;
+    float running;
+    float overcurrent;
+} Monitor_Config_t;
+
 /* 監控結構 */
 typedef struct {
     ACS712_Handle_t *acs712;
     Current_Stats_t stats;
     Monitor_Status_t status;
     float current_now;          // 新增：當下電流值
+    float current_sample;       // 最新的單一樣本（已套死區），每個取樣週期更新
     float filter_buffer[FILTER_SIZE];
     uint8_t filter_index;
     uint32_t last_update;
@@ -53,22 +75,53 @@ typedef struct {
     float power;               // 功率
     uint32_t energy_wh;        // 累積電能 (Wh)
     uint32_t energy_start_time; // 電能計算開始時間
+    float sample_sum;           // 目前這次更新累加的樣本
+    uint8_t sample_count;
 } Current_Monitor_t;
 
+/* 手動零點校準階段（CurrentMonitor_CalibrationTask 狀態機） */
+typedef enum {
+    CAL_IDLE = 0,
+    CAL_SETTLE,                 // 等待移除負載
+    CAL_OFFSET,                 // 採集零點樣本
+    CAL_NOISE,                  // 採集標準差樣本
+    CAL_DONE
+} Calibration_Phase_t;
+
+/* 濾波器測試的最新結果 */
+typedef struct {
+    float raw;
+    float moving_avg;
+    float kalman1;
+    float kalman2;
+    uint32_t count;
+} Filter_Result_t;
+
 /* 函數宣告 */
 HAL_StatusTypeDef CurrentMonitor_Init(Current_Monitor_t *monitor, ACS712_Handle_t *acs712);
 void CurrentMonitor_Update(Current_Monitor_t *monitor);
 void CurrentMonitor_Display(Current_Monitor_t *monitor);
+Load_State_t CurrentMonitor_GetLoadState(const Current_Monitor_t *monitor);
+const Monitor_Config_t *CurrentMonitor_GetConfig(void);
+HAL_StatusTypeDef CurrentMonitor_SetConfig(const Monitor_Config_t *config);
 void CurrentMonitor_CheckOvercurrent(Current_Monitor_t *monitor);
 float CurrentMonitor_MovingAverage(Current_Monitor_t *monitor, float new_value);
 void CurrentMonitor_CalculatePower(Current_Monitor_t *monitor, float current);
 void CurrentMonitor_ResetEnergy(Current_Monitor_t *monitor);
 void CurrentMonitor_ResetStats(Current_Monitor_t *monitor);
-void CurrentMonitor_ManualCalibration(Current_Monitor_t *monitor);
 void CheckAutoReset(Current_Monitor_t *monitor);
 void CurrentMonitor_ResetMovingAverage(Current_Monitor_t *monitor);
 void CurrentMonitor_UpdateStats(Current_Monitor_t *monitor, float current);
-void CurrentMonitor_TestFilters(Current_Monitor_t *monitor);
+
+/* 非阻塞版本：由排程器週期呼叫 */
+void CurrentMonitor_StartCalibration(Current_Monitor_t *monitor);
+uint8_t CurrentMonitor_CalibrationTask(Current_Monitor_t *monitor);
+void CurrentMonitor_FilterInit(Current_Monitor_t *monitor);
+void CurrentMonitor_FilterStep(Current_Monitor_t *monitor);
+void CurrentMonitor_FilterReport(Current_Monitor_t *monitor);
+void CurrentMonitor_FilterDisplay(Current_Monitor_t *monitor);
+void CurrentMonitor_FilterDisplayInvalidate(void);
+const Filter_Result_t *CurrentMonitor_GetFilterResult(void);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,35 @@
+/*
+ * fixfmt.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  定點數字格式化：取代 printf 的 %.Nf，不需要 newlib 浮點 printf
+ */
+
+#ifndef INC_FIXFMT_H_
+#define INC_FIXFMT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// 最長輸出："-2147483648" 加小數點與結尾 0
+#define FIXFMT_BUF_SIZE         14
+// 最多小數位數
+#define FIXFMT_MAX_DECIMALS     6
+
+typedef char FixFmt_Buf_t[FIXFMT_BUF_SIZE];
+
+int32_t FixFmt_Scale(float value, uint8_t decimals);
+uint8_t FixFmt_Fixed(char *buf, int32_t value, uint8_t decimals);
+const char *FixFmt_Float(char *buf, float value, uint8_t decimals);
+const char *FixFmt_Milli(char *buf, int32_t milli, uint8_t decimals);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_FIXFMT_H_ */
@@ -18,8 +18,20 @@ typedef struct {
     uint8_t initialized; // 初始化標誌
 } KalmanFilter_t;
 
+// PI 控制器結構體（手機電流迴路）
+typedef struct {
+    float kp;         // 比例增益 (duty / A)
+    float ki;         // 積分增益 (duty / (A*s))
+    float integral;   // 積分項（已乘 ki）
+    float out_min;    // 輸出下限
+    float out_max;    // 輸出上限
+} PI_Controller_t;
+
 #define ADC_CHANNEL_COUNT 6
 
+// 一般 PWM 佔空比上限（TIM1 ARR = 1000-1）
+#define HANDPIECE_DUTY_MAX 999
+
 // 濾波器配置
 #define FILTER_SIZE 10
 
@@ -51,4 +63,19 @@ uint32_t Get_Channel_Voltage_Filtered_Kalman(uint8_t channel);
 void Kalman_Init(KalmanFilter_t* kf, float initial_value, float process_noise, float measurement_noise);
 float Kalman_Update(KalmanFilter_t* kf, float measurement);
 void Kalman_Set_Parameters(uint8_t channel, float process_noise, float measurement_noise);
+void Kalman_Get_Parameters(uint8_t channel, float *process_noise, float *measurement_noise);
+
+// PI 控制器函數
+void PI_Init(PI_Controller_t* pi, float kp, float ki, float out_min, float out_max);
+void PI_Reset(PI_Controller_t* pi);
+float PI_Update(PI_Controller_t* pi, float setpoint, float measurement, float dt);
+
+// 手機電流迴路（PI → TIM1 佔空比）
+HAL_StatusTypeDef Handpiece_DriveStart(float setpoint, float kp, float ki);
+void Handpiece_DriveSetpoint(float setpoint);
+void Handpiece_DriveStop(void);
+uint16_t Handpiece_DriveUpdate(float measurement, float dt);
+uint8_t Handpiece_DriveIsRunning(void);
+float Handpiece_DriveGetSetpoint(void);
+uint16_t Handpiece_DriveGetDuty(void);
 #endif /* INC_HANDPIECE_H_ */
@@ -0,0 +1,25 @@
+/*
+ * hw_crc.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  硬體 CRC 單元（CRC-32/MPEG-2，以 32 位元字為單位）
+ */
+
+#ifndef INC_HW_CRC_H_
+#define INC_HW_CRC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f4xx_hal.h"
+
+uint32_t HwCrc_Compute(const uint32_t *words, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_HW_CRC_H_ */
@@ -0,0 +1,83 @@
+/*
+ * itm_trace.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  ITM / SWO 追蹤輸出（PB3 TRACESWO）：stimulus port 分開文字、排程器事件與取樣值，
+ *  DWT 比較器追蹤變數寫入
+ */
+
+#ifndef INC_ITM_TRACE_H_
+#define INC_ITM_TRACE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f4xx_hal.h"
+
+// SWO 輸出速率：72 MHz / 36，沒有誤差（除錯器的 SWV 設定要填相同的值）
+#define ITM_TRACE_SWO_HZ        2000000
+
+// Stimulus port 配置
+#define ITM_PORT_TEXT           0       // printf 文字（啟用時取代 uart_log）
+#define ITM_PORT_PROFILE        1       // 排程器事件（16 位元，見 ITM_EVT_x）
+#define ITM_PORT_VALUE          2       // 取樣值（32 位元，float 以原始位元送出）
+
+// 排程器事件：(event << 8) | task id
+#define ITM_EVT_TASK_START      0x01
+#define ITM_EVT_TASK_END        0x02
+#define ITM_EVT_IDLE_ENTER      0x03
+#define ITM_EVT_IDLE_EXIT       0x04
+
+// 可用的 DWT 資料追蹤槽（比較器 1..3，比較器 0 留給除錯器的觀察點）
+#define ITM_TRACE_WATCH_SLOTS   3
+
+HAL_StatusTypeDef ItmTrace_Init(uint32_t swo_hz);
+void ItmTrace_EnablePort(uint8_t port, uint8_t enable);
+void ItmTrace_Write(uint8_t port, const uint8_t *data, uint32_t len);
+HAL_StatusTypeDef ItmTrace_Watch(uint8_t slot, const volatile void *address);
+void ItmTrace_Unwatch(uint8_t slot);
+uint32_t ItmTrace_GetWatch(uint8_t slot);
+uint32_t ItmTrace_GetDrops(void);
+
+/**
+ * @brief  port 是否啟用（ITM 總開關 + TER 該位元）
+ * @param  port: stimulus port
+ * @retval 1 = 啟用
+ */
+__STATIC_INLINE uint8_t ItmTrace_IsPortEnabled(uint8_t port)
+{
+    return ((ITM->TCR & ITM_TCR_ITMENA_Msk) && (ITM->TER & (1UL << port))) ? 1 : 0;
+}
+
+/**
+ * @brief  送出 16 位元事件，FIFO 滿時直接丟棄，不等待（可在中斷中呼叫）
+ * @param  port: stimulus port
+ * @param  value: 事件
+ * @retval None
+ */
+__STATIC_INLINE void ItmTrace_Event(uint8_t port, uint16_t value)
+{
+    if (ItmTrace_IsPortEnabled(port) && ITM->PORT[port].u32 != 0)
+        ITM->PORT[port].u16 = value;
+}
+
+/**
+ * @brief  送出 32 位元數值，FIFO 滿時直接丟棄，不等待（可在中斷中呼叫）
+ * @param  port: stimulus port
+ * @param  value: 數值
+ * @retval None
+ */
+__STATIC_INLINE void ItmTrace_Value(uint8_t port, uint32_t value)
+{
+    if (ItmTrace_IsPortEnabled(port) && ITM->PORT[port].u32 != 0)
+        ITM->PORT[port].u32 = value;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ITM_TRACE_H_ */
@@ -0,0 +1,102 @@
+/*
+ * logid.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  延後格式化的 log：格式字串放在不載入的 .logstr section，只送出 ID 與參數
+ *
+ *  用法和 printf 相同：LOGID("Current: %.1f mA\r\n", current * 1000.0f);
+ *  參數最多 TLM_LOG_MAX_ARGS 個，型態由 _Generic 判斷（整數、float/double、字串）。
+ *  Tools/tlm_decode -e <elf> 從 ELF 取回格式字串還原文字。
+ *
+ *  遙測關閉（mode text）時不送訊框，改在目標端格式化成文字：
+ *    - LOGID_TEXT_FALLBACK = 1：另外保留一份可載入的格式字串，照格式輸出（%f 用 FixFmt）
+ *    - LOGID_TEXT_FALLBACK = 0：不佔 Flash，只輸出 "[log 0xID] 參數..."，再對照 ELF
+ *  預設只有 Debug 組態（DEBUG）保留格式字串，Release 不佔 Flash。
+ *  字串參數超過剩餘空間時截斷，但一定留下後面參數的空間，長度位元組一定會送出。
+ *  LOGID_ENABLE 為 0 時格式字串一般存放，一律以文字輸出，不需要 _printf_float。
+ */
+
+#ifndef INC_LOGID_H_
+#define INC_LOGID_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f4xx_hal.h"
+#include "telemetry_protocol.h"
+#include <stdio.h>
+
+#ifndef LOGID_ENABLE
+#define LOGID_ENABLE            1
+#endif
+#ifndef LOGID_TEXT_FALLBACK
+#ifdef DEBUG
+#define LOGID_TEXT_FALLBACK     1
+#else
+#define LOGID_TEXT_FALLBACK     0
+#endif
+#endif
+// 文字輸出一行的最大長度（超過時截斷）
+#define LOGID_TEXT_SIZE         160
+
+void LogId_Begin(Tlm_Log_t *record, const char *format);
+void LogId_PutU32(Tlm_Log_t *record, uint32_t value, uint8_t rest);
+void LogId_PutI32(Tlm_Log_t *record, int32_t value, uint8_t rest);
+void LogId_PutFloat(Tlm_Log_t *record, float value, uint8_t rest);
+void LogId_PutString(Tlm_Log_t *record, const char *value, uint8_t rest);
+void LogId_End(Tlm_Log_t *record, const char *text_format);
+
+// 依參數型態選擇打包函數，rest 是後面還有幾個參數
+#define LOGID_PUT(rec, x, rest) _Generic((x),                               \
+        float: LogId_PutFloat, double: LogId_PutFloat,                      \
+        char *: LogId_PutString, const char *: LogId_PutString,             \
+        signed char: LogId_PutI32, short: LogId_PutI32,                     \
+        int: LogId_PutI32, long: LogId_PutI32,                              \
+        default: LogId_PutU32)(rec, x, rest)
+
+// 計算參數個數（0 ~ 8）
+#define LOGID_NARGS(...)        LOGID_NARGS_(0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define LOGID_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, N, ...)  N
+#define LOGID_CAT(a, b)         LOGID_CAT_(a, b)
+#define LOGID_CAT_(a, b)        a##b
+
+#define LOGID_PUT_0(rec)
+#define LOGID_PUT_1(rec, a)         LOGID_PUT(rec, a, 0);
+#define LOGID_PUT_2(rec, a, ...)    LOGID_PUT(rec, a, 1); LOGID_PUT_1(rec, __VA_ARGS__)
+#define LOGID_PUT_3(rec, a, ...)    LOGID_PUT(rec, a, 2); LOGID_PUT_2(rec, __VA_ARGS__)
+#define LOGID_PUT_4(rec, a, ...)    LOGID_PUT(rec, a, 3); LOGID_PUT_3(rec, __VA_ARGS__)
+#define LOGID_PUT_5(rec, a, ...)    LOGID_PUT(rec, a, 4); LOGID_PUT_4(rec, __VA_ARGS__)
+#define LOGID_PUT_6(rec, a, ...)    LOGID_PUT(rec, a, 5); LOGID_PUT_5(rec, __VA_ARGS__)
+#define LOGID_PUT_7(rec, a, ...)    LOGID_PUT(rec, a, 6); LOGID_PUT_6(rec, __VA_ARGS__)
+#define LOGID_PUT_8(rec, a, ...)    LOGID_PUT(rec, a, 7); LOGID_PUT_7(rec, __VA_ARGS__)
+
+#if LOGID_ENABLE
+// 格式字串放在不載入的 .logstr；文字輸出另外用一份一般的字串常數
+#define LOGID_SECTION_          __attribute__((section(".logstr"), used))
+#if LOGID_TEXT_FALLBACK
+#define LOGID_TEXT_(format, stored) (format)
+#else
+#define LOGID_TEXT_(format, stored) NULL
+#endif
+#else
+#define LOGID_SECTION_
+#define LOGID_TEXT_(format, stored) (stored)
+#endif /* LOGID_ENABLE */
+
+#define LOGID(format, ...)                                                  \
+    do {                                                                    \
+        static const char logid_format_[] LOGID_SECTION_ = format;          \
+        Tlm_Log_t logid_record_;                                            \
+        LogId_Begin(&logid_record_, logid_format_);                         \
+        LOGID_CAT(LOGID_PUT_, LOGID_NARGS(__VA_ARGS__))(&logid_record_, ##__VA_ARGS__) \
+        LogId_End(&logid_record_, LOGID_TEXT_(format, logid_format_));     \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_LOGID_H_ */
@@ -0,0 +1,48 @@
+/*
+ * param_store.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  手機校正參數存放在 Flash 最後一個 sector（sector 7, 0x08060000, 128K）
+ */
+
+#ifndef INC_PARAM_STORE_H_
+#define INC_PARAM_STORE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f4xx_hal.h"
+
+// 參數區位置，必須和 linker script 中縮短後的 FLASH 區域一致
+#define PARAM_STORE_ADDR        0x08060000UL
+#define PARAM_STORE_SIZE        0x00020000UL
+#define PARAM_STORE_SECTOR      FLASH_SECTOR_7
+
+#define PARAM_STORE_MAGIC       0x50524D31UL    // "PRM1"
+#define PARAM_STORE_VERSION     1
+
+// 持久化的參數（改變內容時要遞增 PARAM_STORE_VERSION）
+typedef struct {
+    float kalman_q[2];          // filter 任務兩組卡爾曼參數
+    float kalman_r[2];
+    float pi_kp;                // 電流迴路 PI 增益 (duty / A)
+    float pi_ki;                // (duty / (A*s))
+    float ku;                   // 自動調諧量到的臨界增益
+    float tu;                   // 臨界週期 (s)
+} Param_Data_t;
+
+HAL_StatusTypeDef ParamStore_Init(void);
+const Param_Data_t *ParamStore_Get(void);
+uint8_t ParamStore_IsLoaded(void);
+HAL_StatusTypeDef ParamStore_Save(const Param_Data_t *data);
+HAL_StatusTypeDef ParamStore_Append(const Param_Data_t *data);
+void ParamStore_GetDefaults(Param_Data_t *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_PARAM_STORE_H_ */
@@ -0,0 +1,53 @@
+/*
+ * pwm_hr.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  TIM1 CH1 高解析度 PWM（sigma-delta 抖動 + DMA 更新 CCR1）
+ */
+
+#ifndef INC_PWM_HR_H_
+#define INC_PWM_HR_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f4xx_hal.h"
+
+// DMA 環形緩衝區長度（PWM 週期數），半滿/全滿各觸發一次補填
+#define PWM_HR_DMA_LENGTH       512
+// 最大計數週期，限制在 15 位元內以便 Q16 運算不溢位
+#define PWM_HR_MAX_PERIOD       0x7FFF
+// 最小計數週期（解析度太低時沒有意義）
+#define PWM_HR_MIN_PERIOD       16
+
+// 調變器階數
+typedef enum {
+    PWM_HR_ORDER_1 = 1,     // 一階：誤差累加器
+    PWM_HR_ORDER_2 = 2      // 二階：雜訊整形 (1 - z^-1)^2
+} PWM_HR_Order_t;
+
+// 執行狀態
+typedef struct {
+    uint8_t  running;
+    PWM_HR_Order_t order;
+    uint32_t carrier_hz;        // 實際載波頻率
+    uint16_t period_counts;     // 每個 PWM 週期的計數 (ARR + 1)
+    uint16_t duty;              // 目前 16 位元佔空比
+    uint32_t refills;           // 半緩衝補填次數
+    uint32_t late_refills;      // 補填時 DMA 已追上（來不及）的次數
+} PWM_HR_Status_t;
+
+HAL_StatusTypeDef PWM_HR_Start(uint32_t carrier_hz, PWM_HR_Order_t order);
+void PWM_HR_Stop(void);
+void PWM_HR_SetDuty(uint16_t duty);
+uint8_t PWM_HR_IsRunning(void);
+void PWM_HR_GetStatus(PWM_HR_Status_t *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_PWM_HR_H_ */
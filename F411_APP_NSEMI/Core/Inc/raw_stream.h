@@ -0,0 +1,46 @@
+/*
+ * raw_stream.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  原始波形串流：USART6 切到高鮑率，把取樣區塊打包成 12 位元後直接以 DMA 送出
+ */
+
+#ifndef INC_RAW_STREAM_H_
+#define INC_RAW_STREAM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f4xx_hal.h"
+#include "acquisition.h"
+
+// 串流鮑率：72 MHz / 32（OVER8 時 USARTDIV = 4，沒有誤差）；4500000 也沒有誤差
+#define RAW_STREAM_BAUD         2250000
+// 傳送佇列的區塊數
+#define RAW_STREAM_SLOTS        4
+// 停止時等佇列送完的最長時間，超過時中止傳輸
+#define RAW_STREAM_STOP_TIMEOUT_MS  100
+
+// 串流統計
+typedef struct {
+    uint8_t  running;
+    uint32_t baud;              // 實際鮑率
+    uint32_t frames;            // 已送出的區塊
+    uint32_t dropped;           // 佇列滿而丟棄的區塊
+    uint32_t bytes;
+    uint8_t  max_queued;        // 佇列最高使用量
+} RawStream_Stats_t;
+
+HAL_StatusTypeDef RawStream_Start(const Acq_Config_t *config);
+HAL_StatusTypeDef RawStream_Stop(void);
+uint8_t RawStream_IsRunning(void);
+void RawStream_GetStats(RawStream_Stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_RAW_STREAM_H_ */
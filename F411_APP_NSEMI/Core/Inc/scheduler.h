@@ -0,0 +1,83 @@
+/*
+ * scheduler.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  協作式 run-to-completion 排程器（TIM4 1 kHz 時基 + PendSV 延後處理）
+ */
+
+#ifndef INC_SCHEDULER_H_
+#define INC_SCHEDULER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f4xx_hal.h"
+
+// 最多任務數
+#define SCHED_MAX_TASKS         16
+// 延後處理佇列長度（2 的次方）
+#define SCHED_DEFER_QUEUE       8
+// 時基頻率 (Hz)，對應 TIM4 的更新頻率
+#define SCHED_TICK_HZ           1000
+// TIM4 計數頻率 (Hz)，PSC = 72-1 時為 1 MHz
+#define SCHED_TIMER_HZ          1000000
+// 閒置超過這個 tick 數才關掉週期性中斷（tickless），否則只 WFI
+#define SCHED_TICKLESS_MIN_MS   3
+// 單次 tickless 的最長時間，TIM4 ARR 為 16 位元 (65 ms @ 1 MHz)
+#define SCHED_TICKLESS_MAX_MS   60
+
+// 任務優先權，數字越小越先執行
+typedef enum {
+    SCHED_PRIO_HIGH = 0,
+    SCHED_PRIO_NORMAL,
+    SCHED_PRIO_LOW,
+    SCHED_PRIO_COUNT
+} Sched_Priority_t;
+
+typedef void (*Sched_TaskFn_t)(void *context);
+typedef int8_t Sched_TaskId_t;      // 負值代表無效
+
+#define SCHED_INVALID_TASK      ((Sched_TaskId_t)-1)
+
+// 任務統計
+typedef struct {
+    const char *name;
+    Sched_Priority_t priority;
+    uint32_t period_ms;         // 0 = 事件觸發
+    uint32_t deadline_ms;
+    uint32_t runs;
+    uint32_t last_cycles;       // 最近一次執行的 CPU cycles (DWT)
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+    uint32_t deadline_misses;   // 完成時間超過 release + deadline
+    uint32_t overruns;          // 上一次 release 還沒執行又被 release
+} Sched_TaskStats_t;
+
+void Scheduler_Init(void);
+void Scheduler_Start(void);
+Sched_TaskId_t Scheduler_AddPeriodic(const char *name, Sched_TaskFn_t fn, void *context,
+                                     Sched_Priority_t priority, uint32_t period_ms, uint32_t offset_ms);
+Sched_TaskId_t Scheduler_AddEvent(const char *name, Sched_TaskFn_t fn, void *context,
+                                  Sched_Priority_t priority, uint32_t deadline_ms);
+void Scheduler_Enable(Sched_TaskId_t id, uint8_t enable);
+void Scheduler_Signal(Sched_TaskId_t id);
+HAL_StatusTypeDef Scheduler_Defer(Sched_TaskFn_t fn, void *context);
+uint8_t Scheduler_Run(void);
+void Scheduler_Idle(void);
+void Scheduler_Tick(void);
+void Scheduler_PendSV(void);
+uint32_t Scheduler_GetTick(void);
+uint8_t Scheduler_GetTaskCount(void);
+uint16_t Scheduler_GetCpuLoad(void);
+HAL_StatusTypeDef Scheduler_GetStats(Sched_TaskId_t id, Sched_TaskStats_t *stats);
+void Scheduler_ResetStats(void);
+void Scheduler_PrintStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_SCHEDULER_H_ */
@@ -0,0 +1,57 @@
+/*
+ * shell.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  USART6 指令列：環形 DMA + IDLE 偵測接收，排程器事件任務逐步解析
+ */
+
+#ifndef INC_SHELL_H_
+#define INC_SHELL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f4xx_hal.h"
+
+// 接收 DMA 環形緩衝區大小
+#define SHELL_RX_SIZE           256
+// 一行指令最長字元數（不含結尾 0）
+#define SHELL_LINE_MAX          80
+// 每行最多參數數（含指令名稱）
+#define SHELL_MAX_ARGS          8
+// 每次執行最多處理的位元組，剩下的下一次再處理
+#define SHELL_BYTES_PER_RUN     64
+
+// 指令處理函數：回傳 HAL_ERROR 時 shell 印出 usage
+typedef HAL_StatusTypeDef (*Shell_Handler_t)(int argc, char *argv[]);
+
+typedef struct {
+    const char *name;
+    const char *usage;
+    Shell_Handler_t handler;
+} Shell_Command_t;
+
+// 接收統計
+typedef struct {
+    uint32_t bytes;             // 已處理的位元組
+    uint32_t lines;             // 已執行的指令
+    uint32_t unknown;           // 未知指令
+    uint32_t overflows;         // 超過 SHELL_LINE_MAX 而丟棄的行
+    uint32_t rx_errors;         // UART 接收錯誤（雜訊、溢位等）
+    uint32_t restarts;          // 重新啟動接收的次數
+} Shell_Stats_t;
+
+HAL_StatusTypeDef Shell_Init(const Shell_Command_t *commands, uint8_t count);
+void Shell_PrintHelp(void);
+void Shell_GetStats(Shell_Stats_t *stats);
+uint8_t Shell_ParseUInt(const char *text, uint32_t *value);
+uint8_t Shell_ParseFloat(const char *text, float *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_SHELL_H_ */
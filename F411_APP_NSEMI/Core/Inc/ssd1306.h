@@ -60,6 +60,32 @@ _BEGIN_STD_C
 #define SSD1306_X_OFFSET_UPPER 0
 #endif
 
+// First RAM column of the panel
+#define SSD1306_X_START ((SSD1306_X_OFFSET_UPPER << 4) | SSD1306_X_OFFSET_LOWER)
+
+// Decoded glyphs kept for run-length encoded fonts, and the largest glyph (width x pages).
+// 0 leaves the cache out: RLE glyphs then cannot be drawn as text (the readout decodes its own)
+#ifndef SSD1306_GLYPH_CACHE_SIZE
+#define SSD1306_GLYPH_CACHE_SIZE    0
+#endif
+#ifndef SSD1306_GLYPH_CACHE_BYTES
+#define SSD1306_GLYPH_CACHE_BYTES   64
+#endif
+
+// Numeric readout (ssd1306_ReadoutInit): characters, and the widest digit sprite in pixels
+#ifndef SSD1306_READOUT_MAX_CHARS
+#define SSD1306_READOUT_MAX_CHARS   8
+#endif
+#ifndef SSD1306_READOUT_MAX_WIDTH
+#define SSD1306_READOUT_MAX_WIDTH   16
+#endif
+// Sprites: '0'..'9', '.', '-' and blank
+#define SSD1306_READOUT_GLYPHS      13
+
+#ifndef SSD1306_FLUSH_TIMEOUT
+#define SSD1306_FLUSH_TIMEOUT   100     // ms, blocking writes wait this long for a DMA flush
+#endif
+
 /* vvv I2C config vvv */
 
 #ifndef SSD1306_I2C_PORT
@@ -155,6 +181,49 @@ typedef struct {
     const uint8_t *const char_width;    /**< Proportional character width in pixels (NULL for monospaced) */
 } SSD1306_Font_t;
 
+/** Font in SSD1306 page layout, generated on demand by Tools/font_gen (full-font mode, not checked in) */
+typedef struct {
+	const uint8_t width;                /**< Font width in pixels */
+	const uint8_t height;               /**< Font height in pixels */
+	const uint8_t pages;                /**< Bytes per glyph column, (height + 7) / 8 */
+	const uint8_t *const data;          /**< pages x width bytes per glyph, one page after another */
+    const uint8_t *const char_width;    /**< Proportional character width in pixels (NULL for monospaced) */
+} SSD1306_PagedFont_t;
+
+#define SSD1306_GLYPH_RLE       0x01    /**< Glyph data is run-length encoded */
+
+/** Subset font compiled by Tools/font_gen: glyphs looked up by Unicode code point */
+typedef struct {
+	const uint8_t height;               /**< Font height in pixels */
+	const uint8_t pages;                /**< Bytes per glyph column, (height + 7) / 8 */
+	const uint8_t flags;                /**< SSD1306_GLYPH_RLE */
+	const uint16_t count;               /**< Number of glyphs */
+	const uint16_t *const codes;        /**< Code points, sorted */
+	const uint8_t *const widths;        /**< Glyph widths in pixels */
+	const uint16_t *const offsets;      /**< Start of each glyph in data, count + 1 entries */
+	const uint8_t *const data;          /**< pages x width bytes per glyph, page by page */
+} SSD1306_GlyphFont_t;
+
+/**
+ * Large numeric readout: digit sprites pre-shifted to the readout's y offset,
+ * text right-aligned in its area, only changed characters redrawn.
+ */
+typedef struct {
+    uint8_t x;                          /**< Area left edge */
+    uint8_t width;                      /**< Area width, the text is right-aligned */
+    uint8_t page;                       /**< First buffer page */
+    uint8_t pages;                      /**< Buffer pages covered */
+    uint8_t valid;                      /**< 0: redraw everything on the next ssd1306_ReadoutSet */
+    uint8_t count;                      /**< Characters on screen */
+    uint8_t left;                       /**< Left edge of the text on screen */
+    uint8_t glyph[SSD1306_READOUT_MAX_CHARS];       /**< Sprite index of each character on screen */
+    uint8_t pos[SSD1306_READOUT_MAX_CHARS];         /**< x of each character on screen */
+    uint8_t mask[SSD1306_HEIGHT / 8];               /**< Rows of each page inside the readout */
+    uint8_t background[SSD1306_HEIGHT / 8];         /**< Background byte of each page, within mask */
+    uint8_t widths[SSD1306_READOUT_GLYPHS];
+    uint8_t sprites[SSD1306_READOUT_GLYPHS][SSD1306_HEIGHT / 8][SSD1306_READOUT_MAX_WIDTH];
+} SSD1306_Readout_t;
+
 // Procedure definitions
 void ssd1306_Init(void);
 void ssd1306_Fill(SSD1306_COLOR color);
@@ -162,8 +231,14 @@ void ssd1306_UpdateScreen(void);
 void ssd1306_DrawPixel(uint8_t x, uint8_t y, SSD1306_COLOR color);
 char ssd1306_WriteChar(char ch, SSD1306_Font_t Font, SSD1306_COLOR color);
 char ssd1306_WriteString(char* str, SSD1306_Font_t Font, SSD1306_COLOR color);
+char ssd1306_WriteCharPaged(char ch, SSD1306_PagedFont_t Font, SSD1306_COLOR color);
+char ssd1306_WriteStringPaged(char* str, SSD1306_PagedFont_t Font, SSD1306_COLOR color);
+uint16_t ssd1306_WriteGlyph(uint16_t code, const SSD1306_GlyphFont_t *Font, SSD1306_COLOR color);
+char ssd1306_WriteStringUtf8(const char* str, const SSD1306_GlyphFont_t *Font, SSD1306_COLOR color);
 void ssd1306_SetCursor(uint8_t x, uint8_t y);
 void ssd1306_Line(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD1306_COLOR color);
+void ssd1306_DrawHLine(uint8_t x1, uint8_t x2, uint8_t y, SSD1306_COLOR color);
+void ssd1306_DrawVLine(uint8_t x, uint8_t y1, uint8_t y2, SSD1306_COLOR color);
 void ssd1306_DrawArc(uint8_t x, uint8_t y, uint8_t radius, uint16_t start_angle, uint16_t sweep, SSD1306_COLOR color);
 void ssd1306_DrawArcWithRadiusLine(uint8_t x, uint8_t y, uint8_t radius, uint16_t start_angle, uint16_t sweep, SSD1306_COLOR color);
 void ssd1306_DrawCircle(uint8_t par_x, uint8_t par_y, uint8_t par_r, SSD1306_COLOR color);
@@ -206,6 +281,78 @@ void ssd1306_SetDisplayOn(const uint8_t on);
  */
 uint8_t ssd1306_GetDisplayOn();
 
+/** Frame statistics, ssd1306_GetFrameStats */
+typedef struct {
+    uint32_t presented;     /**< ssd1306_UpdateScreen calls */
+    uint32_t shown;         /**< Frames completely sent to the panel */
+    uint32_t skipped;       /**< Replaced by a newer frame before they were sent */
+    uint32_t late;          /**< Presented after the end of their frame slot */
+    uint16_t fps_x10;       /**< Frames shown per second x10, measured over 1 s or more */
+    uint16_t target_fps;    /**< ssd1306_SetFrameRate, 0 = no pacing */
+} SSD1306_FrameStats_t;
+
+/**
+ * @brief Sets the target frame rate for ssd1306_FrameDue.
+ * @param[in] fps frames per second, 0 = no pacing.
+ */
+void ssd1306_SetFrameRate(uint16_t fps);
+
+/**
+ * @brief Checks whether the next frame should be rendered and starts its slot.
+ * @return  1: render now, then call ssd1306_UpdateScreen.
+ *          0: not yet.
+ */
+uint8_t ssd1306_FrameDue(void);
+
+/**
+ * @brief Reads the frame counters and the achieved frame rate.
+ * @param[out] stats frame statistics.
+ */
+void ssd1306_GetFrameStats(SSD1306_FrameStats_t *stats);
+
+/**
+ * @brief Builds the digit sprites of a numeric readout.
+ * @param[out] readout readout state, keep it for ssd1306_ReadoutSet.
+ * @param[in] font subset font with the digits, '.' and '-' (e.g. Font_UI_16x26),
+ *            run-length encoded glyphs are decoded once here.
+ * @param[in] x, y top left corner of the area, any y offset.
+ * @param[in] width area width in pixels.
+ * @param[in] color digit color.
+ * @return SSD1306_ERR if the font or area does not fit.
+ */
+SSD1306_Error_t ssd1306_ReadoutInit(SSD1306_Readout_t *readout, const SSD1306_GlyphFont_t *font,
+                                    uint8_t x, uint8_t y, uint8_t width, SSD1306_COLOR color);
+
+/**
+ * @brief Shows a number, redrawing only the characters that changed.
+ * @param[in] text digits, '.', '-' and ' '; other characters are blank.
+ *            Text wider than the area is shown as "---".
+ * @return  1: the screenbuffer changed.
+ *          0: nothing to draw.
+ */
+uint8_t ssd1306_ReadoutSet(SSD1306_Readout_t *readout, const char *text);
+
+/**
+ * @brief Redraws the whole readout on the next ssd1306_ReadoutSet.
+ * @note Call after something else has drawn over the area.
+ */
+void ssd1306_ReadoutInvalidate(SSD1306_Readout_t *readout);
+
+#if defined(SSD1306_USE_DMA)
+/**
+ * @brief Reads the DMA flush state.
+ * @return  0: idle, the screenbuffer may be sent again.
+ *          1: a frame is being sent.
+ */
+uint8_t ssd1306_IsFlushing(void);
+
+/**
+ * @brief Called from interrupt context when a frame has been sent.
+ * @note Weak, override in the application.
+ */
+void ssd1306_FlushCpltCallback(void);
+#endif
+
 // Low-level procedures
 void ssd1306_Reset(void);
 void ssd1306_WriteCommand(uint8_t byte);
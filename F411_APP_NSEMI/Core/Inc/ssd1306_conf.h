@@ -24,6 +24,15 @@
 #define SSD1306_I2C_PORT        hi2c1
 #define SSD1306_I2C_ADDR        (0x3C << 1)
 
+// Non-blocking ssd1306_UpdateScreen: the frame goes out with I2C DMA.
+// Needs the I2C TX DMA stream and the I2C event/error interrupts (i2c.c).
+#define SSD1306_USE_DMA
+
+// Double buffering for SSD1306_USE_DMA: ssd1306_UpdateScreen copies the frame
+// to a second buffer (SSD1306_BUFFER_SIZE bytes of RAM) so drawing the next
+// frame cannot mix into the one being sent.
+#define SSD1306_DOUBLE_BUFFER
+
 // SPI Configuration
 //#define SSD1306_SPI_PORT        hspi1
 //#define SSD1306_CS_Port         OLED_CS_GPIO_Port
@@ -41,11 +50,22 @@
 // # define SSD1306_INVERSE_COLOR
 
 // Include only needed fonts
+// The firmware draws with the Font_UI_* subsets (ssd1306_fonts_ui.c, Tools/font_gen).
+// The full fonts are only used by ssd1306_tests.c, define SSD1306_TESTS to build them.
+#ifdef SSD1306_TESTS
 #define SSD1306_INCLUDE_FONT_6x8
 #define SSD1306_INCLUDE_FONT_7x10
 #define SSD1306_INCLUDE_FONT_11x18
 #define SSD1306_INCLUDE_FONT_16x26
 #define SSD1306_INCLUDE_FONT_16x24
+#endif
+
+// Decoded glyph cache for run-length encoded fonts drawn as text. The firmware's
+// only RLE font is decoded once by the readout, so the cache is needed only by
+// ssd1306_tests.c and by a generated Font_UI_CJK (Tools/font_gen -DFONT_CJK_BDF).
+#ifdef SSD1306_TESTS
+#define SSD1306_GLYPH_CACHE_SIZE    8
+#endif
 
 // Some OLEDs don't display anything in first two columns.
 // In this case change the following macro to 130.
@@ -28,6 +28,15 @@
 #define SSD1306_I2C_PORT        hi2c1
 #define SSD1306_I2C_ADDR        (0x3C << 1)
 
+// Non-blocking ssd1306_UpdateScreen: the frame goes out with I2C DMA.
+// Needs the I2C TX DMA stream and the I2C event/error interrupts.
+//#define SSD1306_USE_DMA
+
+// Double buffering for SSD1306_USE_DMA: ssd1306_UpdateScreen copies the frame
+// to a second buffer (SSD1306_BUFFER_SIZE bytes of RAM) so drawing the next
+// frame cannot mix into the one being sent.
+//#define SSD1306_DOUBLE_BUFFER
+
 // SPI Configuration
 //#define SSD1306_SPI_PORT        hspi1
 //#define SSD1306_CS_Port         OLED_CS_GPIO_Port
@@ -0,0 +1,16 @@
+/*
+ * ssd1306_fonts_ui.h
+ *
+ *  Generated by Tools/font_gen, do not edit.
+ */
+#ifndef __SSD1306_FONTS_UI_H__
+#define __SSD1306_FONTS_UI_H__
+
+#include "ssd1306.h"
+
+#define SSD1306_HAVE_FONT_UI_6X8
+extern const SSD1306_GlyphFont_t Font_UI_6x8;
+#define SSD1306_HAVE_FONT_UI_16X26
+extern const SSD1306_GlyphFont_t Font_UI_16x26;
+
+#endif // __SSD1306_FONTS_UI_H__
@@ -18,6 +18,8 @@ void ssd1306_TestCircle(void);
 void ssd1306_TestArc(void);
 void ssd1306_TestPolyline(void);
 void ssd1306_TestDrawBitmap(void);
+void ssd1306_TestBenchmark(void);
+void ssd1306_TestBenchmarkPrint(void);
 
 _END_STD_C
 
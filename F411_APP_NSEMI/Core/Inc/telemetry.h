@@ -0,0 +1,44 @@
+/*
+ * telemetry.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  二進位遙測：COBS 訊框 + 硬體 CRC，經 uart_log 或 USB CDC 送出（格式見 telemetry_protocol.h）
+ */
+
+#ifndef INC_TELEMETRY_H_
+#define INC_TELEMETRY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f4xx_hal.h"
+#include "telemetry_protocol.h"
+#include "current_monitor.h"
+
+// 遙測統計
+typedef struct {
+    uint32_t frames;            // 成功放進輸出緩衝區的訊框
+    uint32_t dropped;           // 緩衝區滿而丟棄的訊框
+    uint32_t bytes;             // 編碼後的位元組
+} Telemetry_Stats_t;
+
+void Telemetry_Init(void);
+void Telemetry_SetEnabled(uint8_t enable);
+uint8_t Telemetry_IsEnabled(void);
+HAL_StatusTypeDef Telemetry_Send(uint8_t type, const void *payload, uint16_t length);
+void Telemetry_AddSample(float value, uint16_t period_ms);
+void Telemetry_FlushSamples(void);
+void Telemetry_SendStats(const Current_Monitor_t *monitor);
+void Telemetry_FillStats(const Current_Monitor_t *monitor, Tlm_Stats_t *record);
+void Telemetry_SendState(uint8_t domain, uint8_t from, uint8_t to);
+void Telemetry_SendProfile(void);
+void Telemetry_GetStats(Telemetry_Stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_TELEMETRY_H_ */
@@ -0,0 +1,222 @@
+/*
+ * telemetry_protocol.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  二進位遙測格式（韌體與 Tools/tlm_decode 共用，只能依賴 stdint）
+ *
+ *  一個訊框 = 0x00 + COBS(header + payload + crc32) + 0x00
+ *    header   : Tlm_Header_t，8 bytes
+ *    payload  : 紀錄內容，長度為 4 的倍數
+ *    crc32    : header + payload 的 CRC-32/MPEG-2，以 little-endian 32 位元字計算
+ *               （即 STM32 硬體 CRC 單元的結果）
+ *  所有欄位皆為 little-endian，float 為 IEEE-754 單精度。
+ *  seq 每送一個訊框加一（包含因緩衝區滿而丟棄的），接收端以跳號判斷遺失。
+ *  訊框前後都有 0x00，同一條 UART 上夾雜的 printf 文字會落在兩個 0x00 之間，
+ *  不會和訊框黏在一起。
+ */
+
+#ifndef INC_TELEMETRY_PROTOCOL_H_
+#define INC_TELEMETRY_PROTOCOL_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+#define TLM_STATIC_ASSERT(cond, msg)    static_assert(cond, msg)
+#else
+#define TLM_STATIC_ASSERT(cond, msg)    _Static_assert(cond, msg)
+#endif
+
+#define TLM_PROTOCOL_VERSION    1
+#define TLM_DELIMITER           0x00
+
+// 紀錄類型
+#define TLM_REC_SAMPLES         0x01
+#define TLM_REC_STATS           0x02
+#define TLM_REC_STATE           0x03
+#define TLM_REC_PROFILE         0x04
+#define TLM_REC_LOG             0x05
+
+// 狀態轉換的範圍
+#define TLM_DOMAIN_APP          0       // 開機流程（main.c App_Phase_t）
+#define TLM_DOMAIN_LOAD         1       // 負載狀態（Load_State_t）
+
+// TLM_DOMAIN_APP 的狀態值
+#define TLM_APP_CAL_ZERO        0
+#define TLM_APP_CAL_MANUAL      1
+#define TLM_APP_RUNNING         2
+
+// TLM_DOMAIN_LOAD 的狀態值
+#define TLM_LOAD_STOPPED        0
+#define TLM_LOAD_NOISE          1
+#define TLM_LOAD_WEAK           2
+#define TLM_LOAD_DETECTED       3
+#define TLM_LOAD_STARTING       4
+#define TLM_LOAD_RUNNING        5
+
+#define TLM_MAX_SAMPLES         32      // 每筆 SAMPLES 紀錄最多樣本數
+#define TLM_TASK_NAME_LEN       8
+#define TLM_LOG_MAX_ARGS        8       // 每筆 LOG 紀錄最多參數數
+#define TLM_LOG_ARG_BYTES       56      // 參數區大小
+
+// LOG 參數型態（arg_types 每個參數 2 位元，第 0 個參數在最低位元）
+#define TLM_LOG_ARG_U32         0       // 4 bytes
+#define TLM_LOG_ARG_I32         1       // 4 bytes
+#define TLM_LOG_ARG_FLOAT       2       // 4 bytes IEEE-754
+#define TLM_LOG_ARG_STRING      3       // 1 byte 長度 + 字元（不含結尾 0）
+
+typedef struct {
+    uint8_t  type;              // TLM_REC_x
+    uint8_t  version;           // TLM_PROTOCOL_VERSION
+    uint16_t seq;
+    uint32_t time_ms;           // HAL_GetTick()
+} Tlm_Header_t;
+
+// 電流樣本（A）；實際長度 8 + 4 * count
+typedef struct {
+    uint32_t first_index;       // 第一個樣本的序號
+    uint16_t period_ms;         // 樣本間隔
+    uint16_t count;
+    float    value[TLM_MAX_SAMPLES];
+} Tlm_Samples_t;
+
+// 監控統計（A / V / W）
+typedef struct {
+    float    current_now;
+    float    current_rms;
+    float    current_max;
+    float    current_min;
+    float    voltage;
+    float    power;
+    uint32_t sample_count;
+    uint8_t  load_state;        // TLM_LOAD_x
+    uint8_t  monitor_status;    // Monitor_Status_t
+    uint16_t reserved;
+} Tlm_Stats_t;
+
+// 狀態轉換
+typedef struct {
+    uint8_t  domain;            // TLM_DOMAIN_x
+    uint8_t  from;
+    uint8_t  to;
+    uint8_t  reserved;
+} Tlm_State_t;
+
+// 排程器任務統計，一個任務一筆
+typedef struct {
+    uint8_t  task_id;
+    uint8_t  priority;
+    uint16_t cpu_load;          // 整體 CPU 負載（千分比）
+    char     name[TLM_TASK_NAME_LEN];
+    uint32_t runs;
+    uint32_t last_cycles;
+    uint32_t max_cycles;
+    uint32_t avg_cycles;
+    uint32_t deadline_misses;
+    uint32_t overruns;
+} Tlm_Profile_t;
+
+// LOGID 紀錄：格式字串不傳送，id 是它在 ELF .logstr section 中的位移；
+// 實際長度 8 + arg_length 補到 4 的倍數
+typedef struct {
+    uint16_t id;
+    uint16_t arg_types;         // TLM_LOG_ARG_x
+    uint8_t  arg_count;
+    uint8_t  arg_length;        // args 的有效長度
+    uint16_t reserved;
+    uint8_t  args[TLM_LOG_ARG_BYTES];
+} Tlm_Log_t;
+
+/*
+ *  原始波形串流（raw_stream.c，USART6 切換到高鮑率時使用，不經過 COBS）
+ *  一個區塊 = Tlm_StreamHeader_t + 12 位元打包樣本 + Fletcher-16 檢查碼
+ *    打包：每兩個樣本 a、b 佔 3 bytes：a[7:0]、b[3:0]<<4 | a[11:8]、b[11:4]，
+ *          樣本依 data[sample * channels + channel] 順序，奇數個時最後補 0
+ *    payload_bytes 補到 4 的倍數；檢查碼涵蓋 header + payload，之後補 2 bytes 0
+ *  接收端以 sync 找區塊開頭，以 first_index 的跳號計算遺失的樣本數。
+ *
+ *  USB CDC 串流（usb_stream.c）用同一個 header，bits = TLM_STREAM_BITS_RAW：
+ *    payload 直接是 DMA 緩衝區的 16 位元 little-endian 樣本，payload_bytes = 樣本數 * 2，
+ *    沒有檢查碼（USB 封包本身有 CRC16）；overruns 另外包含傳送中被 DMA 覆寫的區塊。
+ */
+#define TLM_STREAM_SYNC         0x5AA5
+#define TLM_STREAM_BITS         12
+#define TLM_STREAM_BITS_RAW     16
+
+typedef struct {
+    uint16_t sync;              // TLM_STREAM_SYNC
+    uint8_t  channels;
+    uint8_t  bits;              // TLM_STREAM_BITS
+    uint32_t sequence;          // 取樣區塊序號
+    uint32_t first_index;       // 第一個樣本的全域樣本索引
+    uint32_t sample_rate_hz;
+    uint16_t samples;           // 每通道樣本數
+    uint16_t payload_bytes;
+    uint16_t dropped;           // 累計：傳送佇列滿而丟棄的區塊
+    uint16_t overruns;          // 累計：取樣 DMA 覆寫次數
+} Tlm_StreamHeader_t;
+
+/*
+ *  USB 通用 HID（usb_hid.c，vendor-defined，不需要安裝驅動）：報告固定 64 bytes，沒有 report ID
+ *    IN 區塊：一個 header 報告（Tlm_StreamHeader_t，bits = TLM_STREAM_BITS_RAW，補 0 到 64 bytes），
+ *             接著 payload_bytes / 64 個報告，內容直接是 DMA 緩衝區的 16 位元樣本
+ *    IN 狀態：Tlm_HidStatus_t，sync = TLM_HID_SYNC_STATUS，可能插在兩個區塊之間
+ *    OUT 指令：Tlm_HidCommand_t，結果在下一個狀態報告的 last_cmd / last_tag / last_result
+ *  樣本只有 12 位元（< 0x1000），接收端以報告開頭的 sync 分辨報告類型。
+ *  複合裝置（CDC + HID）的 CDC 埠已開啟時，START 的區塊改走 CDC bulk（格式同 USB CDC 串流），
+ *  HID 只送狀態報告，streaming = TLM_HID_STREAM_CDC，計數為 CDC 串流的計數。
+ */
+#define TLM_HID_REPORT_SIZE     64
+#define TLM_HID_SYNC_STATUS     0x5AA6
+
+// OUT 指令
+#define TLM_HID_CMD_START       0x01    // 開始區塊串流，arg = 取樣率 Hz（0 = 預設）
+#define TLM_HID_CMD_STOP        0x02    // 停止區塊串流
+#define TLM_HID_CMD_STATUS      0x03    // 狀態報告間隔，arg = ms（0 = 停止）
+
+// 狀態報告 streaming
+#define TLM_HID_STREAM_NONE     0
+#define TLM_HID_STREAM_HID      1       // 區塊以 HID 報告送出
+#define TLM_HID_STREAM_CDC      2       // 區塊走 CDC bulk（複合裝置）
+
+typedef struct {
+    uint8_t  cmd;               // TLM_HID_CMD_x
+    uint8_t  tag;               // 主機自訂，原樣放回狀態報告
+    uint16_t reserved;
+    uint32_t arg;
+    uint8_t  unused[TLM_HID_REPORT_SIZE - 8];
+} Tlm_HidCommand_t;
+
+typedef struct {
+    uint16_t sync;              // TLM_HID_SYNC_STATUS
+    uint8_t  last_cmd;          // 最近執行的指令
+    uint8_t  last_tag;
+    uint8_t  last_result;       // 0 = 成功，其餘為 HAL_StatusTypeDef
+    uint8_t  streaming;         // TLM_HID_STREAM_*
+    uint16_t reserved;
+    uint32_t time_ms;
+    Tlm_Stats_t stats;          // 與 TLM_REC_STATS 相同
+    uint32_t blocks;            // 已送出的區塊
+    uint32_t dropped;           // 丟棄的區塊
+    uint32_t torn;              // 傳送中被 DMA 覆寫的區塊
+    uint32_t commands;          // 收到的指令報告
+    uint32_t sample_rate_hz;    // 串流中的取樣率，0 = 未串流
+} Tlm_HidStatus_t;
+
+TLM_STATIC_ASSERT(sizeof(Tlm_Header_t) == 8, "Tlm_Header_t layout");
+TLM_STATIC_ASSERT(sizeof(Tlm_Samples_t) == 8 + 4 * TLM_MAX_SAMPLES, "Tlm_Samples_t layout");
+TLM_STATIC_ASSERT(sizeof(Tlm_Stats_t) == 32, "Tlm_Stats_t layout");
+TLM_STATIC_ASSERT(sizeof(Tlm_State_t) == 4, "Tlm_State_t layout");
+TLM_STATIC_ASSERT(sizeof(Tlm_Profile_t) == 36, "Tlm_Profile_t layout");
+TLM_STATIC_ASSERT(sizeof(Tlm_Log_t) == 8 + TLM_LOG_ARG_BYTES, "Tlm_Log_t layout");
+TLM_STATIC_ASSERT(sizeof(Tlm_StreamHeader_t) == 24, "Tlm_StreamHeader_t layout");
+TLM_STATIC_ASSERT(sizeof(Tlm_HidCommand_t) == TLM_HID_REPORT_SIZE, "Tlm_HidCommand_t layout");
+TLM_STATIC_ASSERT(sizeof(Tlm_HidStatus_t) == TLM_HID_REPORT_SIZE, "Tlm_HidStatus_t layout");
+
+#define TLM_MAX_PAYLOAD         ((uint16_t)sizeof(Tlm_Samples_t))
+#define TLM_MAX_RAW             (sizeof(Tlm_Header_t) + TLM_MAX_PAYLOAD + 4)
+// COBS 每 254 bytes 最多多一個 byte，再加開頭碼與前後兩個 0x00
+#define TLM_MAX_ENCODED         (TLM_MAX_RAW + TLM_MAX_RAW / 254 + 3)
+
+#endif /* INC_TELEMETRY_PROTOCOL_H_ */
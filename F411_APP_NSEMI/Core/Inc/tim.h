@@ -46,7 +46,9 @@ void MX_TIM4_Init(void);
 void HAL_TIM_MspPostInit(TIM_HandleTypeDef *htim);
 
 /* USER CODE BEGIN Prototypes */
+extern TIM_HandleTypeDef htim3;
 
+void MX_TIM3_Init(void);
 /* USER CODE END Prototypes */
 
 #ifdef __cplusplus
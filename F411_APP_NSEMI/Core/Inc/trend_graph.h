@@ -0,0 +1,59 @@
+/*
+ * trend_graph.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  OLED 即時電流趨勢圖：每行像素顯示一段時間內的最小/最大值，
+ *  新資料以掃描方式（像心電圖）寫到環形位置，每行只更新一行像素
+ */
+
+#ifndef INC_TREND_GRAPH_H_
+#define INC_TREND_GRAPH_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f4xx_hal.h"
+#include "ssd1306.h"
+
+// 最大寬度（行數）
+#define TREND_GRAPH_MAX_WIDTH   SSD1306_WIDTH
+// 掃描位置前方清空的行數，標示最新資料的位置
+#define TREND_GRAPH_GAP         2
+
+typedef struct {
+    // 區域與刻度
+    uint8_t  x;
+    uint8_t  y;
+    uint8_t  width;
+    uint8_t  height;
+    int32_t  min_milli;             // 底部對應的電流 (mA)
+    int32_t  max_milli;             // 頂部對應的電流 (mA)
+    uint16_t samples_per_column;    // 每行抽取的樣本數
+
+    // 目前這一行的抽取
+    int32_t  acc_min;
+    int32_t  acc_max;
+    uint16_t acc_count;
+
+    // 環形行緩衝區：位置 = 畫面上的行，保留數值以便重畫或改刻度
+    int16_t  col_min[TREND_GRAPH_MAX_WIDTH];
+    int16_t  col_max[TREND_GRAPH_MAX_WIDTH];
+    uint32_t written;               // 已完成的行數（全域索引）
+    uint32_t drawn;                 // 已畫到畫面緩衝區的行數
+} TrendGraph_t;
+
+HAL_StatusTypeDef TrendGraph_Init(TrendGraph_t *graph, uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+                                  int32_t min_milli, int32_t max_milli, uint16_t samples_per_column);
+HAL_StatusTypeDef TrendGraph_SetRange(TrendGraph_t *graph, int32_t min_milli, int32_t max_milli);
+void TrendGraph_AddSample(TrendGraph_t *graph, int32_t milli);
+uint8_t TrendGraph_Render(TrendGraph_t *graph);
+void TrendGraph_Redraw(TrendGraph_t *graph);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_TREND_GRAPH_H_ */
@@ -0,0 +1,45 @@
+/*
+ * uart_log.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  非阻塞 UART 輸出：無鎖環形緩衝區 + USART6 TX DMA
+ */
+
+#ifndef INC_UART_LOG_H_
+#define INC_UART_LOG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f4xx_hal.h"
+
+// 環形緩衝區大小（2 的次方）
+#define UART_LOG_RING_SIZE      2048
+
+// 輸出統計
+typedef struct {
+    uint32_t bytes;             // 已放進緩衝區的位元組
+    uint32_t dropped_msgs;      // 緩衝區放不下而丟棄的訊息
+    uint32_t dropped_bytes;
+    uint32_t isr_drops;         // 在中斷中呼叫而丟棄的訊息
+    uint32_t max_used;          // 緩衝區最高使用量
+    uint32_t dma_errors;        // DMA 啟動失敗次數
+} UartLog_Stats_t;
+
+uint32_t UartLog_Write(const uint8_t *data, uint32_t len);
+uint32_t UartLog_Free(void);
+uint8_t UartLog_IsIdle(void);
+void UartLog_GetStats(UartLog_Stats_t *stats);
+HAL_StatusTypeDef UartLog_Suspend(uint32_t timeout_ms);
+void UartLog_Resume(void);
+void UartLog_TxComplete(UART_HandleTypeDef *huart);
+void UartLog_TxCpltCallback(UART_HandleTypeDef *huart);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_UART_LOG_H_ */
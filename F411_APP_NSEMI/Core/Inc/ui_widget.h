@@ -0,0 +1,96 @@
+/*
+ * ui_widget.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  OLED 保留模式元件：文字標籤、固定格式數值、長條圖、狀態圖示
+ *  每個元件記住上一次畫出的內容，只有顯示結果改變時才重畫自己的區域
+ */
+
+#ifndef INC_UI_WIDGET_H_
+#define INC_UI_WIDGET_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f4xx_hal.h"
+#include "ssd1306.h"
+
+// 文字標籤最多字元數（bytes，UTF-8）
+#define UI_LABEL_MAX_CHARS      21
+// 數值欄位最多字元數（含負號與小數點）
+#define UI_NUMBER_MAX_CHARS     11
+// 狀態圖示大小（row-major，每列 1 byte，高位元在左）
+#define UI_ICON_SIZE            8
+
+/* 共同部分：區域與是否需要整個重畫 */
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+    uint8_t width;
+    uint8_t height;
+    uint8_t valid;                  // 0 = 下一次 Set 整個重畫
+} UiWidget_t;
+
+/* 文字標籤：文字不同時清除區域重畫 */
+typedef struct {
+    UiWidget_t base;
+    const SSD1306_GlyphFont_t *font;
+    char text[UI_LABEL_MAX_CHARS + 1];
+} UiLabel_t;
+
+/* 數值欄位：定點數值靠右對齊成固定字元數，每個字元一格，只重畫改變的格 */
+typedef struct {
+    UiWidget_t base;
+    const SSD1306_GlyphFont_t *font;
+    uint8_t chars;                  // 欄位字元數
+    uint8_t decimals;               // 小數位數
+    uint8_t cell;                   // 每格寬度（字型最寬的字）
+    int32_t value;                  // 上一次的定點數值（value / 10^decimals）
+    char text[UI_NUMBER_MAX_CHARS + 1];
+} UiNumber_t;
+
+/* 長條圖：外框 + 內部填滿長度，只畫增減的那幾行 */
+typedef struct {
+    UiWidget_t base;
+    int32_t min;
+    int32_t max;
+    uint8_t fill;                   // 上一次的填滿寬度（像素）
+} UiBar_t;
+
+/* 狀態圖示：每個狀態一張 UI_ICON_SIZE x UI_ICON_SIZE 點陣圖 */
+typedef struct {
+    UiWidget_t base;
+    const uint8_t (*images)[UI_ICON_SIZE];
+    uint8_t count;
+    uint8_t state;
+} UiIcon_t;
+
+void UiWidget_Invalidate(UiWidget_t *widget);
+void UiWidget_Clear(UiWidget_t *widget);
+
+HAL_StatusTypeDef UiLabel_Init(UiLabel_t *label, uint8_t x, uint8_t y, uint8_t width,
+                               const SSD1306_GlyphFont_t *font);
+uint8_t UiLabel_Set(UiLabel_t *label, const char *text);
+
+HAL_StatusTypeDef UiNumber_Init(UiNumber_t *number, uint8_t x, uint8_t y, uint8_t chars,
+                                uint8_t decimals, const SSD1306_GlyphFont_t *font);
+uint8_t UiNumber_Set(UiNumber_t *number, int32_t value);
+uint8_t UiNumber_SetFloat(UiNumber_t *number, float value);
+
+HAL_StatusTypeDef UiBar_Init(UiBar_t *bar, uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+                             int32_t min, int32_t max);
+HAL_StatusTypeDef UiBar_SetRange(UiBar_t *bar, int32_t min, int32_t max);
+uint8_t UiBar_Set(UiBar_t *bar, int32_t value);
+
+HAL_StatusTypeDef UiIcon_Init(UiIcon_t *icon, uint8_t x, uint8_t y,
+                              const uint8_t (*images)[UI_ICON_SIZE], uint8_t count);
+uint8_t UiIcon_Set(UiIcon_t *icon, uint8_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_UI_WIDGET_H_ */
@@ -0,0 +1,64 @@
+/*
+ * usb_audio.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  USB 音訊輸入（UAC1 麥克風）：ACS712（可選 VC）以 16 位元 PCM 送給主機，
+ *  主機開啟錄音時自動開始取樣
+ */
+
+#ifndef INC_USB_AUDIO_H_
+#define INC_USB_AUDIO_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f4xx_hal.h"
+#include "acquisition.h"
+
+// 環形緩衝區（每通道樣本數，2 的次方）：48 kHz 約 21 ms
+#define USB_AUDIO_RING_FRAMES   1024
+// 目標水位（已取樣未送出的樣本數）：要大於一個區塊加一個封包，約 3.3 ms 延遲
+#define USB_AUDIO_TARGET_FRAMES (ACQ_BLOCK_SAMPLES * 5 / 2)
+// 速率量測視窗（SOF 數，2 的次方）
+#define USB_AUDIO_FB_WINDOW_LOG2 10
+
+// 控制事件任務的 deadline（主機切換介面到處理完）
+#define USB_AUDIO_CONTROL_DEADLINE_MS 20
+
+// 主機開始/停止錄音時由 audioctl 事件任務在主迴圈呼叫：active = 1 開始，0 停止
+typedef HAL_StatusTypeDef (*UsbAudio_Handler_t)(uint8_t active);
+
+// 音訊統計
+typedef struct {
+    uint8_t  configured;        // 主機已設定裝置
+    uint8_t  active;            // 主機選了串流介面（錄音中）
+    uint8_t  streaming;         // 取樣中
+    uint32_t packets;           // 主機收走的封包
+    uint32_t resent;            // 主機漏收而重送的封包
+    uint32_t frames;            // 送出的樣本數（每通道）
+    uint32_t underruns;         // 資料不足而縮短的封包
+    uint32_t overflows;         // 主機收太慢、被覆寫而丟棄的樣本
+    uint32_t trims;             // 水位修正（封包多送/少送一個樣本）
+    uint32_t rate_milli_hz;     // 以 SOF 量到的取樣率（0.001 Hz，以主機 1 kHz SOF 為基準）
+    uint16_t level;             // 目前水位（樣本數）
+} UsbAudio_Stats_t;
+
+HAL_StatusTypeDef UsbAudio_Init(UsbAudio_Handler_t handler);
+HAL_StatusTypeDef UsbAudio_Start(void);
+void UsbAudio_Stop(void);
+uint8_t UsbAudio_IsStreaming(void);
+void UsbAudio_GetStats(UsbAudio_Stats_t *stats);
+
+// usbd_audio_in_if.c 呼叫（USB 中斷）
+void UsbAudio_SetConfigured(uint8_t configured);
+void UsbAudio_SetActive(uint8_t active);
+uint16_t UsbAudio_Fill(uint8_t *buffer, uint16_t max_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_USB_AUDIO_H_ */
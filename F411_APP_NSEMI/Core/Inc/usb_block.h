@@ -0,0 +1,65 @@
+/*
+ * usb_block.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  USB 取樣區塊佇列：usb_stream.c（CDC bulk）與 usb_hid.c（HID 報告）共用的
+ *  兩個槽位、取樣區塊回呼與 header → 樣本的傳送流程
+ */
+
+#ifndef INC_USB_BLOCK_H_
+#define INC_USB_BLOCK_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f4xx_hal.h"
+#include "acquisition.h"
+#include "telemetry_protocol.h"
+
+// 槽位狀態
+#define USB_BLOCK_FREE          0
+#define USB_BLOCK_QUEUED        1
+#define USB_BLOCK_SENDING       2
+
+// 類別的傳送函數（CDC_Transmit_FS / HID_Transmit_FS），回傳 USBD_OK 表示已開始
+typedef uint8_t (*UsbBlock_Transmit_t)(uint8_t *buf, uint16_t len);
+
+// 一個取樣區塊：header 在這裡（HID 補滿一個報告），樣本直接指向 DMA 緩衝區
+typedef struct {
+    Tlm_StreamHeader_t header;
+    uint8_t padding[TLM_HID_REPORT_SIZE - sizeof(Tlm_StreamHeader_t)];
+    const uint16_t *data;
+    uint16_t bytes;
+    volatile uint8_t state;
+} UsbBlock_Slot_t;
+
+typedef struct {
+    UsbBlock_Slot_t slots[2];           // sequence & 1 對應乒乓緩衝區的一半
+    uint8_t send_slot;                  // 正在送的槽位
+    uint16_t header_len;                // 送出的 header 長度
+    UsbBlock_Transmit_t transmit;
+    uint32_t blocks;                    // 已送出的區塊
+    uint32_t dropped;                   // 來不及送而丟棄的區塊
+    uint32_t torn;                      // 傳送中被 DMA 覆寫的區塊
+} UsbBlock_Queue_t;
+
+#define USB_BLOCK_QUEUE_INIT(transmit_fn, header_size) \
+    { .header_len = (header_size), .transmit = (transmit_fn) }
+
+void UsbBlock_Clear(UsbBlock_Queue_t *queue);
+void UsbBlock_Cancel(UsbBlock_Queue_t *queue);
+void UsbBlock_Abort(UsbBlock_Queue_t *queue);
+void UsbBlock_Put(UsbBlock_Queue_t *queue, const Acq_Block_t *block);
+uint8_t UsbBlock_Pending(const UsbBlock_Queue_t *queue);
+uint8_t UsbBlock_SendHeader(UsbBlock_Queue_t *queue);
+uint8_t UsbBlock_SendData(UsbBlock_Queue_t *queue);
+void UsbBlock_Sent(UsbBlock_Queue_t *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_USB_BLOCK_H_ */
@@ -0,0 +1,60 @@
+/*
+ * usb_hid.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  USB 通用 HID：64 bytes IN/OUT 報告、1 ms 輪詢，IN 送狀態與原始取樣區塊，
+ *  OUT 收指令（格式見 telemetry_protocol.h）
+ */
+
+#ifndef INC_USB_HID_H_
+#define INC_USB_HID_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f4xx_hal.h"
+#include "acquisition.h"
+#include "current_monitor.h"
+#include "telemetry_protocol.h"
+
+// 狀態任務週期，狀態報告間隔以此為單位
+#define USB_HID_TICK_MS         10
+// 預設狀態報告間隔
+#define USB_HID_STATUS_MS       100
+// 指令事件任務的 deadline（收到 OUT 報告到處理完）
+#define USB_HID_COMMAND_DEADLINE_MS 20
+
+// 指令處理函數（hidcmd 事件任務在主迴圈呼叫）：START / STOP 由應用程式處理，STATUS 由本模組處理
+typedef HAL_StatusTypeDef (*UsbHid_Handler_t)(const Tlm_HidCommand_t *command);
+
+// HID 統計
+typedef struct {
+    uint8_t  configured;        // 主機已設定裝置
+    uint8_t  streaming;         // 區塊串流中
+    uint32_t blocks;            // 已送出的取樣區塊
+    uint32_t dropped;           // 上一個區塊還沒送完而丟棄的區塊
+    uint32_t torn;              // 傳送中被 DMA 覆寫的區塊
+    uint32_t status_reports;    // 已送出的狀態報告
+    uint32_t commands;          // 收到的指令報告
+    uint32_t command_drops;     // 上一個指令還沒處理完而丟棄的指令
+} UsbHid_Stats_t;
+
+HAL_StatusTypeDef UsbHid_Init(const Current_Monitor_t *monitor, UsbHid_Handler_t handler);
+HAL_StatusTypeDef UsbHid_Start(const Acq_Config_t *config);
+void UsbHid_Stop(void);
+uint8_t UsbHid_IsStreaming(void);
+void UsbHid_GetStats(UsbHid_Stats_t *stats);
+
+// usbd_hid_if.c 呼叫（USB 中斷）
+void UsbHid_SetConfigured(uint8_t configured);
+void UsbHid_Received(const uint8_t *report, uint16_t len);
+void UsbHid_TxComplete(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_USB_HID_H_ */
@@ -0,0 +1,64 @@
+/*
+ * usb_stream.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  USB CDC-ACM 串流：取樣區塊直接從 ADC DMA 乒乓緩衝區以 64 bytes bulk 送出，
+ *  平常則承載 COBS 遙測訊框
+ */
+
+#ifndef INC_USB_STREAM_H_
+#define INC_USB_STREAM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f4xx_hal.h"
+#include "acquisition.h"
+
+// 遙測位元組環形緩衝區大小（2 的次方），bench 時也當作測試資料
+#define USB_STREAM_RING_SIZE    2048
+// 一次 bulk 傳輸最多的位元組（多個 64 bytes 封包，結尾由 CDC 類別補 ZLP）
+#define USB_STREAM_MAX_XFER     USB_STREAM_RING_SIZE
+
+typedef enum {
+    USB_STREAM_IDLE = 0,        // 承載遙測
+    USB_STREAM_SAMPLES,         // 原始取樣區塊
+    USB_STREAM_BENCH            // 吞吐量測試
+} UsbStream_Mode_t;
+
+// 串流統計
+typedef struct {
+    uint8_t  mode;              // UsbStream_Mode_t
+    uint8_t  host_open;         // 主機已開啟序列埠（DTR）
+    uint32_t blocks;            // 已送出的取樣區塊
+    uint32_t dropped;           // 上一個區塊還沒送完而丟棄的區塊
+    uint32_t torn;              // 傳送中被 DMA 覆寫的區塊
+    uint32_t tlm_bytes;         // 已送出的遙測位元組
+    uint32_t tlm_drops;         // 緩衝區滿而丟棄的遙測訊框
+    uint32_t rx_bytes;          // 主機送來（並丟棄）的位元組
+    uint32_t bench_bytes;       // 最近一次 bench 送出的位元組
+    uint32_t bench_ms;          // 最近一次 bench 的實際時間
+} UsbStream_Stats_t;
+
+HAL_StatusTypeDef UsbStream_Start(const Acq_Config_t *config);
+void UsbStream_Stop(void);
+HAL_StatusTypeDef UsbStream_StartBench(uint32_t duration_ms);
+uint8_t UsbStream_IsOpen(void);
+UsbStream_Mode_t UsbStream_GetMode(void);
+uint32_t UsbStream_Write(const uint8_t *data, uint32_t len);
+void UsbStream_GetStats(UsbStream_Stats_t *stats);
+
+// usbd_cdc_if.c 呼叫（USB 中斷）
+void UsbStream_Reset(void);
+void UsbStream_SetHostOpen(uint8_t open);
+void UsbStream_Received(const uint8_t *data, uint32_t len);
+void UsbStream_TxComplete(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_USB_STREAM_H_ */
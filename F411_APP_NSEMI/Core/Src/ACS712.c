@@ -1,5 +1,7 @@
 #include "acs712.h"
 #include "current_monitor.h"
+#include "fixfmt.h"
+#include <stdio.h>
 
 /* 私有變數 */
 static float sensitivity_table[] = {0.185f, 0.100f, 0.066f}; // mV/A for 5A, 20A, 30A
@@ -50,12 +52,38 @@ HAL_StatusTypeDef ACS712_Calibrate(ACS712_Handle_t *hacs712)
         HAL_Delay(10);
     }
 
-    float average_adc = (float)sum / samples;
-    hacs712->zero_offset = (average_adc * hacs712->vref) / hacs712->adc_resolution;
+    ACS712_SetZeroFromRaw(hacs712, (float)sum / samples);
 
     return HAL_OK;
 }
 
+/**
+ * @brief  以 ADC 平均值設定零點（非阻塞校準由呼叫端自行累加樣本）
+ * @param  hacs712: ACS712控制結構指標
+ * @param  average_raw: 無負載時的 ADC 平均值
+ * @retval None
+ */
+void ACS712_SetZeroFromRaw(ACS712_Handle_t *hacs712, float average_raw)
+{
+    if (hacs712 == NULL)
+        return;
+
+    hacs712->zero_offset = (average_raw * hacs712->vref) / hacs712->adc_resolution;
+}
+
+/**
+ * @brief  讀取一次 ADC 原始值
+ * @param  hacs712: ACS712控制結構指標
+ * @retval ADC原始值
+ */
+uint32_t ACS712_ReadRaw(ACS712_Handle_t *hacs712)
+{
+    if (hacs712 == NULL)
+        return 0;
+
+    return ACS712_ReadADC(hacs712);
+}
+
 /**
  * @brief  讀取電流值
  * @param  hacs712: ACS712控制結構指標
@@ -66,8 +94,21 @@ float ACS712_ReadCurrent(ACS712_Handle_t *hacs712)
     if (hacs712 == NULL)
         return 0.0f;
 
-    uint32_t adc_value = ACS712_ReadADC(hacs712);
-    float voltage = (adc_value * hacs712->vref) / hacs712->adc_resolution;
+    return ACS712_ConvertRaw(hacs712, ACS712_ReadADC(hacs712));
+}
+
+/**
+ * @brief  將 ADC 原始值換算成電流（串流取樣的區塊資料用）
+ * @param  hacs712: ACS712控制結構指標
+ * @param  raw: ADC原始值（可為多個樣本的平均）
+ * @retval 電流值 (A)
+ */
+float ACS712_ConvertRaw(ACS712_Handle_t *hacs712, float raw)
+{
+    if (hacs712 == NULL)
+        return 0.0f;
+
+    float voltage = (raw * hacs712->vref) / hacs712->adc_resolution;
     float current = (voltage - hacs712->zero_offset) / hacs712->sensitivity;
 
     return current;
@@ -179,13 +220,17 @@ void ACS712_UpdateStats(float current, Current_Stats_t *stats)
 
     stats->timestamp = HAL_GetTick();
 
-    // **調試輸出**
+    // **調試輸出**（定義 ACS712_DEBUG_STATS 才輸出）
+#ifdef ACS712_DEBUG_STATS
     static uint32_t debug_count = 0;
     debug_count++;
     if (debug_count % 50 == 0) {  // 每50次輸出一次調試信息
-        printf("DEBUG: Raw=%.1f, Processed=%.1f, RMS=%.1f mA\r\n",
-               current * 1000.0f, current * 1000.0f, stats->rms_current * 1000.0f);
+        FixFmt_Buf_t num[2];
+        FixFmt_Float(num[0], current * 1000.0f, 1);
+        printf("DEBUG: Raw=%s, Processed=%s, RMS=%s mA\r\n",
+               num[0], num[0], FixFmt_Float(num[1], stats->rms_current * 1000.0f, 1));
     }
+#endif
 }
 
 
@@ -0,0 +1,307 @@
+/*
+ * acquisition.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  ADC1 串流取樣
+ *
+ *  原本 ACS712_ReadADC 每次都用輪詢啟動/等待/停止 ADC，取樣時間點不固定，
+ *  也無法和 PWM 同時長時間量測。串流模式下 TIM3 的 TRGO 以固定頻率觸發
+ *  ADC1 掃描，DMA2 Stream0 以環形模式搬到乒乓緩衝區；半滿/全滿中斷時把
+ *  剛完成的半區當成一個區塊交給註冊的使用者（自動調諧、遙測等）。
+ *
+ *  停止後 ADC1 會還原成 MX_ADC1_Init 的設定，原本的輪詢讀取可以繼續使用。
+ */
+#include "main.h"
+#include "adc.h"
+#include "tim.h"
+#include "acquisition.h"
+
+#define ACQ_BUFFER_LENGTH   (2 * ACQ_BLOCK_SAMPLES * ACQ_MAX_CHANNELS)
+
+/* 區塊使用者 */
+typedef struct {
+    Acq_Consumer_t consumer;
+    void *context;
+} Acq_Slot_t;
+
+/* 私有變數 */
+static uint16_t acq_buffer[ACQ_BUFFER_LENGTH];      // DMA 目的：前半/後半各一個區塊
+static Acq_Slot_t acq_slots[ACQ_MAX_CONSUMERS];
+static Acq_Status_t acq;
+
+/* 私有函數 */
+static uint32_t Acquisition_TimerClock(void);
+static HAL_StatusTypeDef Acquisition_ConfigADC(const Acq_Config_t *config);
+static void Acquisition_Dispatch(uint8_t half);
+
+/**
+ * @brief  取得預設設定：10 kHz、只取 ACS712 (IN0)
+ * @param  config: 設定結構指標
+ * @retval None
+ */
+void Acquisition_GetDefaultConfig(Acq_Config_t *config)
+{
+    if (config == NULL)
+        return;
+
+    config->sample_rate_hz = ACQ_DEFAULT_RATE_HZ;
+    config->channels = 1;
+    config->channel_list[0] = ADC_CHANNEL_0;
+    config->channel_list[1] = ADC_CHANNEL_3;
+}
+
+/**
+ * @brief  啟動串流取樣
+ * @param  config: 取樣設定
+ * @retval HAL狀態
+ */
+HAL_StatusTypeDef Acquisition_Start(const Acq_Config_t *config)
+{
+    if (config == NULL || config->sample_rate_hz == 0 ||
+        config->channels == 0 || config->channels > ACQ_MAX_CHANNELS)
+        return HAL_ERROR;
+
+    if (acq.running)
+        Acquisition_Stop();
+
+    // 計算 TIM3 分頻：ARR 必須放得進 16 位元
+    uint32_t clock = Acquisition_TimerClock();
+    uint32_t ticks = clock / config->sample_rate_hz;
+    if (ticks < 2)
+        return HAL_ERROR;
+
+    uint32_t prescaler = (ticks - 1) / 65536;
+    uint32_t period = ticks / (prescaler + 1);
+
+    __HAL_TIM_SET_PRESCALER(&htim3, prescaler);
+    __HAL_TIM_SET_AUTORELOAD(&htim3, period - 1);
+    __HAL_TIM_SET_COUNTER(&htim3, 0);
+    htim3.Instance->EGR = TIM_EGR_UG;
+
+    // ADC 單純輪詢時可能還在跑，先停掉再改設定
+    HAL_ADC_Stop(&hadc1);
+    if (Acquisition_ConfigADC(config) != HAL_OK)
+        return HAL_ERROR;
+
+    acq.channels = config->channels;
+    acq.sample_rate_hz = clock / ((prescaler + 1) * period);
+    acq.blocks = 0;
+    acq.overruns = 0;
+    acq.running = 1;
+
+    uint32_t length = 2U * ACQ_BLOCK_SAMPLES * config->channels;
+    if (HAL_ADC_Start_DMA(&hadc1, (uint32_t *)acq_buffer, length) != HAL_OK)
+    {
+        acq.running = 0;
+        MX_ADC1_Init();
+        return HAL_ERROR;
+    }
+
+    return HAL_TIM_Base_Start(&htim3);
+}
+
+/**
+ * @brief  停止串流取樣並還原 ADC 設定
+ * @retval None
+ */
+void Acquisition_Stop(void)
+{
+    if (!acq.running)
+        return;
+
+    acq.running = 0;
+    HAL_TIM_Base_Stop(&htim3);
+    HAL_ADC_Stop_DMA(&hadc1);
+
+    // 還原成軟體觸發的單通道設定，ACS712_ReadADC 依賴這個設定
+    MX_ADC1_Init();
+}
+
+/**
+ * @brief  註冊區塊使用者
+ * @param  consumer: 回呼函數（DMA 中斷內執行）
+ * @param  context: 回呼時原樣傳回
+ * @retval HAL狀態，沒有空位時回傳 HAL_ERROR
+ */
+HAL_StatusTypeDef Acquisition_Register(Acq_Consumer_t consumer, void *context)
+{
+    if (consumer == NULL)
+        return HAL_ERROR;
+
+    for (int i = 0; i < ACQ_MAX_CONSUMERS; i++) {
+        if (acq_slots[i].consumer == consumer) {
+            acq_slots[i].context = context;
+            return HAL_OK;
+        }
+    }
+
+    for (int i = 0; i < ACQ_MAX_CONSUMERS; i++) {
+        if (acq_slots[i].consumer == NULL) {
+            // 先寫 context，中斷看到 consumer 時 context 已經有效
+            acq_slots[i].context = context;
+            acq_slots[i].consumer = consumer;
+            return HAL_OK;
+        }
+    }
+
+    return HAL_ERROR;
+}
+
+void Acquisition_Unregister(Acq_Consumer_t consumer)
+{
+    for (int i = 0; i < ACQ_MAX_CONSUMERS; i++) {
+        if (acq_slots[i].consumer == consumer) {
+            acq_slots[i].consumer = NULL;
+        }
+    }
+}
+
+uint8_t Acquisition_IsRunning(void)
+{
+    return acq.running;
+}
+
+void Acquisition_GetStatus(Acq_Status_t *status)
+{
+    if (status == NULL)
+        return;
+
+    *status = acq;
+}
+
+/**
+ * @brief  目前的全域樣本索引：DMA 已寫入的每通道樣本數，精確到單一樣本
+ *         （區塊只能精確到 ACQ_BLOCK_SAMPLES，速率量測用這個）
+ * @retval 樣本索引，未取樣時為 0
+ * @note   在中斷內或關中斷時呼叫；半區已寫完但 DMA 中斷還沒處理時也算進去
+ */
+uint32_t Acquisition_GetSampleIndex(void)
+{
+    if (!acq.running)
+        return 0;
+
+    uint32_t half_length = (uint32_t)ACQ_BLOCK_SAMPLES * acq.channels;
+    uint32_t position = 2 * half_length - __HAL_DMA_GET_COUNTER(hadc1.DMA_Handle);
+    if (position >= 2 * half_length)
+        position = 0;
+
+    uint8_t writing = (position < half_length) ? 0 : 1;
+    uint32_t index = acq.blocks * ACQ_BLOCK_SAMPLES + (position % half_length) / acq.channels;
+    if (writing != (acq.blocks & 1U))
+        index += ACQ_BLOCK_SAMPLES;
+
+    return index;
+}
+
+/**
+ * @brief  TIM3 計數時脈（APB1 有分頻時計時器時脈為 PCLK1 x2）
+ * @retval 時脈 (Hz)
+ */
+static uint32_t Acquisition_TimerClock(void)
+{
+    uint32_t clock = HAL_RCC_GetPCLK1Freq();
+
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+        clock *= 2;
+
+    return clock;
+}
+
+/**
+ * @brief  將 ADC1 設為 TIM3 TRGO 觸發的掃描模式
+ * @param  config: 取樣設定
+ * @retval HAL狀態
+ */
+static HAL_StatusTypeDef Acquisition_ConfigADC(const Acq_Config_t *config)
+{
+    ADC_ChannelConfTypeDef sConfig = {0};
+
+    hadc1.Init.ScanConvMode = (config->channels > 1) ? ENABLE : DISABLE;
+    hadc1.Init.ContinuousConvMode = DISABLE;
+    hadc1.Init.DiscontinuousConvMode = DISABLE;
+    hadc1.Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_RISING;
+    hadc1.Init.ExternalTrigConv = ADC_EXTERNALTRIGCONV_T3_TRGO;
+    hadc1.Init.NbrOfConversion = config->channels;
+    hadc1.Init.DMAContinuousRequests = ENABLE;
+    hadc1.Init.EOCSelection = ADC_EOC_SEQ_CONV;
+    if (HAL_ADC_Init(&hadc1) != HAL_OK)
+        return HAL_ERROR;
+
+    for (uint8_t i = 0; i < config->channels; i++) {
+        sConfig.Channel = config->channel_list[i];
+        sConfig.Rank = i + 1;
+        // ACS712 輸出阻抗較高，取樣時間拉長比 3 cycles 穩定
+        sConfig.SamplingTime = ADC_SAMPLETIME_56CYCLES;
+        if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK)
+            return HAL_ERROR;
+    }
+
+    return HAL_OK;
+}
+
+/**
+ * @brief  把剛完成的半區交給所有使用者
+ * @param  half: 0 = 前半, 1 = 後半
+ * @retval None
+ */
+static void Acquisition_Dispatch(uint8_t half)
+{
+    if (!acq.running)
+        return;
+
+    Acq_Block_t block;
+    uint32_t half_length = (uint32_t)ACQ_BLOCK_SAMPLES * acq.channels;
+
+    block.data = &acq_buffer[half * half_length];
+    block.samples = ACQ_BLOCK_SAMPLES;
+    block.channels = acq.channels;
+    block.sequence = acq.blocks;
+    block.first_index = acq.blocks * ACQ_BLOCK_SAMPLES;
+
+    for (int i = 0; i < ACQ_MAX_CONSUMERS; i++) {
+        Acq_Consumer_t consumer = acq_slots[i].consumer;
+        if (consumer != NULL) {
+            consumer(&block, acq_slots[i].context);
+        }
+    }
+
+    acq.blocks++;
+
+    // 處理完時 DMA 若已寫進同一半區，代表使用者拿到的資料被覆寫過
+    uint32_t position = 2 * half_length - __HAL_DMA_GET_COUNTER(hadc1.DMA_Handle);
+    uint8_t writing = (position < half_length) ? 0 : 1;
+    if (writing == half) {
+        acq.overruns++;
+    }
+}
+
+/**
+ * @brief  串流未啟動時的 ADC DMA 完成回呼（單次 DMA 的使用者覆寫此函數）
+ * @param  hadc: ADC handle
+ * @retval None
+ */
+__weak void Acquisition_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    UNUSED(hadc);
+}
+
+// DMA 寫完前半區
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    if (hadc->Instance == ADC1)
+        Acquisition_Dispatch(0);
+}
+
+// DMA 寫完後半區
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    if (hadc->Instance != ADC1)
+        return;
+
+    if (acq.running)
+        Acquisition_Dispatch(1);
+    else
+        Acquisition_ConvCpltCallback(hadc);
+}
@@ -0,0 +1,339 @@
+/*
+ * autotune.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  繼電器回授自動調諧
+ *
+ *  1. PWM 關閉，從串流取樣的區塊內變異數估計 ACS712 雜訊 → 卡爾曼 R
+ *  2. 以 bias ± d 的繼電器（含遲滯 h）驅動 TIM1，讓電流迴路自行振盪
+ *  3. 量測振盪振幅 a 與週期 Tu：Ku = 4d / (π·sqrt(a² - h²))
+ *  4. Ziegler–Nichols PI：Kp = 0.45·Ku, Ki = Kp / (Tu / 1.2)
+ *
+ *  繼電器判斷在取樣區塊回呼（DMA 中斷）內以區塊平均電流進行，
+ *  結果計算在主迴圈呼叫 Autotune_Process 時處理。
+ */
+#include "main.h"
+#include "tim.h"
+#include "autotune.h"
+#include "acquisition.h"
+#include "handpiece.h"
+#include "param_store.h"
+#include "pwm_hr.h"
+#include <math.h>
+#include <string.h>
+
+#define AUTOTUNE_PI             3.14159265f
+#define AUTOTUNE_DUTY_MAX       999
+#define AUTOTUNE_NOISE_SETTLE   4       // PWM 關閉後先丟掉的區塊數
+
+/* 調諧過程資料（中斷與主迴圈共用） */
+typedef struct {
+    volatile Autotune_State_t state;
+    Autotune_Config_t config;
+    ACS712_Handle_t *hacs712;
+    uint32_t sample_rate_hz;
+    uint32_t start_tick;
+    uint8_t owns_acquisition;
+
+    // 雜訊量測
+    uint32_t noise_blocks;
+    float noise_var_sum;                // raw counts^2
+
+    // 繼電器
+    uint8_t relay_high;
+    uint8_t cycle_count;                // 已經過的完整週期（含穩定期）
+    uint8_t measured;                   // 納入平均的週期
+    uint8_t has_rise;
+    float last_rise_s;
+    float y_max;
+    float y_min;
+    float period_sum;
+    float amplitude_sum;
+
+    uint8_t result_valid;
+    Autotune_Result_t result;
+} Autotune_t;
+
+static Autotune_t at;
+
+/* 私有函數 */
+static void Autotune_OnBlock(const Acq_Block_t *block, void *context);
+static void Autotune_Finish(void);
+static void Autotune_Compute(void);
+
+/**
+ * @brief  預設設定（5V 風扇負載量級）
+ * @param  config: 設定結構指標
+ * @retval None
+ */
+void Autotune_GetDefaultConfig(Autotune_Config_t *config)
+{
+    if (config == NULL)
+        return;
+
+    config->setpoint = 0.150f;
+    config->hysteresis = 0.010f;
+    config->duty_bias = 500;
+    config->duty_step = 300;
+    config->cycles = 6;
+    config->timeout_ms = 20000;
+}
+
+/**
+ * @brief  開始自動調諧
+ * @param  hacs712: ACS712控制結構指標（提供零點與靈敏度）
+ * @param  config: 調諧設定
+ * @retval HAL狀態
+ */
+HAL_StatusTypeDef Autotune_Start(ACS712_Handle_t *hacs712, const Autotune_Config_t *config)
+{
+    if (hacs712 == NULL || config == NULL)
+        return HAL_ERROR;
+
+    if (config->duty_step == 0 || config->duty_step > config->duty_bias ||
+        config->duty_bias + config->duty_step > AUTOTUNE_DUTY_MAX ||
+        config->cycles == 0 || config->cycles > AUTOTUNE_MAX_CYCLES ||
+        config->hysteresis < 0.0f)
+        return HAL_ERROR;
+
+    if (at.state == AUTOTUNE_NOISE || at.state == AUTOTUNE_RELAY)
+        return HAL_BUSY;
+
+    // 高解析度模式的佔空比刻度不同，調諧只支援一般 PWM
+    if (PWM_HR_IsRunning())
+        return HAL_BUSY;
+
+    memset(&at, 0, sizeof(at));
+    at.config = *config;
+    at.hacs712 = hacs712;
+    at.start_tick = HAL_GetTick();
+
+    Set_PWM_DutyCycle(0);
+    Start_PWM();
+
+    if (!Acquisition_IsRunning()) {
+        Acq_Config_t acq_config;
+        Acquisition_GetDefaultConfig(&acq_config);
+        if (Acquisition_Start(&acq_config) != HAL_OK) {
+            Stop_PWM();
+            return HAL_ERROR;
+        }
+        at.owns_acquisition = 1;
+    }
+
+    Acq_Status_t acq_status;
+    Acquisition_GetStatus(&acq_status);
+    at.sample_rate_hz = acq_status.sample_rate_hz;
+
+    at.state = AUTOTUNE_NOISE;
+    if (Acquisition_Register(Autotune_OnBlock, &at) != HAL_OK) {
+        at.state = AUTOTUNE_FAILED;
+        Autotune_Finish();
+        return HAL_ERROR;
+    }
+
+    return HAL_OK;
+}
+
+/**
+ * @brief  主迴圈呼叫：處理逾時，振盪量測完成後計算結果
+ * @retval 目前狀態
+ */
+Autotune_State_t Autotune_Process(void)
+{
+    Autotune_State_t state = at.state;
+
+    if (state == AUTOTUNE_NOISE || state == AUTOTUNE_RELAY) {
+        if (HAL_GetTick() - at.start_tick > at.config.timeout_ms) {
+            at.state = AUTOTUNE_FAILED;
+            Autotune_Finish();
+        }
+    } else if (state == AUTOTUNE_DONE && !at.result_valid) {
+        Autotune_Finish();
+        Autotune_Compute();
+    }
+
+    return at.state;
+}
+
+void Autotune_Abort(void)
+{
+    if (at.state == AUTOTUNE_NOISE || at.state == AUTOTUNE_RELAY) {
+        at.state = AUTOTUNE_FAILED;
+        Autotune_Finish();
+    }
+}
+
+Autotune_State_t Autotune_GetState(void)
+{
+    return at.state;
+}
+
+HAL_StatusTypeDef Autotune_GetResult(Autotune_Result_t *result)
+{
+    if (result == NULL || !at.result_valid)
+        return HAL_ERROR;
+
+    *result = at.result;
+    return HAL_OK;
+}
+
+/**
+ * @brief  把調諧結果寫入參數區（第二組卡爾曼參數保持不變）
+ * @param  allow_erase: 0 = 只寫空白槽位（約數百 us，可以在排程任務中呼叫）
+ *                      1 = 參數區已滿時抹除 sector（CPU 停住 1~2 秒）
+ * @retval HAL狀態，allow_erase = 0 且參數區已滿時回傳 HAL_BUSY
+ */
+HAL_StatusTypeDef Autotune_SaveResult(uint8_t allow_erase)
+{
+    if (!at.result_valid)
+        return HAL_ERROR;
+
+    Param_Data_t data = *ParamStore_Get();
+
+    data.kalman_q[0] = at.result.kalman_q;
+    data.kalman_r[0] = at.result.kalman_r;
+    data.pi_kp = at.result.kp;
+    data.pi_ki = at.result.ki;
+    data.ku = at.result.ku;
+    data.tu = at.result.tu;
+
+    return allow_erase ? ParamStore_Save(&data) : ParamStore_Append(&data);
+}
+
+/**
+ * @brief  取樣區塊回呼（DMA 中斷內）
+ * @param  block: 取樣區塊
+ * @param  context: 未使用
+ * @retval None
+ */
+static void Autotune_OnBlock(const Acq_Block_t *block, void *context)
+{
+    (void)context;
+
+    Autotune_State_t state = at.state;
+    if (state != AUTOTUNE_NOISE && state != AUTOTUNE_RELAY)
+        return;
+
+    // 只用第一個通道（ACS712）
+    uint32_t sum = 0;
+    uint32_t sum_sq = 0;
+    for (uint16_t i = 0; i < block->samples; i++) {
+        uint32_t raw = block->data[i * block->channels];
+        sum += raw;
+        sum_sq += raw * raw;
+    }
+
+    float mean = (float)sum / block->samples;
+    float y = ACS712_ConvertRaw(at.hacs712, mean);
+
+    if (state == AUTOTUNE_NOISE) {
+        at.noise_blocks++;
+        if (at.noise_blocks <= AUTOTUNE_NOISE_SETTLE)
+            return;
+
+        // 區塊內變異數只含感測器雜訊，不受慢速漂移影響
+        float var = ((float)sum_sq - (float)sum * mean) / (block->samples - 1);
+        at.noise_var_sum += var;
+
+        if (at.noise_blocks >= AUTOTUNE_NOISE_SETTLE + AUTOTUNE_NOISE_BLOCKS) {
+            at.relay_high = 1;
+            at.y_max = y;
+            at.y_min = y;
+            Set_PWM_DutyCycle(at.config.duty_bias + at.config.duty_step);
+            at.state = AUTOTUNE_RELAY;
+        }
+        return;
+    }
+
+    if (y > at.y_max) at.y_max = y;
+    if (y < at.y_min) at.y_min = y;
+
+    if (at.relay_high && y > at.config.setpoint + at.config.hysteresis) {
+        at.relay_high = 0;
+        Set_PWM_DutyCycle(at.config.duty_bias - at.config.duty_step);
+    } else if (!at.relay_high && y < at.config.setpoint - at.config.hysteresis) {
+        // 切回高輸出 = 新週期開始
+        float t = (block->first_index + block->samples / 2) / (float)at.sample_rate_hz;
+
+        at.relay_high = 1;
+        Set_PWM_DutyCycle(at.config.duty_bias + at.config.duty_step);
+
+        if (at.has_rise) {
+            at.cycle_count++;
+            if (at.cycle_count > AUTOTUNE_SETTLE_CYCLES) {
+                at.period_sum += t - at.last_rise_s;
+                at.amplitude_sum += (at.y_max - at.y_min) * 0.5f;
+                at.measured++;
+            }
+        }
+
+        at.has_rise = 1;
+        at.last_rise_s = t;
+        at.y_max = y;
+        at.y_min = y;
+
+        if (at.measured >= at.config.cycles) {
+            Set_PWM_DutyCycle(0);
+            at.state = AUTOTUNE_DONE;
+        }
+    }
+}
+
+/**
+ * @brief  停止取樣回呼與 PWM
+ * @retval None
+ */
+static void Autotune_Finish(void)
+{
+    Acquisition_Unregister(Autotune_OnBlock);
+    if (at.owns_acquisition) {
+        Acquisition_Stop();
+        at.owns_acquisition = 0;
+    }
+
+    Set_PWM_DutyCycle(0);
+    Stop_PWM();
+}
+
+/**
+ * @brief  由量測值計算臨界增益、PI 增益與卡爾曼參數
+ * @retval None
+ */
+static void Autotune_Compute(void)
+{
+    Autotune_Result_t *r = &at.result;
+    float h = at.config.hysteresis;
+
+    memset(r, 0, sizeof(*r));
+    r->cycles = at.measured;
+    r->tu = at.period_sum / at.measured;
+    r->amplitude = at.amplitude_sum / at.measured;
+
+    if (r->amplitude <= h || r->tu <= 0.0f) {
+        at.state = AUTOTUNE_FAILED;
+        return;
+    }
+
+    // 含遲滯的描述函數
+    r->ku = 4.0f * at.config.duty_step / (AUTOTUNE_PI * sqrtf(r->amplitude * r->amplitude - h * h));
+    r->kp = 0.45f * r->ku;
+    r->ki = r->kp * 1.2f / r->tu;
+
+    // 雜訊：raw counts^2 → A^2 → 濾波器刻度
+    float amps_per_count = at.hacs712->vref / at.hacs712->adc_resolution / at.hacs712->sensitivity;
+    float noise_blocks = (float)AUTOTUNE_NOISE_BLOCKS;
+    r->noise_var = at.noise_var_sum / noise_blocks * amps_per_count * amps_per_count;
+    r->kalman_r = r->noise_var * AUTOTUNE_FILTER_SCALE * AUTOTUNE_FILTER_SCALE;
+
+    // Q << R 時穩態增益 K ≈ sqrt(Q/R)，時間常數約 1/K 次更新；
+    // 讓濾波器時間常數對應迴路臨界頻率 1/(2π·Tu)
+    float tau = r->tu / (2.0f * AUTOTUNE_PI * AUTOTUNE_FILTER_PERIOD_S);
+    if (tau < 1.0f)
+        tau = 1.0f;
+    r->kalman_q = r->kalman_r / (tau * tau);
+
+    at.result_valid = 1;
+}
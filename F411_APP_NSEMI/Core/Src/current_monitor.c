@@ -3,8 +3,23 @@
 #include <string.h>
 #include <stdbool.h>    // ← 加入這行
 #include "handpiece.h"
+#include "param_store.h"
 #include "ssd1306.h"
-#include "ssd1306_fonts.h"
+#include "ssd1306_fonts_ui.h"
+#include "logid.h"
+#include "fixfmt.h"
+#include "ui_widget.h"
+#include "itm_trace.h"
+
+// 執行時門檻，開機為 current_monitor.h 的預設值
+static Monitor_Config_t monitor_config = {
+    .deadband = CURRENT_DEADBAND,
+    .noise = FAN_5V_NOISE_THRESHOLD,
+    .detection = FAN_5V_DETECTION_THRESHOLD,
+    .startup = FAN_5V_STARTUP_THRESHOLD,
+    .running = FAN_5V_RUNNING_THRESHOLD,
+    .overcurrent = OVERCURRENT_THRESHOLD,
+};
 
 // 本地統計初始化函數
 static void InitStats(Current_Stats_t *stats)  // ← 使用 Current_Stats_t
@@ -39,6 +54,8 @@ HAL_StatusTypeDef CurrentMonitor_Init(Current_Monitor_t *monitor, ACS712_Handle_
     monitor->filter_index = 0;
     monitor->last_update = 0;
     monitor->current_now = 0.0f;  // 初始化當前電流
+    monitor->sample_sum = 0.0f;
+    monitor->sample_count = 0;
 
     // 初始化濾波器緩衝區
     memset(monitor->filter_buffer, 0, sizeof(monitor->filter_buffer));
@@ -55,7 +72,7 @@ void CurrentMonitor_ResetStats(Current_Monitor_t *monitor)
     if (monitor == NULL || &monitor->stats == NULL)
         return;
 
-    printf("重置統計數據...\r\n");
+    LOGID("重置統計數據...\r\n");
 
     // 重置統計數據
     monitor->stats.max_current = 0.0f;
@@ -75,7 +92,7 @@ void CurrentMonitor_ResetStats(Current_Monitor_t *monitor)
     // 重置移動平均
     CurrentMonitor_ResetMovingAverage(monitor);
 
-    printf("統計數據已重置\r\n");
+    LOGID("統計數據已重置\r\n");
 }
 
 void CurrentMonitor_ResetMovingAverage(Current_Monitor_t *monitor)
@@ -92,13 +109,14 @@ void CurrentMonitor_ResetMovingAverage(Current_Monitor_t *monitor)
         CurrentMonitor_MovingAverage(monitor, 0.0f);
     }
 
-    printf("移動平均已重置\r\n");
+    LOGID("移動平均已重置\r\n");
 }
 
 /**
- * @brief  更新監控器數據
+ * @brief  取一個樣本，累積 UPDATE_SAMPLES 個後更新監控器數據
  * @param  monitor: 監控器結構指標
  * @retval None
+ * @note   每 UPDATE_INTERVAL_MS / UPDATE_SAMPLES 呼叫一次（排程器的 sample 任務），不會阻塞
  */
 // 修正 CurrentMonitor_Update 函數
 void CurrentMonitor_Update(Current_Monitor_t *monitor)
@@ -106,30 +124,31 @@ void CurrentMonitor_Update(Current_Monitor_t *monitor)
     if (monitor == NULL)
         return;
 
-    uint32_t now = HAL_GetTick();
-    if (now - monitor->last_update < UPDATE_INTERVAL_MS)
-        return;
-
     // **多樣本平均 + 強化死區處理**
-    float current_sum = 0.0f;
-    const int samples = 10;
-
-    for (int i = 0; i < samples; i++) {
-        float raw_current = ACS712_ReadCurrent(monitor->acs712);
+    float raw_current = ACS712_ReadCurrent(monitor->acs712);
 
-        // **每個樣本都先應用死區**
-        if (fabs(raw_current) < CURRENT_DEADBAND) {
-            raw_current = 0.0f;
-        }
+    // 原始樣本送到 SWO（float 原始位元）
+    uint32_t raw_bits;
+    memcpy(&raw_bits, &raw_current, sizeof(raw_bits));
+    ItmTrace_Value(ITM_PORT_VALUE, raw_bits);
 
-        current_sum += raw_current;
-        HAL_Delay(2);
+    // **每個樣本都先應用死區**
+    if (fabs(raw_current) < monitor_config.deadband) {
+        raw_current = 0.0f;
     }
 
-    float current_avg = current_sum / samples;
+    monitor->current_sample = raw_current;
+    monitor->sample_sum += raw_current;
+    if (++monitor->sample_count < UPDATE_SAMPLES)
+        return;
+
+    uint32_t now = HAL_GetTick();
+    float current_avg = monitor->sample_sum / monitor->sample_count;
+    monitor->sample_sum = 0.0f;
+    monitor->sample_count = 0;
 
     // **再次應用死區到平均值**
-    if (fabs(current_avg) < CURRENT_DEADBAND) {
+    if (fabs(current_avg) < monitor_config.deadband) {
         current_avg = 0.0f;
     }
 
@@ -142,7 +161,7 @@ void CurrentMonitor_Update(Current_Monitor_t *monitor)
         if (stable_count > 50) {  // 連續50次零電流才更新偏移
             zero_offset = 0.98f * zero_offset;  // 逐漸減小偏移
             if (stable_count == 51) {
-                printf("Zero offset decay: %.1f mA\r\n", zero_offset * 1000.0f);
+                LOGID("Zero offset decay: %.1f mA\r\n", zero_offset * 1000.0f);
             }
         }
     } else {
@@ -155,13 +174,13 @@ void CurrentMonitor_Update(Current_Monitor_t *monitor)
         current_compensated = current_avg - zero_offset;
 
         // **補償後再次檢查死區**
-        if (fabs(current_compensated) < CURRENT_DEADBAND) {
+        if (fabs(current_compensated) < monitor_config.deadband) {
             current_compensated = 0.0f;
         }
     }
 
     // **最終確認 - 三重死區檢查**
-    if (fabs(current_compensated) < CURRENT_DEADBAND) {
+    if (fabs(current_compensated) < monitor_config.deadband) {
         current_compensated = 0.0f;
     }
 
@@ -180,6 +199,61 @@ void CurrentMonitor_Update(Current_Monitor_t *monitor)
 }
 
 
+/**
+ * @brief  依目前電流與 RMS 判斷負載狀態
+ * @param  monitor: 監控結構指標
+ * @retval 負載狀態
+ */
+Load_State_t CurrentMonitor_GetLoadState(const Current_Monitor_t *monitor)
+{
+    float abs_current = fabs(monitor->current_now);
+    float rms_current = monitor->stats.rms_current;
+
+    // **優化的狀態判斷邏輯**
+    if (abs_current == 0.0f && rms_current < monitor_config.noise)
+        return LOAD_STOPPED;
+    if (rms_current >= monitor_config.running)
+        return LOAD_RUNNING;
+    if (rms_current >= monitor_config.startup)
+        return LOAD_STARTING;
+    if (abs_current >= monitor_config.detection)
+        return LOAD_DETECTED;
+    if (abs_current > 0.0f && abs_current < monitor_config.detection)
+        return LOAD_WEAK;
+
+    return LOAD_NOISE;
+}
+
+/**
+ * @brief  取得目前的門檻設定
+ * @retval 門檻設定
+ */
+const Monitor_Config_t *CurrentMonitor_GetConfig(void)
+{
+    return &monitor_config;
+}
+
+/**
+ * @brief  更新門檻設定，下一次更新起生效
+ * @param  config: 新設定
+ * @retval HAL_ERROR 表示數值不合理，原設定不變
+ */
+HAL_StatusTypeDef CurrentMonitor_SetConfig(const Monitor_Config_t *config)
+{
+    if (config == NULL)
+        return HAL_ERROR;
+
+    if (config->deadband < 0.0f || config->noise <= 0.0f ||
+        config->noise >= config->detection ||
+        config->detection > config->startup ||
+        config->startup > config->running ||
+        config->overcurrent <= config->running)
+        return HAL_ERROR;
+
+    monitor_config = *config;
+    return HAL_OK;
+}
+
 /**
  * @brief  顯示監控數據
  * @param  monitor: 監控器結構指標
@@ -197,119 +271,180 @@ void CurrentMonitor_Display(Current_Monitor_t *monitor)
     const char* status_info;
     const char* signal_status;
 
-    // **優化的狀態判斷邏輯**
-    if (abs_current == 0.0f && rms_current < FAN_5V_NOISE_THRESHOLD) {
+    switch (CurrentMonitor_GetLoadState(monitor)) {
+    case LOAD_STOPPED:
         status = "STOPPED";
         status_info = "No Load - Clean Signal";
         signal_status = "CLEAN - No noise";
-    }
-    else if (rms_current >= FAN_5V_RUNNING_THRESHOLD) {
+        break;
+    case LOAD_RUNNING:
         status = "RUNNING";
         status_info = "Fan Operating";
         signal_status = "Fan running";
-    }
-    else if (rms_current >= FAN_5V_STARTUP_THRESHOLD) {
+        break;
+    case LOAD_STARTING:
         status = "STARTING";
         status_info = "Fan Starting Up";
         signal_status = "Startup current";
-    }
-    else if (abs_current >= FAN_5V_DETECTION_THRESHOLD) {
+        break;
+    case LOAD_DETECTED:
         status = "DETECTED";
         status_info = "Load Detected";
         signal_status = "Current detected";
-    }
-    else if (abs_current == 0.0f && rms_current >= FAN_5V_NOISE_THRESHOLD) {
-        status = "NOISE";
-        status_info = "RMS Noise Present";
-        signal_status = "DEADBAND working, RMS noise";
-    }
-    else if (abs_current > 0.0f && abs_current < FAN_5V_DETECTION_THRESHOLD) {
+        break;
+    case LOAD_WEAK:
         status = "WEAK";
         status_info = "Weak Signal";
         signal_status = "Below detection threshold";
-    }
-    else {
+        break;
+    default:
         status = "NOISE";
-        status_info = "Sensor Noise/Offset";
-        signal_status = "Low level noise";
+        if (abs_current == 0.0f) {
+            status_info = "RMS Noise Present";
+            signal_status = "DEADBAND working, RMS noise";
+        } else {
+            status_info = "Sensor Noise/Offset";
+            signal_status = "Low level noise";
+        }
+        break;
     }
 
-    printf("\r\n=== 5V DC Fan Current Monitor ===\r\n");
-    printf("Fan Status:   %s\r\n", status);
-    printf("Current Now:  %.1f mA\r\n", monitor->current_now * 1000.0f);
-    printf("Current Abs:  %.1f mA\r\n", abs_current * 1000.0f);
-    printf("RMS Current:  %.1f mA\r\n", rms_current * 1000.0f);
-    printf("Max Current:  +%.1f mA\r\n", monitor->stats.max_current * 1000.0f);
-    printf("Min Current:  %.1f mA\r\n", monitor->stats.min_current * 1000.0f);
-    printf("Voltage:      %.1f V\r\n", monitor->voltage);
-    printf("Power:        %.0f mW\r\n", monitor->power * 1000.0f);
-    printf("Sample Count: %lu\r\n", monitor->stats.sample_count);
-    printf("Status Info:  %s\r\n", status_info);
-    printf("Signal Status: %s: %.1f mA\r\n", signal_status,
-           (abs_current > 0.0f) ? abs_current * 1000.0f : rms_current * 1000.0f);
-    printf("Deadband:     %.0f mA\r\n", CURRENT_DEADBAND * 1000.0f);
+    LOGID("\r\n=== 5V DC Fan Current Monitor ===\r\n");
+    LOGID("Fan Status:   %s\r\n", status);
+    LOGID("Current Now:  %.1f mA\r\n", monitor->current_now * 1000.0f);
+    LOGID("Current Abs:  %.1f mA\r\n", abs_current * 1000.0f);
+    LOGID("RMS Current:  %.1f mA\r\n", rms_current * 1000.0f);
+    LOGID("Max Current:  +%.1f mA\r\n", monitor->stats.max_current * 1000.0f);
+    LOGID("Min Current:  %.1f mA\r\n", monitor->stats.min_current * 1000.0f);
+    LOGID("Voltage:      %.1f V\r\n", monitor->voltage);
+    LOGID("Power:        %.0f mW\r\n", monitor->power * 1000.0f);
+    LOGID("Sample Count: %lu\r\n", monitor->stats.sample_count);
+    LOGID("Status Info:  %s\r\n", status_info);
+    LOGID("Signal Status: %s: %.1f mA\r\n", signal_status,
+          (abs_current > 0.0f) ? abs_current * 1000.0f : rms_current * 1000.0f);
+    LOGID("Deadband:     %.0f mA\r\n", monitor_config.deadband * 1000.0f);
 
     // **添加閾值參考信息**
-    printf("Thresholds:   Detection=%.0f, Startup=%.0f, Running=%.0f, Noise=%.0f mA\r\n",
-           FAN_5V_DETECTION_THRESHOLD * 1000.0f,
-           FAN_5V_STARTUP_THRESHOLD * 1000.0f,
-           FAN_5V_RUNNING_THRESHOLD * 1000.0f,
-           FAN_5V_NOISE_THRESHOLD * 1000.0f);
-    printf("================================\r\n\r\n");
+    LOGID("Thresholds:   Detection=%.0f, Startup=%.0f, Running=%.0f, Noise=%.0f mA\r\n",
+          monitor_config.detection * 1000.0f,
+          monitor_config.startup * 1000.0f,
+          monitor_config.running * 1000.0f,
+          monitor_config.noise * 1000.0f);
+    LOGID("================================\r\n\r\n");
 }
 
 
-// 新增手動零點校準函數
-void CurrentMonitor_ManualCalibration(Current_Monitor_t *monitor)
+// 手動零點校準參數
+#define CAL_SETTLE_MS           2000    // 等待移除負載
+#define CAL_SAMPLE_MS           50      // 取樣間隔
+#define CAL_OFFSET_SAMPLES      100
+#define CAL_NOISE_SAMPLES       20
+
+// 校準狀態
+static struct {
+    Calibration_Phase_t phase;
+    uint32_t phase_start;
+    uint32_t last_sample;
+    int count;
+    float sum;
+    float offset;
+} cal;
+
+/**
+ * @brief  開始手動零點校準（非阻塞，之後週期呼叫 CurrentMonitor_CalibrationTask）
+ * @param  monitor: 監控器結構指標
+ * @retval None
+ */
+void CurrentMonitor_StartCalibration(Current_Monitor_t *monitor)
 {
-    printf("=== 開始手動零點校準 ===\r\n");
-    printf("請確保沒有負載連接...\r\n");
+    (void)monitor;
 
-    HAL_Delay(2000);  // 等待2秒
+    LOGID("=== 開始手動零點校準 ===\r\n");
+    LOGID("請確保沒有負載連接...\r\n");
 
-    float sum = 0.0f;
-    const int cal_samples = 100;
+    memset(&cal, 0, sizeof(cal));
+    cal.phase = CAL_SETTLE;
+    cal.phase_start = HAL_GetTick();
+}
+
+/**
+ * @brief  手動零點校準狀態機，呼叫間隔需小於 CAL_SAMPLE_MS
+ * @param  monitor: 監控器結構指標
+ * @retval 1 = 校準完成, 0 = 進行中
+ */
+uint8_t CurrentMonitor_CalibrationTask(Current_Monitor_t *monitor)
+{
+    uint32_t now = HAL_GetTick();
 
-    printf("採集 %d 個樣本...\r\n", cal_samples);
+    switch (cal.phase) {
+    case CAL_SETTLE:
+        if (now - cal.phase_start < CAL_SETTLE_MS)
+            return 0;
+
+        LOGID("採集 %d 個樣本...\r\n", CAL_OFFSET_SAMPLES);
+        cal.phase = CAL_OFFSET;
+        cal.last_sample = now - CAL_SAMPLE_MS;
+        return 0;
+
+    case CAL_OFFSET:
+    {
+        if (now - cal.last_sample < CAL_SAMPLE_MS)
+            return 0;
+        cal.last_sample = now;
 
-    for (int i = 0; i < cal_samples; i++) {
         float current = ACS712_ReadCurrent(monitor->acs712);
-        sum += current;
+        cal.sum += current;
 
-        if (i % 20 == 0) {
-            printf("進度: %d/%d, 當前讀數: %.1f mA\r\n",
-                   i, cal_samples, current * 1000.0f);
+        if (cal.count % 20 == 0) {
+            LOGID("進度: %d/%d, 當前讀數: %.1f mA\r\n",
+                  cal.count, CAL_OFFSET_SAMPLES, current * 1000.0f);
         }
 
-        HAL_Delay(50);
+        if (++cal.count >= CAL_OFFSET_SAMPLES) {
+            cal.offset = cal.sum / cal.count;
+            LOGID("計算出的零點偏移: %.1f mA\r\n", cal.offset * 1000.0f);
+
+            // 計算標準差
+            cal.phase = CAL_NOISE;
+            cal.count = 0;
+            cal.sum = 0.0f;
+        }
+        return 0;
     }
 
-    float offset = sum / cal_samples;
+    case CAL_NOISE:
+    {
+        if (now - cal.last_sample < CAL_SAMPLE_MS)
+            return 0;
+        cal.last_sample = now;
 
-    printf("計算出的零點偏移: %.1f mA\r\n", offset * 1000.0f);
-    printf("標準差: ");
+        float diff = ACS712_ReadCurrent(monitor->acs712) - cal.offset;
+        cal.sum += diff * diff;
 
-    // 計算標準差
-    float variance_sum = 0.0f;
-    for (int i = 0; i < 20; i++) {
-        float current = ACS712_ReadCurrent(monitor->acs712);
-        float diff = current - offset;
-        variance_sum += diff * diff;
-        HAL_Delay(50);
-    }
+        if (++cal.count < CAL_NOISE_SAMPLES)
+            return 0;
 
-    float std_dev = sqrtf(variance_sum / 20.0f);
-    printf("%.1f mA\r\n", std_dev * 1000.0f);
+        float std_dev = sqrtf(cal.sum / CAL_NOISE_SAMPLES);
+        LOGID("標準差: %.1f mA\r\n", std_dev * 1000.0f);
 
-    if (std_dev > 0.020f) {  // 標準差大於20mA
-        printf("警告: 噪聲過大，建議檢查硬體連接！\r\n");
-    }
+        if (std_dev > 0.020f) {  // 標準差大於20mA
+            LOGID("警告: 噪聲過大，建議檢查硬體連接！\r\n");
+        }
+
+        // 可以將偏移值存儲到 EEPROM 或全域變數
+        // monitor->acs712->zero_offset = offset;
 
-    // 可以將偏移值存儲到 EEPROM 或全域變數
-    // monitor->acs712->zero_offset = offset;
+        LOGID("校準完成！\r\n");
+        LOGID("========================\r\n\r\n");
+        cal.phase = CAL_DONE;
+        return 1;
+    }
 
-    printf("校準完成！\r\n");
-    printf("========================\r\n\r\n");
+    case CAL_IDLE:
+    case CAL_DONE:
+    default:
+        return 1;
+    }
 }
 
 
@@ -328,7 +463,7 @@ void CurrentMonitor_CheckOvercurrent(Current_Monitor_t *monitor)
     float current_rms = (monitor->stats.sample_count > 0) ?
                        sqrtf(monitor->stats.rms_current / monitor->stats.sample_count) : 0.0f;
 
-    if (current_rms > OVERCURRENT_THRESHOLD) {
+    if (current_rms > monitor_config.overcurrent) {
         // 過電流處理...
     }
 }
@@ -410,7 +545,7 @@ void CheckAutoReset(Current_Monitor_t *monitor)
         // 如果最大最小值都在噪聲範圍內，且 RMS 也很小
         if (abs_max < 0.100f && abs_min < 0.100f && monitor->stats.rms_current < 0.080f) {
             if (now - last_reset > 30000) {  // 30秒重置一次
-                printf("檢測到低電流噪聲，自動重置統計...\r\n");
+                LOGID("檢測到低電流噪聲，自動重置統計...\r\n");
                 CurrentMonitor_ResetStats(monitor);
                 last_reset = now;
             }
@@ -433,7 +568,7 @@ void CurrentMonitor_UpdateStats(Current_Monitor_t *monitor, float current)
         monitor->stats.max_current = current;
         monitor->stats.min_current = current;
         monitor->stats.sample_count = 0;
-        printf("Auto-reset stats after 1000 samples\r\n");
+        LOGID("Auto-reset stats after 1000 samples\r\n");
     }
 
     monitor->stats.sample_count++;
@@ -463,91 +598,212 @@ void CurrentMonitor_UpdateStats(Current_Monitor_t *monitor, float current)
     }
 }
 
+extern volatile uint16_t adc_filtered_ma[ADC_CHANNEL_COUNT];     // 移動平均濾波
+extern volatile uint16_t adc_filtered_kalman[ADC_CHANNEL_COUNT]; // 卡爾曼濾波
+
+static Filter_Result_t filter_result;
+
+/* 濾波器顯示：保留模式元件，數值沒變時不重畫 */
+#define FILTER_UI_ROWS      3
+#define FILTER_UI_VALUE_X   48      // 數值欄位（對齊原本 "MovAvg: " 之後）
+#define FILTER_UI_CHARS     7       // "-5000.0"
+
+static const char *const filter_ui_names[FILTER_UI_ROWS] = { "Raw:", "MovAvg:", "Kalman:" };
+
+// 負載狀態圖示：停止、啟動中、運轉、過電流
+static const uint8_t filter_ui_icons[][UI_ICON_SIZE] = {
+    { 0x3C, 0x42, 0x81, 0x81, 0x81, 0x81, 0x42, 0x3C },
+    { 0x3C, 0x72, 0xF1, 0xF1, 0xF1, 0xF1, 0x72, 0x3C },
+    { 0x3C, 0x7E, 0xFF, 0xFF, 0xFF, 0xFF, 0x7E, 0x3C },
+    { 0x18, 0x3C, 0x66, 0x66, 0xE7, 0xFF, 0xE7, 0xFF }
+};
+
+static struct {
+    UiLabel_t name[FILTER_UI_ROWS];
+    UiNumber_t value[FILTER_UI_ROWS];
+    UiLabel_t unit[FILTER_UI_ROWS];
+    UiBar_t bar;                    // 卡爾曼電流 / 過電流門檻
+    UiIcon_t state;
+    uint8_t ready;                  // 元件已初始化
+    uint8_t shown;                  // 畫面上是這個顯示（0 = 先清除畫面再整個重畫）
+} filter_ui;
+
+static void CurrentMonitor_FilterDisplayInit(void);
+static uint8_t CurrentMonitor_FilterIconState(const Current_Monitor_t *monitor);
+
 /**
- * @brief  測試不同濾波器對電流監控的效果
+ * @brief  初始化濾波器測試
  * @param  monitor: 監控器結構指標
  * @retval None
  */
+void CurrentMonitor_FilterInit(Current_Monitor_t *monitor)
+{
+    (void)monitor;
 
-extern volatile uint16_t adc_filtered_ma[ADC_CHANNEL_COUNT];     // 移動平均濾波
-extern volatile uint16_t adc_filtered_kalman[ADC_CHANNEL_COUNT]; // 卡爾曼濾波
+    LOGID("=== 電流濾波器測試 ===\r\n");
+
+    // 初始化濾波器
+    ADC_Filter_Init();
+
+    // 設定卡爾曼濾波器參數：自動調諧存過的值，沒有時為預設值
+    // 預設 通道0：低過程噪聲，中等測量噪聲；通道1：中等過程噪聲，高測量噪聲
+    const Param_Data_t *params = ParamStore_Get();
+    Kalman_Set_Parameters(0, params->kalman_q[0], params->kalman_r[0]);
+    Kalman_Set_Parameters(1, params->kalman_q[1], params->kalman_r[1]);
+    LOGID("Kalman 參數來源: %s\r\n", ParamStore_IsLoaded() ? "Flash" : "預設值");
 
+    memset(&filter_result, 0, sizeof(filter_result));
+    CurrentMonitor_FilterDisplayInvalidate();
+}
 
-void CurrentMonitor_TestFilters(Current_Monitor_t *monitor)
+/**
+ * @brief  取一個樣本並更新所有濾波器
+ * @param  monitor: 監控器結構指標
+ * @retval None
+ */
+void CurrentMonitor_FilterStep(Current_Monitor_t *monitor)
 {
     if (monitor == NULL) return;
 
-    printf("=== 電流濾波器測試 ===\r\n");
+    // 讀取原始電流
+    float raw_current = ACS712_ReadCurrent(monitor->acs712);
 
-    // 初始化濾波器
-    ADC_Filter_Init();
+    // **修正 ADC 轉換範圍**
+    // 假設電流範圍是 0 到 5A，對應 ADC 0-4095
+    uint16_t current_as_adc;
+    if (raw_current < 0) {
+        current_as_adc = 0;  // 負電流設為0
+    } else if (raw_current > 5.0f) {
+        current_as_adc = 4095;  // 超過5A設為最大值
+    } else {
+        current_as_adc = (uint16_t)(raw_current * 4095.0f / 5.0f);
+    }
+    // 處理所有濾波器
+    ADC_Process_All_Filters(0, current_as_adc); // 通道0：卡爾曼參數1
+    ADC_Process_All_Filters(1, current_as_adc); // 通道1：卡爾曼參數2
+
+    // **修正轉換回電流值**
+    filter_result.raw = raw_current;
+    filter_result.moving_avg = ((float)adc_filtered_ma[0] * 5.0f / 4095.0f);
+    filter_result.kalman1 = ((float)adc_filtered_kalman[0] * 5.0f / 4095.0f);
+    filter_result.kalman2 = ((float)adc_filtered_kalman[1] * 5.0f / 4095.0f);
+    filter_result.count++;
+}
 
-    // 設定卡爾曼濾波器參數（針對電流測量優化）
-    Kalman_Set_Parameters(0, 0.1f, 5.0f);  // 通道0：低過程噪聲，中等測量噪聲
-    Kalman_Set_Parameters(1, 0.5f, 10.0f); // 通道1：中等過程噪聲，高測量噪聲
-
-    for (int test_count = 0; test_count < 100; test_count++) {
-        // 讀取原始電流
-        float raw_current = ACS712_ReadCurrent(monitor->acs712);
-
-        // **修正 ADC 轉換範圍**
-        // 假設電流範圍是 0 到 5A，對應 ADC 0-4095
-        uint16_t current_as_adc;
-        if (raw_current < 0) {
-            current_as_adc = 0;  // 負電流設為0
-        } else if (raw_current > 5.0f) {
-            current_as_adc = 4095;  // 超過5A設為最大值
-        } else {
-            current_as_adc = (uint16_t)(raw_current * 4095.0f / 5.0f);
-        }
-        // 處理所有濾波器
-        ADC_Process_All_Filters(0, current_as_adc); // 通道0：卡爾曼參數1
-        ADC_Process_All_Filters(1, current_as_adc); // 通道1：卡爾曼參數2
-
-        // **修正轉換回電流值**
-        float filtered_ma = ((float)adc_filtered_ma[0] * 5.0f / 4095.0f);
-        float filtered_kalman1 = ((float)adc_filtered_kalman[0] * 5.0f / 4095.0f);
-        float filtered_kalman2 = ((float)adc_filtered_kalman[1] * 5.0f / 4095.0f);
-
-        // **修正噪聲減少計算**
-        float noise_reduction = 0.0f;
-        if (raw_current > 0.001f) {  // 避免除零
-            noise_reduction = (1.0f - fabs(filtered_kalman1 - raw_current) / raw_current) * 100.0f;
+/**
+ * @brief  從串列埠輸出最新的濾波結果
+ * @param  monitor: 監控器結構指標
+ * @retval None
+ */
+void CurrentMonitor_FilterReport(Current_Monitor_t *monitor)
+{
+    (void)monitor;
+    const Param_Data_t *params = ParamStore_Get();
+    const Filter_Result_t *r = &filter_result;
+
+    LOGID("Test %lu:\r\n", r->count);
+    LOGID("  Raw:      %.1f mA\r\n", r->raw * 1000.0f);
+    LOGID("  MovAvg:   %.1f mA\r\n", r->moving_avg * 1000.0f);
+    LOGID("  Kalman1:  %.1f mA (Q=%.3f, R=%.3f)\r\n", r->kalman1 * 1000.0f,
+          params->kalman_q[0], params->kalman_r[0]);
+    LOGID("  Kalman2:  %.1f mA (Q=%.3f, R=%.3f)\r\n", r->kalman2 * 1000.0f,
+          params->kalman_q[1], params->kalman_r[1]);
+    LOGID("  Noise Reduction: %.1f%%\r\n",
+          (1.0f - fabs(r->kalman1)/fabs(r->raw)) * 100.0f);
+    LOGID("\r\n");
+}
+
+/**
+ * @brief  在 OLED 顯示最新的濾波結果、卡爾曼電流長條圖與負載狀態
+ *         只重畫改變的數值，都沒變時不呼叫 ssd1306_UpdateScreen
+ * @param  monitor: 監控器結構指標
+ * @retval None
+ */
+void CurrentMonitor_FilterDisplay(Current_Monitor_t *monitor)
+{
+    const Filter_Result_t *r = &filter_result;
+    const float values[FILTER_UI_ROWS] = { r->raw, r->moving_avg, r->kalman1 };
+    uint8_t changed = 0;
+
+    if (!filter_ui.ready)
+        CurrentMonitor_FilterDisplayInit();
+
+    if (!filter_ui.shown) {
+        ssd1306_Fill(Black);
+        for (uint8_t i = 0; i < FILTER_UI_ROWS; i++) {
+            UiWidget_Invalidate(&filter_ui.name[i].base);
+            UiWidget_Invalidate(&filter_ui.value[i].base);
+            UiWidget_Invalidate(&filter_ui.unit[i].base);
         }
+        UiWidget_Invalidate(&filter_ui.bar.base);
+        UiWidget_Invalidate(&filter_ui.state.base);
+        filter_ui.shown = 1;
+        changed = 1;
+    }
 
-        // 每10次顯示一次結果
-        if ((test_count % 10 == 0) && (test_count != 0)) {
-            printf("Test %d:\r\n", test_count);
-            printf("  Raw:      %.1f mA\r\n", raw_current * 1000.0f);
-            printf("  MovAvg:   %.1f mA\r\n", filtered_ma * 1000.0f);
-            printf("  Kalman1:  %.1f mA (Q=0.1, R=5.0)\r\n", filtered_kalman1 * 1000.0f);
-            printf("  Kalman2:  %.1f mA (Q=0.5, R=10.0)\r\n", filtered_kalman2 * 1000.0f);
-            printf("  Noise Reduction: %.1f%%\r\n",
-                   (1.0f - fabs(filtered_kalman1)/fabs(raw_current)) * 100.0f);
-            printf("\r\n");
-
-            char buf[32];
-            ssd1306_Fill(Black);
-            ssd1306_SetCursor(0, 0); // 設定顯示位置
-          	sprintf(buf, "  Raw:      %.1f mA\r\n", raw_current * 1000.0f);
-            ssd1306_WriteString(buf, Font_6x8, White);
-          	sprintf(buf, "  MovAvg:   %.1f mA\r\n", filtered_ma * 1000.0f);
-            ssd1306_SetCursor(0, 8); // 設定顯示位置
-          	sprintf(buf, "  Raw:      %.1f mA\r\n", raw_current * 1000.0f);
-            ssd1306_WriteString(buf, Font_6x8, White);
-          	sprintf(buf, "  Kalman1:  %.1f mA (Q=0.1, R=5.0)\r\n", filtered_kalman1 * 1000.0f);
-            ssd1306_SetCursor(0, 16); // 設定顯示位置
-          	sprintf(buf, "  Raw:      %.1f mA\r\n", raw_current * 1000.0f);
-            ssd1306_WriteString(buf, Font_6x8, White);
-            ssd1306_UpdateScreen();
+    for (uint8_t i = 0; i < FILTER_UI_ROWS; i++) {
+        changed |= UiLabel_Set(&filter_ui.name[i], filter_ui_names[i]);
+        changed |= UiNumber_SetFloat(&filter_ui.value[i], values[i] * 1000.0f);
+        changed |= UiLabel_Set(&filter_ui.unit[i], "mA");
+    }
 
+    // 刻度跟著過電流門檻（shell 可調整），下一次 Set 依新刻度畫
+    UiBar_SetRange(&filter_ui.bar, 0, (int32_t)(monitor_config.overcurrent * 1000.0f));
+    changed |= UiBar_Set(&filter_ui.bar, (int32_t)(fabsf(r->kalman1) * 1000.0f));
+    if (monitor != NULL)
+        changed |= UiIcon_Set(&filter_ui.state, CurrentMonitor_FilterIconState(monitor));
 
-        }
+    // 顯示內容都沒變時不送出
+    if (changed)
+        ssd1306_UpdateScreen();
+}
 
-        HAL_Delay(100);
+/**
+ * @brief  濾波器顯示被其他畫面覆蓋，下一次 CurrentMonitor_FilterDisplay 清除畫面後整個重畫
+ * @retval None
+ */
+void CurrentMonitor_FilterDisplayInvalidate(void)
+{
+    filter_ui.shown = 0;
+}
+
+// 建立元件：三列 "名稱  數值 mA"，最下面一列是長條圖和負載狀態圖示
+static void CurrentMonitor_FilterDisplayInit(void)
+{
+    for (uint8_t i = 0; i < FILTER_UI_ROWS; i++) {
+        uint8_t y = i * 8;
+        UiLabel_Init(&filter_ui.name[i], 0, y, FILTER_UI_VALUE_X, &Font_UI_6x8);
+        UiNumber_Init(&filter_ui.value[i], FILTER_UI_VALUE_X, y, FILTER_UI_CHARS, 1, &Font_UI_6x8);
+        UiLabel_Init(&filter_ui.unit[i], FILTER_UI_VALUE_X + FILTER_UI_CHARS * 6 + 6, y, 12, &Font_UI_6x8);
     }
 
-    printf("濾波器測試完成！\r\n");
+    UiBar_Init(&filter_ui.bar, 0, 25, SSD1306_WIDTH - UI_ICON_SIZE - 4, 7,
+               0, (int32_t)(monitor_config.overcurrent * 1000.0f));
+    UiIcon_Init(&filter_ui.state, SSD1306_WIDTH - UI_ICON_SIZE, 24, filter_ui_icons,
+                sizeof(filter_ui_icons) / sizeof(filter_ui_icons[0]));
+    filter_ui.ready = 1;
+    filter_ui.shown = 0;
 }
 
+// 負載狀態對應的圖示
+static uint8_t CurrentMonitor_FilterIconState(const Current_Monitor_t *monitor)
+{
+    if (monitor->status == MONITOR_OVERCURRENT)
+        return 3;
+
+    switch (CurrentMonitor_GetLoadState(monitor)) {
+    case LOAD_RUNNING:
+        return 2;
+    case LOAD_WEAK:
+    case LOAD_DETECTED:
+    case LOAD_STARTING:
+        return 1;
+    default:
+        return 0;
+    }
+}
 
+const Filter_Result_t *CurrentMonitor_GetFilterResult(void)
+{
+    return &filter_result;
+}
@@ -0,0 +1,122 @@
+/*
+ * fixfmt.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  定點數字格式化
+ *
+ *  newlib 的 %f 要連結 _printf_float（十幾 KB Flash），每個數值要數千個 cycle，
+ *  還會用到 heap。這裡把數值先換成「整數 x 10^小數位數」，再逐位轉成字元：
+ *  最多 10 次除以 10，不配置記憶體，輸出直接寫進呼叫端的 FixFmt_Buf_t。
+ *
+ *  用法：FixFmt_Buf_t num;
+ *        printf("Current: %s mA\r\n", FixFmt_Float(num, current * 1000.0f, 1));
+ *  同一個 printf 有多個數值時每個數值各用一個緩衝區。
+ */
+#include "fixfmt.h"
+
+static const uint32_t fixfmt_pow10[FIXFMT_MAX_DECIMALS + 1] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000
+};
+
+/**
+ * @brief  浮點數轉成定點整數（四捨五入，超出範圍時飽和）
+ * @param  value: 數值
+ * @param  decimals: 小數位數（0 ~ FIXFMT_MAX_DECIMALS）
+ * @retval value x 10^decimals
+ */
+int32_t FixFmt_Scale(float value, uint8_t decimals)
+{
+    if (decimals > FIXFMT_MAX_DECIMALS)
+        decimals = FIXFMT_MAX_DECIMALS;
+
+    float scaled = value * (float)fixfmt_pow10[decimals];
+
+    if (scaled != scaled)                   // NaN
+        return 0;
+    if (scaled >= 2147483647.0f)
+        return INT32_MAX;
+    if (scaled <= -2147483648.0f)
+        return INT32_MIN;
+
+    return (int32_t)(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+}
+
+/**
+ * @brief  定點整數轉字串
+ * @param  buf: 輸出，至少 FIXFMT_BUF_SIZE bytes
+ * @param  value: 定點數值（value / 10^decimals）
+ * @param  decimals: 小數位數
+ * @retval 字串長度（不含結尾 0）
+ */
+uint8_t FixFmt_Fixed(char *buf, int32_t value, uint8_t decimals)
+{
+    char digits[10];
+    uint8_t count = 0;
+    uint8_t length = 0;
+    uint32_t magnitude = (value < 0) ? 0U - (uint32_t)value : (uint32_t)value;
+
+    if (decimals > FIXFMT_MAX_DECIMALS)
+        decimals = FIXFMT_MAX_DECIMALS;
+
+    // 由低位往高位產生，至少要有整數位的 0
+    do {
+        digits[count++] = (char)('0' + magnitude % 10U);
+        magnitude /= 10U;
+    } while (magnitude != 0);
+
+    while (count < decimals + 1) {
+        digits[count++] = '0';
+    }
+
+    if (value < 0)
+        buf[length++] = '-';
+
+    while (count > 0) {
+        if (count == decimals)
+            buf[length++] = '.';
+        buf[length++] = digits[--count];
+    }
+
+    buf[length] = '\0';
+    return length;
+}
+
+/**
+ * @brief  浮點數格式化，等同 %.Nf
+ * @param  buf: 輸出，至少 FIXFMT_BUF_SIZE bytes
+ * @param  value: 數值
+ * @param  decimals: 小數位數
+ * @retval buf
+ */
+const char *FixFmt_Float(char *buf, float value, uint8_t decimals)
+{
+    FixFmt_Fixed(buf, FixFmt_Scale(value, decimals), decimals);
+    return buf;
+}
+
+/**
+ * @brief  千分之一單位（mA、mV、mW）轉成基本單位字串，例如 2503 mV → "2.503"
+ * @param  buf: 輸出，至少 FIXFMT_BUF_SIZE bytes
+ * @param  milli: 數值（千分之一單位）
+ * @param  decimals: 小數位數（0 ~ 3），多餘的位數四捨五入
+ * @retval buf
+ */
+const char *FixFmt_Milli(char *buf, int32_t milli, uint8_t decimals)
+{
+    if (decimals > 3)
+        decimals = 3;
+
+    int32_t divisor = (int32_t)fixfmt_pow10[3 - decimals];
+    int32_t half = divisor / 2;
+    int32_t value;
+
+    if (milli >= 0)
+        value = (milli > INT32_MAX - half) ? milli / divisor : (milli + half) / divisor;
+    else
+        value = (milli < INT32_MIN + half) ? milli / divisor : (milli - half) / divisor;
+
+    FixFmt_Fixed(buf, value, decimals);
+    return buf;
+}
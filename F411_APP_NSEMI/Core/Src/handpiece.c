@@ -8,6 +8,8 @@
 #include "tim.h"         // ✅ 或者這個，看你的專案結構
 #include "adc.h"
 #include "handpiece.h"
+#include "acquisition.h"
+#include "fixfmt.h"
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
@@ -81,7 +83,7 @@ extern ADC_HandleTypeDef hadc1;
 
 volatile uint16_t adc_value = 0;
 volatile float voltage = 0.0f;
-extern volatile uint8_t adc_updated;
+volatile uint8_t adc_updated = 0;
 
 void Start_ADC_Sampling(void)
 {
@@ -112,7 +114,8 @@ void TestADC(void)
     {
         if(adc_updated)
         {
-            printf("ADC Value: %d, Voltage: %.3f V\r\n", adc_value, voltage);
+            FixFmt_Buf_t num;
+            printf("ADC Value: %d, Voltage: %s V\r\n", adc_value, FixFmt_Float(num, voltage, 3));
             adc_updated = 0;
             HAL_ADC_Start_DMA(&hadc1, (uint32_t*)&adc_value, 1);
         }
@@ -137,8 +140,12 @@ void TestADC_Averaging(void)
         adc_complete = 0;
         HAL_ADC_Start_DMA(&hadc1, (uint32_t*)adc_buffer, ADC_SAMPLES);
 
-        // 等待採樣完成
-        while(!adc_complete);
+        // 等待採樣完成：睡眠到 DMA 完成中斷
+        while(!adc_complete)
+        {
+            __WFI();
+        }
+        HAL_ADC_Stop_DMA(&hadc1);
 
         // 計算平均值
         uint32_t sum = 0;
@@ -147,14 +154,22 @@ void TestADC_Averaging(void)
             sum += adc_buffer[i];
         }
         uint16_t average = sum / ADC_SAMPLES;
-        float avg_voltage = (float)average * 3.3f / 4095.0f;
+        int32_t avg_mv = (int32_t)average * 3300 / 4095;
 
-        printf("ADC Average: %d, Voltage: %.3f V\r\n", average, avg_voltage);
+        FixFmt_Buf_t num;
+        printf("ADC Average: %d, Voltage: %s V\r\n", average, FixFmt_Milli(num, avg_mv, 3));
 
         HAL_Delay(100);
     }
 }
 
+// ADC DMA 完成（串流取樣未啟動時由 acquisition.c 轉呼叫）
+void Acquisition_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    adc_updated = 1;
+    adc_complete = 1;
+}
+
 // 在 handpiece.c 中加入
 float ADC_To_Voltage(uint16_t adc_val)
 {
@@ -295,3 +310,131 @@ void Kalman_Set_Parameters(uint8_t channel, float process_noise, float measureme
     kalman_filters[channel].R = measurement_noise;
 }
 
+// 讀取目前的卡爾曼濾波器參數
+void Kalman_Get_Parameters(uint8_t channel, float *process_noise, float *measurement_noise)
+{
+    if(channel >= ADC_CHANNEL_COUNT) return;
+
+    *process_noise = kalman_filters[channel].Q;
+    *measurement_noise = kalman_filters[channel].R;
+}
+
+//=========================================PI============================================//
+// PI 控制器初始化（增益由自動調諧產生，見 autotune.c）
+void PI_Init(PI_Controller_t* pi, float kp, float ki, float out_min, float out_max)
+{
+    pi->kp = kp;
+    pi->ki = ki;
+    pi->integral = 0.0f;
+    pi->out_min = out_min;
+    pi->out_max = out_max;
+}
+
+void PI_Reset(PI_Controller_t* pi)
+{
+    pi->integral = 0.0f;
+}
+
+// PI 控制器更新：輸出飽和時停止積分（防止積分飽和）
+float PI_Update(PI_Controller_t* pi, float setpoint, float measurement, float dt)
+{
+    float error = setpoint - measurement;
+    float integral = pi->integral + pi->ki * error * dt;
+    float output = pi->kp * error + integral;
+
+    if(output > pi->out_max)
+    {
+        output = pi->out_max;
+        if(error < 0) pi->integral = integral;
+    }
+    else if(output < pi->out_min)
+    {
+        output = pi->out_min;
+        if(error > 0) pi->integral = integral;
+    }
+    else
+    {
+        pi->integral = integral;
+    }
+
+    return output;
+}
+
+//=========================================電流迴路============================================//
+// 手機電流迴路：PI 輸出直接設定 TIM1 CH1 佔空比（0 ~ HANDPIECE_DUTY_MAX）
+static PI_Controller_t drive_pi;
+static float drive_setpoint = 0.0f;
+static uint16_t drive_duty = 0;
+static uint8_t drive_running = 0;
+
+/**
+ * @brief  啟動電流迴路
+ * @param  setpoint: 目標電流 (A)
+ * @param  kp, ki: PI 增益（自動調諧結果，見 param_store）
+ * @retval HAL狀態
+ */
+HAL_StatusTypeDef Handpiece_DriveStart(float setpoint, float kp, float ki)
+{
+    if (setpoint < 0.0f || kp < 0.0f || ki < 0.0f || (kp == 0.0f && ki == 0.0f))
+        return HAL_ERROR;
+
+    PI_Init(&drive_pi, kp, ki, 0.0f, (float)HANDPIECE_DUTY_MAX);
+    drive_setpoint = setpoint;
+    drive_duty = 0;
+
+    if (!drive_running) {
+        Set_PWM_DutyCycle(0);
+        Start_PWM();
+        drive_running = 1;
+    }
+    return HAL_OK;
+}
+
+// 改變目標電流，積分項保留（不重新起步）
+void Handpiece_DriveSetpoint(float setpoint)
+{
+    if (setpoint >= 0.0f)
+        drive_setpoint = setpoint;
+}
+
+void Handpiece_DriveStop(void)
+{
+    if (!drive_running)
+        return;
+
+    drive_running = 0;
+    drive_duty = 0;
+    Set_PWM_DutyCycle(0);
+    Stop_PWM();
+}
+
+/**
+ * @brief  更新電流迴路（固定週期呼叫）
+ * @param  measurement: 量測電流 (A)
+ * @param  dt: 與上一次呼叫的間隔 (s)
+ * @retval 新的佔空比
+ */
+uint16_t Handpiece_DriveUpdate(float measurement, float dt)
+{
+    if (!drive_running)
+        return 0;
+
+    drive_duty = (uint16_t)(PI_Update(&drive_pi, drive_setpoint, measurement, dt) + 0.5f);
+    Set_PWM_DutyCycle(drive_duty);
+    return drive_duty;
+}
+
+uint8_t Handpiece_DriveIsRunning(void)
+{
+    return drive_running;
+}
+
+float Handpiece_DriveGetSetpoint(void)
+{
+    return drive_setpoint;
+}
+
+uint16_t Handpiece_DriveGetDuty(void)
+{
+    return drive_duty;
+}
@@ -0,0 +1,31 @@
+/*
+ * hw_crc.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  硬體 CRC 單元：多項式 0x04C11DB7、初值 0xFFFFFFFF、不反射、不做最終 XOR。
+ *  每個 32 位元字從最高位元開始計算，位元組順序即 CPU 讀到的 little-endian 字。
+ *
+ *  參數區與遙測共用這個單元，只能在主程式（非中斷）呼叫。
+ */
+#include "main.h"
+#include "hw_crc.h"
+
+/**
+ * @brief  以硬體 CRC 單元計算 CRC（不經過 HAL CRC 模組）
+ * @param  words: 資料
+ * @param  count: 32 位元字數
+ * @retval CRC值
+ */
+uint32_t HwCrc_Compute(const uint32_t *words, uint32_t count)
+{
+    __HAL_RCC_CRC_CLK_ENABLE();
+    CRC->CR = CRC_CR_RESET;
+
+    for (uint32_t i = 0; i < count; i++) {
+        CRC->DR = words[i];
+    }
+
+    return CRC->DR;
+}
@@ -0,0 +1,172 @@
+/*
+ * itm_trace.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  ITM / SWO 追蹤輸出
+ *
+ *  所有診斷輸出原本都走 USART6，中斷裡不能印，高頻率的事件也會塞滿 115200 baud。
+ *  ITM 寫入 stimulus port 只是一次暫存器寫入，由 TPIU 以 SWO（NRZ）在背景送出，
+ *  每個事件只花幾個 cycle，中斷裡也可以使用：
+ *    port 0 (ITM_PORT_TEXT)    : printf 文字，_write 在這個 port 啟用時改走 ITM
+ *    port 1 (ITM_PORT_PROFILE) : 排程器任務開始/結束、idle 進出
+ *    port 2 (ITM_PORT_VALUE)   : 每個原始電流樣本
+ *  另外以 DWT 比較器追蹤變數寫入（例如 monitor.current_now），CPU 完全不參與，
+ *  由硬體產生 data trace 封包。
+ *
+ *  ITM 本身有時間戳記（TSENA），CubeIDE 的 SWV Trace Log / Data Trace 可直接顯示；
+ *  設定為 Core Clock 72 MHz、SWO Clock 2000 kHz。SWO 是 8N1 UART 格式，
+ *  也可以用 2 Mbaud 的 USB-UART 接 PB3 擷取。
+ *
+ *  port 0 開機預設關閉（文字仍走 UART），port 1、2 開啟；沒有人接收時 FIFO
+ *  照常清空，不影響執行。
+ */
+#include "main.h"
+#include "itm_trace.h"
+
+// 等待 FIFO 的上限（文字輸出），超過時丟棄剩下的位元組
+#define ITM_TRACE_SPIN          200
+
+// DWT FUNCTION：寫入時送出資料值（EMITRANGE = 0）
+#define ITM_DWT_FUNC_DATA_WRITE 0xDUL
+// DWT MASK：比對位址忽略低 2 位元（32 位元變數）
+#define ITM_DWT_MASK_WORD       2UL
+
+/* 私有變數 */
+static volatile uint32_t itm_drops = 0;
+static uint32_t itm_watch[ITM_TRACE_WATCH_SLOTS];
+
+/**
+ * @brief  設定 TPIU (SWO NRZ)、ITM 與 DWT 追蹤
+ * @param  swo_hz: SWO 位元率，必須整除 HCLK
+ * @retval HAL狀態
+ */
+HAL_StatusTypeDef ItmTrace_Init(uint32_t swo_hz)
+{
+    uint32_t hclk = HAL_RCC_GetHCLKFreq();
+
+    if (swo_hz == 0 || hclk % swo_hz != 0)
+        return HAL_ERROR;
+
+    // 追蹤時脈與 TRACESWO 腳位（非同步模式，PB3 AF0 為重置預設值）
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DBGMCU->CR = (DBGMCU->CR & ~DBGMCU_CR_TRACE_MODE) | DBGMCU_CR_TRACE_IOEN;
+
+    // TPIU：1 位元 port、NRZ、不經過 formatter
+    TPI->CSPSR = 1;
+    TPI->ACPR = hclk / swo_hz - 1;
+    TPI->SPPR = 2;
+    TPI->FFCR = 0x100;
+
+    // ITM：解鎖後設定 trace bus ID、時間戳記、同步封包與 DWT 轉送
+    ITM->LAR = 0xC5ACCE55;
+    ITM->TCR = 0;
+    ITM->TPR = 0;
+    ITM->TER = (1UL << ITM_PORT_PROFILE) | (1UL << ITM_PORT_VALUE);
+    ITM->TCR = (1UL << ITM_TCR_TraceBusID_Pos) | ITM_TCR_DWTENA_Msk |
+               ITM_TCR_SYNCENA_Msk | ITM_TCR_TSENA_Msk | ITM_TCR_ITMENA_Msk;
+
+    // 同步封包以 CYCCNT 為時基（CYCCNT 由 Scheduler_Init 開啟）
+    DWT->CTRL = (DWT->CTRL & ~DWT_CTRL_SYNCTAP_Msk) | (1UL << DWT_CTRL_SYNCTAP_Pos);
+
+    for (uint8_t i = 0; i < ITM_TRACE_WATCH_SLOTS; i++) {
+        ItmTrace_Unwatch(i);
+    }
+
+    itm_drops = 0;
+    return HAL_OK;
+}
+
+/**
+ * @brief  啟用/停用 stimulus port
+ * @param  port: 0..31
+ * @param  enable: 1 = 啟用
+ * @retval None
+ */
+void ItmTrace_EnablePort(uint8_t port, uint8_t enable)
+{
+    if (port >= 32)
+        return;
+
+    if (enable)
+        ITM->TER |= (1UL << port);
+    else
+        ITM->TER &= ~(1UL << port);
+}
+
+/**
+ * @brief  逐位元組送出文字，FIFO 長時間不空時丟棄剩下的部分並計數
+ * @param  port: stimulus port
+ * @param  data: 資料
+ * @param  len: 長度
+ * @retval None
+ */
+void ItmTrace_Write(uint8_t port, const uint8_t *data, uint32_t len)
+{
+    if (data == NULL || !ItmTrace_IsPortEnabled(port))
+        return;
+
+    for (uint32_t i = 0; i < len; i++) {
+        uint32_t spin = ITM_TRACE_SPIN;
+        while (ITM->PORT[port].u32 == 0) {
+            if (--spin == 0) {
+                itm_drops++;
+                return;
+            }
+        }
+        ITM->PORT[port].u8 = data[i];
+    }
+}
+
+/**
+ * @brief  以 DWT 比較器追蹤 32 位元變數的寫入
+ * @param  slot: 0..ITM_TRACE_WATCH_SLOTS-1（對應比較器 1..3）
+ * @param  address: 變數位址，必須 4 bytes 對齊
+ * @retval HAL狀態
+ */
+HAL_StatusTypeDef ItmTrace_Watch(uint8_t slot, const volatile void *address)
+{
+    uint32_t addr = (uint32_t)address;
+    uint32_t comparators = (DWT->CTRL & DWT_CTRL_NUMCOMP_Msk) >> DWT_CTRL_NUMCOMP_Pos;
+
+    if (slot >= ITM_TRACE_WATCH_SLOTS || slot + 1U >= comparators || (addr & 3U))
+        return HAL_ERROR;
+
+    // 每個比較器佔 4 個字：COMP、MASK、FUNCTION、保留
+    volatile uint32_t *comp = &DWT->COMP0 + (slot + 1U) * 4U;
+    comp[2] = 0;
+    comp[0] = addr;
+    comp[1] = ITM_DWT_MASK_WORD;
+    comp[2] = ITM_DWT_FUNC_DATA_WRITE;
+
+    itm_watch[slot] = addr;
+    return HAL_OK;
+}
+
+/**
+ * @brief  停止追蹤
+ * @param  slot: 追蹤槽
+ * @retval None
+ */
+void ItmTrace_Unwatch(uint8_t slot)
+{
+    if (slot >= ITM_TRACE_WATCH_SLOTS)
+        return;
+
+    volatile uint32_t *comp = &DWT->COMP0 + (slot + 1U) * 4U;
+    comp[2] = 0;
+    itm_watch[slot] = 0;
+}
+
+// 追蹤中的位址，0 = 未使用
+uint32_t ItmTrace_GetWatch(uint8_t slot)
+{
+    return (slot < ITM_TRACE_WATCH_SLOTS) ? itm_watch[slot] : 0;
+}
+
+// 文字輸出丟棄次數
+uint32_t ItmTrace_GetDrops(void)
+{
+    return itm_drops;
+}
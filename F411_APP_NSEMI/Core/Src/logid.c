@@ -0,0 +1,340 @@
+/*
+ * logid.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  LOGID 紀錄打包
+ *
+ *  LOGID 巨集把格式字串放進 .logstr，linker script 把這個 section 設為 INFO
+ *  （不佔 Flash、位址從 0 開始），所以字串的位址就是它在 section 中的位移，
+ *  直接當成 16 位元 ID。執行時只把 ID 與參數原始位元組包成 TLM_REC_LOG 紀錄，
+ *  經遙測訊框送出，不做任何格式化。
+ *
+ *  紀錄放在呼叫端的堆疊上；送出時共用遙測緩衝區與硬體 CRC，中斷內的 log 直接丟棄。
+ *
+ *  遙測關閉時（mode text）同一筆紀錄改在這裡格式化成文字，規則和 tlm_decode 的
+ *  FormatLog 相同；浮點數用 FixFmt，不需要 _printf_float。
+ */
+#include "main.h"
+#include "logid.h"
+#include "telemetry.h"
+#include "fixfmt.h"
+#include <string.h>
+
+// 數值參數都放得下，字串保留空間的前提
+TLM_STATIC_ASSERT(TLM_LOG_ARG_BYTES >= 4 * TLM_LOG_MAX_ARGS, "LOGID argument space");
+
+/* 私有函數 */
+static uint8_t *LogId_Reserve(Tlm_Log_t *record, uint8_t type, uint32_t size);
+static void LogId_Print(const Tlm_Log_t *record, const char *format);
+static uint32_t LogId_Append(char *line, uint32_t length, const char *text, int32_t width, uint8_t left);
+
+/**
+ * @brief  開始一筆紀錄
+ * @param  record: 紀錄（呼叫端堆疊上）
+ * @param  format: .logstr 中的格式字串
+ * @retval None
+ */
+void LogId_Begin(Tlm_Log_t *record, const char *format)
+{
+    record->id = (uint16_t)(uintptr_t)format;
+    record->arg_types = 0;
+    record->arg_count = 0;
+    record->arg_length = 0;
+    record->reserved = 0;
+}
+
+// 數值參數固定 4 位元組；TLM_LOG_MAX_ARGS 個數值一定放得下，不需要 rest
+void LogId_PutU32(Tlm_Log_t *record, uint32_t value, uint8_t rest)
+{
+    (void)rest;
+    uint8_t *dst = LogId_Reserve(record, TLM_LOG_ARG_U32, sizeof(value));
+    if (dst != NULL)
+        memcpy(dst, &value, sizeof(value));
+}
+
+void LogId_PutI32(Tlm_Log_t *record, int32_t value, uint8_t rest)
+{
+    (void)rest;
+    uint8_t *dst = LogId_Reserve(record, TLM_LOG_ARG_I32, sizeof(value));
+    if (dst != NULL)
+        memcpy(dst, &value, sizeof(value));
+}
+
+void LogId_PutFloat(Tlm_Log_t *record, float value, uint8_t rest)
+{
+    (void)rest;
+    uint8_t *dst = LogId_Reserve(record, TLM_LOG_ARG_FLOAT, sizeof(value));
+    if (dst != NULL)
+        memcpy(dst, &value, sizeof(value));
+}
+
+/**
+ * @brief  加入字串參數（超過剩餘空間時截斷）
+ *         後面每個參數保留 4 位元組，所以之前的字串不會把空間用完，
+ *         長度位元組一定放得下，字串最短截成空字串
+ * @param  record: 紀錄
+ * @param  value: 字串
+ * @param  rest: 後面還有幾個參數
+ * @retval None
+ */
+void LogId_PutString(Tlm_Log_t *record, const char *value, uint8_t rest)
+{
+    if (value == NULL)
+        value = "(null)";
+
+    uint32_t length = strlen(value);
+    uint32_t space = TLM_LOG_ARG_BYTES - record->arg_length;
+    uint32_t keep = 4U * rest;
+    if (length + 1 + keep > space)
+        length = (space > keep + 1) ? space - keep - 1 : 0;
+
+    uint8_t *dst = LogId_Reserve(record, TLM_LOG_ARG_STRING, length + 1);
+    if (dst != NULL) {
+        dst[0] = (uint8_t)length;
+        memcpy(&dst[1], value, length);
+    }
+}
+
+/**
+ * @brief  送出紀錄（中斷內呼叫時丟棄）；遙測關閉時改成文字輸出
+ * @param  record: 紀錄
+ * @param  text_format: 文字輸出用的格式字串，NULL 時只印 ID 與參數
+ * @retval None
+ */
+void LogId_End(Tlm_Log_t *record, const char *text_format)
+{
+    if (__get_IPSR() != 0)
+        return;
+
+#if LOGID_ENABLE
+    if (!Telemetry_IsEnabled())
+#endif
+    {
+        LogId_Print(record, text_format);
+        return;
+    }
+
+    uint16_t length = (uint16_t)(sizeof(Tlm_Log_t) - TLM_LOG_ARG_BYTES +
+                                 ((record->arg_length + 3U) & ~3U));
+    memset(&record->args[record->arg_length], 0, ((record->arg_length + 3U) & ~3U) - record->arg_length);
+    Telemetry_Send(TLM_REC_LOG, record, length);
+}
+
+/**
+ * @brief  保留參數空間並記錄型態
+ * @param  record: 紀錄
+ * @param  type: TLM_LOG_ARG_x
+ * @param  size: 位元組數
+ * @retval 參數寫入位置，空間或個數不足時為 NULL
+ */
+static uint8_t *LogId_Reserve(Tlm_Log_t *record, uint8_t type, uint32_t size)
+{
+    if (record->arg_count >= TLM_LOG_MAX_ARGS ||
+        record->arg_length + size > TLM_LOG_ARG_BYTES)
+        return NULL;
+
+    uint8_t *dst = &record->args[record->arg_length];
+    record->arg_types |= (uint16_t)(type << (2 * record->arg_count));
+    record->arg_count++;
+    record->arg_length += (uint8_t)size;
+    return dst;
+}
+
+/**
+ * @brief  紀錄格式化成文字後輸出
+ * @param  record: 紀錄
+ * @param  format: printf 格式字串（支援旗標、寬度、精度與 d i u x X c s f），
+ *                 NULL 時輸出 "[log 0xID] 參數..."
+ * @retval None
+ */
+static void LogId_Print(const Tlm_Log_t *record, const char *format)
+{
+    char line[LOGID_TEXT_SIZE];
+    char spec[16];
+    char value[24];
+    uint32_t length = 0;
+    uint32_t offset = 0;
+    uint8_t index = 0;
+
+    if (format == NULL) {
+        snprintf(line, sizeof(line), "[log 0x%04X]", record->id);
+        length = strlen(line);
+    }
+
+    for (const char *p = format; p != NULL && *p != '\0'; p++) {
+        if (*p != '%' || p[1] == '%') {
+            if (*p == '%')
+                p++;
+            if (length < sizeof(line) - 1)
+                line[length++] = *p;
+            continue;
+        }
+
+        // 旗標、寬度、精度；長度修飾字不影響打包後的參數
+        uint8_t left = 0;
+        uint8_t plus = 0;
+        int32_t width = 0;
+        int32_t precision = -1;
+        uint32_t n = 0;
+
+        spec[n++] = '%';
+        for (p++; *p != '\0' && strchr("-+ #0", *p) != NULL; p++) {
+            if (*p == '-') left = 1;
+            if (*p == '+') plus = 1;
+            if (n < sizeof(spec) - 6) spec[n++] = *p;
+        }
+        for (; *p >= '0' && *p <= '9'; p++) {
+            width = width * 10 + (*p - '0');
+            if (n < sizeof(spec) - 6) spec[n++] = *p;
+        }
+        if (*p == '.') {
+            precision = 0;
+            if (n < sizeof(spec) - 6) spec[n++] = '.';
+            for (p++; *p >= '0' && *p <= '9'; p++) {
+                precision = precision * 10 + (*p - '0');
+                if (n < sizeof(spec) - 6) spec[n++] = *p;
+            }
+        }
+        while (*p != '\0' && strchr("hlLqjzt", *p) != NULL)
+            p++;
+        if (*p == '\0')
+            break;
+
+        char conversion = *p;
+        if (index >= record->arg_count) {
+            length = LogId_Append(line, length, "<?>", 0, 0);
+            continue;
+        }
+
+        uint8_t type = (record->arg_types >> (2 * index)) & 3;
+        index++;
+
+        if (type == TLM_LOG_ARG_STRING) {
+            uint8_t size = record->args[offset];
+            if (size > sizeof(value) - 1)
+                size = sizeof(value) - 1;
+            memcpy(value, &record->args[offset + 1], size);
+            value[size] = '\0';
+            offset += 1U + record->args[offset];
+            length = LogId_Append(line, length, value, width, left);
+            continue;
+        }
+
+        uint32_t word;
+        memcpy(&word, &record->args[offset], sizeof(word));
+        offset += 4;
+
+        if (conversion == 'f' || conversion == 'F' || conversion == 'e' || conversion == 'g') {
+            float real;
+            if (type == TLM_LOG_ARG_FLOAT)
+                memcpy(&real, &word, sizeof(real));
+            else if (type == TLM_LOG_ARG_I32)
+                real = (float)(int32_t)word;
+            else
+                real = (float)word;
+
+            if (precision < 0 || precision > FIXFMT_MAX_DECIMALS)
+                precision = (precision < 0) ? 6 : FIXFMT_MAX_DECIMALS;
+
+            // 正號旗標：FixFmt 只輸出負號
+            value[0] = '+';
+            FixFmt_Float(&value[plus && real >= 0.0f], real, (uint8_t)precision);
+            length = LogId_Append(line, length, value, width, left);
+            continue;
+        }
+
+        // 整數：型態來自打包的參數，不是格式字串
+        if (type == TLM_LOG_ARG_FLOAT) {
+            float real;
+            memcpy(&real, &word, sizeof(real));
+            word = (uint32_t)(int32_t)real;
+        }
+
+        spec[n] = '\0';
+        switch (conversion) {
+        case 'd': case 'i':
+            strcat(spec, "ld");
+            snprintf(value, sizeof(value), spec, (long)(int32_t)word);
+            break;
+        case 'u': case 'x': case 'X': case 'o':
+            spec[n++] = 'l';
+            spec[n++] = conversion;
+            spec[n] = '\0';
+            snprintf(value, sizeof(value), spec, (unsigned long)word);
+            break;
+        case 'c':
+            strcat(spec, "c");
+            snprintf(value, sizeof(value), spec, (int)word);
+            break;
+        default:
+            snprintf(value, sizeof(value), "<%%%c?>", conversion);
+            break;
+        }
+        length = LogId_Append(line, length, value, 0, 0);
+    }
+
+    // 沒有格式字串：依序印出參數
+    if (format == NULL) {
+        for (index = 0; index < record->arg_count; index++) {
+            uint8_t type = (record->arg_types >> (2 * index)) & 3;
+            uint32_t word;
+
+            if (type == TLM_LOG_ARG_STRING) {
+                uint8_t size = record->args[offset];
+                if (size > sizeof(value) - 3)
+                    size = sizeof(value) - 3;
+                value[0] = ' ';
+                value[1] = '"';
+                memcpy(&value[2], &record->args[offset + 1], size);
+                value[2 + size] = '\0';
+                offset += 1U + record->args[offset];
+                length = LogId_Append(line, length, value, 0, 0);
+                length = LogId_Append(line, length, "\"", 0, 0);
+                continue;
+            }
+
+            memcpy(&word, &record->args[offset], sizeof(word));
+            offset += 4;
+            value[0] = ' ';
+            if (type == TLM_LOG_ARG_FLOAT) {
+                float real;
+                memcpy(&real, &word, sizeof(real));
+                FixFmt_Float(&value[1], real, 3);
+            } else if (type == TLM_LOG_ARG_I32) {
+                snprintf(&value[1], sizeof(value) - 1, "%ld", (long)(int32_t)word);
+            } else {
+                snprintf(&value[1], sizeof(value) - 1, "%lu", (unsigned long)word);
+            }
+            length = LogId_Append(line, length, value, 0, 0);
+        }
+        length = LogId_Append(line, length, "\r\n", 0, 0);
+    }
+
+    line[length] = '\0';
+    printf("%s", line);
+}
+
+/**
+ * @brief  把一段文字接到行尾，依寬度補空白
+ * @param  line: 輸出行（LOGID_TEXT_SIZE bytes）
+ * @param  length: 目前長度
+ * @param  text: 文字
+ * @param  width: 最小寬度
+ * @param  left: 1 = 靠左（右邊補空白）
+ * @retval 新的長度
+ */
+static uint32_t LogId_Append(char *line, uint32_t length, const char *text, int32_t width, uint8_t left)
+{
+    int32_t pad = width - (int32_t)strlen(text);
+
+    while (!left && pad-- > 0 && length < LOGID_TEXT_SIZE - 1)
+        line[length++] = ' ';
+    while (*text != '\0' && length < LOGID_TEXT_SIZE - 1)
+        line[length++] = *text++;
+    while (left && pad-- > 0 && length < LOGID_TEXT_SIZE - 1)
+        line[length++] = ' ';
+
+    return length;
+}
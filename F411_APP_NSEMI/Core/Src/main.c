@@ -34,17 +34,79 @@
 #include "current_monitor.h"
 #include "ssd1306.h"
 #include "ssd1306_fonts.h"
+#include "ssd1306_fonts_ui.h"
+#include "ssd1306_tests.h"
 #include "handpiece.h"
+#include "autotune.h"
+#include "param_store.h"
+#include "scheduler.h"
+#include "uart_log.h"
+#include "telemetry.h"
+#include "fixfmt.h"
+#include "raw_stream.h"
+#include "shell.h"
+#include "itm_trace.h"
+#include "usb_stream.h"
+#include "usb_hid.h"
+#include "usb_audio.h"
+#include "trend_graph.h"
+#include "pwm_hr.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
 /* USER CODE BEGIN PTD */
-
+// 開機流程階段（數值與遙測 TLM_APP_x 相同）
+typedef enum {
+    APP_CAL_ZERO = 0,       // ACS712 零點
+    APP_CAL_MANUAL,         // 手動零點校準（量測偏移與雜訊）
+    APP_RUNNING
+} App_Phase_t;
+
+// OLED 顯示模式
+typedef enum {
+    APP_OLED_TEXT = 0,      // 濾波器結果
+    APP_OLED_TREND,         // 趨勢圖
+    APP_OLED_READOUT        // 大字電流值
+} App_OledMode_t;
+
+// 原始波形串流的切換流程（capture 任務輪詢，不在指令中等待）
+typedef enum {
+    APP_CAPTURE_IDLE = 0,
+    APP_CAPTURE_STARTING,   // 等 uart_log 送完提示，之後換鮑率
+    APP_CAPTURE_RUNNING,
+    APP_CAPTURE_STOPPING    // 等串流佇列送完，之後還原鮑率
+} App_CaptureState_t;
 /* USER CODE END PTD */
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
-
+#define APP_ZERO_SAMPLES        100     // ACS712 零點校準樣本數（每 10 ms 一個）
+#define APP_TELEMETRY_BINARY    1       // 1 = 週期報告改用二進位遙測（Tools/tlm_decode 解碼）
+#define APP_TREND_SAMPLES       4       // 趨勢圖每行樣本數：10 ms 取樣 → 25 行/秒，一圈約 5 秒
+#define APP_TREND_MAX_MA        500     // 趨勢圖預設滿刻度 (mA)
+#define APP_TREND_FPS           25      // 趨勢圖畫面更新率（ssd1306_FrameDue 控制）
+#define APP_TREND_POLL_MS       5       // 趨勢圖任務檢查畫面時間的週期
+#define APP_READOUT_Y           6       // 大字電流值（Font_UI_16x26）的頂端，貼齊畫面底部
+#define APP_READOUT_WIDTH       112     // 大字電流值區域寬度，右邊留給 "mA"
+#define APP_TUNE_POLL_MS        50      // 自動調諧任務檢查狀態的週期
+#define APP_CAPTURE_POLL_MS     5       // capture 任務檢查切換進度的週期
+#define APP_CAPTURE_IDLE_MS     500     // 開始串流前等 uart_log 送完的最長時間
+#define APP_DRIVE_PERIOD_MS     (UPDATE_INTERVAL_MS / UPDATE_SAMPLES)   // 電流迴路週期，每個樣本一次
+
+// 開機狀態列：有中文字型時（Tools/font_gen 以 -DFONT_CJK_BDF 產生 Font_UI_CJK）顯示中文，
+// 字元集在 Tools/font_gen/cjk_charset.txt；中文字型為 RLE，需在 ssd1306_conf.h 設定
+// SSD1306_GLYPH_CACHE_SIZE。否則用 Font_UI_6x8 顯示英文
+#if defined(SSD1306_HAVE_FONT_UI_CJK) && (SSD1306_GLYPH_CACHE_SIZE > 0)
+#define APP_STATUS_FONT         (&Font_UI_CJK)
+#define APP_STATUS_ACS712       "ACS712 初始化..."
+#define APP_STATUS_MONITOR      "電流監控初始化..."
+#define APP_STATUS_CALIBRATING  "校準中..."
+#else
+#define APP_STATUS_FONT         (&Font_UI_6x8)
+#define APP_STATUS_ACS712       "ACS712_Init..."
+#define APP_STATUS_MONITOR      "CurrentMonitor_Init..."
+#define APP_STATUS_CALIBRATING  "Calibrating..."
+#endif
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -59,77 +121,109 @@
 //ACS712_Type_t acs712;
 ACS712_Handle_t acs712;
 Current_Monitor_t monitor;
+
+// 排程器任務
+static App_Phase_t app_phase = APP_CAL_ZERO;
+static uint32_t app_zero_sum = 0;
+static uint16_t app_zero_count = 0;
+static Load_State_t app_load_state = LOAD_STOPPED;
+static Sched_TaskId_t task_cal;
+static Sched_TaskId_t task_sample;
+static Sched_TaskId_t task_filter;
+static Sched_TaskId_t task_oled;
+static Sched_TaskId_t task_log;
+static Sched_TaskId_t task_trend;
+static Sched_TaskId_t task_readout;
+static Sched_TaskId_t task_tune;
+static Sched_TaskId_t task_drive;
+static Sched_TaskId_t task_capture;
+
+// 原始波形串流
+static App_CaptureState_t app_capture_state = APP_CAPTURE_IDLE;
+static Acq_Config_t app_capture_config;
+static uint32_t app_capture_tick;
+
+// OLED 趨勢圖：第一列顯示目前電流，下面是圖
+static TrendGraph_t app_trend;
+static App_OledMode_t app_oled_mode = APP_OLED_TEXT;
+static uint32_t app_trend_header_tick = 0;
+
+// OLED 大字電流值
+static SSD1306_Readout_t app_readout;
+
+// OLED 顯示模式名稱（依 App_OledMode_t 順序）
+static const char *const app_oled_names[] = { "text", "trend", "readout" };
+
+// 負載狀態名稱（依 Load_State_t 順序）
+static const char *const app_load_names[] = {
+    "STOPPED", "NOISE", "WEAK", "DETECTED", "STARTING", "RUNNING"
+};
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 /* USER CODE BEGIN PFP */
-
+static void App_InitTasks(void);
+static void App_SetPhase(App_Phase_t phase);
+static void App_ShowStatus(uint8_t line, const char *text);
+static void App_CalibrationTask(void *context);
+static void App_SampleTask(void *context);
+static void App_FilterTask(void *context);
+static void App_DisplayTask(void *context);
+static void App_TrendTask(void *context);
+static void App_ReadoutTask(void *context);
+static void App_SetOledMode(App_OledMode_t mode);
+static void App_LogTask(void *context);
+static void App_EnableMonitor(uint8_t enable);
+static uint8_t App_AcquisitionBusy(void);
+static void App_AutotuneTask(void *context);
+static void App_DriveTask(void *context);
+static void App_CaptureTask(void *context);
+static HAL_StatusTypeDef App_CmdHelp(int argc, char *argv[]);
+static HAL_StatusTypeDef App_CmdMode(int argc, char *argv[]);
+static HAL_StatusTypeDef App_CmdSet(int argc, char *argv[]);
+static HAL_StatusTypeDef App_CmdKalman(int argc, char *argv[]);
+static HAL_StatusTypeDef App_CmdCapture(int argc, char *argv[]);
+static HAL_StatusTypeDef App_CmdStats(int argc, char *argv[]);
+static HAL_StatusTypeDef App_CmdReset(int argc, char *argv[]);
+static HAL_StatusTypeDef App_CmdTrace(int argc, char *argv[]);
+static HAL_StatusTypeDef App_CmdUsb(int argc, char *argv[]);
+static HAL_StatusTypeDef App_CmdOled(int argc, char *argv[]);
+#ifdef SSD1306_TESTS
+static HAL_StatusTypeDef App_CmdBench(int argc, char *argv[]);
+#endif
+static HAL_StatusTypeDef App_CmdPwm(int argc, char *argv[]);
+static HAL_StatusTypeDef App_CmdAutotune(int argc, char *argv[]);
+static HAL_StatusTypeDef App_CmdDrive(int argc, char *argv[]);
+static HAL_StatusTypeDef App_HidCommand(const Tlm_HidCommand_t *command);
+static HAL_StatusTypeDef App_AudioControl(uint8_t active);
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
 int _write(int file, char *ptr, int len)
 {
-    // 使用 10ms 超時，失敗也返回成功
-    HAL_UART_Transmit(DEBUG_UART_PORT, (uint8_t*)ptr, len, 10);
+    // ITM 文字 port 啟用時走 SWO（中斷中也可以輸出）
+    if (ItmTrace_IsPortEnabled(ITM_PORT_TEXT)) {
+        ItmTrace_Write(ITM_PORT_TEXT, (const uint8_t*)ptr, (uint32_t)len);
+        return len;
+    }
+
+    // 放進輸出緩衝區由 DMA 送出，不等待；放不下時丟棄並計數
+    UartLog_Write((const uint8_t*)ptr, (uint32_t)len);
     return len;  // 總是返回成功
 }
 
-void Test_Current_Monitor_With_Filters(void);
 void Menu_Selection(void);
-void Test_Current_Monitor_With_Filters(void)
-{
-    // 初始化電流監控系統
-    Current_Monitor_t monitor;
-    ACS712_Handle_t acs712;
-
-    // 初始化 ACS712
-    ACS712_Init(&acs712, &hadc1, ACS712_05A);
-
-    // 初始化電流監控器
-    CurrentMonitor_Init(&monitor, &acs712);
-
-    printf("\r\n=== 電流監控濾波器測試系統 ===\r\n");
-    printf("初始化完成，開始測試...\r\n\r\n");
-
-    // **執行濾波器測試**
-    CurrentMonitor_TestFilters(&monitor);
-
-    printf("\r\n=== 進入持續監控模式 ===\r\n");
-
-    // **持續監控模式**
-    while (1) {
-        CurrentMonitor_Update(&monitor);
-
-        // 每5秒顯示一次詳細資訊
-        static uint32_t last_display = 0;
-        if (HAL_GetTick() - last_display > 5000) {
-            CurrentMonitor_Display(&monitor);
-            last_display = HAL_GetTick();
-        }
-
-        HAL_Delay(100);
-    }
-}
-
 /**
- * @brief  選單系統
+ * @brief  選單系統：指令由 USART6 shell 接收（shell.c），這裡只印出可用指令
  * @param  None
  * @retval None
  */
 void Menu_Selection(void)
 {
-    printf("\r\n=== 測試選單 ===\r\n");
-    printf("1. PWM 測試\r\n");
-    printf("2. ADC 測試\r\n");
-    printf("3. 電流監控濾波器測試\r\n");
-    printf("4. 電流監控基本測試\r\n");
-    printf("請選擇測試項目 (1-4):\r\n");
-
-    // 這裡可以加入 UART 接收選擇邏輯
-    // 暫時直接執行濾波器測試
-    Test_Current_Monitor_With_Filters();
+    printf("\r\n=== 指令選單 ===\r\n");
+    Shell_PrintHelp();
 }
 /* USER CODE END 0 */
 
@@ -173,6 +267,9 @@ int main(void)
   MX_USB_DEVICE_Init();
   MX_USART6_UART_Init();
   /* USER CODE BEGIN 2 */
+  MX_TIM3_Init();
+  ParamStore_Init();
+
   // 🔧 簡化測試：先測試基本功能
   printf("=== APP STARTED ===\r\n");
 
@@ -190,14 +287,11 @@ int main(void)
   printf("LED Test completed\r\n");
 
   /* 初始化SSD1306 */
-  char buf[32];
   printf("ssd1306_Init...\r\n");
   ssd1306_Init();
 
   ssd1306_Fill(Black);
-  ssd1306_SetCursor(0, 0);
-  ssd1306_WriteString("ACS712_Init...", Font_6x8, White);
-  ssd1306_UpdateScreen();
+  App_ShowStatus(0, APP_STATUS_ACS712);
 
   /* 初始化ACS712 */
   printf("ACS712_Init...\r\n");
@@ -208,71 +302,31 @@ int main(void)
   }
 
 
-  /* 校準ACS712 */
-  //ssd1306_Fill(Black);
-  ssd1306_SetCursor(0, 8);
-  ssd1306_WriteString("Calibrating...", Font_6x8, White);
-  ssd1306_UpdateScreen();
-
-  printf("ACS712 Calibrating ...ADC to OFFSET\r\n");
-  if (ACS712_Calibrate(&acs712) != HAL_OK)
-  {
-	  printf("ACS712 Calibrating FAIL!!!\r\n");
-      Error_Handler();
-  }
-
   /* 初始化電流監控器 */
-  ssd1306_SetCursor(0, 16);
-  ssd1306_WriteString("CurrentMonitor_Init...", Font_6x8, White);
-  ssd1306_UpdateScreen();
+  App_ShowStatus(1, APP_STATUS_MONITOR);
   printf("CurrentMonitor_Init...\r\n");
   if (CurrentMonitor_Init(&monitor, &acs712) != HAL_OK)
   {
 	  printf("CurrentMonitor_Init Fail!!!\r\n");
       Error_Handler();
   }
-  HAL_Delay(300);
-
-
-  printf("Zero offset: %.3f V\r\n", acs712.zero_offset);
-
-  sprintf(buf, "Zero offset: %.3fV", acs712.zero_offset);
-  ssd1306_Fill(Black);
-  ssd1306_SetCursor(0, 0); // 設定顯示位置
-  ssd1306_WriteString(buf, Font_6x8, White);
-  ssd1306_UpdateScreen();
-  HAL_Delay(100);
-
-  // 執行校準
-  CurrentMonitor_ManualCalibration(&monitor);
-
-  CurrentMonitor_ResetStats(&monitor);
-
-  HAL_Delay(100);
-
-  while(1)
-  {
-  	CurrentMonitor_TestFilters(&monitor);
 
+  /* 校準ACS712：由排程器的 cal 任務執行，其他任務在校準完成後才啟用 */
+  App_ShowStatus(2, APP_STATUS_CALIBRATING);
+  printf("ACS712 Calibrating ...ADC to OFFSET\r\n");
 
-  }
+  Telemetry_Init();
+  Telemetry_SetEnabled(APP_TELEMETRY_BINARY);
 
-  /* 主迴圈 */
-  ssd1306_SetCursor(0, 16);
-  ssd1306_WriteString("CurrentMonitor Start  ...", Font_6x8, White);
-  ssd1306_UpdateScreen();
-  printf("CurrentMonitor Start  ...\r\n");
-  while (1)
+  /* SWO 追蹤：排程器事件、原始樣本，並以 DWT 追蹤 current_now 的寫入 */
+  if (ItmTrace_Init(ITM_TRACE_SWO_HZ) == HAL_OK)
   {
-      CurrentMonitor_Update(&monitor);
-      CurrentMonitor_Display(&monitor);
-      CheckAutoReset(&monitor);  // 加入這行
-
-      HAL_Delay(500);
+      ItmTrace_Watch(0, &monitor.current_now);
   }
 
-
-  uint32_t counter = 0;
+  Scheduler_Init();
+  App_InitTasks();
+  Scheduler_Start();
 
   /* USER CODE END 2 */
 
@@ -280,15 +334,11 @@ int main(void)
   /* USER CODE BEGIN WHILE */
   while (1)
   {
-      // 簡單的 LED 閃爍測試
-      HAL_GPIO_TogglePin(HM_OPA_ADC_GPIO_Port, HM_OPA_ADC_Pin);
-
-      // 簡化的串口輸出
-      printf("APP Running: %lu\r\n", counter++);
-
-      //TestADC();
-      TestADC_Averaging();
-      HAL_Delay(1000);  // 改為 1 秒，更容易觀察
+      // 沒有 ready 任務時睡眠到下一個中斷
+      if (!Scheduler_Run())
+      {
+          Scheduler_Idle();
+      }
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
@@ -348,6 +398,985 @@ void SystemClock_Config(void)
 
 /* USER CODE BEGIN 4 */
 
+// USART6 指令表
+static const Shell_Command_t app_commands[] = {
+    { "help",    "",                                    App_CmdHelp },
+    { "mode",    "[text|binary]",                       App_CmdMode },
+    { "set",     "[deadband|noise|detect|startup|running|overcurrent <mA>]", App_CmdSet },
+    { "kalman",  "[ch <Q> <R>]",                        App_CmdKalman },
+    { "capture", "start [rate_hz] | stop",              App_CmdCapture },
+    { "stats",   "",                                    App_CmdStats },
+    { "reset",   "",                                    App_CmdReset },
+    { "trace",   "[text|profile|value on|off]",         App_CmdTrace },
+    { "usb",     "[start [rate_hz] | stop | bench [ms]]", App_CmdUsb },
+    { "oled",    "[text | trend [max_mA] | readout]",   App_CmdOled },
+#ifdef SSD1306_TESTS
+    { "bench",   "",                                    App_CmdBench },
+#endif
+    { "pwm",     "[hr <carrier_hz> [1|2] | duty <0-65535> | off]", App_CmdPwm },
+    { "autotune", "[start | abort | save]",             App_CmdAutotune },
+    { "drive",   "[<mA> | off]",                        App_CmdDrive },
+};
+
+/**
+ * @brief  建立排程器任務
+ * @retval None
+ */
+static void App_InitTasks(void)
+{
+    task_cal = Scheduler_AddPeriodic("cal", App_CalibrationTask, NULL,
+                                     SCHED_PRIO_HIGH, 10, 0);
+    task_sample = Scheduler_AddPeriodic("sample", App_SampleTask, &monitor,
+                                        SCHED_PRIO_HIGH, UPDATE_INTERVAL_MS / UPDATE_SAMPLES, 1);
+    task_filter = Scheduler_AddPeriodic("filter", App_FilterTask, &monitor,
+                                        SCHED_PRIO_NORMAL, 100, 3);
+    task_oled = Scheduler_AddPeriodic("oled", App_DisplayTask, &monitor,
+                                      SCHED_PRIO_LOW, 200, 5);
+    task_log = Scheduler_AddPeriodic("log", App_LogTask, &monitor,
+                                     SCHED_PRIO_LOW, 5000, 7);
+    task_trend = Scheduler_AddPeriodic("trend", App_TrendTask, &monitor,
+                                       SCHED_PRIO_LOW, APP_TREND_POLL_MS, 4);
+    task_readout = Scheduler_AddPeriodic("readout", App_ReadoutTask, &monitor,
+                                         SCHED_PRIO_LOW, UPDATE_INTERVAL_MS, 6);
+    task_tune = Scheduler_AddPeriodic("tune", App_AutotuneTask, NULL,
+                                      SCHED_PRIO_LOW, APP_TUNE_POLL_MS, 8);
+    task_drive = Scheduler_AddPeriodic("drive", App_DriveTask, &monitor,
+                                       SCHED_PRIO_HIGH, APP_DRIVE_PERIOD_MS, 2);
+    task_capture = Scheduler_AddPeriodic("capture", App_CaptureTask, NULL,
+                                         SCHED_PRIO_LOW, APP_CAPTURE_POLL_MS, 0);
+
+    // 校準完成前只跑 cal 任務
+    Scheduler_Enable(task_sample, 0);
+    Scheduler_Enable(task_filter, 0);
+    Scheduler_Enable(task_oled, 0);
+    Scheduler_Enable(task_log, 0);
+    Scheduler_Enable(task_trend, 0);
+    Scheduler_Enable(task_readout, 0);
+    Scheduler_Enable(task_tune, 0);
+    Scheduler_Enable(task_drive, 0);
+    Scheduler_Enable(task_capture, 0);
+
+    if (TrendGraph_Init(&app_trend, 0, 8, SSD1306_WIDTH, SSD1306_HEIGHT - 8,
+                        0, APP_TREND_MAX_MA, APP_TREND_SAMPLES) != HAL_OK) {
+        printf("TrendGraph_Init Fail!!!\r\n");
+    }
+
+    if (ssd1306_ReadoutInit(&app_readout, &Font_UI_16x26, 0, APP_READOUT_Y, APP_READOUT_WIDTH,
+                            White) != SSD1306_OK) {
+        printf("ssd1306_ReadoutInit Fail!!!\r\n");
+    }
+
+    if (Shell_Init(app_commands, sizeof(app_commands) / sizeof(app_commands[0])) != HAL_OK) {
+        printf("Shell_Init Fail!!!\r\n");
+    }
+
+    if (UsbHid_Init(&monitor, App_HidCommand) != HAL_OK) {
+        printf("UsbHid_Init Fail!!!\r\n");
+    }
+
+    if (UsbAudio_Init(App_AudioControl) != HAL_OK) {
+        printf("UsbAudio_Init Fail!!!\r\n");
+    }
+}
+
+/**
+ * @brief  開機校準：ACS712 零點 → 手動零點校準 → 啟用監控任務
+ * @param  context: 未使用
+ * @retval None
+ */
+static void App_CalibrationTask(void *context)
+{
+    (void)context;
+    char buf[32];
+    FixFmt_Buf_t num;
+
+    switch (app_phase) {
+    case APP_CAL_ZERO:
+        app_zero_sum += ACS712_ReadRaw(&acs712);
+        if (++app_zero_count < APP_ZERO_SAMPLES)
+            return;
+
+        ACS712_SetZeroFromRaw(&acs712, (float)app_zero_sum / app_zero_count);
+        FixFmt_Float(num, acs712.zero_offset, 3);
+        printf("Zero offset: %s V\r\n", num);
+
+        snprintf(buf, sizeof(buf), "Zero offset: %sV", num);
+        ssd1306_Fill(Black);
+        ssd1306_SetCursor(0, 0); // 設定顯示位置
+        ssd1306_WriteStringUtf8(buf, &Font_UI_6x8, White);
+        ssd1306_UpdateScreen();
+
+        // 執行校準
+        CurrentMonitor_StartCalibration(&monitor);
+        App_SetPhase(APP_CAL_MANUAL);
+        break;
+
+    case APP_CAL_MANUAL:
+        if (!CurrentMonitor_CalibrationTask(&monitor))
+            return;
+
+        CurrentMonitor_ResetStats(&monitor);
+        CurrentMonitor_FilterInit(&monitor);
+
+        printf("CurrentMonitor Start  ...\r\n");
+        Scheduler_Enable(task_cal, 0);
+        App_EnableMonitor(1);
+        App_SetPhase(APP_RUNNING);
+        App_SetOledMode(app_oled_mode);
+        Menu_Selection();
+        break;
+
+    default:
+        break;
+    }
+}
+
+// 開機狀態列：第 line 列，超出畫面時清除畫面從第一列開始
+static void App_ShowStatus(uint8_t line, const char *text)
+{
+    uint8_t y = line * APP_STATUS_FONT->height;
+
+    if (y + APP_STATUS_FONT->height > SSD1306_HEIGHT) {
+        ssd1306_Fill(Black);
+        y = 0;
+    }
+    ssd1306_SetCursor(0, y);
+    ssd1306_WriteStringUtf8(text, APP_STATUS_FONT, White);
+    ssd1306_UpdateScreen();
+}
+
+// 切換開機流程階段並送出狀態轉換紀錄
+static void App_SetPhase(App_Phase_t phase)
+{
+    if (Telemetry_IsEnabled())
+        Telemetry_SendState(TLM_DOMAIN_APP, (uint8_t)app_phase, (uint8_t)phase);
+
+    app_phase = phase;
+}
+
+// 取樣：每 10 ms 一個樣本，每 100 ms 更新一次監控數據
+static void App_SampleTask(void *context)
+{
+    Current_Monitor_t *mon = (Current_Monitor_t *)context;
+
+    CurrentMonitor_Update(mon);
+    TrendGraph_AddSample(&app_trend, (int32_t)(mon->current_sample * 1000.0f));
+    if (mon->sample_count != 0 || !Telemetry_IsEnabled())
+        return;
+
+    // 每完成一次更新送出一個樣本，負載狀態改變時送出轉換紀錄
+    Telemetry_AddSample(mon->current_now, UPDATE_INTERVAL_MS);
+
+    Load_State_t state = CurrentMonitor_GetLoadState(mon);
+    if (state != app_load_state) {
+        Telemetry_SendState(TLM_DOMAIN_LOAD, (uint8_t)app_load_state, (uint8_t)state);
+        app_load_state = state;
+    }
+}
+
+// 濾波：每 100 ms
+static void App_FilterTask(void *context)
+{
+    CurrentMonitor_FilterStep((Current_Monitor_t *)context);
+}
+
+// OLED：每 200 ms，只有顯示的數值改變時才重畫、送出
+static void App_DisplayTask(void *context)
+{
+    CurrentMonitor_FilterDisplay((Current_Monitor_t *)context);
+}
+
+// OLED 趨勢圖：每個畫面時間（APP_TREND_FPS）畫新的行，第一列的電流值每秒更新
+// 送出是非同步的（雙緩衝），畫下一個畫面時上一個還可以在傳送中
+static void App_TrendTask(void *context)
+{
+    Current_Monitor_t *mon = (Current_Monitor_t *)context;
+
+    if (!ssd1306_FrameDue())
+        return;
+
+    uint8_t changed = TrendGraph_Render(&app_trend);
+
+    if (HAL_GetTick() - app_trend_header_tick >= 1000) {
+        char buf[24];
+        FixFmt_Buf_t num;
+
+        app_trend_header_tick = HAL_GetTick();
+        snprintf(buf, sizeof(buf), "%s mA (0-%ld)",
+                 FixFmt_Float(num, mon->current_now * 1000.0f, 1), app_trend.max_milli);
+        ssd1306_FillRectangle(0, 0, SSD1306_WIDTH - 1, 7, Black);
+        ssd1306_SetCursor(0, 0);
+        ssd1306_WriteStringUtf8(buf, &Font_UI_6x8, White);
+        changed = 1;
+    }
+
+    if (changed)
+        ssd1306_UpdateScreen();
+}
+
+// OLED 大字電流值：每次更新 (100 ms)，只重畫改變的數字，數值沒變時不送出
+static void App_ReadoutTask(void *context)
+{
+    Current_Monitor_t *mon = (Current_Monitor_t *)context;
+    FixFmt_Buf_t num;
+
+    if (ssd1306_ReadoutSet(&app_readout, FixFmt_Float(num, mon->current_now * 1000.0f, 1)))
+        ssd1306_UpdateScreen();
+}
+
+// 切換 OLED 顯示：文字（濾波器結果）、趨勢圖或大字電流值；校準完成前只記下設定
+static void App_SetOledMode(App_OledMode_t mode)
+{
+    app_oled_mode = mode;
+    if (app_phase != APP_RUNNING)
+        return;
+
+    Scheduler_Enable(task_oled, mode == APP_OLED_TEXT);
+    Scheduler_Enable(task_trend, mode == APP_OLED_TREND);
+    Scheduler_Enable(task_readout, mode == APP_OLED_READOUT);
+    ssd1306_SetFrameRate(mode == APP_OLED_TREND ? APP_TREND_FPS : 0);
+
+    ssd1306_Fill(Black);
+    CurrentMonitor_FilterDisplayInvalidate();
+    ssd1306_ReadoutInvalidate(&app_readout);
+    if (mode == APP_OLED_TREND) {
+        TrendGraph_Redraw(&app_trend);
+        app_trend_header_tick = HAL_GetTick() - 1000;   // 下一次任務就畫第一列
+    } else if (mode == APP_OLED_READOUT) {
+        ssd1306_SetCursor(APP_READOUT_WIDTH + 4, SSD1306_HEIGHT - 8);
+        ssd1306_WriteStringUtf8("mA", &Font_UI_6x8, White);
+    }
+    ssd1306_UpdateScreen();
+}
+
+// 串列埠輸出：每 5 秒
+static void App_LogTask(void *context)
+{
+    Current_Monitor_t *mon = (Current_Monitor_t *)context;
+
+    if (Telemetry_IsEnabled()) {
+        Telemetry_SendStats(mon);
+        Telemetry_SendProfile();
+        CheckAutoReset(mon);
+        return;
+    }
+
+    CurrentMonitor_FilterReport(mon);
+    CurrentMonitor_Display(mon);
+    CheckAutoReset(mon);
+    Scheduler_PrintStats();
+
+    UartLog_Stats_t log_stats;
+    UartLog_GetStats(&log_stats);
+    if (log_stats.dropped_msgs || log_stats.isr_drops) {
+        printf("Log drops: %lu msgs (%lu bytes), ISR %lu, peak %lu/%d\r\n",
+               log_stats.dropped_msgs, log_stats.dropped_bytes,
+               log_stats.isr_drops, log_stats.max_used, UART_LOG_RING_SIZE);
+    }
+}
+
+// 啟用/停用輪詢 ADC 的監控任務（capture 期間 ADC 由 acquisition 的 DMA 使用）
+// 電流迴路需要監控任務的樣本，停用時一併停止
+static void App_EnableMonitor(uint8_t enable)
+{
+    Scheduler_Enable(task_sample, enable);
+    Scheduler_Enable(task_filter, enable);
+    Scheduler_Enable(task_log, enable);
+
+    if (!enable && Handpiece_DriveIsRunning()) {
+        Scheduler_Enable(task_drive, 0);
+        Handpiece_DriveStop();
+        printf("drive stopped\r\n");
+    }
+}
+
+/**
+ * @brief  ADC 是否被佔用：校準未完成、capture、USB/HID 取樣串流、USB 音訊或自動調諧
+ *         （這些都以 acquisition 的 DMA 取樣並停用監控任務，同時只能有一個）
+ * @retval 1 = 佔用中，不能再啟動
+ */
+static uint8_t App_AcquisitionBusy(void)
+{
+    Autotune_State_t tune = Autotune_GetState();
+
+    return app_phase != APP_RUNNING || app_capture_state != APP_CAPTURE_IDLE ||
+           UsbStream_GetMode() == USB_STREAM_SAMPLES || UsbHid_IsStreaming() ||
+           UsbAudio_IsStreaming() || tune == AUTOTUNE_NOISE || tune == AUTOTUNE_RELAY;
+}
+
+/**
+ * @brief  自動調諧：輪詢 Autotune_Process，結束後印出結果、寫入參數區並恢復監控任務
+ *         寫入只用空白槽位（不抹除），參數區已滿時由 'autotune save' 抹除後寫入
+ * @param  context: 未使用
+ * @retval None
+ */
+static void App_AutotuneTask(void *context)
+{
+    (void)context;
+    Autotune_Result_t result;
+    FixFmt_Buf_t num[3];
+
+    Autotune_State_t state = Autotune_Process();
+    if (state == AUTOTUNE_NOISE || state == AUTOTUNE_RELAY)
+        return;
+
+    Scheduler_Enable(task_tune, 0);
+    App_EnableMonitor(1);
+
+    if (Autotune_GetResult(&result) != HAL_OK) {
+        printf("autotune failed (timeout or amplitude too small)\r\n");
+        return;
+    }
+
+    printf("Ku=%s Tu=%s ms a=%s mA (%d cycles)\r\n",
+           FixFmt_Float(num[0], result.ku, 2), FixFmt_Float(num[1], result.tu * 1000.0f, 1),
+           FixFmt_Float(num[2], result.amplitude * 1000.0f, 1), result.cycles);
+    printf("PI: Kp=%s Ki=%s\r\n", FixFmt_Float(num[0], result.kp, 2), FixFmt_Float(num[1], result.ki, 2));
+    printf("Kalman: Q=%s R=%s\r\n", FixFmt_Float(num[0], result.kalman_q, 3),
+           FixFmt_Float(num[1], result.kalman_r, 3));
+
+    HAL_StatusTypeDef status = Autotune_SaveResult(0);
+    if (status == HAL_OK)
+        printf("autotune saved\r\n");
+    else if (status == HAL_BUSY)
+        printf("param sector full, 'autotune save' erases it (CPU stalls 1-2 s)\r\n");
+    else
+        printf("ERR param write\r\n");
+}
+
+// 電流迴路：每個樣本以 PI 更新一次佔空比
+static void App_DriveTask(void *context)
+{
+    Current_Monitor_t *mon = (Current_Monitor_t *)context;
+
+    Handpiece_DriveUpdate(mon->current_sample, APP_DRIVE_PERIOD_MS / 1000.0f);
+}
+
+// help
+static HAL_StatusTypeDef App_CmdHelp(int argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    Shell_PrintHelp();
+    return HAL_OK;
+}
+
+// mode [text|binary]：週期報告用文字或二進位遙測
+static HAL_StatusTypeDef App_CmdMode(int argc, char *argv[])
+{
+    if (argc >= 2) {
+        if (strcmp(argv[1], "binary") == 0) {
+            Telemetry_SetEnabled(1);
+        } else if (strcmp(argv[1], "text") == 0) {
+            Telemetry_FlushSamples();
+            Telemetry_SetEnabled(0);
+        } else {
+            return HAL_ERROR;
+        }
+    }
+
+    printf("mode %s\r\n", Telemetry_IsEnabled() ? "binary" : "text");
+    return HAL_OK;
+}
+
+// set [name mA]：不帶參數時列出目前門檻
+static HAL_StatusTypeDef App_CmdSet(int argc, char *argv[])
+{
+    Monitor_Config_t config = *CurrentMonitor_GetConfig();
+    FixFmt_Buf_t num[6];
+
+    if (argc == 3) {
+        float value;
+        float *field;
+
+        if (!Shell_ParseFloat(argv[2], &value))
+            return HAL_ERROR;
+
+        if (strcmp(argv[1], "deadband") == 0)          field = &config.deadband;
+        else if (strcmp(argv[1], "noise") == 0)        field = &config.noise;
+        else if (strcmp(argv[1], "detect") == 0)       field = &config.detection;
+        else if (strcmp(argv[1], "startup") == 0)      field = &config.startup;
+        else if (strcmp(argv[1], "running") == 0)      field = &config.running;
+        else if (strcmp(argv[1], "overcurrent") == 0)  field = &config.overcurrent;
+        else return HAL_ERROR;
+
+        *field = value / 1000.0f;
+        if (CurrentMonitor_SetConfig(&config) != HAL_OK) {
+            printf("ERR need noise < detect <= startup <= running < overcurrent\r\n");
+            return HAL_OK;
+        }
+    } else if (argc != 1) {
+        return HAL_ERROR;
+    }
+
+    printf("deadband=%s noise=%s detect=%s startup=%s running=%s overcurrent=%s mA\r\n",
+           FixFmt_Float(num[0], config.deadband * 1000.0f, 0),
+           FixFmt_Float(num[1], config.noise * 1000.0f, 0),
+           FixFmt_Float(num[2], config.detection * 1000.0f, 0),
+           FixFmt_Float(num[3], config.startup * 1000.0f, 0),
+           FixFmt_Float(num[4], config.running * 1000.0f, 0),
+           FixFmt_Float(num[5], config.overcurrent * 1000.0f, 0));
+    return HAL_OK;
+}
+
+// kalman [ch Q R]：只改執行中的濾波器，不寫 Flash（抹除 sector 會停住 CPU 數百 ms）
+static HAL_StatusTypeDef App_CmdKalman(int argc, char *argv[])
+{
+    FixFmt_Buf_t num[2];
+    float q;
+    float r;
+
+    if (argc == 4) {
+        uint32_t channel;
+        if (!Shell_ParseUInt(argv[1], &channel) || channel >= ADC_CHANNEL_COUNT ||
+            !Shell_ParseFloat(argv[2], &q) || !Shell_ParseFloat(argv[3], &r) ||
+            q <= 0.0f || r <= 0.0f)
+            return HAL_ERROR;
+
+        Kalman_Set_Parameters((uint8_t)channel, q, r);
+    } else if (argc != 1) {
+        return HAL_ERROR;
+    }
+
+    for (uint8_t ch = 0; ch < 2; ch++) {
+        Kalman_Get_Parameters(ch, &q, &r);
+        printf("kalman%u Q=%s R=%s\r\n", ch, FixFmt_Float(num[0], q, 4), FixFmt_Float(num[1], r, 4));
+    }
+    return HAL_OK;
+}
+
+// capture start [rate_hz] | stop：原始波形串流（raw_stream.c），期間停用監控任務
+// 換鮑率前要等提示送完、停止時要等串流佇列送完，都交給 capture 任務輪詢
+static HAL_StatusTypeDef App_CmdCapture(int argc, char *argv[])
+{
+    if (argc == 2 && strcmp(argv[1], "stop") == 0) {
+        if (app_capture_state != APP_CAPTURE_RUNNING) {
+            printf("capture not running\r\n");
+            return HAL_OK;
+        }
+
+        app_capture_state = APP_CAPTURE_STOPPING;
+        Scheduler_Enable(task_capture, 1);
+        return HAL_OK;
+    }
+
+    if (argc < 2 || argc > 3 || strcmp(argv[1], "start") != 0)
+        return HAL_ERROR;
+
+    if (App_AcquisitionBusy()) {
+        printf("ERR busy\r\n");
+        return HAL_OK;
+    }
+
+    Acquisition_GetDefaultConfig(&app_capture_config);
+    if (argc == 3 && !Shell_ParseUInt(argv[2], &app_capture_config.sample_rate_hz))
+        return HAL_ERROR;
+
+    App_EnableMonitor(0);
+    printf("capture %lu Hz: USART6 -> %lu baud, send 'capture stop' at that baud\r\n",
+           app_capture_config.sample_rate_hz, (unsigned long)RAW_STREAM_BAUD);
+
+    app_capture_state = APP_CAPTURE_STARTING;
+    app_capture_tick = HAL_GetTick();
+    Scheduler_Enable(task_capture, 1);
+    return HAL_OK;
+}
+
+/**
+ * @brief  原始波形串流的切換：提示送完後換鮑率開始串流；停止時佇列送完後恢復監控
+ * @param  context: 未使用
+ * @retval None
+ */
+static void App_CaptureTask(void *context)
+{
+    (void)context;
+    RawStream_Stats_t stream;
+
+    switch (app_capture_state) {
+    case APP_CAPTURE_STARTING:
+        // 提示要在換鮑率前送完；超過時間仍然開始，未送完的留在緩衝區
+        if (!UartLog_IsIdle() && HAL_GetTick() - app_capture_tick < APP_CAPTURE_IDLE_MS)
+            return;
+
+        if (RawStream_Start(&app_capture_config) == HAL_TIMEOUT &&
+            HAL_GetTick() - app_capture_tick < APP_CAPTURE_IDLE_MS)
+            return;
+
+        if (RawStream_IsRunning()) {
+            app_capture_state = APP_CAPTURE_RUNNING;
+        } else {
+            app_capture_state = APP_CAPTURE_IDLE;
+            App_EnableMonitor(1);
+            printf("ERR RawStream_Start\r\n");
+        }
+        Scheduler_Enable(task_capture, 0);
+        break;
+
+    case APP_CAPTURE_STOPPING:
+        if (RawStream_Stop() != HAL_OK)
+            return;
+
+        app_capture_state = APP_CAPTURE_IDLE;
+        Scheduler_Enable(task_capture, 0);
+        App_EnableMonitor(1);
+        RawStream_GetStats(&stream);
+        printf("capture stopped: %lu blocks, %lu dropped, queue peak %u\r\n",
+               stream.frames, stream.dropped, stream.max_queued);
+        break;
+
+    default:
+        Scheduler_Enable(task_capture, 0);
+        break;
+    }
+}
+
+// stats：監控值與各模組統計
+static HAL_StatusTypeDef App_CmdStats(int argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    FixFmt_Buf_t num[2];
+    UartLog_Stats_t log_stats;
+    Telemetry_Stats_t tlm_stats;
+    Shell_Stats_t shell_stats;
+
+    printf("I=%s mA RMS=%s mA load=%s samples=%lu\r\n",
+           FixFmt_Float(num[0], monitor.current_now * 1000.0f, 1),
+           FixFmt_Float(num[1], monitor.stats.rms_current * 1000.0f, 1),
+           app_load_names[CurrentMonitor_GetLoadState(&monitor)], monitor.stats.sample_count);
+
+    Scheduler_PrintStats();
+
+    UartLog_GetStats(&log_stats);
+    Telemetry_GetStats(&tlm_stats);
+    Shell_GetStats(&shell_stats);
+    printf("log: %lu bytes, %lu drops, ISR %lu, peak %lu/%d\r\n",
+           log_stats.bytes, log_stats.dropped_msgs, log_stats.isr_drops,
+           log_stats.max_used, UART_LOG_RING_SIZE);
+    printf("tlm: %lu frames, %lu dropped\r\n", tlm_stats.frames, tlm_stats.dropped);
+    printf("shell: %lu lines, %lu unknown, %lu rx errors, %lu restarts\r\n",
+           shell_stats.lines, shell_stats.unknown, shell_stats.rx_errors, shell_stats.restarts);
+    return HAL_OK;
+}
+
+// reset：清除電流統計與排程器統計
+static HAL_StatusTypeDef App_CmdReset(int argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    CurrentMonitor_ResetStats(&monitor);
+    Scheduler_ResetStats();
+    printf("stats reset\r\n");
+    return HAL_OK;
+}
+
+// trace [text|profile|value on|off]：ITM port 開關，text 開啟時 printf 改走 SWO
+static HAL_StatusTypeDef App_CmdTrace(int argc, char *argv[])
+{
+    static const char *const names[] = { "text", "profile", "value" };
+
+    if (argc == 3) {
+        uint8_t port;
+        for (port = 0; port < 3; port++) {
+            if (strcmp(argv[1], names[port]) == 0)
+                break;
+        }
+        if (port == 3)
+            return HAL_ERROR;
+
+        if (strcmp(argv[2], "on") == 0)
+            ItmTrace_EnablePort(port, 1);
+        else if (strcmp(argv[2], "off") == 0)
+            ItmTrace_EnablePort(port, 0);
+        else
+            return HAL_ERROR;
+    } else if (argc != 1) {
+        return HAL_ERROR;
+    }
+
+    printf("ITM %lu Hz: text=%s profile=%s value=%s watch=0x%08lX drops=%lu\r\n",
+           (unsigned long)ITM_TRACE_SWO_HZ,
+           ItmTrace_IsPortEnabled(ITM_PORT_TEXT) ? "on" : "off",
+           ItmTrace_IsPortEnabled(ITM_PORT_PROFILE) ? "on" : "off",
+           ItmTrace_IsPortEnabled(ITM_PORT_VALUE) ? "on" : "off",
+           ItmTrace_GetWatch(0), ItmTrace_GetDrops());
+    return HAL_OK;
+}
+
+// oled [text | trend [max_mA] | readout]：OLED 顯示文字、趨勢圖或大字電流值
+static HAL_StatusTypeDef App_CmdOled(int argc, char *argv[])
+{
+    if (argc >= 2) {
+        if (strcmp(argv[1], "text") == 0 && argc == 2) {
+            App_SetOledMode(APP_OLED_TEXT);
+        } else if (strcmp(argv[1], "trend") == 0 && argc <= 3) {
+            uint32_t max_ma = app_trend.max_milli;
+            if (argc == 3 && (!Shell_ParseUInt(argv[2], &max_ma) || max_ma == 0 ||
+                              TrendGraph_SetRange(&app_trend, 0, (int32_t)max_ma) != HAL_OK))
+                return HAL_ERROR;
+            App_SetOledMode(APP_OLED_TREND);
+        } else if (strcmp(argv[1], "readout") == 0 && argc == 2) {
+            App_SetOledMode(APP_OLED_READOUT);
+        } else {
+            return HAL_ERROR;
+        }
+    }
+
+    SSD1306_FrameStats_t frames;
+    ssd1306_GetFrameStats(&frames);
+    printf("oled %s, trend 0-%ld mA, %u samples/column\r\n", app_oled_names[app_oled_mode],
+           app_trend.max_milli, app_trend.samples_per_column);
+    printf("frames: %lu presented, %lu shown, %lu skipped, %lu late, %u.%u fps (target %u)\r\n",
+           frames.presented, frames.shown, frames.skipped, frames.late,
+           frames.fps_x10 / 10, frames.fps_x10 % 10, frames.target_fps);
+    return HAL_OK;
+}
+
+#ifdef SSD1306_TESTS
+// bench：OLED 繪圖函數和原本逐點版本的 DWT cycles 比較（ssd1306_tests.c），結果印到串列埠
+// 量測會畫在畫面緩衝區上，之後重畫目前的顯示模式；執行期間（約數十 ms）其他任務延後
+static HAL_StatusTypeDef App_CmdBench(int argc, char *argv[])
+{
+    (void)argv;
+
+    if (argc != 1)
+        return HAL_ERROR;
+
+    if (app_phase != APP_RUNNING) {
+        printf("bench: busy\r\n");
+        return HAL_BUSY;
+    }
+
+    ssd1306_TestBenchmarkPrint();
+    App_SetOledMode(app_oled_mode);
+    return HAL_OK;
+}
+#endif
+
+// pwm [hr <carrier_hz> [1|2] | duty <0-65535> | off]：手機 TIM1 CH1 高解析度 PWM（pwm_hr.c）
+// off 時還原一般 PWM 的時基與佔空比；不帶參數時顯示狀態
+static HAL_StatusTypeDef App_CmdPwm(int argc, char *argv[])
+{
+    PWM_HR_Status_t status;
+
+    if (argc >= 2) {
+        if (strcmp(argv[1], "hr") == 0 && (argc == 3 || argc == 4)) {
+            uint32_t carrier_hz;
+            uint32_t order = PWM_HR_ORDER_2;
+            if (!Shell_ParseUInt(argv[2], &carrier_hz) ||
+                (argc == 4 && (!Shell_ParseUInt(argv[3], &order) ||
+                               (order != PWM_HR_ORDER_1 && order != PWM_HR_ORDER_2))))
+                return HAL_ERROR;
+
+            if (Autotune_GetState() == AUTOTUNE_NOISE || Autotune_GetState() == AUTOTUNE_RELAY ||
+                Handpiece_DriveIsRunning()) {
+                printf("ERR busy\r\n");
+                return HAL_OK;
+            }
+            if (PWM_HR_Start(carrier_hz, (PWM_HR_Order_t)order) != HAL_OK) {
+                printf("ERR carrier out of range\r\n");
+                return HAL_OK;
+            }
+        } else if (strcmp(argv[1], "duty") == 0 && argc == 3) {
+            uint32_t duty;
+            if (!Shell_ParseUInt(argv[2], &duty) || duty > 65535)
+                return HAL_ERROR;
+            PWM_HR_SetDuty((uint16_t)duty);
+        } else if (strcmp(argv[1], "off") == 0 && argc == 2) {
+            PWM_HR_Stop();
+        } else {
+            return HAL_ERROR;
+        }
+    }
+
+    PWM_HR_GetStatus(&status);
+    if (!status.running) {
+        printf("pwm hr off, duty %u/65535\r\n", status.duty);
+        return HAL_OK;
+    }
+
+    printf("pwm hr %lu Hz, %u counts, order %u, duty %u/65535, %lu refills (%lu late)\r\n",
+           status.carrier_hz, status.period_counts, (unsigned)status.order, status.duty,
+           status.refills, status.late_refills);
+    return HAL_OK;
+}
+
+// autotune [start | abort | save]：繼電器自動調諧（autotune.c），由 tune 任務輪詢
+// 調諧期間 ADC 由 acquisition 的 DMA 使用，監控任務停用；不帶參數時顯示狀態
+static HAL_StatusTypeDef App_CmdAutotune(int argc, char *argv[])
+{
+    static const char *const names[] = { "idle", "noise", "relay", "done", "failed" };
+
+    if (argc == 2 && strcmp(argv[1], "start") == 0) {
+        // 調諧用一般 PWM 驅動手機，高解析度 PWM 執行中時不能啟動
+        if (App_AcquisitionBusy() || PWM_HR_IsRunning()) {
+            printf("ERR busy\r\n");
+            return HAL_OK;
+        }
+
+        Autotune_Config_t config;
+        Autotune_GetDefaultConfig(&config);
+
+        App_EnableMonitor(0);
+        if (Autotune_Start(&acs712, &config) != HAL_OK) {
+            App_EnableMonitor(1);
+            printf("ERR Autotune_Start\r\n");
+            return HAL_OK;
+        }
+        Scheduler_Enable(task_tune, 1);
+    } else if (argc == 2 && strcmp(argv[1], "abort") == 0) {
+        // 下一次 tune 任務收尾並恢復監控任務
+        Autotune_Abort();
+    } else if (argc == 2 && strcmp(argv[1], "save") == 0) {
+        if (Autotune_GetState() != AUTOTUNE_DONE) {
+            printf("ERR no result\r\n");
+            return HAL_OK;
+        }
+        printf(Autotune_SaveResult(1) == HAL_OK ? "autotune saved\r\n" : "ERR param write\r\n");
+        return HAL_OK;
+    } else if (argc != 1) {
+        return HAL_ERROR;
+    }
+
+    const Param_Data_t *param = ParamStore_Get();
+    FixFmt_Buf_t num[2];
+    printf("autotune %s, PI Kp=%s Ki=%s (%s)\r\n", names[Autotune_GetState()],
+           FixFmt_Float(num[0], param->pi_kp, 2), FixFmt_Float(num[1], param->pi_ki, 2),
+           ParamStore_IsLoaded() ? "flash" : "default");
+    return HAL_OK;
+}
+
+// drive [<mA> | off]：手機電流迴路，PI 增益取自參數區（先執行 autotune）；不帶參數時顯示狀態
+static HAL_StatusTypeDef App_CmdDrive(int argc, char *argv[])
+{
+    FixFmt_Buf_t num[2];
+
+    if (argc == 2 && strcmp(argv[1], "off") == 0) {
+        Scheduler_Enable(task_drive, 0);
+        Handpiece_DriveStop();
+    } else if (argc == 2) {
+        float setpoint_ma;
+        if (!Shell_ParseFloat(argv[1], &setpoint_ma) || setpoint_ma < 0.0f)
+            return HAL_ERROR;
+
+        if (Handpiece_DriveIsRunning()) {
+            Handpiece_DriveSetpoint(setpoint_ma / 1000.0f);
+        } else {
+            // 需要監控任務的樣本，ADC 被串流或調諧佔用時不能啟動
+            const Param_Data_t *param = ParamStore_Get();
+            if (App_AcquisitionBusy() || PWM_HR_IsRunning()) {
+                printf("ERR busy\r\n");
+                return HAL_OK;
+            }
+            if (Handpiece_DriveStart(setpoint_ma / 1000.0f, param->pi_kp, param->pi_ki) != HAL_OK) {
+                printf("ERR no PI gains, run 'autotune start'\r\n");
+                return HAL_OK;
+            }
+            Scheduler_Enable(task_drive, 1);
+        }
+    } else if (argc != 1) {
+        return HAL_ERROR;
+    }
+
+    if (!Handpiece_DriveIsRunning()) {
+        printf("drive off\r\n");
+        return HAL_OK;
+    }
+
+    printf("drive %s mA, I=%s mA, duty %u/%u\r\n",
+           FixFmt_Float(num[0], Handpiece_DriveGetSetpoint() * 1000.0f, 1),
+           FixFmt_Float(num[1], monitor.current_now * 1000.0f, 1),
+           Handpiece_DriveGetDuty(), HANDPIECE_DUTY_MAX);
+    return HAL_OK;
+}
+
+// usb [start [rate_hz] | stop | bench [ms]]：USB CDC 取樣串流與吞吐量測試，不帶參數時顯示統計
+static HAL_StatusTypeDef App_CmdUsb(int argc, char *argv[])
+{
+    UsbStream_Stats_t usb;
+    UsbHid_Stats_t hid;
+    UsbAudio_Stats_t audio;
+
+    if (argc == 1) {
+        UsbStream_GetStats(&usb);
+        printf("usb: port %s, mode %u, %lu blocks, %lu dropped, %lu torn, tlm %lu bytes %lu drops\r\n",
+               usb.host_open ? "open" : "closed", usb.mode, usb.blocks, usb.dropped, usb.torn,
+               usb.tlm_bytes, usb.tlm_drops);
+        UsbHid_GetStats(&hid);
+        if (hid.configured) {
+            printf("hid: %s, %lu blocks, %lu dropped, %lu torn, %lu status, %lu cmds (%lu dropped)\r\n",
+                   hid.streaming ? "streaming" : "idle", hid.blocks, hid.dropped, hid.torn,
+                   hid.status_reports, hid.commands, hid.command_drops);
+        }
+        UsbAudio_GetStats(&audio);
+        if (audio.configured) {
+            printf("audio: %s, %lu packets (%lu resent), %lu frames, %lu underruns, %lu overflows, "
+                   "%lu trims, level %u, rate %lu.%03lu Hz\r\n",
+                   audio.streaming ? "streaming" : (audio.active ? "busy" : "idle"),
+                   audio.packets, audio.resent, audio.frames, audio.underruns, audio.overflows,
+                   audio.trims, audio.level, audio.rate_milli_hz / 1000, audio.rate_milli_hz % 1000);
+        }
+        if (usb.bench_ms > 0) {
+            printf("bench: %lu bytes in %lu ms, %lu kB/s\r\n",
+                   usb.bench_bytes, usb.bench_ms, usb.bench_bytes / usb.bench_ms);
+        }
+        return HAL_OK;
+    }
+
+    if (strcmp(argv[1], "stop") == 0 && argc == 2) {
+        if (UsbStream_GetMode() != USB_STREAM_SAMPLES) {
+            printf("usb stream not running\r\n");
+            return HAL_OK;
+        }
+
+        UsbStream_Stop();
+        App_EnableMonitor(1);
+        UsbStream_GetStats(&usb);
+        printf("usb stream stopped: %lu blocks, %lu dropped, %lu torn\r\n",
+               usb.blocks, usb.dropped, usb.torn);
+        return HAL_OK;
+    }
+
+    if (strcmp(argv[1], "bench") == 0 && argc <= 3) {
+        uint32_t ms = 1000;
+        if (argc == 3 && !Shell_ParseUInt(argv[2], &ms))
+            return HAL_ERROR;
+
+        if (UsbStream_StartBench(ms) != HAL_OK)
+            printf("ERR usb port closed or busy\r\n");
+        else
+            printf("usb bench %lu ms, read the port on the host, then 'usb'\r\n", ms);
+        return HAL_OK;
+    }
+
+    if (strcmp(argv[1], "start") != 0 || argc > 3)
+        return HAL_ERROR;
+
+    // bench 也佔用 CDC 端點
+    if (App_AcquisitionBusy() || UsbStream_GetMode() != USB_STREAM_IDLE) {
+        printf("ERR busy\r\n");
+        return HAL_OK;
+    }
+
+    Acq_Config_t config;
+    Acquisition_GetDefaultConfig(&config);
+    if (argc == 3 && !Shell_ParseUInt(argv[2], &config.sample_rate_hz))
+        return HAL_ERROR;
+
+    // 取樣 DMA 與監控任務的 ADC 輪詢互斥
+    App_EnableMonitor(0);
+    if (UsbStream_Start(&config) != HAL_OK) {
+        App_EnableMonitor(1);
+        printf("ERR UsbStream_Start (usb port closed?)\r\n");
+        return HAL_OK;
+    }
+
+    printf("usb stream %lu Hz\r\n", config.sample_rate_hz);
+    return HAL_OK;
+}
+
+/**
+ * @brief  USB HID 指令（UsbHid 的 hidcmd 事件任務在主迴圈呼叫）：開始/停止區塊串流
+ *         複合裝置的 CDC 埠已被主機開啟時，區塊走 CDC bulk，HID 只負責控制與狀態；
+ *         否則區塊以 HID 報告送出
+ * @param  command: 指令報告
+ * @retval HAL狀態，放進狀態報告的 last_result
+ */
+static HAL_StatusTypeDef App_HidCommand(const Tlm_HidCommand_t *command)
+{
+    if (command->cmd == TLM_HID_CMD_STOP) {
+        if (UsbStream_GetMode() == USB_STREAM_SAMPLES)
+            UsbStream_Stop();
+        else if (UsbHid_IsStreaming())
+            UsbHid_Stop();
+        else
+            return HAL_OK;
+
+        App_EnableMonitor(1);
+        return HAL_OK;
+    }
+
+    if (command->cmd != TLM_HID_CMD_START)
+        return HAL_ERROR;
+
+    if (App_AcquisitionBusy() || UsbStream_GetMode() != USB_STREAM_IDLE)
+        return HAL_BUSY;
+
+    Acq_Config_t config;
+    Acquisition_GetDefaultConfig(&config);
+    if (command->arg != 0)
+        config.sample_rate_hz = command->arg;
+
+    App_EnableMonitor(0);
+    if (UsbStream_IsOpen()) {
+        if (UsbStream_Start(&config) != HAL_OK) {
+            App_EnableMonitor(1);
+            return HAL_ERROR;
+        }
+        printf("hid: usb stream %lu Hz\r\n", config.sample_rate_hz);
+        return HAL_OK;
+    }
+
+    if (UsbHid_Start(&config) != HAL_OK) {
+        App_EnableMonitor(1);
+        return HAL_ERROR;
+    }
+
+    printf("hid stream %lu Hz\r\n", config.sample_rate_hz);
+    return HAL_OK;
+}
+
+/**
+ * @brief  USB 音訊（audioctl 事件任務在主迴圈呼叫）：主機開始/停止錄音
+ * @param  active: 1 = 開始，0 = 停止
+ * @retval HAL狀態，其他串流或擷取進行中時回傳 HAL_BUSY（主機收到零長度封包）
+ */
+static HAL_StatusTypeDef App_AudioControl(uint8_t active)
+{
+    if (!active) {
+        if (!UsbAudio_IsStreaming())
+            return HAL_OK;
+
+        UsbAudio_Stop();
+        App_EnableMonitor(1);
+        printf("audio stopped\r\n");
+        return HAL_OK;
+    }
+
+    if (App_AcquisitionBusy()) {
+        printf("audio: busy\r\n");
+        return HAL_BUSY;
+    }
+
+    App_EnableMonitor(0);
+    if (UsbAudio_Start() != HAL_OK) {
+        App_EnableMonitor(1);
+        printf("ERR UsbAudio_Start\r\n");
+        return HAL_ERROR;
+    }
+
+    Acq_Status_t acq;
+    Acquisition_GetStatus(&acq);
+    printf("audio %lu Hz, %u ch\r\n", acq.sample_rate_hz, acq.channels);
+    return HAL_OK;
+}
+
+/**
+ * @brief  TIM 更新中斷回呼：TIM4 為排程器 1 kHz 時基
+ * @param  htim: TIM handle
+ * @retval None
+ */
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance == TIM4)
+    {
+        Scheduler_Tick();
+    }
+}
+
 /* USER CODE END 4 */
 
 /**
@@ -0,0 +1,201 @@
+/*
+ * param_store.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  參數持久化
+ *
+ *  整個 sector 當成追加式紀錄區：每次存檔寫在第一個空白槽位，讀取時取最後一筆
+ *  magic、版本與 CRC 都正確的紀錄。sector 寫滿時才抹除，減少抹除次數。
+ *  CRC 使用硬體 CRC 單元（見 hw_crc.c）。
+ */
+#include "main.h"
+#include "param_store.h"
+#include "hw_crc.h"
+#include <string.h>
+
+/* Flash 上的一筆紀錄，大小必須是 4 的倍數 */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t length;
+    Param_Data_t data;
+    uint32_t crc;
+} Param_Record_t;
+
+#define PARAM_RECORD_WORDS      (sizeof(Param_Record_t) / 4)
+#define PARAM_RECORD_COUNT      (PARAM_STORE_SIZE / sizeof(Param_Record_t))
+
+/* 私有變數 */
+static Param_Data_t param_data;
+static uint8_t param_loaded = 0;
+
+/* 私有函數 */
+static uint8_t ParamStore_IsValid(const Param_Record_t *record);
+static uint8_t ParamStore_IsErased(const Param_Record_t *record);
+static HAL_StatusTypeDef ParamStore_Write(const Param_Data_t *data, uint8_t allow_erase);
+
+/**
+ * @brief  預設參數（原本寫死在濾波器測試裡的值）
+ * @param  data: 參數結構指標
+ * @retval None
+ */
+void ParamStore_GetDefaults(Param_Data_t *data)
+{
+    if (data == NULL)
+        return;
+
+    data->kalman_q[0] = 0.1f;
+    data->kalman_r[0] = 5.0f;
+    data->kalman_q[1] = 0.5f;
+    data->kalman_r[1] = 10.0f;
+    data->pi_kp = 0.0f;
+    data->pi_ki = 0.0f;
+    data->ku = 0.0f;
+    data->tu = 0.0f;
+}
+
+/**
+ * @brief  從 Flash 載入最後一筆有效參數，沒有時使用預設值
+ * @retval HAL_OK = 已載入, HAL_ERROR = 使用預設值
+ */
+HAL_StatusTypeDef ParamStore_Init(void)
+{
+    const Param_Record_t *records = (const Param_Record_t *)PARAM_STORE_ADDR;
+    const Param_Record_t *last = NULL;
+
+    ParamStore_GetDefaults(&param_data);
+    param_loaded = 0;
+
+    for (uint32_t i = 0; i < PARAM_RECORD_COUNT; i++) {
+        if (ParamStore_IsErased(&records[i]))
+            break;
+        if (ParamStore_IsValid(&records[i]))
+            last = &records[i];
+    }
+
+    if (last == NULL)
+        return HAL_ERROR;
+
+    param_data = last->data;
+    param_loaded = 1;
+    return HAL_OK;
+}
+
+const Param_Data_t *ParamStore_Get(void)
+{
+    return &param_data;
+}
+
+// 1 = 目前參數來自 Flash, 0 = 預設值
+uint8_t ParamStore_IsLoaded(void)
+{
+    return param_loaded;
+}
+
+/**
+ * @brief  寫入一筆新參數（sector 已滿時先抹除）
+ * @param  data: 參數結構指標
+ * @retval HAL狀態
+ * @note   抹除 128K sector 約需 1~2 秒，期間 CPU 從 Flash 取指會停住
+ */
+HAL_StatusTypeDef ParamStore_Save(const Param_Data_t *data)
+{
+    return ParamStore_Write(data, 1);
+}
+
+/**
+ * @brief  寫入一筆新參數，不抹除：只寫一個空白槽位（每個 word 約 16 us）
+ * @param  data: 參數結構指標
+ * @retval HAL狀態，sector 已滿時回傳 HAL_BUSY（需要以 ParamStore_Save 抹除）
+ */
+HAL_StatusTypeDef ParamStore_Append(const Param_Data_t *data)
+{
+    return ParamStore_Write(data, 0);
+}
+
+// 找第一個空白槽位寫入；沒有空位時依 allow_erase 抹除或回傳 HAL_BUSY
+static HAL_StatusTypeDef ParamStore_Write(const Param_Data_t *data, uint8_t allow_erase)
+{
+    if (data == NULL)
+        return HAL_ERROR;
+
+    const Param_Record_t *records = (const Param_Record_t *)PARAM_STORE_ADDR;
+    Param_Record_t record;
+    uint32_t slot = PARAM_RECORD_COUNT;
+    HAL_StatusTypeDef status = HAL_OK;
+
+    for (uint32_t i = 0; i < PARAM_RECORD_COUNT; i++) {
+        if (ParamStore_IsErased(&records[i])) {
+            slot = i;
+            break;
+        }
+    }
+
+    if (slot == PARAM_RECORD_COUNT && !allow_erase)
+        return HAL_BUSY;
+
+    memset(&record, 0, sizeof(record));
+    record.magic = PARAM_STORE_MAGIC;
+    record.version = PARAM_STORE_VERSION;
+    record.length = sizeof(Param_Data_t);
+    record.data = *data;
+    record.crc = HwCrc_Compute((const uint32_t *)&record, PARAM_RECORD_WORDS - 1);
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR |
+                           FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+
+    if (slot == PARAM_RECORD_COUNT) {
+        FLASH_EraseInitTypeDef erase = {0};
+        uint32_t sector_error = 0;
+
+        erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+        erase.Sector = PARAM_STORE_SECTOR;
+        erase.NbSectors = 1;
+        erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+        status = HAL_FLASHEx_Erase(&erase, &sector_error);
+        slot = 0;
+    }
+
+    if (status == HAL_OK) {
+        uint32_t address = (uint32_t)&records[slot];
+        const uint32_t *words = (const uint32_t *)&record;
+
+        for (uint32_t i = 0; i < PARAM_RECORD_WORDS && status == HAL_OK; i++) {
+            status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address + i * 4, words[i]);
+        }
+    }
+
+    HAL_FLASH_Lock();
+
+    if (status != HAL_OK || !ParamStore_IsValid(&records[slot]))
+        return HAL_ERROR;
+
+    param_data = *data;
+    param_loaded = 1;
+    return HAL_OK;
+}
+
+static uint8_t ParamStore_IsValid(const Param_Record_t *record)
+{
+    if (record->magic != PARAM_STORE_MAGIC ||
+        record->version != PARAM_STORE_VERSION ||
+        record->length != sizeof(Param_Data_t))
+        return 0;
+
+    return HwCrc_Compute((const uint32_t *)record, PARAM_RECORD_WORDS - 1) == record->crc;
+}
+
+static uint8_t ParamStore_IsErased(const Param_Record_t *record)
+{
+    const uint32_t *words = (const uint32_t *)record;
+
+    for (uint32_t i = 0; i < PARAM_RECORD_WORDS; i++) {
+        if (words[i] != 0xFFFFFFFFUL)
+            return 0;
+    }
+
+    return 1;
+}
@@ -0,0 +1,279 @@
+/*
+ * pwm_hr.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  TIM1 CH1 高解析度 PWM 模式
+ *
+ *  原本 Set_PWM_DutyCycle 在 1 kHz 下只有 1000 階，提高載波頻率會線性損失解析度。
+ *  這裡把 TIM1 以不分頻的計數時脈跑高頻載波，CCR1 由 DMA（CC1 請求、環形模式）
+ *  每個 PWM 週期自動更新一次，更新值由 sigma-delta 調變器產生：
+ *  多個週期的平均佔空比等於 16 位元的目標值。
+ *
+ *  CPU 不需要每個週期介入，只有 DMA 半滿/全滿中斷時補填下一半緩衝區。
+ *  佔空比的小數部分為 0 時輸出是常數，補填直接略過。
+ */
+#include "main.h"
+#include "tim.h"
+#include "pwm_hr.h"
+#include <string.h>
+
+/* 私有變數 */
+static uint16_t hr_buffer[PWM_HR_DMA_LENGTH];       // DMA 來源：每個元素是一個週期的 CCR1
+static volatile uint32_t hr_target_q16 = 0;         // 目標值（Q16 計數）
+static uint32_t hr_half_value[2];                   // 半區內容為常數時對應的目標值
+static int32_t hr_err1 = 0;                         // 調變器誤差 e[n-1]
+static int32_t hr_err2 = 0;                         // 調變器誤差 e[n-2]
+static uint32_t hr_saved_prescaler;                 // 進入 HR 模式前的設定，停止時還原
+static uint32_t hr_saved_period;
+static uint32_t hr_saved_compare;
+static uint32_t hr_saved_arpe;
+static uint8_t hr_saved_output;                     // 1 = 進入前一般 PWM 正在輸出
+static PWM_HR_Status_t hr;
+
+#define HR_HALF_LENGTH      (PWM_HR_DMA_LENGTH / 2)
+#define HR_NO_VALUE         0xFFFFFFFFUL
+#define HR_ERR_LIMIT        (1L << 17)
+
+/* 私有函數 */
+static void PWM_HR_Fill(uint16_t *dst, uint32_t count);
+static uint8_t PWM_HR_Refill(uint8_t half);
+static void PWM_HR_Restore(void);
+
+/**
+ * @brief  16 位元佔空比轉成 Q16 計數
+ * @param  duty: 0 ~ 65535 (對應 0% ~ 100%)
+ * @retval Q16 格式的 CCR 目標值
+ */
+static uint32_t PWM_HR_DutyToQ16(uint16_t duty)
+{
+    // 65535 必須剛好等於整個週期，因此除以 65535 而不是右移 16
+    return (uint32_t)((((uint64_t)duty * hr.period_counts) << 16) / 65535U);
+}
+
+/**
+ * @brief  啟動高解析度 PWM
+ * @param  carrier_hz: 載波頻率 (Hz)
+ * @param  order: 調變器階數
+ * @retval HAL狀態
+ */
+HAL_StatusTypeDef PWM_HR_Start(uint32_t carrier_hz, PWM_HR_Order_t order)
+{
+    if (carrier_hz == 0 || (order != PWM_HR_ORDER_1 && order != PWM_HR_ORDER_2))
+        return HAL_ERROR;
+
+    // TIM1 在 APB2 上，APB2 不分頻時計時器時脈 = PCLK2
+    uint32_t timer_clock = HAL_RCC_GetPCLK2Freq();
+    uint32_t period = timer_clock / carrier_hz;
+
+    if (period < PWM_HR_MIN_PERIOD || period > PWM_HR_MAX_PERIOD)
+        return HAL_ERROR;
+
+    if (hr.running)
+        PWM_HR_Stop();
+
+    // 記下一般 PWM 的設定與輸出狀態，再停掉一般 PWM 模式
+    hr_saved_prescaler = htim1.Instance->PSC;
+    hr_saved_period = htim1.Instance->ARR;
+    hr_saved_compare = htim1.Instance->CCR1;
+    hr_saved_arpe = htim1.Instance->CR1 & TIM_CR1_ARPE;
+    hr_saved_output = (htim1.Instance->CCER & TIM_CCER_CC1E) ? 1 : 0;
+    HAL_TIM_PWM_Stop(&htim1, TIM_CHANNEL_1);
+
+    hr.order = order;
+    hr.period_counts = (uint16_t)period;
+    hr.carrier_hz = timer_clock / period;
+    hr.refills = 0;
+    hr.late_refills = 0;
+
+    // 計數時脈不分頻，ARR 使用預載以免週期中途改變
+    __HAL_TIM_SET_PRESCALER(&htim1, 0);
+    __HAL_TIM_SET_AUTORELOAD(&htim1, period - 1);
+    htim1.Instance->CR1 |= TIM_CR1_ARPE;
+    htim1.Instance->EGR = TIM_EGR_UG;
+
+    // 預先填滿兩個半區
+    hr_err1 = 0;
+    hr_err2 = 0;
+    hr_target_q16 = PWM_HR_DutyToQ16(hr.duty);
+    hr_half_value[0] = HR_NO_VALUE;
+    hr_half_value[1] = HR_NO_VALUE;
+    PWM_HR_Refill(0);
+    PWM_HR_Refill(1);
+    hr.refills = 0;
+
+    if (HAL_TIM_PWM_Start_DMA(&htim1, TIM_CHANNEL_1, (uint32_t *)hr_buffer, PWM_HR_DMA_LENGTH) != HAL_OK)
+    {
+        PWM_HR_Restore();
+        return HAL_ERROR;
+    }
+
+    hr.running = 1;
+    return HAL_OK;
+}
+
+/**
+ * @brief  停止高解析度 PWM 並還原一般 PWM（時基、佔空比，進入前有輸出時重新啟動）
+ * @retval None
+ */
+void PWM_HR_Stop(void)
+{
+    if (!hr.running)
+        return;
+
+    hr.running = 0;
+    HAL_TIM_PWM_Stop_DMA(&htim1, TIM_CHANNEL_1);
+    PWM_HR_Restore();
+}
+
+/**
+ * @brief  設定佔空比，最晚在半個 DMA 緩衝區後生效
+ * @param  duty: 0 ~ 65535 (對應 0% ~ 100%)
+ * @retval None
+ */
+void PWM_HR_SetDuty(uint16_t duty)
+{
+    hr.duty = duty;
+    if (hr.running) {
+        hr_target_q16 = PWM_HR_DutyToQ16(duty);
+    }
+}
+
+uint8_t PWM_HR_IsRunning(void)
+{
+    return hr.running;
+}
+
+void PWM_HR_GetStatus(PWM_HR_Status_t *status)
+{
+    if (status == NULL)
+        return;
+
+    *status = hr;
+}
+
+/**
+ * @brief  Sigma-delta 調變器：產生 count 個週期的 CCR 值
+ * @param  dst: 目的緩衝區
+ * @param  count: 週期數
+ * @retval None
+ */
+static void PWM_HR_Fill(uint16_t *dst, uint32_t count)
+{
+    const int32_t x = (int32_t)hr_target_q16;
+    const int32_t top = hr.period_counts;
+    int32_t e1 = hr_err1;
+    int32_t e2 = hr_err2;
+
+    if (hr.order == PWM_HR_ORDER_1) {
+        // y = x + (1 - z^-1) e
+        for (uint32_t i = 0; i < count; i++) {
+            int32_t u = x - e1;
+            int32_t y = (u + 0x8000) >> 16;
+            if (y < 0) y = 0;
+            else if (y > top) y = top;
+            e1 = (y << 16) - u;
+            dst[i] = (uint16_t)y;
+        }
+    } else {
+        // y = x + (1 - z^-1)^2 e
+        // x 最大接近 2^31，加上 2*e1 - e2 會超出 int32，u 與 e 用 64 位元計算
+        for (uint32_t i = 0; i < count; i++) {
+            int64_t u = (int64_t)x - 2 * (int64_t)e1 + e2;
+            int32_t y = (int32_t)((u + 0x8000) >> 16);
+            if (y < 0) y = 0;
+            else if (y > top) y = top;
+            int64_t e = ((int64_t)y << 16) - u;
+            // 飽和時限制誤差，避免在 0% / 100% 附近積分飽和
+            if (e > HR_ERR_LIMIT) e = HR_ERR_LIMIT;
+            else if (e < -HR_ERR_LIMIT) e = -HR_ERR_LIMIT;
+            e2 = e1;
+            e1 = (int32_t)e;
+            dst[i] = (uint16_t)y;
+        }
+    }
+
+    hr_err1 = e1;
+    hr_err2 = e2;
+}
+
+/**
+ * @brief  補填指定的半區
+ * @param  half: 0 = 前半, 1 = 後半
+ * @retval 1 = 有重寫內容, 0 = 內容不變
+ */
+static uint8_t PWM_HR_Refill(uint8_t half)
+{
+    uint16_t *dst = &hr_buffer[half * HR_HALF_LENGTH];
+    uint32_t target = hr_target_q16;
+
+    if ((target & 0xFFFF) == 0) {
+        // 整數佔空比：輸出為常數，內容沒變就不用重寫
+        if (hr_half_value[half] == target)
+            return 0;
+
+        uint16_t value = (uint16_t)(target >> 16);
+        for (uint32_t i = 0; i < HR_HALF_LENGTH; i++) {
+            dst[i] = value;
+        }
+        hr_err1 = 0;
+        hr_err2 = 0;
+        hr_half_value[half] = target;
+    } else {
+        PWM_HR_Fill(dst, HR_HALF_LENGTH);
+        hr_half_value[half] = HR_NO_VALUE;
+    }
+
+    hr.refills++;
+    return 1;
+}
+
+// 還原進入 HR 模式前的一般 PWM 設定
+static void PWM_HR_Restore(void)
+{
+    htim1.Instance->CR1 = (htim1.Instance->CR1 & ~TIM_CR1_ARPE) | hr_saved_arpe;
+    __HAL_TIM_SET_PRESCALER(&htim1, hr_saved_prescaler);
+    __HAL_TIM_SET_AUTORELOAD(&htim1, hr_saved_period);
+    __HAL_TIM_SET_COMPARE(&htim1, TIM_CHANNEL_1, hr_saved_compare);
+    htim1.Instance->EGR = TIM_EGR_UG;
+
+    if (hr_saved_output)
+        HAL_TIM_PWM_Start(&htim1, TIM_CHANNEL_1);
+}
+
+/**
+ * @brief  檢查補填完成時 DMA 是否已經讀進剛寫入的半區
+ * @param  half: 剛補填的半區
+ * @retval None
+ */
+static void PWM_HR_CheckLate(uint8_t half)
+{
+    DMA_HandleTypeDef *hdma = htim1.hdma[TIM_DMA_ID_CC1];
+    uint32_t position = PWM_HR_DMA_LENGTH - __HAL_DMA_GET_COUNTER(hdma);
+    uint8_t reading = (position < HR_HALF_LENGTH) ? 0 : 1;
+
+    if (reading == half) {
+        hr.late_refills++;
+    }
+}
+
+// DMA 讀完前半區：補填前半
+void HAL_TIM_PWM_PulseFinishedHalfCpltCallback(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance != TIM1 || !hr.running)
+        return;
+
+    if (PWM_HR_Refill(0))
+        PWM_HR_CheckLate(0);
+}
+
+// DMA 讀完後半區：補填後半
+void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance != TIM1 || !hr.running)
+        return;
+
+    if (PWM_HR_Refill(1))
+        PWM_HR_CheckLate(1);
+}
@@ -0,0 +1,317 @@
+/*
+ * raw_stream.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  原始波形串流
+ *
+ *  USART6 掛在 APB2 (72 MHz)，但平常只跑 115200 baud，無法把 ACS712 的原始波形
+ *  拉出來離線分析。串流模式暫停 uart_log，把 USART6 改成 OVER8 的高鮑率，
+ *  在取樣區塊回呼（ADC DMA 中斷）中把乒乓緩衝區剛完成的半區打包成 12 位元，
+ *  放進傳送佇列的一個槽位，USART6 TX DMA 直接從槽位送出，傳送完成中斷再接著送
+ *  下一個槽位，主程式不參與。
+ *
+ *  含 header 每個樣本約 1.9 bytes，10 kHz 單通道約 19 kB/s；2.25 Mbaud 約可承受 11 萬次/秒的取樣。
+ *  佇列滿時整個區塊丟棄並計數；接收端以 header 的 first_index 檢查樣本是否連續。
+ *  格式見 telemetry_protocol.h 的 Tlm_StreamHeader_t，主機端用 Tools/tlm_decode/tlm_stream 解碼。
+ */
+#include "main.h"
+#include "usart.h"
+#include "raw_stream.h"
+#include "uart_log.h"
+#include "telemetry_protocol.h"
+#include <string.h>
+
+// 打包後的資料長度（補到 4 的倍數）
+#define RAW_STREAM_PAYLOAD_MAX  ((((ACQ_BLOCK_SAMPLES * ACQ_MAX_CHANNELS * 3 + 1) / 2) + 3) & ~3)
+#define RAW_STREAM_FRAME_WORDS  ((sizeof(Tlm_StreamHeader_t) + RAW_STREAM_PAYLOAD_MAX + 4) / 4)
+
+/* 私有變數 */
+static uint32_t stream_frames[RAW_STREAM_SLOTS][RAW_STREAM_FRAME_WORDS];
+static uint16_t stream_length[RAW_STREAM_SLOTS];
+static volatile uint8_t stream_head = 0;        // 下一個要填的槽位（取樣中斷）
+static volatile uint8_t stream_tail = 0;        // 正在送的槽位（傳送完成中斷）
+static volatile uint8_t stream_count = 0;
+static volatile uint8_t stream_tx_busy = 0;
+static uint8_t stream_stopping = 0;             // 取樣已停止，等佇列送完
+static uint32_t stream_stop_tick;
+static uint32_t stream_saved_baud;
+static uint32_t stream_saved_oversampling;
+static RawStream_Stats_t stream;
+
+/* 私有函數 */
+static void RawStream_Consumer(const Acq_Block_t *block, void *context);
+static uint16_t RawStream_Pack(uint8_t *dst, const uint16_t *src, uint32_t count);
+static uint16_t RawStream_Fletcher16(const uint8_t *data, uint32_t length);
+static void RawStream_StartNext(void);
+static HAL_StatusTypeDef RawStream_SetBaud(uint32_t baud, uint32_t oversampling);
+
+/**
+ * @brief  開始串流：暫停 uart_log、提高鮑率並啟動取樣
+ * @param  config: 取樣設定
+ * @retval HAL狀態，uart_log 還在傳送時回傳 HAL_TIMEOUT（等 UartLog_IsIdle 後再呼叫）
+ */
+HAL_StatusTypeDef RawStream_Start(const Acq_Config_t *config)
+{
+    if (config == NULL)
+        return HAL_ERROR;
+    if (stream.running)
+        return HAL_BUSY;
+
+    // 目前的 log 傳完才能換鮑率，這裡不等待
+    if (UartLog_Suspend(0) != HAL_OK)
+        return HAL_TIMEOUT;
+
+    stream_saved_baud = huart6.Init.BaudRate;
+    stream_saved_oversampling = huart6.Init.OverSampling;
+    if (RawStream_SetBaud(RAW_STREAM_BAUD, UART_OVERSAMPLING_8) != HAL_OK) {
+        UartLog_Resume();
+        return HAL_ERROR;
+    }
+
+    memset(&stream, 0, sizeof(stream));
+    stream.baud = RAW_STREAM_BAUD;
+    stream_head = 0;
+    stream_tail = 0;
+    stream_count = 0;
+    stream_tx_busy = 0;
+    stream_stopping = 0;
+    stream.running = 1;
+
+    if (Acquisition_Register(RawStream_Consumer, NULL) != HAL_OK ||
+        Acquisition_Start(config) != HAL_OK) {
+        RawStream_Stop();
+        return HAL_ERROR;
+    }
+
+    return HAL_OK;
+}
+
+/**
+ * @brief  停止串流：第一次呼叫停止取樣，佇列送完後還原鮑率並恢復 uart_log
+ *         不等待，佇列還在傳送時回傳 HAL_BUSY，由呼叫端稍後再呼叫
+ * @retval HAL_OK = 已停止, HAL_BUSY = 還在送出佇列
+ * @note   超過 RAW_STREAM_STOP_TIMEOUT_MS 還沒送完時中止傳輸
+ */
+HAL_StatusTypeDef RawStream_Stop(void)
+{
+    if (!stream.running)
+        return HAL_OK;
+
+    if (!stream_stopping) {
+        Acquisition_Unregister(RawStream_Consumer);
+        Acquisition_Stop();
+        stream_stopping = 1;
+        stream_stop_tick = HAL_GetTick();
+    }
+
+    if (stream_tx_busy) {
+        if (HAL_GetTick() - stream_stop_tick < RAW_STREAM_STOP_TIMEOUT_MS)
+            return HAL_BUSY;
+
+        HAL_UART_AbortTransmit(DEBUG_UART_PORT);
+        stream_tx_busy = 0;
+    }
+
+    stream_stopping = 0;
+    stream.running = 0;
+    RawStream_SetBaud(stream_saved_baud, stream_saved_oversampling);
+    UartLog_Resume();
+    return HAL_OK;
+}
+
+uint8_t RawStream_IsRunning(void)
+{
+    return stream.running;
+}
+
+void RawStream_GetStats(RawStream_Stats_t *stats)
+{
+    if (stats == NULL)
+        return;
+
+    *stats = stream;
+}
+
+/**
+ * @brief  取樣區塊回呼（ADC DMA 中斷）：打包進佇列，TX 閒置時立即送出
+ * @param  block: 取樣區塊
+ * @param  context: 未使用
+ * @retval None
+ */
+static void RawStream_Consumer(const Acq_Block_t *block, void *context)
+{
+    (void)context;
+
+    if (stream_count >= RAW_STREAM_SLOTS) {
+        stream.dropped++;
+        return;
+    }
+
+    // 只有這個中斷會寫 head 指向的槽位，打包不需要遮蔽中斷
+    uint8_t slot = stream_head;
+    uint8_t *frame = (uint8_t *)stream_frames[slot];
+    Tlm_StreamHeader_t *header = (Tlm_StreamHeader_t *)frame;
+    Acq_Status_t status;
+
+    Acquisition_GetStatus(&status);
+
+    header->sync = TLM_STREAM_SYNC;
+    header->channels = block->channels;
+    header->bits = TLM_STREAM_BITS;
+    header->sequence = block->sequence;
+    header->first_index = block->first_index;
+    header->sample_rate_hz = status.sample_rate_hz;
+    header->samples = block->samples;
+    header->dropped = (uint16_t)stream.dropped;
+    header->overruns = (uint16_t)status.overruns;
+
+    uint16_t payload = RawStream_Pack(frame + sizeof(Tlm_StreamHeader_t), block->data,
+                                      (uint32_t)block->samples * block->channels);
+    header->payload_bytes = payload;
+
+    uint32_t length = sizeof(Tlm_StreamHeader_t) + payload;
+    uint16_t checksum = RawStream_Fletcher16(frame, length);
+    frame[length++] = (uint8_t)checksum;
+    frame[length++] = (uint8_t)(checksum >> 8);
+    frame[length++] = 0;
+    frame[length++] = 0;
+    stream_length[slot] = (uint16_t)length;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    stream_head = (slot + 1) % RAW_STREAM_SLOTS;
+    stream_count++;
+    if (stream_count > stream.max_queued)
+        stream.max_queued = stream_count;
+    if (!stream_tx_busy)
+        RawStream_StartNext();
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  12 位元打包：每兩個樣本 3 bytes
+ * @param  dst: 輸出
+ * @param  src: 樣本
+ * @param  count: 樣本數
+ * @retval 輸出長度（補到 4 的倍數）
+ */
+static uint16_t RawStream_Pack(uint8_t *dst, const uint16_t *src, uint32_t count)
+{
+    uint32_t out = 0;
+    uint32_t i = 0;
+
+    for (; i + 1 < count; i += 2) {
+        uint16_t a = src[i] & 0x0FFF;
+        uint16_t b = src[i + 1] & 0x0FFF;
+        dst[out++] = (uint8_t)a;
+        dst[out++] = (uint8_t)((a >> 8) | (b << 4));
+        dst[out++] = (uint8_t)(b >> 4);
+    }
+
+    if (i < count) {
+        uint16_t a = src[i] & 0x0FFF;
+        dst[out++] = (uint8_t)a;
+        dst[out++] = (uint8_t)(a >> 8);
+    }
+
+    while (out & 3U) {
+        dst[out++] = 0;
+    }
+
+    return (uint16_t)out;
+}
+
+// Fletcher-16：中斷內計算，不佔用硬體 CRC 單元
+static uint16_t RawStream_Fletcher16(const uint8_t *data, uint32_t length)
+{
+    uint32_t sum1 = 0;
+    uint32_t sum2 = 0;
+
+    while (length > 0) {
+        // 每 20 bytes 取一次餘數，32 位元累加不會溢位
+        uint32_t chunk = (length > 20) ? 20 : length;
+        length -= chunk;
+        while (chunk--) {
+            sum1 += *data++;
+            sum2 += sum1;
+        }
+        sum1 %= 255;
+        sum2 %= 255;
+    }
+
+    return (uint16_t)((sum2 << 8) | sum1);
+}
+
+/**
+ * @brief  送出 tail 槽位（呼叫端需遮蔽中斷）
+ * @retval None
+ */
+static void RawStream_StartNext(void)
+{
+    if (stream_count == 0)
+        return;
+
+    uint8_t slot = stream_tail;
+    stream_tx_busy = 1;
+    if (HAL_UART_Transmit_DMA(DEBUG_UART_PORT, (uint8_t *)stream_frames[slot],
+                              stream_length[slot]) != HAL_OK) {
+        stream_tx_busy = 0;
+    }
+}
+
+/**
+ * @brief  串流期間的 UART 傳送完成（覆寫 uart_log 的 weak 回呼）
+ * @param  huart: UART handle
+ * @retval None
+ */
+void UartLog_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart != DEBUG_UART_PORT || !stream_tx_busy)
+        return;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    stream.frames++;
+    stream.bytes += stream_length[stream_tail];
+    stream_tail = (stream_tail + 1) % RAW_STREAM_SLOTS;
+    stream_count--;
+    stream_tx_busy = 0;
+    RawStream_StartNext();
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  重新設定 USART6 的鮑率與過取樣
+ * @param  baud: 鮑率
+ * @param  oversampling: UART_OVERSAMPLING_8 / UART_OVERSAMPLING_16
+ * @retval HAL狀態
+ * @note   不用 HAL_UART_Init：它會把 RxState 設回 READY，shell 的 RX DMA 還在跑
+ *         卻被 HAL 當成閒置。這裡只在 UE 清除時改寫 BRR/OVER8，DMA 與 HAL 狀態不動
+ */
+static HAL_StatusTypeDef RawStream_SetBaud(uint32_t baud, uint32_t oversampling)
+{
+    UART_HandleTypeDef *huart = DEBUG_UART_PORT;
+    uint32_t pclk = HAL_RCC_GetPCLK2Freq();     // USART6 掛在 APB2
+    uint32_t start = HAL_GetTick();
+
+    // TX DMA 完成時最後一個位元組可能還在移位暫存器裡，最多等一個字元時間
+    while (!__HAL_UART_GET_FLAG(huart, UART_FLAG_TC) && HAL_GetTick() - start <= 2) {
+    }
+
+    __HAL_UART_DISABLE(huart);
+    if (oversampling == UART_OVERSAMPLING_8) {
+        SET_BIT(huart->Instance->CR1, USART_CR1_OVER8);
+        huart->Instance->BRR = UART_BRR_SAMPLING8(pclk, baud);
+    } else {
+        CLEAR_BIT(huart->Instance->CR1, USART_CR1_OVER8);
+        huart->Instance->BRR = UART_BRR_SAMPLING16(pclk, baud);
+    }
+    __HAL_UART_ENABLE(huart);
+
+    // 之後的 HAL_UART_Init（例如錯誤復原）沿用新設定
+    huart->Init.BaudRate = baud;
+    huart->Init.OverSampling = oversampling;
+    return HAL_OK;
+}
@@ -0,0 +1,503 @@
+/*
+ * scheduler.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  協作式 run-to-completion 排程器
+ *
+ *  - TIM4 每 1 ms 中斷一次（Scheduler_Tick），把到期的週期任務標成 ready
+ *  - 事件任務由中斷或其他任務呼叫 Scheduler_Signal 觸發
+ *  - 主迴圈反覆呼叫 Scheduler_Run，每次執行一個最高優先權的 ready 任務，
+ *    任務必須很快返回，不可以呼叫 HAL_Delay
+ *  - 中斷裡放不下的工作可以用 Scheduler_Defer 丟到 PendSV。NVIC_PRIORITYGROUP_0
+ *    沒有搶占位元，所有中斷互不搶占；PendSV 的子優先權最低，只代表它排在其他
+ *    待處理中斷之後執行。執行中不會被任何中斷打斷，延後的工作不可以等待 tick
+ *    或其他中斷的進度，需要等待的工作要用事件任務（Scheduler_Signal）在主迴圈執行
+ *
+ *  每個任務記錄執行次數、DWT cycles 與 deadline miss；任務開始/結束與 idle 進出
+ *  另外送到 ITM_PORT_PROFILE，由 SWO 取得完整時間軸。
+ *
+ *  沒有 ready 任務時主迴圈呼叫 Scheduler_Idle 進入 WFI 睡眠。距離下一個週期
+ *  任務還很久時暫停 SysTick，並把 TIM4 改成一次到期的長週期（tickless），
+ *  醒來後依 TIM4 計數補回 sched_tick 與 HAL 的 uwTick。睡眠時間同樣由 TIM4
+ *  計數取得，每秒換算一次 CPU 負載（清醒時間比例）。
+ */
+#include "main.h"
+#include "tim.h"
+#include "scheduler.h"
+#include "itm_trace.h"
+#include <stdio.h>
+#include <string.h>
+
+/* 任務控制區塊 */
+typedef struct {
+    Sched_TaskFn_t fn;
+    void *context;
+    uint32_t next_release;          // 週期任務下次 release 的 tick
+    uint32_t release_tick;          // 目前這次 release 的 tick
+    volatile uint8_t pending;
+    uint8_t enabled;
+    Sched_TaskStats_t stats;
+} Sched_Task_t;
+
+/* 延後處理項目 */
+typedef struct {
+    Sched_TaskFn_t fn;
+    void *context;
+} Sched_Deferred_t;
+
+/* 私有變數 */
+static Sched_Task_t sched_tasks[SCHED_MAX_TASKS];
+static uint8_t sched_task_count = 0;
+static volatile uint32_t sched_tick = 0;
+static Sched_Deferred_t sched_defer[SCHED_DEFER_QUEUE];
+static volatile uint8_t sched_defer_head = 0;
+static volatile uint8_t sched_defer_tail = 0;
+static volatile uint32_t sched_defer_drops = 0;
+static uint32_t sched_sleep_us = 0;                 // 目前量測窗內的睡眠時間
+static uint32_t sched_load_start = 0;               // 量測窗起點 tick
+static volatile uint16_t sched_cpu_load = 0;        // 最近一秒的 CPU 負載 (0.1%)
+
+#define SCHED_TIMER_PER_TICK    (SCHED_TIMER_HZ / SCHED_TICK_HZ)
+
+/* 私有函數 */
+static Sched_TaskId_t Scheduler_Add(const char *name, Sched_TaskFn_t fn, void *context,
+                                    Sched_Priority_t priority, uint32_t period_ms, uint32_t deadline_ms);
+static void Scheduler_Release(uint32_t tick);
+static uint32_t Scheduler_NextRelease(void);
+
+/**
+ * @brief  初始化排程器：清除任務表、開啟 DWT 計數、PendSV 設為最低子優先權
+ * @retval None
+ */
+void Scheduler_Init(void)
+{
+    memset(sched_tasks, 0, sizeof(sched_tasks));
+    sched_task_count = 0;
+    sched_tick = 0;
+    sched_defer_head = 0;
+    sched_defer_tail = 0;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    // NVIC_PRIORITYGROUP_0 下 HAL_NVIC_SetPriority(PendSV_IRQn, 15, 0) 的搶占優先權
+    // 沒有位元可放，編碼結果是 0（最高）；直接寫入 4 位元優先權值
+    NVIC_SetPriority(PendSV_IRQn, 0xF);
+
+#ifdef DEBUG
+    // 睡眠時保持除錯介面連線
+    DBGMCU->CR |= DBGMCU_CR_DBG_SLEEP;
+#endif
+}
+
+/**
+ * @brief  啟動 TIM4 時基
+ * @retval None
+ */
+void Scheduler_Start(void)
+{
+    HAL_TIM_Base_Start_IT(&htim4);
+}
+
+/**
+ * @brief  新增週期任務
+ * @param  name: 任務名稱（統計輸出用）
+ * @param  fn: 任務函數
+ * @param  context: 傳給任務函數的參數
+ * @param  priority: 優先權
+ * @param  period_ms: 週期 (ms)，deadline 等於週期
+ * @param  offset_ms: 第一次 release 的延遲，用來錯開同週期的任務
+ * @retval 任務編號，失敗回傳 SCHED_INVALID_TASK
+ */
+Sched_TaskId_t Scheduler_AddPeriodic(const char *name, Sched_TaskFn_t fn, void *context,
+                                     Sched_Priority_t priority, uint32_t period_ms, uint32_t offset_ms)
+{
+    if (period_ms == 0)
+        return SCHED_INVALID_TASK;
+
+    Sched_TaskId_t id = Scheduler_Add(name, fn, context, priority, period_ms, period_ms);
+    if (id != SCHED_INVALID_TASK) {
+        sched_tasks[id].next_release = sched_tick + offset_ms;
+    }
+    return id;
+}
+
+/**
+ * @brief  新增事件任務（由 Scheduler_Signal 觸發）
+ * @param  deadline_ms: 從觸發到完成的期限 (ms)，0 = 不檢查
+ * @retval 任務編號，失敗回傳 SCHED_INVALID_TASK
+ */
+Sched_TaskId_t Scheduler_AddEvent(const char *name, Sched_TaskFn_t fn, void *context,
+                                  Sched_Priority_t priority, uint32_t deadline_ms)
+{
+    return Scheduler_Add(name, fn, context, priority, 0, deadline_ms);
+}
+
+/**
+ * @brief  啟用/停用任務，週期任務重新啟用時從下一個 tick 開始計算
+ * @param  id: 任務編號
+ * @param  enable: 1 = 啟用, 0 = 停用
+ * @retval None
+ */
+void Scheduler_Enable(Sched_TaskId_t id, uint8_t enable)
+{
+    if (id < 0 || id >= sched_task_count)
+        return;
+
+    Sched_Task_t *task = &sched_tasks[id];
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (enable && !task->enabled) {
+        task->next_release = sched_tick + 1;
+    }
+    task->enabled = enable ? 1 : 0;
+    if (!enable) {
+        task->pending = 0;
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  觸發事件任務（可在中斷中呼叫）
+ * @param  id: 任務編號
+ * @retval None
+ */
+void Scheduler_Signal(Sched_TaskId_t id)
+{
+    if (id < 0 || id >= sched_task_count)
+        return;
+
+    Sched_Task_t *task = &sched_tasks[id];
+    if (!task->enabled)
+        return;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (task->pending) {
+        task->stats.overruns++;
+    } else {
+        task->release_tick = sched_tick;
+        task->pending = 1;
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  把工作延後到 PendSV 執行（可在中斷中呼叫）
+ * @param  fn: 要執行的函數
+ * @param  context: 參數
+ * @retval HAL狀態，佇列滿時回傳 HAL_ERROR
+ * @note   fn 在中斷內執行且不會被其他中斷打斷：不可等待 tick、DMA 或 USB 的進度，
+ *         printf 也會被 UartLog 丟棄
+ */
+HAL_StatusTypeDef Scheduler_Defer(Sched_TaskFn_t fn, void *context)
+{
+    if (fn == NULL)
+        return HAL_ERROR;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint8_t next = (sched_defer_head + 1) & (SCHED_DEFER_QUEUE - 1);
+    if (next == sched_defer_tail) {
+        sched_defer_drops++;
+        __set_PRIMASK(primask);
+        return HAL_ERROR;
+    }
+
+    sched_defer[sched_defer_head].fn = fn;
+    sched_defer[sched_defer_head].context = context;
+    sched_defer_head = next;
+
+    __set_PRIMASK(primask);
+
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+    return HAL_OK;
+}
+
+/**
+ * @brief  執行一個最高優先權的 ready 任務
+ * @retval 1 = 有執行任務, 0 = 沒有 ready 任務
+ */
+uint8_t Scheduler_Run(void)
+{
+    Sched_Task_t *best = NULL;
+
+    for (uint8_t i = 0; i < sched_task_count; i++) {
+        Sched_Task_t *task = &sched_tasks[i];
+        if (task->pending && (best == NULL || task->stats.priority < best->stats.priority)) {
+            best = task;
+        }
+    }
+
+    if (best == NULL)
+        return 0;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t release = best->release_tick;
+    best->pending = 0;
+    __set_PRIMASK(primask);
+
+    uint16_t id = (uint16_t)(best - sched_tasks);
+    ItmTrace_Event(ITM_PORT_PROFILE, (ITM_EVT_TASK_START << 8) | id);
+    uint32_t start = DWT->CYCCNT;
+    best->fn(best->context);
+    uint32_t cycles = DWT->CYCCNT - start;
+    ItmTrace_Event(ITM_PORT_PROFILE, (ITM_EVT_TASK_END << 8) | id);
+
+    Sched_TaskStats_t *stats = &best->stats;
+    stats->runs++;
+    stats->last_cycles = cycles;
+    stats->total_cycles += cycles;
+    if (cycles > stats->max_cycles) {
+        stats->max_cycles = cycles;
+    }
+    if (stats->deadline_ms != 0 && sched_tick - release > stats->deadline_ms) {
+        stats->deadline_misses++;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief  沒有 ready 任務時睡眠，直到下一個中斷
+ * @retval None
+ * @note   PRIMASK 遮蔽期間 WFI 仍會被待處理的中斷喚醒，中斷在補償 tick 之後
+ *         才執行，所以中斷裡看到的 HAL_GetTick 已經是正確的時間
+ */
+void Scheduler_Idle(void)
+{
+    TIM_TypeDef *tim = htim4.Instance;
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    // 檢查與睡眠之間可能有中斷 release 了任務
+    for (uint8_t i = 0; i < sched_task_count; i++) {
+        if (sched_tasks[i].pending) {
+            __set_PRIMASK(primask);
+            return;
+        }
+    }
+
+    // tick 已經到了但中斷還沒處理，不用睡
+    if (tim->SR & TIM_SR_UIF) {
+        __set_PRIMASK(primask);
+        return;
+    }
+
+    uint32_t gap = Scheduler_NextRelease();
+    uint32_t start = tim->CNT;
+    uint8_t tickless = (gap >= SCHED_TICKLESS_MIN_MS);
+    uint32_t reload = SCHED_TIMER_PER_TICK;
+
+    if (tickless) {
+        // TIM4 沒有 ARR 預載，寫入立即生效；計數相位保持不變
+        reload = gap * SCHED_TIMER_PER_TICK;
+        HAL_SuspendTick();
+        tim->ARR = reload - 1;
+    }
+
+    ItmTrace_Event(ITM_PORT_PROFILE, ITM_EVT_IDLE_ENTER << 8);
+    __DSB();
+    __WFI();
+    ItmTrace_Event(ITM_PORT_PROFILE, ITM_EVT_IDLE_EXIT << 8);
+
+    uint32_t now = tim->CNT;
+    uint8_t wrapped = (tim->SR & TIM_SR_UIF) ? 1 : 0;
+    uint32_t elapsed = wrapped ? (reload - start + now) : (now - start);
+
+    if (tickless) {
+        // 換算經過的 tick，剩下的部分留在計數器裡維持 1 ms 相位
+        uint32_t total = start + elapsed;
+        uint32_t ticks = total / SCHED_TIMER_PER_TICK;
+
+        tim->ARR = SCHED_TIMER_PER_TICK - 1;
+        tim->CNT = total % SCHED_TIMER_PER_TICK;
+        tim->SR = ~TIM_SR_UIF;
+        HAL_NVIC_ClearPendingIRQ(TIM4_IRQn);
+
+        uwTick += ticks;
+        HAL_ResumeTick();
+
+        sched_sleep_us += elapsed;
+        if (ticks) {
+            sched_tick += ticks;
+            Scheduler_Release(sched_tick);
+        }
+    } else {
+        // 一般睡眠：tick 由即將執行的 TIM4 中斷處理
+        sched_sleep_us += elapsed;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  時基中斷：release 到期的週期任務（由 TIM4 更新中斷呼叫）
+ * @retval None
+ */
+void Scheduler_Tick(void)
+{
+    Scheduler_Release(++sched_tick);
+}
+
+/**
+ * @brief  release 到期的週期任務，並每秒更新一次 CPU 負載
+ * @param  tick: 目前 tick
+ * @retval None
+ */
+static void Scheduler_Release(uint32_t tick)
+{
+    for (uint8_t i = 0; i < sched_task_count; i++) {
+        Sched_Task_t *task = &sched_tasks[i];
+
+        if (!task->enabled || task->stats.period_ms == 0)
+            continue;
+
+        while ((int32_t)(tick - task->next_release) >= 0) {
+            if (task->pending) {
+                task->stats.overruns++;
+            } else {
+                task->release_tick = task->next_release;
+                task->pending = 1;
+            }
+            task->next_release += task->stats.period_ms;
+        }
+    }
+
+    uint32_t window = tick - sched_load_start;
+    if (window >= SCHED_TICK_HZ) {
+        uint32_t window_us = window * (1000000U / SCHED_TICK_HZ);
+        uint32_t sleep_us = (sched_sleep_us < window_us) ? sched_sleep_us : window_us;
+
+        sched_cpu_load = (uint16_t)(1000U - (uint32_t)(((uint64_t)sleep_us * 1000U) / window_us));
+        sched_sleep_us = 0;
+        sched_load_start = tick;
+    }
+}
+
+/**
+ * @brief  距離下一個週期任務 release 的 tick 數
+ * @retval tick 數，限制在 SCHED_TICKLESS_MAX_MS 以內；已經到期的任務回傳 0
+ */
+static uint32_t Scheduler_NextRelease(void)
+{
+    uint32_t gap = SCHED_TICKLESS_MAX_MS;
+
+    for (uint8_t i = 0; i < sched_task_count; i++) {
+        Sched_Task_t *task = &sched_tasks[i];
+
+        if (!task->enabled || task->stats.period_ms == 0)
+            continue;
+
+        int32_t remaining = (int32_t)(task->next_release - sched_tick);
+        if (remaining <= 0)
+            return 0;
+        if ((uint32_t)remaining < gap)
+            gap = remaining;
+    }
+
+    // TIM4 週期設成 gap 個 tick，更新事件正好落在 release 的那個 tick；
+    // 醒來後由 Scheduler_Idle 補上經過的 tick 並 release，不經過 Scheduler_Tick
+    return gap;
+}
+
+/**
+ * @brief  PendSV 中斷：清空延後處理佇列
+ * @retval None
+ */
+void Scheduler_PendSV(void)
+{
+    while (sched_defer_tail != sched_defer_head) {
+        Sched_Deferred_t item = sched_defer[sched_defer_tail];
+        sched_defer_tail = (sched_defer_tail + 1) & (SCHED_DEFER_QUEUE - 1);
+        item.fn(item.context);
+    }
+}
+
+uint32_t Scheduler_GetTick(void)
+{
+    return sched_tick;
+}
+
+uint8_t Scheduler_GetTaskCount(void)
+{
+    return sched_task_count;
+}
+
+// 最近一秒的 CPU 負載（清醒時間比例），單位 0.1%
+uint16_t Scheduler_GetCpuLoad(void)
+{
+    return sched_cpu_load;
+}
+
+HAL_StatusTypeDef Scheduler_GetStats(Sched_TaskId_t id, Sched_TaskStats_t *stats)
+{
+    if (id < 0 || id >= sched_task_count || stats == NULL)
+        return HAL_ERROR;
+
+    *stats = sched_tasks[id].stats;
+    return HAL_OK;
+}
+
+void Scheduler_ResetStats(void)
+{
+    for (uint8_t i = 0; i < sched_task_count; i++) {
+        Sched_TaskStats_t *stats = &sched_tasks[i].stats;
+        stats->runs = 0;
+        stats->last_cycles = 0;
+        stats->max_cycles = 0;
+        stats->total_cycles = 0;
+        stats->deadline_misses = 0;
+        stats->overruns = 0;
+    }
+}
+
+/**
+ * @brief  輸出每個任務的執行統計
+ * @retval None
+ */
+void Scheduler_PrintStats(void)
+{
+    uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+
+    printf("=== Scheduler (tick %lu, CPU %u.%u%%) ===\r\n", sched_tick,
+           sched_cpu_load / 10, sched_cpu_load % 10);
+    printf("Task       Pri Period  Runs     Avg(us) Max(us) Miss  Ovr\r\n");
+    for (uint8_t i = 0; i < sched_task_count; i++) {
+        Sched_TaskStats_t *s = &sched_tasks[i].stats;
+        uint32_t avg = s->runs ? (uint32_t)(s->total_cycles / s->runs) / cycles_per_us : 0;
+        printf("%-10s %3d %6lu %6lu %9lu %7lu %4lu %4lu\r\n",
+               s->name, s->priority, s->period_ms, s->runs,
+               avg, s->max_cycles / cycles_per_us, s->deadline_misses, s->overruns);
+    }
+    if (sched_defer_drops) {
+        printf("Deferred drops: %lu\r\n", sched_defer_drops);
+    }
+}
+
+static Sched_TaskId_t Scheduler_Add(const char *name, Sched_TaskFn_t fn, void *context,
+                                    Sched_Priority_t priority, uint32_t period_ms, uint32_t deadline_ms)
+{
+    if (fn == NULL || priority >= SCHED_PRIO_COUNT || sched_task_count >= SCHED_MAX_TASKS)
+        return SCHED_INVALID_TASK;
+
+    Sched_Task_t *task = &sched_tasks[sched_task_count];
+
+    memset(task, 0, sizeof(*task));
+    task->fn = fn;
+    task->context = context;
+    task->enabled = 1;
+    task->stats.name = name;
+    task->stats.priority = priority;
+    task->stats.period_ms = period_ms;
+    task->stats.deadline_ms = deadline_ms;
+
+    return (Sched_TaskId_t)sched_task_count++;
+}
@@ -0,0 +1,341 @@
+/*
+ * shell.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  USART6 指令列
+ *
+ *  Menu_Selection 原本只印出選單，沒有接收輸入，換模式或改門檻都要重新燒錄。
+ *  現在 USART6 RX 以環形 DMA 持續接收，HAL_UARTEx_ReceiveToIdle_DMA 在線路閒置、
+ *  半滿與全滿時呼叫 HAL_UARTEx_RxEventCallback，回呼只記下 DMA 寫到哪裡並觸發
+ *  shell 事件任務（SCHED_PRIO_LOW）。
+ *
+ *  事件任務每次最多處理 SHELL_BYTES_PER_RUN 個位元組、最多執行一行指令，
+ *  剩下的資料重新觸發自己，讓取樣等高優先權任務可以插隊，指令處理不會卡住取樣。
+ *  接收錯誤或鮑率切換（raw_stream）會讓 HAL 停止接收，任務結束前檢查並重新啟動。
+ *
+ *  指令表由呼叫端（main.c）提供，shell 只負責接收、行編輯與分割參數。
+ */
+#include "main.h"
+#include "usart.h"
+#include "shell.h"
+#include "scheduler.h"
+#include "uart_log.h"
+#include <stdio.h>
+#include <string.h>
+
+/* 私有變數 */
+static uint8_t shell_rx_buf[SHELL_RX_SIZE];
+static volatile uint16_t shell_rx_head = 0;     // DMA 已寫到的位置（RX 事件回呼）
+static uint16_t shell_rx_tail = 0;              // 已處理到的位置（shell 任務）
+static char shell_line[SHELL_LINE_MAX + 1];
+static uint8_t shell_line_len = 0;
+static uint8_t shell_line_overflow = 0;
+static uint8_t shell_last_cr = 0;
+static const Shell_Command_t *shell_commands = NULL;
+static uint8_t shell_command_count = 0;
+static Sched_TaskId_t shell_task = SCHED_INVALID_TASK;
+static Shell_Stats_t shell_stats;
+
+/* 私有函數 */
+static void Shell_Task(void *context);
+static uint8_t Shell_Feed(uint8_t c);
+static void Shell_Execute(void);
+static void Shell_StartReception(void);
+static void Shell_Echo(const char *text, uint32_t len);
+
+/**
+ * @brief  初始化 shell：建立事件任務並啟動 USART6 RX DMA
+ * @param  commands: 指令表（必須一直有效）
+ * @param  count: 指令數
+ * @retval HAL狀態
+ * @note   必須在 Scheduler_Init 之後呼叫
+ */
+HAL_StatusTypeDef Shell_Init(const Shell_Command_t *commands, uint8_t count)
+{
+    if (commands == NULL || count == 0)
+        return HAL_ERROR;
+
+    shell_commands = commands;
+    shell_command_count = count;
+    shell_line_len = 0;
+    memset(&shell_stats, 0, sizeof(shell_stats));
+
+    shell_task = Scheduler_AddEvent("shell", Shell_Task, NULL, SCHED_PRIO_LOW, 50);
+    if (shell_task == SCHED_INVALID_TASK)
+        return HAL_ERROR;
+
+    Shell_StartReception();
+    return (huart6.RxState == HAL_UART_STATE_BUSY_RX) ? HAL_OK : HAL_ERROR;
+}
+
+/**
+ * @brief  印出所有指令的用法
+ * @retval None
+ */
+void Shell_PrintHelp(void)
+{
+    printf("指令:\r\n");
+    for (uint8_t i = 0; i < shell_command_count; i++) {
+        printf("  %-8s %s\r\n", shell_commands[i].name, shell_commands[i].usage);
+    }
+}
+
+void Shell_GetStats(Shell_Stats_t *stats)
+{
+    if (stats == NULL)
+        return;
+
+    *stats = shell_stats;
+}
+
+/**
+ * @brief  解析十進位無號整數
+ * @param  text: 字串
+ * @param  value: 輸出
+ * @retval 1 = 成功，0 = 格式錯誤或溢位
+ */
+uint8_t Shell_ParseUInt(const char *text, uint32_t *value)
+{
+    uint32_t result = 0;
+
+    if (text == NULL || *text == '\0')
+        return 0;
+
+    for (; *text; text++) {
+        if (*text < '0' || *text > '9')
+            return 0;
+        uint32_t digit = (uint32_t)(*text - '0');
+        if (result > (UINT32_MAX - digit) / 10)
+            return 0;
+        result = result * 10 + digit;
+    }
+
+    *value = result;
+    return 1;
+}
+
+/**
+ * @brief  解析 [+-]整數[.小數]，不使用 strtof（會連結 newlib 的大數運算與 malloc）
+ * @param  text: 字串
+ * @param  value: 輸出
+ * @retval 1 = 成功，0 = 格式錯誤
+ */
+uint8_t Shell_ParseFloat(const char *text, float *value)
+{
+    float result = 0.0f;
+    float scale = 1.0f;
+    uint8_t negative = 0;
+    uint8_t digits = 0;
+    uint8_t fraction = 0;
+
+    if (text == NULL)
+        return 0;
+
+    if (*text == '-' || *text == '+') {
+        negative = (*text == '-');
+        text++;
+    }
+
+    for (; *text; text++) {
+        if (*text == '.' && !fraction) {
+            fraction = 1;
+        } else if (*text >= '0' && *text <= '9') {
+            if (fraction) {
+                scale *= 0.1f;
+                result += (float)(*text - '0') * scale;
+            } else {
+                result = result * 10.0f + (float)(*text - '0');
+            }
+            digits++;
+        } else {
+            return 0;
+        }
+    }
+
+    if (digits == 0)
+        return 0;
+
+    *value = negative ? -result : result;
+    return 1;
+}
+
+/**
+ * @brief  shell 事件任務：處理 DMA 已收到的資料，一次最多執行一行
+ * @param  context: 未使用
+ * @retval None
+ */
+static void Shell_Task(void *context)
+{
+    (void)context;
+
+    uint16_t head = shell_rx_head;
+    uint32_t budget = SHELL_BYTES_PER_RUN;
+
+    while (shell_rx_tail != head && budget > 0) {
+        uint8_t c = shell_rx_buf[shell_rx_tail];
+        shell_rx_tail = (shell_rx_tail + 1) % SHELL_RX_SIZE;
+        shell_stats.bytes++;
+        budget--;
+
+        if (Shell_Feed(c)) {
+            Shell_Execute();
+            break;
+        }
+    }
+
+    // 還有資料沒處理，讓出 CPU 後再回來
+    if (shell_rx_tail != shell_rx_head)
+        Scheduler_Signal(shell_task);
+
+    // 接收錯誤或指令切換鮑率後 HAL 已停止接收
+    if (huart6.RxState != HAL_UART_STATE_BUSY_RX) {
+        shell_stats.restarts++;
+        Shell_StartReception();
+    }
+}
+
+/**
+ * @brief  行編輯：加入一個字元
+ * @param  c: 收到的字元
+ * @retval 1 = 一行結束，可以執行
+ */
+static uint8_t Shell_Feed(uint8_t c)
+{
+    // \r\n 只算一次換行
+    if (c == '\n' && shell_last_cr) {
+        shell_last_cr = 0;
+        return 0;
+    }
+    shell_last_cr = (c == '\r');
+
+    if (c == '\r' || c == '\n') {
+        Shell_Echo("\r\n", 2);
+        if (shell_line_overflow) {
+            shell_line_overflow = 0;
+            shell_line_len = 0;
+            shell_stats.overflows++;
+            printf("ERR line too long\r\n");
+            return 0;
+        }
+        shell_line[shell_line_len] = '\0';
+        return 1;
+    }
+
+    // Backspace / DEL
+    if (c == '\b' || c == 0x7F) {
+        if (shell_line_len > 0) {
+            shell_line_len--;
+            Shell_Echo("\b \b", 3);
+        }
+        return 0;
+    }
+
+    if (c < ' ' || c > '~')
+        return 0;
+
+    if (shell_line_len >= SHELL_LINE_MAX) {
+        shell_line_overflow = 1;
+        return 0;
+    }
+
+    shell_line[shell_line_len++] = (char)c;
+    Shell_Echo((const char *)&c, 1);
+    return 0;
+}
+
+/**
+ * @brief  分割參數並執行指令
+ * @retval None
+ */
+static void Shell_Execute(void)
+{
+    char *argv[SHELL_MAX_ARGS];
+    int argc = 0;
+    char *p = shell_line;
+
+    shell_line_len = 0;
+
+    while (*p && argc < SHELL_MAX_ARGS) {
+        while (*p == ' ' || *p == '\t')
+            *p++ = '\0';
+        if (*p == '\0')
+            break;
+        argv[argc++] = p;
+        while (*p && *p != ' ' && *p != '\t')
+            p++;
+    }
+
+    if (argc == 0)
+        return;
+
+    shell_stats.lines++;
+
+    for (uint8_t i = 0; i < shell_command_count; i++) {
+        const Shell_Command_t *cmd = &shell_commands[i];
+        if (strcmp(argv[0], cmd->name) != 0)
+            continue;
+
+        if (cmd->handler(argc, argv) != HAL_OK)
+            printf("ERR usage: %s %s\r\n", cmd->name, cmd->usage);
+        return;
+    }
+
+    shell_stats.unknown++;
+    printf("ERR unknown command '%s', try help\r\n", argv[0]);
+}
+
+/**
+ * @brief  (重新)啟動環形 DMA 接收，已收到但未處理的資料捨棄
+ * @retval None
+ */
+static void Shell_StartReception(void)
+{
+    HAL_UART_AbortReceive(DEBUG_UART_PORT);
+
+    shell_rx_head = 0;
+    shell_rx_tail = 0;
+    shell_line_len = 0;
+    shell_line_overflow = 0;
+
+    HAL_UARTEx_ReceiveToIdle_DMA(DEBUG_UART_PORT, shell_rx_buf, SHELL_RX_SIZE);
+}
+
+// 回顯輸入（終端機沒有本地回顯）
+static void Shell_Echo(const char *text, uint32_t len)
+{
+    UartLog_Write((const uint8_t *)text, len);
+}
+
+/**
+ * @brief  UART 接收事件（IDLE / DMA 全滿）回呼：記下 DMA 位置並觸發 shell 任務
+ * @param  huart: UART handle
+ * @param  Size: 環形模式下為 DMA 在緩衝區中的位置
+ * @retval None
+ */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+    if (huart != DEBUG_UART_PORT)
+        return;
+
+    shell_rx_head = Size % SHELL_RX_SIZE;
+    Scheduler_Signal(shell_task);
+}
+
+/**
+ * @brief  UART 錯誤回呼：DMA 模式下任何接收錯誤都會中止接收，交給 shell 任務重新啟動
+ * @param  huart: UART handle
+ * @retval None
+ */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    if (huart != DEBUG_UART_PORT)
+        return;
+
+    if (huart->ErrorCode & (HAL_UART_ERROR_PE | HAL_UART_ERROR_NE |
+                            HAL_UART_ERROR_FE | HAL_UART_ERROR_ORE)) {
+        shell_stats.rx_errors++;
+    }
+    Scheduler_Signal(shell_task);
+}
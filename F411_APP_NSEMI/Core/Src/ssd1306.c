@@ -1,21 +1,54 @@
 #include "ssd1306.h"
-#include <math.h>
 #include <stdlib.h>
 #include <string.h>  // For memcpy
 
+#if defined(SSD1306_USE_DMA) && !defined(SSD1306_USE_I2C)
+#error "SSD1306_USE_DMA is only supported with SSD1306_USE_I2C"
+#endif
+
+#if defined(SSD1306_DOUBLE_BUFFER) && !defined(SSD1306_USE_DMA)
+#error "SSD1306_DOUBLE_BUFFER needs SSD1306_USE_DMA"
+#endif
+
 #if defined(SSD1306_USE_I2C)
 
+#if defined(SSD1306_USE_DMA)
+// Flush state, advanced by the I2C completion interrupt
+typedef enum {
+    SSD1306_FLUSH_IDLE = 0,
+    SSD1306_FLUSH_WINDOW,   // Sending the address window commands
+    SSD1306_FLUSH_DATA      // Sending the span data
+} SSD1306_FlushState_t;
+
+static volatile SSD1306_FlushState_t SSD1306_FlushState = SSD1306_FLUSH_IDLE;
+static volatile uint8_t SSD1306_FlushPending = 0;  // A frame waits for the flush in progress
+
+// Blocking transfers must not collide with a DMA flush in progress
+static void ssd1306_WaitFlush(void) {
+    uint32_t start = HAL_GetTick();
+    while (SSD1306_FlushState != SSD1306_FLUSH_IDLE &&
+           (HAL_GetTick() - start) < SSD1306_FLUSH_TIMEOUT) {
+    }
+}
+#endif // SSD1306_USE_DMA
+
 void ssd1306_Reset(void) {
     /* for I2C - do nothing */
 }
 
 // Send a byte to the command register
 void ssd1306_WriteCommand(uint8_t byte) {
+#if defined(SSD1306_USE_DMA)
+    ssd1306_WaitFlush();
+#endif
     HAL_I2C_Mem_Write(&SSD1306_I2C_PORT, SSD1306_I2C_ADDR, 0x00, 1, &byte, 1, HAL_MAX_DELAY);
 }
 
 // Send data
 void ssd1306_WriteData(uint8_t* buffer, size_t buff_size) {
+#if defined(SSD1306_USE_DMA)
+    ssd1306_WaitFlush();
+#endif
     HAL_I2C_Mem_Write(&SSD1306_I2C_PORT, SSD1306_I2C_ADDR, 0x40, 1, buffer, buff_size, HAL_MAX_DELAY);
 }
 
@@ -53,17 +86,68 @@ void ssd1306_WriteData(uint8_t* buffer, size_t buff_size) {
 #endif
 
 
-// Screenbuffer
-static uint8_t SSD1306_Buffer[SSD1306_BUFFER_SIZE];
+// Screenbuffer, word aligned for the 32-bit stores of ssd1306_FillSpan
+static uint8_t SSD1306_Buffer[SSD1306_BUFFER_SIZE] __attribute__((aligned(4)));
+
+// Word access to the byte buffers
+typedef uint32_t __attribute__((__may_alias__)) ssd1306_word_t;
+
+#define SSD1306_PAGES   (SSD1306_HEIGHT / 8)
+#define SSD1306_CLEAN   0xFF    // First column of a clean page (first > last)
+
+// What the panel RAM holds. Updates send only bytes that differ from it, and
+// spans go out from here so drawing during a DMA flush cannot tear a span.
+static uint8_t SSD1306_Sent[SSD1306_BUFFER_SIZE];
+static uint8_t SSD1306_SentValid = 0;   // 0: panel content unknown, send everything
+
+// Columns changed by the drawing primitives since the last update, per page
+static uint8_t SSD1306_DirtyFirst[SSD1306_PAGES];
+static uint8_t SSD1306_DirtyLast[SSD1306_PAGES];
+
+// Part of the panel sent as one window: columns x1..x2 of pages page..page_last
+typedef struct {
+    uint8_t page;
+    uint8_t page_last;
+    uint8_t x1;
+    uint8_t x2;
+} SSD1306_Span_t;
+
+// Mark columns x1..x2 of pages page1..page2 as changed
+static inline void ssd1306_MarkDirty(uint8_t page1, uint8_t page2, uint8_t x1, uint8_t x2) {
+    for (uint8_t page = page1; page <= page2; page++) {
+        if (x1 < SSD1306_DirtyFirst[page]) {
+            SSD1306_DirtyFirst[page] = x1;
+        }
+        if (x2 > SSD1306_DirtyLast[page]) {
+            SSD1306_DirtyLast[page] = x2;
+        }
+    }
+}
+
+static void ssd1306_ClearDirty(void) {
+    memset(SSD1306_DirtyFirst, SSD1306_CLEAN, sizeof(SSD1306_DirtyFirst));
+    memset(SSD1306_DirtyLast, 0, sizeof(SSD1306_DirtyLast));
+}
 
 // Screen object
 static SSD1306_t SSD1306;
 
+// Frame pacing and statistics
+static uint16_t SSD1306_FrameRate = 0;      // 0: no pacing
+static uint32_t SSD1306_FrameBase;          // Tick of the first frame of the current second
+static uint16_t SSD1306_FrameIndex;         // Frame slots started since SSD1306_FrameBase
+static uint32_t SSD1306_FrameDeadline;      // End of the slot of the frame being rendered
+static uint32_t SSD1306_FpsTick;            // Start of the FPS measurement window
+static uint32_t SSD1306_FpsShown;
+static SSD1306_FrameStats_t SSD1306_FrameStats;
+static volatile uint32_t SSD1306_FramesShown = 0;   // Counted when a flush completes
+
 /* Fills the Screenbuffer with values from a given buffer of a fixed length */
 SSD1306_Error_t ssd1306_FillBuffer(uint8_t* buf, uint32_t len) {
     SSD1306_Error_t ret = SSD1306_ERR;
     if (len <= SSD1306_BUFFER_SIZE) {
         memcpy(SSD1306_Buffer,buf,len);
+        ssd1306_MarkDirty(0, SSD1306_PAGES - 1, 0, SSD1306_WIDTH - 1);
         ret = SSD1306_OK;
     }
     return ret;
@@ -158,6 +242,9 @@ void ssd1306_Init(void) {
     ssd1306_WriteCommand(0x14); //
     ssd1306_SetDisplayOn(1); //--turn on SSD1306 panel
 
+    // Panel RAM content is unknown after power up, the first update sends it all
+    SSD1306_SentValid = 0;
+
     // Clear screen
     ssd1306_Fill(Black);
     
@@ -171,25 +258,390 @@ void ssd1306_Init(void) {
     SSD1306.Initialized = 1;
 }
 
+/*
+ * Set (White) or clear (Black) the mask bits in count consecutive buffer bytes.
+ * The aligned middle part goes 4 bytes per access; a full mask is a plain store.
+ */
+static void ssd1306_FillSpan(uint8_t *dst, uint16_t count, uint8_t mask, SSD1306_COLOR color) {
+    const uint8_t value = (color == White) ? mask : 0x00;
+    const uint32_t mask32 = mask * 0x01010101UL;
+    const uint32_t value32 = value * 0x01010101UL;
+
+    // Bytes up to the first word boundary
+    while (count > 0 && ((uintptr_t)dst & 3)) {
+        *dst = (*dst & ~mask) | value;
+        dst++;
+        count--;
+    }
+
+    ssd1306_word_t *word = (ssd1306_word_t *)dst;
+    if (mask == 0xFF) {
+        for (; count >= 4; count -= 4) {
+            *word++ = value32;
+        }
+    } else {
+        for (; count >= 4; count -= 4, word++) {
+            *word = (*word & ~mask32) | value32;
+        }
+    }
+
+    dst = (uint8_t *)word;
+    while (count-- > 0) {
+        *dst = (*dst & ~mask) | value;
+        dst++;
+    }
+}
+
 /* Fill the whole screen with the given color */
 void ssd1306_Fill(SSD1306_COLOR color) {
-    memset(SSD1306_Buffer, (color == Black) ? 0x00 : 0xFF, sizeof(SSD1306_Buffer));
+    // newlib-nano memset stores a byte at a time
+    ssd1306_FillSpan(SSD1306_Buffer, sizeof(SSD1306_Buffer), 0xFF, color);
+    ssd1306_MarkDirty(0, SSD1306_PAGES - 1, 0, SSD1306_WIDTH - 1);
+}
+
+/*
+ * Narrow each page's range to the bytes of frame that differ from the panel
+ * and copy them to SSD1306_Sent. The ranges are rewritten in place.
+ * After a bus error every page goes out whole, whatever the ranges say.
+ */
+static void ssd1306_TakeSpans(const uint8_t *frame, uint8_t *first, uint8_t *last) {
+    for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+        const uint8_t *src = &frame[page * SSD1306_WIDTH];
+        uint8_t *dst = &SSD1306_Sent[page * SSD1306_WIDTH];
+        uint8_t x1 = first[page];
+        uint8_t x2 = last[page];
+
+        if (SSD1306_SentValid) {
+            while (x1 <= x2 && src[x1] == dst[x1]) {
+                x1++;
+            }
+            while (x2 > x1 && src[x2] == dst[x2]) {
+                x2--;
+            }
+        } else {
+            x1 = 0;
+            x2 = SSD1306_WIDTH - 1;
+        }
+
+        if (x1 <= x2) {
+            memcpy(&dst[x1], &src[x1], x2 - x1 + 1);
+            first[page] = x1;
+            last[page] = x2;
+        } else {
+            first[page] = SSD1306_CLEAN;
+            last[page] = 0;
+        }
+    }
+    SSD1306_SentValid = 1;
+}
+
+/*
+ * Next span to send, searching from page *next. Full width spans on
+ * consecutive pages are contiguous in SSD1306_Sent and go out as one.
+ */
+static uint8_t ssd1306_NextSpan(const uint8_t *first, const uint8_t *last, uint8_t *next, SSD1306_Span_t *span) {
+    uint8_t page = *next;
+    while (page < SSD1306_PAGES && first[page] > last[page]) {
+        page++;
+    }
+    if (page >= SSD1306_PAGES) {
+        *next = page;
+        return 0;
+    }
+
+    span->page = page;
+    span->page_last = page;
+    span->x1 = first[page];
+    span->x2 = last[page];
+    if (span->x1 == 0 && span->x2 == SSD1306_WIDTH - 1) {
+        while (span->page_last + 1 < SSD1306_PAGES &&
+               first[span->page_last + 1] == 0 && last[span->page_last + 1] == SSD1306_WIDTH - 1) {
+            span->page_last++;
+        }
+    }
+    *next = span->page_last + 1;
+    return 1;
+}
+
+// Count a presented frame; late when its pacing slot is already over
+static void ssd1306_FramePresented(void) {
+    SSD1306_FrameStats.presented++;
+    if (SSD1306_FrameRate != 0 && (int32_t)(HAL_GetTick() - SSD1306_FrameDeadline) > 0) {
+        SSD1306_FrameStats.late++;
+    }
+}
+
+#if defined(SSD1306_USE_DMA)
+
+// Horizontal addressing window of the span being sent
+static uint8_t SSD1306_WindowCmd[6];
+
+// Ranges requested by ssd1306_UpdateScreen and not yet taken
+static uint8_t SSD1306_QueuedFirst[SSD1306_PAGES];
+static uint8_t SSD1306_QueuedLast[SSD1306_PAGES];
+
+#if defined(SSD1306_DOUBLE_BUFFER)
+// Frame handed to the flush: drawing goes on in SSD1306_Buffer meanwhile.
+// Owned by the interrupt while SSD1306_FlushPending is set, by the caller otherwise.
+static uint8_t SSD1306_Frame[SSD1306_BUFFER_SIZE];
+#define SSD1306_FLUSH_FRAME     SSD1306_Frame
+#else
+#define SSD1306_FLUSH_FRAME     SSD1306_Buffer
+#endif
+
+// Spans of the flush in progress
+static uint8_t SSD1306_FlushFirst[SSD1306_PAGES];
+static uint8_t SSD1306_FlushLast[SSD1306_PAGES];
+static uint8_t SSD1306_FlushNext;
+static uint8_t *SSD1306_FlushData;
+static uint16_t SSD1306_FlushLen;
+
+static void ssd1306_StartFlush(void);
+
+/* Flush finished (interrupt context), override in the application */
+__weak void ssd1306_FlushCpltCallback(void) {
+}
+
+// Drop the flush; the panel content is unknown, so the next one is a full frame
+static void ssd1306_FlushError(void) {
+    SSD1306_SentValid = 0;
+    if (SSD1306_FlushPending) {
+        SSD1306_FlushPending = 0;
+        ssd1306_StartFlush();
+        return;
+    }
+    SSD1306_FlushState = SSD1306_FLUSH_IDLE;
+}
+
+// Send the window of the next span, or finish the flush
+static void ssd1306_SendSpan(void) {
+    SSD1306_Span_t span;
+
+    if (!ssd1306_NextSpan(SSD1306_FlushFirst, SSD1306_FlushLast, &SSD1306_FlushNext, &span)) {
+        if (SSD1306_FlushPending) {
+            SSD1306_FlushPending = 0;
+            ssd1306_StartFlush();
+            return;
+        }
+        SSD1306_FlushState = SSD1306_FLUSH_IDLE;
+        SSD1306_FramesShown++;
+        ssd1306_FlushCpltCallback();
+        return;
+    }
+
+    SSD1306_WindowCmd[0] = 0x21;                    // Set column address
+    SSD1306_WindowCmd[1] = SSD1306_X_START + span.x1;
+    SSD1306_WindowCmd[2] = SSD1306_X_START + span.x2;
+    SSD1306_WindowCmd[3] = 0x22;                    // Set page address
+    SSD1306_WindowCmd[4] = span.page;
+    SSD1306_WindowCmd[5] = span.page_last;
+    SSD1306_FlushData = &SSD1306_Sent[span.page * SSD1306_WIDTH + span.x1];
+    SSD1306_FlushLen = (uint16_t)(span.x2 - span.x1 + 1) * (span.page_last - span.page + 1);
+
+    SSD1306_FlushState = SSD1306_FLUSH_WINDOW;
+    if (HAL_I2C_Mem_Write_DMA(&SSD1306_I2C_PORT, SSD1306_I2C_ADDR, 0x00, 1,
+                              SSD1306_WindowCmd, sizeof(SSD1306_WindowCmd)) != HAL_OK) {
+        ssd1306_FlushError();
+    }
 }
 
-/* Write the screenbuffer with changed to the screen */
+// Take the queued ranges and send the first span (flush owned by the caller)
+static void ssd1306_StartFlush(void) {
+    memcpy(SSD1306_FlushFirst, SSD1306_QueuedFirst, SSD1306_PAGES);
+    memcpy(SSD1306_FlushLast, SSD1306_QueuedLast, SSD1306_PAGES);
+    memset(SSD1306_QueuedFirst, SSD1306_CLEAN, SSD1306_PAGES);
+    memset(SSD1306_QueuedLast, 0, SSD1306_PAGES);
+
+    ssd1306_TakeSpans(SSD1306_FLUSH_FRAME, SSD1306_FlushFirst, SSD1306_FlushLast);
+    SSD1306_FlushNext = 0;
+    ssd1306_SendSpan();
+}
+
+// Add the dirty ranges to the queued ones
+static void ssd1306_QueueDirty(void) {
+    for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+        if (SSD1306_DirtyFirst[page] < SSD1306_QueuedFirst[page]) {
+            SSD1306_QueuedFirst[page] = SSD1306_DirtyFirst[page];
+        }
+        if (SSD1306_DirtyLast[page] > SSD1306_QueuedLast[page]) {
+            SSD1306_QueuedLast[page] = SSD1306_DirtyLast[page];
+        }
+    }
+}
+
+/*
+ * Start sending the changed parts of the screenbuffer and return at once.
+ * Each span is a window command and its data, chained by DMA interrupts;
+ * ssd1306_FlushCpltCallback() runs when the last one is done (directly from
+ * here when nothing changed). A call during a flush is sent right after it;
+ * a newer call before that replaces it (counted as skipped).
+ *
+ * SSD1306_DOUBLE_BUFFER: the changed bytes are copied to a second buffer
+ * that the flush reads, so drawing the next frame can start right away.
+ * Otherwise a frame queued during a flush is read from the screenbuffer
+ * when the flush ends, and drawing in the meantime can show up half done.
+ */
 void ssd1306_UpdateScreen(void) {
-    // Write data to each page of RAM. Number of pages
-    // depends on the screen height:
-    //
-    //  * 32px   ==  4 pages
-    //  * 64px   ==  8 pages
-    //  * 128px  ==  16 pages
-    for(uint8_t i = 0; i < SSD1306_HEIGHT/8; i++) {
-        ssd1306_WriteCommand(0xB0 + i); // Set the current RAM page address.
-        ssd1306_WriteCommand(0x00 + SSD1306_X_OFFSET_LOWER);
-        ssd1306_WriteCommand(0x10 + SSD1306_X_OFFSET_UPPER);
-        ssd1306_WriteData(&SSD1306_Buffer[SSD1306_WIDTH*i],SSD1306_WIDTH);
+    uint32_t primask = __get_PRIMASK();
+
+    ssd1306_FramePresented();
+
+#if defined(SSD1306_DOUBLE_BUFFER)
+    // Take the frame buffer back from the interrupt, a frame still waiting in it is replaced
+    __disable_irq();
+    if (SSD1306_FlushPending) {
+        SSD1306_FlushPending = 0;
+        SSD1306_FrameStats.skipped++;
     }
+    __set_PRIMASK(primask);
+
+    ssd1306_QueueDirty();
+    for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+        const uint8_t x1 = SSD1306_DirtyFirst[page];
+        const uint8_t x2 = SSD1306_DirtyLast[page];
+        if (x1 <= x2) {
+            memcpy(&SSD1306_Frame[page * SSD1306_WIDTH + x1], &SSD1306_Buffer[page * SSD1306_WIDTH + x1], x2 - x1 + 1);
+        }
+    }
+    ssd1306_ClearDirty();
+
+    __disable_irq();
+    if (SSD1306_FlushState != SSD1306_FLUSH_IDLE) {
+        SSD1306_FlushPending = 1;
+        __set_PRIMASK(primask);
+        return;
+    }
+    SSD1306_FlushState = SSD1306_FLUSH_WINDOW;
+    __set_PRIMASK(primask);
+
+    ssd1306_StartFlush();
+#else
+    __disable_irq();
+    ssd1306_QueueDirty();
+    if (SSD1306_FlushState != SSD1306_FLUSH_IDLE) {
+        if (SSD1306_FlushPending) {
+            SSD1306_FrameStats.skipped++;
+        }
+        SSD1306_FlushPending = 1;
+        __set_PRIMASK(primask);
+        ssd1306_ClearDirty();
+        return;
+    }
+    SSD1306_FlushState = SSD1306_FLUSH_WINDOW;
+    __set_PRIMASK(primask);
+
+    ssd1306_ClearDirty();
+    ssd1306_StartFlush();
+#endif
+}
+
+uint8_t ssd1306_IsFlushing(void) {
+    return SSD1306_FlushState != SSD1306_FLUSH_IDLE;
+}
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    if (hi2c != &SSD1306_I2C_PORT) {
+        return;
+    }
+
+    if (SSD1306_FlushState == SSD1306_FLUSH_WINDOW) {
+        SSD1306_FlushState = SSD1306_FLUSH_DATA;
+        if (HAL_I2C_Mem_Write_DMA(&SSD1306_I2C_PORT, SSD1306_I2C_ADDR, 0x40, 1,
+                                  SSD1306_FlushData, SSD1306_FlushLen) != HAL_OK) {
+            ssd1306_FlushError();
+        }
+        return;
+    }
+
+    ssd1306_SendSpan();
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
+    if (hi2c != &SSD1306_I2C_PORT) {
+        return;
+    }
+
+    ssd1306_FlushError();
+}
+
+#else
+
+/* Write the changed parts of the screenbuffer to the screen */
+void ssd1306_UpdateScreen(void) {
+    SSD1306_Span_t span;
+    uint8_t next = 0;
+
+    ssd1306_FramePresented();
+    ssd1306_TakeSpans(SSD1306_Buffer, SSD1306_DirtyFirst, SSD1306_DirtyLast);
+    while (ssd1306_NextSpan(SSD1306_DirtyFirst, SSD1306_DirtyLast, &next, &span)) {
+        ssd1306_WriteCommand(0x21); // Set column address
+        ssd1306_WriteCommand(SSD1306_X_START + span.x1);
+        ssd1306_WriteCommand(SSD1306_X_START + span.x2);
+        ssd1306_WriteCommand(0x22); // Set page address
+        ssd1306_WriteCommand(span.page);
+        ssd1306_WriteCommand(span.page_last);
+        ssd1306_WriteData(&SSD1306_Sent[span.page * SSD1306_WIDTH + span.x1],
+                          (size_t)(span.x2 - span.x1 + 1) * (span.page_last - span.page + 1));
+    }
+    ssd1306_ClearDirty();
+    SSD1306_FramesShown++;
+}
+
+#endif // SSD1306_USE_DMA
+
+/*
+ * Frame pacing: render a frame when ssd1306_FrameDue() returns 1, then call
+ * ssd1306_UpdateScreen(). A frame presented after the end of its slot is late.
+ * fps => target frame rate, 0 turns pacing off (every call is due)
+ */
+void ssd1306_SetFrameRate(uint16_t fps) {
+    SSD1306_FrameRate = (fps > 1000) ? 1000 : fps;
+    SSD1306_FrameBase = HAL_GetTick();
+    SSD1306_FrameIndex = 0;
+    SSD1306_FrameDeadline = SSD1306_FrameBase;
+}
+
+uint8_t ssd1306_FrameDue(void) {
+    if (SSD1306_FrameRate == 0) {
+        return 1;
+    }
+
+    const uint32_t now = HAL_GetTick();
+    if ((int32_t)(now - (SSD1306_FrameBase + SSD1306_FrameIndex * 1000UL / SSD1306_FrameRate)) < 0) {
+        return 0;
+    }
+
+    // Start the next slot; slots are whole milliseconds, the rounding evens out over a second
+    if (++SSD1306_FrameIndex == SSD1306_FrameRate) {
+        SSD1306_FrameBase += 1000;
+        SSD1306_FrameIndex = 0;
+    }
+    SSD1306_FrameDeadline = SSD1306_FrameBase + SSD1306_FrameIndex * 1000UL / SSD1306_FrameRate;
+
+    // More than a slot behind: start over from now instead of rendering a burst
+    if ((int32_t)(now - SSD1306_FrameDeadline) >= 0) {
+        SSD1306_FrameBase = now;
+        SSD1306_FrameIndex = 1;
+        SSD1306_FrameDeadline = now + 1000UL / SSD1306_FrameRate;
+    }
+    return 1;
+}
+
+void ssd1306_GetFrameStats(SSD1306_FrameStats_t *stats) {
+    const uint32_t now = HAL_GetTick();
+    const uint32_t shown = SSD1306_FramesShown;
+    const uint32_t elapsed = now - SSD1306_FpsTick;
+
+    // Achieved rate over at least one second since the last measurement
+    if (elapsed >= 1000) {
+        SSD1306_FrameStats.fps_x10 = (uint16_t)((uint64_t)(shown - SSD1306_FpsShown) * 10000U / elapsed);
+        SSD1306_FpsTick = now;
+        SSD1306_FpsShown = shown;
+    }
+
+    *stats = SSD1306_FrameStats;
+    stats->shown = shown;
+    stats->target_fps = SSD1306_FrameRate;
 }
 
 /*
@@ -210,6 +662,7 @@ void ssd1306_DrawPixel(uint8_t x, uint8_t y, SSD1306_COLOR color) {
     } else { 
         SSD1306_Buffer[x + (y / 8) * SSD1306_WIDTH] &= ~(1 << (y % 8));
     }
+    ssd1306_MarkDirty(y / 8, y / 8, x, x);
 }
 
 /*
@@ -268,6 +721,481 @@ char ssd1306_WriteString(char* str, SSD1306_Font_t Font, SSD1306_COLOR color) {
     return *str;
 }
 
+/*
+ * Copy a glyph in page layout to the cursor position, shifted into one or two
+ * buffer pages with a mask. Background pixels are drawn as well.
+ * The caller checks that the glyph fits.
+ */
+static void ssd1306_BlitGlyph(const uint8_t *glyph, uint8_t stride, uint8_t width,
+                              uint8_t height, uint8_t pages, SSD1306_COLOR color) {
+    const uint8_t shift = SSD1306.CurrentY % 8;
+    const uint8_t invert = (color == White) ? 0x00 : 0xFF;
+    uint8_t *dst = &SSD1306_Buffer[(SSD1306.CurrentY / 8) * SSD1306_WIDTH + SSD1306.CurrentX];
+
+    for (uint8_t p = 0; p < pages; p++, glyph += stride, dst += SSD1306_WIDTH) {
+        // Glyph rows in this page, the last one may be partial
+        const uint8_t rows = height - p * 8;
+        const uint8_t bits = (rows >= 8) ? 0xFF : (uint8_t)((1U << rows) - 1);
+        const uint16_t mask = (uint16_t)bits << shift;
+
+        if (mask >> 8) {
+            // Straddles two buffer pages
+            uint8_t *next = dst + SSD1306_WIDTH;
+            for (uint8_t x = 0; x < width; x++) {
+                const uint16_t v = (uint16_t)((glyph[x] ^ invert) & bits) << shift;
+                dst[x] = (dst[x] & ~(uint8_t)mask) | (uint8_t)v;
+                next[x] = (next[x] & ~(uint8_t)(mask >> 8)) | (uint8_t)(v >> 8);
+            }
+        } else {
+            for (uint8_t x = 0; x < width; x++) {
+                dst[x] = (dst[x] & ~(uint8_t)mask) | (uint8_t)(((glyph[x] ^ invert) & bits) << shift);
+            }
+        }
+    }
+
+    ssd1306_MarkDirty(SSD1306.CurrentY / 8, (SSD1306.CurrentY + height - 1) / 8,
+                      SSD1306.CurrentX, SSD1306.CurrentX + width - 1);
+}
+
+/*
+ * Draw 1 char from a paged font to the screen buffer
+ * Same result as ssd1306_WriteChar, a byte at a time instead of pixel by pixel.
+ */
+char ssd1306_WriteCharPaged(char ch, SSD1306_PagedFont_t Font, SSD1306_COLOR color) {
+    // Check if character is valid
+    if (ch < 32 || ch > 126)
+        return 0;
+
+    // Char width is not equal to font width for proportional font
+    const uint8_t char_width = Font.char_width ? Font.char_width[ch-32] : Font.width;
+    // Check remaining space on current line
+    if (SSD1306_WIDTH < (SSD1306.CurrentX + char_width) ||
+        SSD1306_HEIGHT < (SSD1306.CurrentY + Font.height))
+    {
+        // Not enough space on current line
+        return 0;
+    }
+
+    ssd1306_BlitGlyph(&Font.data[(ch - 32) * Font.pages * Font.width], Font.width, char_width,
+                      Font.height, Font.pages, color);
+
+    // The current space is now taken
+    SSD1306.CurrentX += char_width;
+
+    // Return written char for validation
+    return ch;
+}
+
+/* Write full string to screenbuffer with a paged font */
+char ssd1306_WriteStringPaged(char* str, SSD1306_PagedFont_t Font, SSD1306_COLOR color) {
+    while (*str) {
+        if (ssd1306_WriteCharPaged(*str, Font, color) != *str) {
+            // Char could not be written
+            return *str;
+        }
+        str++;
+    }
+
+    // Everything ok
+    return *str;
+}
+
+#if SSD1306_GLYPH_CACHE_SIZE > 0
+// Decoded glyphs of run-length encoded fonts
+typedef struct {
+    const SSD1306_GlyphFont_t *font;    // NULL: free slot
+    uint16_t index;
+    uint8_t data[SSD1306_GLYPH_CACHE_BYTES];
+} SSD1306_GlyphCache_t;
+
+static SSD1306_GlyphCache_t SSD1306_GlyphCache[SSD1306_GLYPH_CACHE_SIZE];
+static uint8_t SSD1306_GlyphCacheNext = 0;  // Round robin replacement
+#endif
+
+// Binary search of the sorted code point table, '?' for a missing glyph
+static int32_t ssd1306_FindGlyph(const SSD1306_GlyphFont_t *Font, uint16_t code) {
+    for (uint8_t pass = 0; pass < 2; pass++, code = '?') {
+        uint16_t lo = 0;
+        uint16_t hi = Font->count;
+        while (lo < hi) {
+            const uint16_t mid = (lo + hi) / 2;
+            if (Font->codes[mid] < code) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo < Font->count && Font->codes[lo] == code) {
+            return lo;
+        }
+    }
+    return -1;
+}
+
+// Run-length decoding: control byte bit 7 set repeats the next byte
+// (n & 0x7F) + 1 times, otherwise n + 1 literal bytes follow
+static uint8_t ssd1306_DecodeRle(const uint8_t *src, const uint8_t *end, uint8_t *dst, uint16_t len) {
+    uint16_t n = 0;
+    while (n < len && src < end) {
+        const uint8_t ctl = *src++;
+        const uint8_t count = (ctl & 0x7F) + 1;
+        if (n + count > len) {
+            return 0;
+        }
+        if (ctl & 0x80) {
+            memset(&dst[n], *src++, count);
+        } else {
+            memcpy(&dst[n], src, count);
+            src += count;
+        }
+        n += count;
+    }
+    return n == len;
+}
+
+// Glyph data in page layout: straight from flash, or decoded into the cache
+static const uint8_t *ssd1306_GlyphData(const SSD1306_GlyphFont_t *Font, uint16_t index) {
+    const uint8_t *src = &Font->data[Font->offsets[index]];
+    if (!(Font->flags & SSD1306_GLYPH_RLE)) {
+        return src;
+    }
+
+#if SSD1306_GLYPH_CACHE_SIZE > 0
+    for (uint8_t i = 0; i < SSD1306_GLYPH_CACHE_SIZE; i++) {
+        if (SSD1306_GlyphCache[i].font == Font && SSD1306_GlyphCache[i].index == index) {
+            return SSD1306_GlyphCache[i].data;
+        }
+    }
+
+    const uint16_t len = (uint16_t)Font->widths[index] * Font->pages;
+    if (len > SSD1306_GLYPH_CACHE_BYTES) {
+        return NULL;
+    }
+
+    SSD1306_GlyphCache_t *slot = &SSD1306_GlyphCache[SSD1306_GlyphCacheNext];
+    SSD1306_GlyphCacheNext = (SSD1306_GlyphCacheNext + 1) % SSD1306_GLYPH_CACHE_SIZE;
+    if (!ssd1306_DecodeRle(src, &Font->data[Font->offsets[index + 1]], slot->data, len)) {
+        slot->font = NULL;
+        return NULL;
+    }
+    slot->font = Font;
+    slot->index = index;
+    return slot->data;
+#else
+    // No cache configured
+    return NULL;
+#endif
+}
+
+/*
+ * Draw 1 glyph of a compiled subset font (Tools/font_gen)
+ * code     => Unicode code point, '?' is drawn when the font lacks it
+ * Returns the code point drawn, 0 if it does not fit or the font has neither
+ */
+uint16_t ssd1306_WriteGlyph(uint16_t code, const SSD1306_GlyphFont_t *Font, SSD1306_COLOR color) {
+    const int32_t index = ssd1306_FindGlyph(Font, code);
+    if (index < 0) {
+        return 0;
+    }
+
+    const uint8_t width = Font->widths[index];
+    if (SSD1306_WIDTH < (SSD1306.CurrentX + width) ||
+        SSD1306_HEIGHT < (SSD1306.CurrentY + Font->height))
+    {
+        // Not enough space on current line
+        return 0;
+    }
+
+    const uint8_t *glyph = ssd1306_GlyphData(Font, (uint16_t)index);
+    if (glyph == NULL) {
+        return 0;
+    }
+
+    ssd1306_BlitGlyph(glyph, width, width, Font->height, Font->pages, color);
+    SSD1306.CurrentX += width;
+    return Font->codes[index];
+}
+
+/*
+ * Write a UTF-8 string with a compiled subset font
+ * Code points above U+FFFF and malformed bytes are drawn as '?'.
+ * Returns 0 when everything fit, otherwise the first byte not written
+ */
+char ssd1306_WriteStringUtf8(const char* str, const SSD1306_GlyphFont_t *Font, SSD1306_COLOR color) {
+    const uint8_t *s = (const uint8_t *)str;
+
+    while (*s) {
+        const uint8_t *start = s;
+        uint32_t code = *s++;
+        uint8_t extra = 0;
+
+        if (code >= 0xF0) {
+            code = '?';
+            extra = 3;
+        } else if (code >= 0xE0) {
+            code &= 0x0F;
+            extra = 2;
+        } else if (code >= 0xC0) {
+            code &= 0x1F;
+            extra = 1;
+        } else if (code >= 0x80) {
+            code = '?';
+        }
+        for (; extra > 0; extra--) {
+            if ((*s & 0xC0) != 0x80) {
+                code = '?';
+                break;
+            }
+            if (code != '?') {
+                code = (code << 6) | (*s & 0x3F);
+            }
+            s++;
+        }
+
+        if (ssd1306_WriteGlyph((uint16_t)code, Font, color) == 0) {
+            // Char could not be written
+            return (char)*start;
+        }
+    }
+
+    // Everything ok
+    return 0;
+}
+
+/*
+ * Numeric readout
+ * The digits of a subset font are converted once into page bytes already shifted
+ * to the readout's y offset, so drawing a digit is a copy of width bytes per
+ * page, masked only on the partial top and bottom pages. The characters on
+ * screen are remembered; a new value redraws only the characters whose sprite
+ * or position changed. Digits keep the font width, '.' and '-' are cropped to
+ * their ink plus a pixel on each side.
+ */
+static const char SSD1306_ReadoutChars[SSD1306_READOUT_GLYPHS - 1] = {
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '.', '-'
+};
+#define SSD1306_READOUT_DASH    11
+#define SSD1306_READOUT_BLANK   (SSD1306_READOUT_GLYPHS - 1)
+
+static uint8_t ssd1306_ReadoutGlyph(char ch) {
+    for (uint8_t i = 0; i < SSD1306_READOUT_GLYPHS - 1; i++) {
+        if (SSD1306_ReadoutChars[i] == ch) {
+            return i;
+        }
+    }
+    return SSD1306_READOUT_BLANK;
+}
+
+// Column c of a page layout glyph as a bit column, bit 0 is the top row
+static uint64_t ssd1306_GlyphColumn(const SSD1306_GlyphFont_t *font, const uint8_t *glyph,
+                                    uint8_t width, uint8_t c) {
+    uint64_t column = 0;
+    for (uint8_t p = 0; p < font->pages; p++) {
+        column |= (uint64_t)glyph[p * width + c] << (p * 8);
+    }
+    return column & (((uint64_t)1 << font->height) - 1);
+}
+
+// Copy a sprite to column x of the readout
+static void ssd1306_ReadoutBlit(const SSD1306_Readout_t *readout, uint8_t index, uint8_t x) {
+    const uint8_t width = readout->widths[index];
+    uint8_t *dst = &SSD1306_Buffer[readout->page * SSD1306_WIDTH + x];
+
+    for (uint8_t p = 0; p < readout->pages; p++, dst += SSD1306_WIDTH) {
+        const uint8_t *src = readout->sprites[index][p];
+        const uint8_t mask = readout->mask[p];
+        if (mask == 0xFF) {
+            memcpy(dst, src, width);
+        } else {
+            for (uint8_t c = 0; c < width; c++) {
+                dst[c] = (dst[c] & ~mask) | src[c];
+            }
+        }
+    }
+    ssd1306_MarkDirty(readout->page, readout->page + readout->pages - 1, x, x + width - 1);
+}
+
+// Background over columns x1..x2 - 1 of the readout
+static void ssd1306_ReadoutClear(const SSD1306_Readout_t *readout, uint8_t x1, uint8_t x2) {
+    if (x1 >= x2) {
+        return;
+    }
+
+    uint8_t *dst = &SSD1306_Buffer[readout->page * SSD1306_WIDTH];
+    for (uint8_t p = 0; p < readout->pages; p++, dst += SSD1306_WIDTH) {
+        const uint8_t mask = readout->mask[p];
+        const uint8_t background = readout->background[p];
+        for (uint8_t c = x1; c < x2; c++) {
+            dst[c] = (dst[c] & ~mask) | background;
+        }
+    }
+    ssd1306_MarkDirty(readout->page, readout->page + readout->pages - 1, x1, x2 - 1);
+}
+
+SSD1306_Error_t ssd1306_ReadoutInit(SSD1306_Readout_t *readout, const SSD1306_GlyphFont_t *font,
+                                    uint8_t x, uint8_t y, uint8_t width, SSD1306_COLOR color) {
+    if (readout == NULL || font == NULL || font->height == 0 || y + font->height > SSD1306_HEIGHT ||
+        width == 0 || x + width > SSD1306_WIDTH) {
+        return SSD1306_ERR;
+    }
+
+    // The digits, '.' and '-' must all be in the font; blanks are as wide as '0'
+    int32_t index[SSD1306_READOUT_GLYPHS - 1];
+    for (uint8_t i = 0; i < SSD1306_READOUT_GLYPHS - 1; i++) {
+        index[i] = ssd1306_FindGlyph(font, (uint8_t)SSD1306_ReadoutChars[i]);
+        if (index[i] < 0 || font->codes[index[i]] != (uint8_t)SSD1306_ReadoutChars[i] ||
+            font->widths[index[i]] > SSD1306_READOUT_MAX_WIDTH) {
+            return SSD1306_ERR;
+        }
+    }
+    const uint8_t digit_width = font->widths[index[0]];
+
+    memset(readout, 0, sizeof(*readout));
+    readout->x = x;
+    readout->width = width;
+    readout->page = y / 8;
+    readout->pages = (y % 8 + font->height + 7) / 8;
+
+    // Readout rows as a bit column starting at the first page; up to 32 + 7 bits
+    const uint8_t shift = y % 8;
+    const uint64_t rows = (((uint64_t)1 << font->height) - 1) << shift;
+    for (uint8_t p = 0; p < readout->pages; p++) {
+        readout->mask[p] = (uint8_t)(rows >> (p * 8));
+        readout->background[p] = (color == White) ? 0x00 : readout->mask[p];
+    }
+
+    readout->widths[SSD1306_READOUT_BLANK] = digit_width;
+    for (uint8_t p = 0; p < readout->pages; p++) {
+        memset(readout->sprites[SSD1306_READOUT_BLANK][p], readout->background[p], digit_width);
+    }
+
+    for (uint8_t i = 0; i < SSD1306_READOUT_GLYPHS - 1; i++) {
+        // Glyph in page layout, run-length encoded glyphs decoded once here
+        uint8_t decoded[SSD1306_READOUT_MAX_WIDTH * (SSD1306_HEIGHT / 8)];
+        const uint8_t glyph_width = font->widths[index[i]];
+        const uint8_t *glyph = &font->data[font->offsets[index[i]]];
+        if (font->flags & SSD1306_GLYPH_RLE) {
+            if (!ssd1306_DecodeRle(glyph, &font->data[font->offsets[index[i] + 1]], decoded,
+                                   (uint16_t)glyph_width * font->pages)) {
+                return SSD1306_ERR;
+            }
+            glyph = decoded;
+        }
+
+        const char ch = SSD1306_ReadoutChars[i];
+        uint8_t first = 0;
+        uint8_t width_i = glyph_width;
+
+        if (ch == '.' || ch == '-') {
+            // Crop to the ink plus a pixel on each side
+            int16_t ink_first = -1;
+            int16_t ink_last = -1;
+            for (uint8_t c = 0; c < glyph_width; c++) {
+                if (ssd1306_GlyphColumn(font, glyph, glyph_width, c) != 0) {
+                    if (ink_first < 0) {
+                        ink_first = c;
+                    }
+                    ink_last = c;
+                }
+            }
+            if (ink_first >= 0) {
+                first = (ink_first > 0) ? ink_first - 1 : 0;
+                width_i = (ink_last + 2 - first < glyph_width - first) ? ink_last + 2 - first : glyph_width - first;
+            } else {
+                width_i = digit_width / 4 + 1;
+            }
+        }
+        readout->widths[i] = width_i;
+
+        for (uint8_t c = 0; c < width_i; c++) {
+            uint64_t column = 0;
+            if (first + c < glyph_width) {
+                column = ssd1306_GlyphColumn(font, glyph, glyph_width, first + c) << shift;
+            }
+            for (uint8_t p = 0; p < readout->pages; p++) {
+                uint8_t bits = (uint8_t)(column >> (p * 8));
+                if (color == Black) {
+                    bits ^= readout->mask[p];
+                }
+                readout->sprites[i][p][c] = bits;
+            }
+        }
+    }
+
+    return SSD1306_OK;
+}
+
+uint8_t ssd1306_ReadoutSet(SSD1306_Readout_t *readout, const char *text) {
+    uint8_t glyph[SSD1306_READOUT_MAX_CHARS];
+    uint8_t pos[SSD1306_READOUT_MAX_CHARS];
+    uint8_t count = 0;
+    uint16_t total = 0;
+
+    if (readout == NULL || text == NULL) {
+        return 0;
+    }
+
+    for (const char *s = text; *s != '\0'; s++) {
+        if (count == SSD1306_READOUT_MAX_CHARS) {
+            total = readout->width + 1;
+            break;
+        }
+        glyph[count] = ssd1306_ReadoutGlyph(*s);
+        total += readout->widths[glyph[count]];
+        count++;
+    }
+
+    if (total > readout->width) {
+        // Does not fit
+        count = 0;
+        total = 0;
+        for (; count < 3 && total + readout->widths[SSD1306_READOUT_DASH] <= readout->width; count++) {
+            glyph[count] = SSD1306_READOUT_DASH;
+            total += readout->widths[SSD1306_READOUT_DASH];
+        }
+    }
+
+    // Right-aligned
+    const uint8_t left = readout->x + readout->width - total;
+    uint8_t x = left;
+    for (uint8_t i = 0; i < count; i++) {
+        pos[i] = x;
+        x += readout->widths[glyph[i]];
+    }
+
+    uint8_t changed = 0;
+    if (!readout->valid) {
+        ssd1306_ReadoutClear(readout, readout->x, left);
+        changed = 1;
+    } else if (readout->left < left) {
+        ssd1306_ReadoutClear(readout, readout->left, left);
+        changed = 1;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        // The character the same distance from the right edge last time
+        const int16_t old = (int16_t)readout->count - (int16_t)(count - i);
+        if (readout->valid && old >= 0 && readout->glyph[old] == glyph[i] && readout->pos[old] == pos[i]) {
+            continue;
+        }
+        ssd1306_ReadoutBlit(readout, glyph[i], pos[i]);
+        changed = 1;
+    }
+
+    memcpy(readout->glyph, glyph, count);
+    memcpy(readout->pos, pos, count);
+    readout->count = count;
+    readout->left = left;
+    readout->valid = 1;
+    return changed;
+}
+
+void ssd1306_ReadoutInvalidate(SSD1306_Readout_t *readout) {
+    if (readout != NULL) {
+        readout->valid = 0;
+    }
+}
+
 /* Position the cursor */
 void ssd1306_SetCursor(uint8_t x, uint8_t y) {
     SSD1306.CurrentX = x;
@@ -282,6 +1210,12 @@ void ssd1306_Line(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD1306_COLOR
     int32_t signY = ((y1 < y2) ? 1 : -1);
     int32_t error = deltaX - deltaY;
     int32_t error2;
+
+    // Horizontal and vertical lines are a byte mask per page
+    if (x1 == x2 || y1 == y2) {
+        ssd1306_FillRectangle(x1, y1, x2, y2, color);
+        return;
+    }
     
     ssd1306_DrawPixel(x2, y2, color);
 
@@ -315,9 +1249,35 @@ void ssd1306_Polyline(const SSD1306_VERTEX *par_vertex, uint16_t par_size, SSD13
     return;
 }
 
-/* Convert Degrees to Radians */
-static float ssd1306_DegToRad(float par_deg) {
-    return par_deg * (3.14f / 180.0f);
+/* sin(0..90 degrees) * 16384, rounded */
+static const uint16_t ssd1306_SinTable[91] = {
+        0,   286,   572,   857,  1143,  1428,  1713,  1997,  2280,  2563,
+     2845,  3126,  3406,  3686,  3964,  4240,  4516,  4790,  5063,  5334,
+     5604,  5872,  6138,  6402,  6664,  6924,  7182,  7438,  7692,  7943,
+     8192,  8438,  8682,  8923,  9162,  9397,  9630,  9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384,
+};
+
+/* Sine of an angle in [0;360] degrees, Q14 */
+static int32_t ssd1306_Sin(uint16_t par_deg) {
+    if (par_deg <= 90) {
+        return ssd1306_SinTable[par_deg];
+    } else if (par_deg <= 180) {
+        return ssd1306_SinTable[180 - par_deg];
+    } else if (par_deg <= 270) {
+        return -(int32_t)ssd1306_SinTable[par_deg - 180];
+    }
+    return -(int32_t)ssd1306_SinTable[360 - par_deg];
+}
+
+/* Cosine of an angle in [0;360] degrees, Q14 */
+static int32_t ssd1306_Cos(uint16_t par_deg) {
+    return ssd1306_Sin((par_deg + 90) % 360);
 }
 
 /* Normalize degree to [0;360] */
@@ -332,42 +1292,109 @@ static uint16_t ssd1306_NormalizeTo0_360(uint16_t par_deg) {
     return loc_angle;
 }
 
+/* Draw a pixel given in signed coordinates, nothing outside the screen */
+static void ssd1306_DrawPixelClipped(int16_t x, int16_t y, SSD1306_COLOR color) {
+    if (x < 0 || y < 0 || x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) {
+        return;
+    }
+    ssd1306_DrawPixel((uint8_t)x, (uint8_t)y, color);
+}
+
+/* Vertical line given in signed coordinates, clipped to the screen */
+static void ssd1306_DrawVLineClipped(int16_t x, int16_t y1, int16_t y2, SSD1306_COLOR color) {
+    if (x < 0 || x >= SSD1306_WIDTH) {
+        return;
+    }
+    if (y1 < 0) {
+        y1 = 0;
+    }
+    if (y2 >= SSD1306_HEIGHT) {
+        y2 = SSD1306_HEIGHT - 1;
+    }
+    if (y1 > y2) {
+        return;
+    }
+    ssd1306_DrawVLine((uint8_t)x, (uint8_t)y1, (uint8_t)y2, color);
+}
+
+/* Point on the circle at an angle, same orientation as ssd1306_DrawArc */
+static void ssd1306_ArcPoint(uint8_t x, uint8_t y, uint8_t radius, uint16_t angle, uint8_t *px, uint8_t *py) {
+    // Q14 with rounding; the shift of a negative value rounds toward -inf like floor
+    *px = (uint8_t)(x + ((ssd1306_Sin(angle) * radius + 8192) >> 14));
+    *py = (uint8_t)(y + ((ssd1306_Cos(angle) * radius + 8192) >> 14));
+}
+
 /*
  * DrawArc. Draw angle is beginning from 4 quart of trigonometric circle (3pi/2)
  * start_angle in degree
- * sweep in degree
+ * sweep in degree, the angle where the arc ends
+ *
+ * The circle is walked with the same Bresenham steps as ssd1306_DrawCircle, and
+ * a pixel is kept when it lies between the start and end directions. That test
+ * uses two cross products against the start and end vectors from a Q14 sine
+ * table, so there is no float math. The pixels lie on the circle itself rather
+ * than on 10 degree chords, and a full sweep gives exactly ssd1306_DrawCircle.
  */
 void ssd1306_DrawArc(uint8_t x, uint8_t y, uint8_t radius, uint16_t start_angle, uint16_t sweep, SSD1306_COLOR color) {
-    static const uint8_t CIRCLE_APPROXIMATION_SEGMENTS = 36;
-    float approx_degree;
-    uint32_t approx_segments;
-    uint8_t xp1,xp2;
-    uint8_t yp1,yp2;
-    uint32_t count;
-    uint32_t loc_sweep;
-    float rad;
-    
-    loc_sweep = ssd1306_NormalizeTo0_360(sweep);
-    
-    count = (ssd1306_NormalizeTo0_360(start_angle) * CIRCLE_APPROXIMATION_SEGMENTS) / 360;
-    approx_segments = (loc_sweep * CIRCLE_APPROXIMATION_SEGMENTS) / 360;
-    approx_degree = loc_sweep / (float)approx_segments;
-    while(count < approx_segments)
-    {
-        rad = ssd1306_DegToRad(count*approx_degree);
-        xp1 = x + (int8_t)(sinf(rad)*radius);
-        yp1 = y + (int8_t)(cosf(rad)*radius);    
-        count++;
-        if(count != approx_segments) {
-            rad = ssd1306_DegToRad(count*approx_degree);
-        } else {
-            rad = ssd1306_DegToRad(loc_sweep);
-        }
-        xp2 = x + (int8_t)(sinf(rad)*radius);
-        yp2 = y + (int8_t)(cosf(rad)*radius);    
-        ssd1306_Line(xp1,yp1,xp2,yp2,color);
+    const uint16_t loc_start = ssd1306_NormalizeTo0_360(start_angle);
+    const uint16_t loc_end = ssd1306_NormalizeTo0_360(sweep);
+    int32_t px = -radius;
+    int32_t py = 0;
+    int32_t err = 2 - 2 * radius;
+    int32_t e2;
+
+    if (loc_end <= loc_start || x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) {
+        return;
     }
-    
+
+    // Direction vectors as (sin, cos), matching the (dx, dy) of a pixel
+    const int32_t start_sin = ssd1306_Sin(loc_start);
+    const int32_t start_cos = ssd1306_Cos(loc_start);
+    const int32_t end_sin = ssd1306_Sin(loc_end);
+    const int32_t end_cos = ssd1306_Cos(loc_end);
+    const uint16_t span = loc_end - loc_start;
+
+    do {
+        // The four mirror images of this step
+        const int32_t dxs[4] = { -px, px, px, -px };
+        const int32_t dys[4] = { py, py, -py, -py };
+
+        for (uint8_t i = 0; i < 4; i++) {
+            const int32_t dx = dxs[i];
+            const int32_t dy = dys[i];
+            // >= 0: the pixel is at or past the start, at or before the end
+            const int32_t after_start = start_cos * dx - start_sin * dy;
+            const int32_t before_end = end_sin * dy - end_cos * dx;
+            uint8_t inside;
+
+            if (span >= 360) {
+                inside = 1;
+            } else if (span <= 180) {
+                inside = (after_start >= 0) && (before_end >= 0);
+            } else {
+                inside = (after_start >= 0) || (before_end >= 0);
+            }
+
+            if (inside) {
+                ssd1306_DrawPixelClipped(x + dx, y + dy, color);
+            }
+        }
+
+        e2 = err;
+        if (e2 <= py) {
+            py++;
+            err = err + (py * 2 + 1);
+            if(-px == py && e2 <= px) {
+                e2 = 0;
+            }
+        }
+
+        if (e2 > px) {
+            px++;
+            err = err + (px * 2 + 1);
+        }
+    } while (px <= 0);
+
     return;
 }
 
@@ -378,43 +1405,21 @@ void ssd1306_DrawArc(uint8_t x, uint8_t y, uint8_t radius, uint16_t start_angle,
  * sweep: finish angle in degree
  */
 void ssd1306_DrawArcWithRadiusLine(uint8_t x, uint8_t y, uint8_t radius, uint16_t start_angle, uint16_t sweep, SSD1306_COLOR color) {
-    const uint32_t CIRCLE_APPROXIMATION_SEGMENTS = 36;
-    float approx_degree;
-    uint32_t approx_segments;
-    uint8_t xp1;
-    uint8_t xp2 = 0;
-    uint8_t yp1;
-    uint8_t yp2 = 0;
-    uint32_t count;
-    uint32_t loc_sweep;
-    float rad;
-    
-    loc_sweep = ssd1306_NormalizeTo0_360(sweep);
-    
-    count = (ssd1306_NormalizeTo0_360(start_angle) * CIRCLE_APPROXIMATION_SEGMENTS) / 360;
-    approx_segments = (loc_sweep * CIRCLE_APPROXIMATION_SEGMENTS) / 360;
-    approx_degree = loc_sweep / (float)approx_segments;
-
-    rad = ssd1306_DegToRad(count*approx_degree);
-    uint8_t first_point_x = x + (int8_t)(sinf(rad)*radius);
-    uint8_t first_point_y = y + (int8_t)(cosf(rad)*radius);   
-    while (count < approx_segments) {
-        rad = ssd1306_DegToRad(count*approx_degree);
-        xp1 = x + (int8_t)(sinf(rad)*radius);
-        yp1 = y + (int8_t)(cosf(rad)*radius);    
-        count++;
-        if (count != approx_segments) {
-            rad = ssd1306_DegToRad(count*approx_degree);
-        } else {
-            rad = ssd1306_DegToRad(loc_sweep);
-        }
-        xp2 = x + (int8_t)(sinf(rad)*radius);
-        yp2 = y + (int8_t)(cosf(rad)*radius);    
-        ssd1306_Line(xp1,yp1,xp2,yp2,color);
+    const uint16_t loc_start = ssd1306_NormalizeTo0_360(start_angle);
+    const uint16_t loc_end = ssd1306_NormalizeTo0_360(sweep);
+    uint8_t xp1, yp1;
+    uint8_t xp2, yp2;
+
+    if (loc_end <= loc_start) {
+        return;
     }
-    
+
+    ssd1306_DrawArc(x, y, radius, loc_start, loc_end, color);
+
     // Radius line
-    ssd1306_Line(x,y,first_point_x,first_point_y,color);
+    ssd1306_ArcPoint(x, y, radius, loc_start, &xp1, &yp1);
+    ssd1306_ArcPoint(x, y, radius, loc_end, &xp2, &yp2);
+    ssd1306_Line(x,y,xp1,yp1,color);
     ssd1306_Line(x,y,xp2,yp2,color);
     return;
 }
@@ -431,10 +1436,10 @@ void ssd1306_DrawCircle(uint8_t par_x,uint8_t par_y,uint8_t par_r,SSD1306_COLOR
     }
 
     do {
-        ssd1306_DrawPixel(par_x - x, par_y + y, par_color);
-        ssd1306_DrawPixel(par_x + x, par_y + y, par_color);
-        ssd1306_DrawPixel(par_x + x, par_y - y, par_color);
-        ssd1306_DrawPixel(par_x - x, par_y - y, par_color);
+        ssd1306_DrawPixelClipped(par_x - x, par_y + y, par_color);
+        ssd1306_DrawPixelClipped(par_x + x, par_y + y, par_color);
+        ssd1306_DrawPixelClipped(par_x + x, par_y - y, par_color);
+        ssd1306_DrawPixelClipped(par_x - x, par_y - y, par_color);
         e2 = err;
 
         if (e2 <= y) {
@@ -454,7 +1459,11 @@ void ssd1306_DrawCircle(uint8_t par_x,uint8_t par_y,uint8_t par_r,SSD1306_COLOR
     return;
 }
 
-/* Draw filled circle. Pixel positions calculated using Bresenham's algorithm */
+/*
+ * Draw filled circle. Pixel positions calculated using Bresenham's algorithm
+ * Each step covers columns par_x +- x down to +-y, drawn as two vertical
+ * lines of page byte masks; y only grows, so the last step on a column wins.
+ */
 void ssd1306_FillCircle(uint8_t par_x,uint8_t par_y,uint8_t par_r,SSD1306_COLOR par_color) {
     int32_t x = -par_r;
     int32_t y = 0;
@@ -466,10 +1475,9 @@ void ssd1306_FillCircle(uint8_t par_x,uint8_t par_y,uint8_t par_r,SSD1306_COLOR
     }
 
     do {
-        for (uint8_t _y = (par_y + y); _y >= (par_y - y); _y--) {
-            for (uint8_t _x = (par_x - x); _x >= (par_x + x); _x--) {
-                ssd1306_DrawPixel(_x, _y, par_color);
-            }
+        ssd1306_DrawVLineClipped(par_x + x, par_y - y, par_y + y, par_color);
+        if (x != 0) {
+            ssd1306_DrawVLineClipped(par_x - x, par_y - y, par_y + y, par_color);
         }
 
         e2 = err;
@@ -500,18 +1508,46 @@ void ssd1306_DrawRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD13
     return;
 }
 
-/* Draw a filled rectangle */
+/* Draw a horizontal line from x1 to x2 */
+void ssd1306_DrawHLine(uint8_t x1, uint8_t x2, uint8_t y, SSD1306_COLOR color) {
+    ssd1306_FillRectangle(x1, y, x2, y, color);
+}
+
+/* Draw a vertical line from y1 to y2 */
+void ssd1306_DrawVLine(uint8_t x, uint8_t y1, uint8_t y2, SSD1306_COLOR color) {
+    ssd1306_FillRectangle(x, y1, x, y2, color);
+}
+
+/* Draw a filled rectangle, one byte mask per page */
 void ssd1306_FillRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD1306_COLOR color) {
     uint8_t x_start = ((x1<=x2) ? x1 : x2);
     uint8_t x_end   = ((x1<=x2) ? x2 : x1);
     uint8_t y_start = ((y1<=y2) ? y1 : y2);
     uint8_t y_end   = ((y1<=y2) ? y2 : y1);
 
-    for (uint8_t y= y_start; (y<= y_end)&&(y<SSD1306_HEIGHT); y++) {
-        for (uint8_t x= x_start; (x<= x_end)&&(x<SSD1306_WIDTH); x++) {
-            ssd1306_DrawPixel(x, y, color);
+    if (x_start >= SSD1306_WIDTH || y_start >= SSD1306_HEIGHT) {
+        return;
+    }
+    if (x_end >= SSD1306_WIDTH) {
+        x_end = SSD1306_WIDTH - 1;
+    }
+    if (y_end >= SSD1306_HEIGHT) {
+        y_end = SSD1306_HEIGHT - 1;
+    }
+
+    const uint8_t page_start = y_start / 8;
+    const uint8_t page_end = y_end / 8;
+    for (uint8_t page = page_start; page <= page_end; page++) {
+        uint8_t mask = 0xFF;
+        if (page == page_start) {
+            mask &= 0xFF << (y_start % 8);
+        }
+        if (page == page_end) {
+            mask &= 0xFF >> (7 - (y_end % 8));
         }
+        ssd1306_FillSpan(&SSD1306_Buffer[page * SSD1306_WIDTH + x_start], x_end - x_start + 1, mask, color);
     }
+    ssd1306_MarkDirty(page_start, page_end, x_start, x_end);
     return;
 }
 
@@ -523,6 +1559,7 @@ SSD1306_Error_t ssd1306_InvertRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint
     return SSD1306_ERR;
   }
   uint32_t i;
+  ssd1306_MarkDirty(y1 / 8, y2 / 8, x1, x2);
   if ((y1 / 8) != (y2 / 8)) {
     /* if rectangle doesn't lie on one 8px row */
     for (uint32_t x = x1; x <= x2; x++) {
@@ -545,28 +1582,88 @@ SSD1306_Error_t ssd1306_InvertRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint
   return SSD1306_OK;
 }
 
-/* Draw a bitmap */
+/*
+ * Transpose an 8x8 bit block: row[k] holds 8 pixels of a bitmap row, MSB first.
+ * col[c] gets column c with row k in bit k, the SSD1306 page layout.
+ * Two 32-bit words, three swap steps (Hacker's Delight, transpose8).
+ */
+static void ssd1306_Transpose8(const uint8_t row[8], uint8_t col[8]) {
+    // Rows in reverse order put row 0 in the low bit of each column
+    uint32_t x = ((uint32_t)row[7] << 24) | ((uint32_t)row[6] << 16) | ((uint32_t)row[5] << 8) | row[4];
+    uint32_t y = ((uint32_t)row[3] << 24) | ((uint32_t)row[2] << 16) | ((uint32_t)row[1] << 8) | row[0];
+    uint32_t t;
+
+    t = (x ^ (x >> 7)) & 0x00AA00AA;  x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AA;  y = y ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC; x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCC; y = y ^ t ^ (t << 14);
+    t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+    y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+    x = t;
+
+    col[0] = x >> 24; col[1] = x >> 16; col[2] = x >> 8; col[3] = x;
+    col[4] = y >> 24; col[5] = y >> 16; col[6] = y >> 8; col[7] = y;
+}
+
+/*
+ * Draw a bitmap (rows of MSB first bytes, LCD Assistant horizontal format)
+ * Set bits are drawn in color, clear bits leave the screen unchanged.
+ * Each 8x8 block is transposed to page bytes and shifted into one or two pages.
+ */
 void ssd1306_DrawBitmap(uint8_t x, uint8_t y, const unsigned char* bitmap, uint8_t w, uint8_t h, SSD1306_COLOR color) {
     int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-    uint8_t byte = 0;
+    uint8_t row[8];
+    uint8_t col[8];
 
-    if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) {
+    if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT || w == 0 || h == 0) {
         return;
     }
 
-    for (uint8_t j = 0; j < h; j++, y++) {
-        for (uint8_t i = 0; i < w; i++) {
-            if (i & 7) {
-                byte <<= 1;
-            } else {
-                byte = (*(const unsigned char *)(&bitmap[j * byteWidth + i / 8]));
+    // Visible part
+    const uint8_t x_end = (x + w - 1 < SSD1306_WIDTH) ? x + w - 1 : SSD1306_WIDTH - 1;
+    const uint8_t y_end = (y + h - 1 < SSD1306_HEIGHT) ? y + h - 1 : SSD1306_HEIGHT - 1;
+
+    for (uint8_t j = 0; j <= y_end - y; j += 8) {
+        const uint8_t rows = (h - j < 8) ? h - j : 8;
+        const uint8_t page = (y + j) / 8;
+        const uint8_t shift = (y + j) % 8;
+        uint8_t *dst = &SSD1306_Buffer[page * SSD1306_WIDTH];
+        // The band reaches the next page unless it ends in this one or at the bottom
+        uint8_t *next = (shift + rows > 8 && page + 1 < SSD1306_PAGES) ? dst + SSD1306_WIDTH : NULL;
+
+        for (uint8_t i = 0; i <= x_end - x; i += 8) {
+            const unsigned char *src = &bitmap[j * byteWidth + i / 8];
+            uint32_t any = 0;
+            for (uint8_t k = 0; k < 8; k++) {
+                row[k] = (k < rows) ? src[k * byteWidth] : 0;
+                any |= row[k];
+            }
+            if (any == 0) {
+                continue;
             }
 
-            if (byte & 0x80) {
-                ssd1306_DrawPixel(x + i, y, color);
+            ssd1306_Transpose8(row, col);
+
+            const uint8_t cols = (x_end - x - i < 8) ? x_end - x - i + 1 : 8;
+            for (uint8_t c = 0; c < cols; c++) {
+                const uint16_t v = (uint16_t)col[c] << shift;
+                const uint8_t xi = x + i + c;
+                if (color == White) {
+                    dst[xi] |= (uint8_t)v;
+                    if (next != NULL) {
+                        next[xi] |= (uint8_t)(v >> 8);
+                    }
+                } else {
+                    dst[xi] &= ~(uint8_t)v;
+                    if (next != NULL) {
+                        next[xi] &= ~(uint8_t)(v >> 8);
+                    }
+                }
             }
         }
     }
+
+    ssd1306_MarkDirty(y / 8, y_end / 8, x, x_end);
     return;
 }
 
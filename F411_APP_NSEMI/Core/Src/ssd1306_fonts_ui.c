@@ -0,0 +1,112 @@
+/*
+ * ssd1306_fonts_ui.c
+ *
+ *  Generated by Tools/font_gen, do not edit.
+ *  Subset fonts: sorted code points, glyph widths and offsets into the glyph
+ *  data (SSD1306 page layout, run-length encoded for SSD1306_GLYPH_RLE fonts).
+ */
+#include "ssd1306_fonts_ui.h"
+
+/* Font_UI_6x8: 44 glyphs, 264 bytes */
+static const uint16_t Font_UI_6x8_codes [] = {
+0x0020, 0x0028, 0x0029, 0x002B, 0x002D, 0x002E, 0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035,
+0x0036, 0x0037, 0x0038, 0x0039, 0x003A, 0x003F, 0x0041, 0x0043, 0x0049, 0x004B, 0x004D, 0x0052,
+0x0053, 0x0056, 0x005A, 0x005F, 0x0061, 0x0062, 0x0065, 0x0066, 0x0067, 0x0069, 0x006C, 0x006D,
+0x006E, 0x006F, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+};
+
+static const uint8_t Font_UI_6x8_widths [] = {
+6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+};
+
+static const uint16_t Font_UI_6x8_offsets [] = {
+0, 6, 12, 18, 24, 30, 36, 42, 48, 54, 60, 66,
+72, 78, 84, 90, 96, 102, 108, 114, 120, 126, 132, 138,
+144, 150, 156, 162, 168, 174, 180, 186, 192, 198, 204, 210,
+216, 222, 228, 234, 240, 246, 252, 258, 264,
+};
+
+static const uint8_t Font_UI_6x8_data [] = {
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // sp
+0x00, 0x1C, 0x22, 0x41, 0x00, 0x00,  // (
+0x00, 0x41, 0x22, 0x1C, 0x00, 0x00,  // )
+0x08, 0x08, 0x3E, 0x08, 0x08, 0x00,  // +
+0x08, 0x08, 0x08, 0x08, 0x08, 0x00,  // -
+0x00, 0x00, 0x60, 0x60, 0x00, 0x00,  // .
+0x3E, 0x51, 0x49, 0x45, 0x3E, 0x00,  // 0
+0x00, 0x42, 0x7F, 0x40, 0x00, 0x00,  // 1
+0x72, 0x49, 0x49, 0x49, 0x46, 0x00,  // 2
+0x21, 0x41, 0x49, 0x4D, 0x33, 0x00,  // 3
+0x18, 0x14, 0x12, 0x7F, 0x10, 0x00,  // 4
+0x27, 0x45, 0x45, 0x45, 0x39, 0x00,  // 5
+0x3C, 0x4A, 0x49, 0x49, 0x31, 0x00,  // 6
+0x41, 0x21, 0x11, 0x09, 0x07, 0x00,  // 7
+0x36, 0x49, 0x49, 0x49, 0x36, 0x00,  // 8
+0x46, 0x49, 0x49, 0x29, 0x1E, 0x00,  // 9
+0x00, 0x00, 0x14, 0x00, 0x00, 0x00,  // :
+0x02, 0x01, 0x59, 0x09, 0x06, 0x00,  // ?
+0x7C, 0x12, 0x11, 0x12, 0x7C, 0x00,  // A
+0x3E, 0x41, 0x41, 0x41, 0x22, 0x00,  // C
+0x00, 0x41, 0x7F, 0x41, 0x00, 0x00,  // I
+0x7F, 0x08, 0x14, 0x22, 0x41, 0x00,  // K
+0x7F, 0x02, 0x1C, 0x02, 0x7F, 0x00,  // M
+0x7F, 0x09, 0x19, 0x29, 0x46, 0x00,  // R
+0x26, 0x49, 0x49, 0x49, 0x32, 0x00,  // S
+0x1F, 0x20, 0x40, 0x20, 0x1F, 0x00,  // V
+0x61, 0x59, 0x49, 0x4D, 0x43, 0x00,  // Z
+0x40, 0x40, 0x40, 0x40, 0x40, 0x00,  // _
+0x20, 0x54, 0x54, 0x78, 0x40, 0x00,  // a
+0x7F, 0x28, 0x44, 0x44, 0x38, 0x00,  // b
+0x38, 0x54, 0x54, 0x54, 0x18, 0x00,  // e
+0x00, 0x08, 0x7E, 0x09, 0x02, 0x00,  // f
+0x18, 0x24, 0x24, 0x1C, 0x78, 0x00,  // g
+0x00, 0x44, 0x7D, 0x40, 0x00, 0x00,  // i
+0x00, 0x41, 0x7F, 0x40, 0x00, 0x00,  // l
+0x7C, 0x04, 0x78, 0x04, 0x78, 0x00,  // m
+0x7C, 0x08, 0x04, 0x04, 0x78, 0x00,  // n
+0x38, 0x44, 0x44, 0x44, 0x38, 0x00,  // o
+0x7C, 0x08, 0x04, 0x04, 0x08, 0x00,  // r
+0x48, 0x54, 0x54, 0x54, 0x24, 0x00,  // s
+0x04, 0x04, 0x3F, 0x44, 0x24, 0x00,  // t
+0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00,  // u
+0x1C, 0x20, 0x40, 0x20, 0x1C, 0x00,  // v
+0x3C, 0x40, 0x30, 0x40, 0x3C, 0x00,  // w
+};
+
+const SSD1306_GlyphFont_t Font_UI_6x8 = {8, 1, 0, 44, Font_UI_6x8_codes, Font_UI_6x8_widths, Font_UI_6x8_offsets, Font_UI_6x8_data};
+
+/* Font_UI_16x26: 14 glyphs, 449 bytes (896 before RLE), largest glyph 64 bytes, must fit SSD1306_GLYPH_CACHE_BYTES */
+static const uint16_t Font_UI_16x26_codes [] = {
+0x0020, 0x002D, 0x002E, 0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037, 0x0038,
+0x0039, 0x003F,
+};
+
+static const uint8_t Font_UI_16x26_widths [] = {
+16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+};
+
+static const uint16_t Font_UI_16x26_offsets [] = {
+0, 2, 8, 14, 60, 85, 126, 168, 200, 233, 283, 316,
+367, 417, 449,
+};
+
+static const uint8_t Font_UI_16x26_data [] = {
+0xBF, 0x00,  // sp
+0x91, 0x00, 0x8C, 0x18, 0xA0, 0x00,  // -
+0xA5, 0x00, 0x84, 0x1E, 0x94, 0x00,  // .
+0x10, 0x00, 0xE0, 0xF8, 0xFC, 0xFE, 0x7F, 0x0F, 0x07, 0x03, 0x07, 0x0F, 0x7F, 0xFE, 0xFC, 0xF8, 0xE0, 0x00, 0x83, 0xFF, 0x00, 0xC0, 0x84, 0x00, 0x00, 0xC0, 0x83, 0xFF, 0x0E, 0x00, 0x00, 0x03, 0x07, 0x0F, 0x1F, 0x1E, 0x1C, 0x18, 0x1C, 0x1E, 0x1F, 0x0F, 0x07, 0x03, 0x90, 0x00,  // 0
+0x01, 0x00, 0x00, 0x82, 0x0C, 0x02, 0x0E, 0x0E, 0xFE, 0x83, 0xFF, 0x8A, 0x00, 0x84, 0xFF, 0x85, 0x00, 0x84, 0x18, 0x84, 0x1F, 0x83, 0x18, 0x8F, 0x00,  // 1
+0x05, 0x00, 0x00, 0x06, 0x06, 0x07, 0x07, 0x82, 0x03, 0x05, 0x07, 0xFF, 0xFE, 0xFE, 0xFC, 0x70, 0x84, 0x00, 0x09, 0x80, 0xE0, 0xF0, 0xF8, 0x7C, 0x3E, 0x1F, 0x0F, 0x07, 0x03, 0x83, 0x00, 0x00, 0x1E, 0x82, 0x1F, 0x00, 0x1B, 0x87, 0x18, 0x90, 0x00,  // 2
+0x82, 0x00, 0x02, 0x06, 0x07, 0x07, 0x82, 0x03, 0x05, 0x07, 0xFF, 0xFF, 0xFE, 0xFC, 0x38, 0x84, 0x00, 0x83, 0x06, 0x06, 0x07, 0x0F, 0x1F, 0xFF, 0xFD, 0xF8, 0xF0, 0x83, 0x00, 0x82, 0x1C, 0x82, 0x18, 0x05, 0x1C, 0x1E, 0x0F, 0x0F, 0x07, 0x03, 0x90, 0x00,  // 3
+0x83, 0x00, 0x04, 0x80, 0xE0, 0xF0, 0xF8, 0x7E, 0x83, 0xFF, 0x82, 0x00, 0x08, 0x60, 0x78, 0x7C, 0x7F, 0x7F, 0x67, 0x63, 0x60, 0x60, 0x83, 0xFF, 0x82, 0x60, 0x88, 0x00, 0x83, 0x1F, 0x92, 0x00,  // 4
+0x82, 0x00, 0x83, 0xFF, 0x86, 0x07, 0x84, 0x00, 0x84, 0x03, 0x06, 0x07, 0x0F, 0xBF, 0xFE, 0xFE, 0xFC, 0xF0, 0x83, 0x00, 0x82, 0x1C, 0x82, 0x18, 0x05, 0x1C, 0x1F, 0x0F, 0x0F, 0x07, 0x01, 0x90, 0x00,  // 5
+0x08, 0x00, 0x00, 0xE0, 0xF8, 0xFC, 0xFE, 0x3E, 0x0F, 0x07, 0x82, 0x03, 0x05, 0x07, 0x07, 0x06, 0x00, 0x00, 0x0C, 0x83, 0xFF, 0x19, 0x0E, 0x07, 0x03, 0x03, 0x07, 0x0F, 0xFF, 0xFE, 0xFC, 0xF8, 0x00, 0x00, 0x01, 0x07, 0x0F, 0x0F, 0x1F, 0x1C, 0x18, 0x18, 0x1C, 0x1E, 0x0F, 0x0F, 0x07, 0x03, 0x8F, 0x00,  // 6
+0x01, 0x00, 0x00, 0x87, 0x07, 0x05, 0xC7, 0xF7, 0xFF, 0x7F, 0x3F, 0x0F, 0x84, 0x00, 0x07, 0x80, 0xE0, 0xF8, 0xFE, 0x7F, 0x1F, 0x07, 0x01, 0x85, 0x00, 0x00, 0x18, 0x83, 0x1F, 0x00, 0x03, 0x96, 0x00,  // 7
+0x2F, 0x00, 0x00, 0x30, 0xFC, 0xFE, 0xFF, 0xFF, 0x87, 0x03, 0x03, 0x87, 0xFF, 0xFF, 0xFE, 0x7C, 0x00, 0x00, 0xC0, 0xF0, 0xF8, 0xFD, 0xFF, 0x1F, 0x07, 0x0F, 0x0F, 0x1F, 0x7F, 0xFD, 0xF8, 0xF0, 0xE0, 0x00, 0x01, 0x07, 0x0F, 0x0F, 0x1F, 0x1C, 0x1C, 0x18, 0x18, 0x1C, 0x1E, 0x0F, 0x0F, 0x07, 0x03, 0x8F, 0x00,  // 8
+0x16, 0x00, 0xE0, 0xF8, 0xFC, 0xFE, 0xFF, 0x07, 0x03, 0x03, 0x07, 0x0F, 0xFF, 0xFE, 0xFC, 0xF8, 0xE0, 0x00, 0x01, 0x07, 0x0F, 0x0F, 0x1F, 0x1C, 0x82, 0x18, 0x01, 0x1C, 0xEF, 0x82, 0xFF, 0x05, 0x3F, 0x00, 0x00, 0x0C, 0x1C, 0x1C, 0x82, 0x18, 0x06, 0x1C, 0x1C, 0x1F, 0x0F, 0x07, 0x03, 0x01, 0x90, 0x00,  // 9
+0x04, 0x00, 0x00, 0x1E, 0x1F, 0x1F, 0x84, 0x03, 0x05, 0x87, 0xFF, 0xFE, 0xFE, 0x7C, 0x18, 0x84, 0x00, 0x07, 0x60, 0x78, 0x7C, 0x7E, 0x7F, 0x07, 0x03, 0x01, 0x87, 0x00, 0x84, 0x1C, 0x95, 0x00,  // ?
+};
+
+const SSD1306_GlyphFont_t Font_UI_16x26 = {26, 4, SSD1306_GLYPH_RLE, 14, Font_UI_16x26_codes, Font_UI_16x26_widths, Font_UI_16x26_offsets, Font_UI_16x26_data};
@@ -1,8 +1,14 @@
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
 #include "ssd1306.h"
 #include "ssd1306_tests.h"
 #include "ssd1306_fonts.h"
+#include "ssd1306_fonts_ui.h"
+
+// The tests draw with the full fonts, which ssd1306_conf.h only includes with SSD1306_TESTS
+#ifdef SSD1306_TESTS
 
 //------------------------------------------------------------------------------
 // Table generated by LCD Assistant
@@ -356,6 +362,264 @@ void ssd1306_TestDrawBitmap()
     ssd1306_UpdateScreen();
 }
 
+//------------------------------------------------------------------------------
+// Benchmark of the word-wide and integer primitives against the pixel-by-pixel
+// and float versions they replaced. Cycles from the DWT cycle counter, best of BENCH_RUNS.
+// The reference versions draw into bench_buffer through ssd1306_RefDrawPixel, a copy
+// of the old ssd1306_DrawPixel, so they do not pay for the dirty tracking added later.
+//------------------------------------------------------------------------------
+#define BENCH_RUNS  8
+// Result rows per screen page of the benchmark
+#define BENCH_ROWS  (SSD1306_HEIGHT / 8)
+
+static uint8_t bench_buffer[SSD1306_BUFFER_SIZE];
+
+// The old ssd1306_DrawPixel, without ssd1306_MarkDirty
+static void ssd1306_RefDrawPixel(uint8_t x, uint8_t y, SSD1306_COLOR color) {
+    if(x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) {
+        // Don't write outside the buffer
+        return;
+    }
+
+    // Draw in the right color
+    if(color == White) {
+        bench_buffer[x + (y / 8) * SSD1306_WIDTH] |= 1 << (y % 8);
+    } else {
+        bench_buffer[x + (y / 8) * SSD1306_WIDTH] &= ~(1 << (y % 8));
+    }
+}
+
+static void ssd1306_RefLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD1306_COLOR color) {
+    int32_t deltaX = abs(x2 - x1);
+    int32_t deltaY = abs(y2 - y1);
+    int32_t signX = ((x1 < x2) ? 1 : -1);
+    int32_t signY = ((y1 < y2) ? 1 : -1);
+    int32_t error = deltaX - deltaY;
+    int32_t error2;
+
+    ssd1306_RefDrawPixel(x2, y2, color);
+    while((x1 != x2) || (y1 != y2)) {
+        ssd1306_RefDrawPixel(x1, y1, color);
+        error2 = error * 2;
+        if(error2 > -deltaY) {
+            error -= deltaY;
+            x1 += signX;
+        }
+        if(error2 < deltaX) {
+            error += deltaX;
+            y1 += signY;
+        }
+    }
+}
+
+static void ssd1306_RefFillRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD1306_COLOR color) {
+    for (uint8_t y = y1; (y <= y2) && (y < SSD1306_HEIGHT); y++) {
+        for (uint8_t x = x1; (x <= x2) && (x < SSD1306_WIDTH); x++) {
+            ssd1306_RefDrawPixel(x, y, color);
+        }
+    }
+}
+
+static void ssd1306_RefDrawBitmap(uint8_t x, uint8_t y, const unsigned char* bitmap, uint8_t w, uint8_t h, SSD1306_COLOR color) {
+    int16_t byteWidth = (w + 7) / 8;
+    uint8_t byte = 0;
+
+    for (uint8_t j = 0; j < h; j++, y++) {
+        for (uint8_t i = 0; i < w; i++) {
+            if (i & 7) {
+                byte <<= 1;
+            } else {
+                byte = bitmap[j * byteWidth + i / 8];
+            }
+            if (byte & 0x80) {
+                ssd1306_RefDrawPixel(x + i, y, color);
+            }
+        }
+    }
+}
+
+// Chords every 10 degrees through sinf/cosf, pi taken as 3.14
+static void ssd1306_RefDrawArc(uint8_t x, uint8_t y, uint8_t radius, uint16_t start_angle, uint16_t sweep, SSD1306_COLOR color) {
+    uint32_t count = (start_angle * 36) / 360;
+    uint32_t approx_segments = (sweep * 36) / 360;
+    float approx_degree = sweep / (float)approx_segments;
+    float rad;
+    uint8_t xp1, yp1, xp2, yp2;
+
+    while (count < approx_segments) {
+        rad = count * approx_degree * (3.14f / 180.0f);
+        xp1 = x + (int8_t)(sinf(rad) * radius);
+        yp1 = y + (int8_t)(cosf(rad) * radius);
+        count++;
+        rad = ((count != approx_segments) ? count * approx_degree : sweep) * (3.14f / 180.0f);
+        xp2 = x + (int8_t)(sinf(rad) * radius);
+        yp2 = y + (int8_t)(cosf(rad) * radius);
+        ssd1306_RefLine(xp1, yp1, xp2, yp2, color);
+    }
+}
+
+// A rectangle of pixels per Bresenham step
+static void ssd1306_RefFillCircle(uint8_t par_x, uint8_t par_y, uint8_t par_r, SSD1306_COLOR par_color) {
+    int32_t x = -par_r;
+    int32_t y = 0;
+    int32_t err = 2 - 2 * par_r;
+    int32_t e2;
+
+    do {
+        for (uint8_t _y = (par_y + y); _y >= (par_y - y); _y--) {
+            for (uint8_t _x = (par_x - x); _x >= (par_x + x); _x--) {
+                ssd1306_RefDrawPixel(_x, _y, par_color);
+            }
+        }
+        e2 = err;
+        if (e2 <= y) {
+            y++;
+            err = err + (y * 2 + 1);
+            if (-x == y && e2 <= x) {
+                e2 = 0;
+            }
+        }
+        if (e2 > x) {
+            x++;
+            err = err + (x * 2 + 1);
+        }
+    } while (x <= 0);
+}
+
+// The old ssd1306_WriteChar: every pixel of the glyph cell, background included
+static void ssd1306_RefWriteString(uint8_t x, uint8_t y, const char *str, SSD1306_Font_t Font, SSD1306_COLOR color) {
+    for (; *str; str++) {
+        const char ch = *str;
+        if (ch < 32 || ch > 126)
+            return;
+
+        const uint8_t char_width = Font.char_width ? Font.char_width[ch-32] : Font.width;
+        if (SSD1306_WIDTH < (x + char_width) || SSD1306_HEIGHT < (y + Font.height))
+            return;
+
+        for(uint32_t i = 0; i < Font.height; i++) {
+            uint32_t b = Font.data[(ch - 32) * Font.height + i];
+            for(uint32_t j = 0; j < char_width; j++) {
+                if((b << j) & 0x8000)  {
+                    ssd1306_RefDrawPixel(x + j, (y + i), (SSD1306_COLOR) color);
+                } else {
+                    ssd1306_RefDrawPixel(x + j, (y + i), (SSD1306_COLOR)!color);
+                }
+            }
+        }
+        x += char_width;
+    }
+}
+
+// The old ssd1306_Fill was a memset of the screen buffer
+static void bench_ref_fill(void)    { memset(bench_buffer, 0xFF, sizeof(bench_buffer)); }
+static void bench_fill(void)        { ssd1306_Fill(White); }
+static void bench_ref_rect(void)    { ssd1306_RefFillRectangle(10, 3, 117, 60, White); }
+static void bench_rect(void)        { ssd1306_FillRectangle(10, 3, 117, 60, White); }
+static void bench_ref_hline(void)   { ssd1306_RefLine(0, 29, SSD1306_WIDTH - 1, 29, White); }
+static void bench_hline(void)       { ssd1306_DrawHLine(0, SSD1306_WIDTH - 1, 29, White); }
+static void bench_ref_vline(void)   { ssd1306_RefLine(64, 0, 64, SSD1306_HEIGHT - 1, White); }
+static void bench_vline(void)       { ssd1306_DrawVLine(64, 0, SSD1306_HEIGHT - 1, White); }
+// y = 3: every band straddles two pages
+static void bench_ref_bitmap(void)  { ssd1306_RefDrawBitmap(32, 3, github_logo_64x64, 64, 61, White); }
+static void bench_bitmap(void)      { ssd1306_DrawBitmap(32, 3, github_logo_64x64, 64, 61, White); }
+static void bench_ref_arc(void)     { ssd1306_RefDrawArc(64, 16, 15, 20, 270, White); }
+static void bench_arc(void)         { ssd1306_DrawArc(64, 16, 15, 20, 270, White); }
+static void bench_ref_circle(void)  { ssd1306_RefFillCircle(64, 16, 15, White); }
+static void bench_circle(void)      { ssd1306_FillCircle(64, 16, 15, White); }
+#ifdef SSD1306_INCLUDE_FONT_16x26
+// Full readout redraw, every character changes
+static SSD1306_Readout_t bench_readout;
+static void bench_ref_digits(void)  { ssd1306_RefWriteString(0, 6, "-1234.5", Font_16x26, White); }
+static void bench_digits(void)      { ssd1306_ReadoutInvalidate(&bench_readout); ssd1306_ReadoutSet(&bench_readout, "-1234.5"); }
+#endif
+
+typedef struct {
+    const char *name;
+    void (*ref)(void);
+    void (*run)(void);
+} ssd1306_Bench_t;
+
+static const ssd1306_Bench_t bench_cases[] = {
+    { "Fill",   bench_ref_fill,   bench_fill   },
+    { "Rect",   bench_ref_rect,   bench_rect   },
+    { "HLine",  bench_ref_hline,  bench_hline  },
+    { "VLine",  bench_ref_vline,  bench_vline  },
+    { "Bitmap", bench_ref_bitmap, bench_bitmap },
+    { "Arc",    bench_ref_arc,    bench_arc    },
+    { "Circle", bench_ref_circle, bench_circle },
+#ifdef SSD1306_INCLUDE_FONT_16x26
+    { "Digits", bench_ref_digits, bench_digits },
+#endif
+};
+
+static uint32_t ssd1306_BenchCycles(void (*fn)(void)) {
+    uint32_t best = UINT32_MAX;
+
+    for (uint8_t i = 0; i < BENCH_RUNS; i++) {
+        ssd1306_Fill(Black);
+        memset(bench_buffer, 0, sizeof(bench_buffer));
+        uint32_t start = DWT->CYCCNT;
+        fn();
+        uint32_t cycles = DWT->CYCCNT - start;
+        if (cycles < best) {
+            best = cycles;
+        }
+    }
+    return best;
+}
+
+#define BENCH_CASES (sizeof(bench_cases) / sizeof(bench_cases[0]))
+
+// Times every case and prints the results. Leaves the screen buffer drawn over.
+static void ssd1306_BenchMeasure(uint32_t *ref, uint32_t *run) {
+    // Cycle counter, also started by Scheduler_Init
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+#ifdef SSD1306_INCLUDE_FONT_16x26
+    ssd1306_ReadoutInit(&bench_readout, &Font_UI_16x26, 0, 6, SSD1306_WIDTH, White);
+#endif
+
+    for (uint8_t i = 0; i < BENCH_CASES; i++) {
+        ref[i] = ssd1306_BenchCycles(bench_cases[i].ref);
+        run[i] = ssd1306_BenchCycles(bench_cases[i].run);
+        printf("%-6s %6lu -> %5lu cycles\r\n", bench_cases[i].name,
+               (unsigned long)ref[i], (unsigned long)run[i]);
+    }
+}
+
+// Results to printf only, for the shell; the caller redraws the screen afterwards
+void ssd1306_TestBenchmarkPrint() {
+    uint32_t ref[BENCH_CASES];
+    uint32_t run[BENCH_CASES];
+
+    ssd1306_BenchMeasure(ref, run);
+}
+
+// Results to printf and the screen, BENCH_ROWS rows per page, 3 s per page
+void ssd1306_TestBenchmark() {
+    char buff[32];
+    uint32_t ref[BENCH_CASES];
+    uint32_t run[BENCH_CASES];
+
+    ssd1306_BenchMeasure(ref, run);
+
+    for (uint8_t first = 0; first < BENCH_CASES; first += BENCH_ROWS) {
+        if (first > 0) {
+            HAL_Delay(3000);
+        }
+        ssd1306_Fill(Black);
+        for (uint8_t i = first; i < BENCH_CASES && i < first + BENCH_ROWS; i++) {
+            snprintf(buff, sizeof(buff), "%-6s%6lu>%5lu", bench_cases[i].name,
+                     (unsigned long)ref[i], (unsigned long)run[i]);
+            ssd1306_SetCursor(2, (i - first) * 8);
+            ssd1306_WriteString(buff, Font_6x8, White);
+        }
+        ssd1306_UpdateScreen();
+    }
+}
+
 void ssd1306_TestAll() {
     ssd1306_Init();
 
@@ -389,5 +653,8 @@ void ssd1306_TestAll() {
     HAL_Delay(3000);
     ssd1306_TestDrawBitmap();
     HAL_Delay(3000);
+    ssd1306_TestBenchmark();
+    HAL_Delay(3000);
 }
 
+#endif // SSD1306_TESTS
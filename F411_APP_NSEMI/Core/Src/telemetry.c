@@ -0,0 +1,253 @@
+/*
+ * telemetry.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  二進位遙測
+ *
+ *  CurrentMonitor_Display 每份報告約 15 行、500 bytes 的 %.1f 文字，115200 baud 下
+ *  要佔用約 45 ms 的線路時間，浮點格式化也很耗 CPU。改成固定格式的二進位紀錄後
+ *  一份統計只有 47 bytes（含 COBS 與 CRC），主程式只做 memcpy 與硬體 CRC。
+ *
+ *  訊框先在 32 位元對齊的緩衝區組好 header + payload，用硬體 CRC 單元計算後
+ *  附在尾端，再以 COBS 編碼（資料中不會出現 0x00）並在前後加上 0x00，
+ *  接收端從任意位置開始都能在下一個 0x00 重新同步。
+ *
+ *  主機開啟 USB CDC 序列埠時訊框改寫進 usb_stream，否則寫進 uart_log。
+ *  只能在主程式呼叫（uart_log 與硬體 CRC 都不支援中斷內使用）。
+ */
+#include "main.h"
+#include "telemetry.h"
+#include "uart_log.h"
+#include "usb_stream.h"
+#include "hw_crc.h"
+#include "scheduler.h"
+#include <string.h>
+
+TLM_STATIC_ASSERT(LOAD_STOPPED == TLM_LOAD_STOPPED && LOAD_NOISE == TLM_LOAD_NOISE &&
+                  LOAD_WEAK == TLM_LOAD_WEAK && LOAD_DETECTED == TLM_LOAD_DETECTED &&
+                  LOAD_STARTING == TLM_LOAD_STARTING && LOAD_RUNNING == TLM_LOAD_RUNNING,
+                  "Load_State_t must match TLM_LOAD_x");
+
+/* 私有變數 */
+static uint32_t tlm_raw[TLM_MAX_RAW / 4];          // header + payload + crc，CRC 單元以字為單位
+static uint8_t tlm_encoded[TLM_MAX_ENCODED];
+static uint16_t tlm_seq = 0;
+static uint8_t tlm_enabled = 0;
+static Telemetry_Stats_t tlm_stats;
+static Tlm_Samples_t tlm_samples;
+static uint32_t tlm_sample_index = 0;
+
+/* 私有函數 */
+static uint32_t Telemetry_CobsEncode(const uint8_t *src, uint32_t length, uint8_t *dst);
+
+void Telemetry_Init(void)
+{
+    tlm_seq = 0;
+    tlm_sample_index = 0;
+    tlm_samples.count = 0;
+    memset(&tlm_stats, 0, sizeof(tlm_stats));
+}
+
+// 1 = 週期輸出改用二進位紀錄
+void Telemetry_SetEnabled(uint8_t enable)
+{
+    tlm_enabled = enable ? 1 : 0;
+}
+
+uint8_t Telemetry_IsEnabled(void)
+{
+    return tlm_enabled;
+}
+
+/**
+ * @brief  組成並送出一個訊框
+ * @param  type: 紀錄類型 TLM_REC_x
+ * @param  payload: 紀錄內容
+ * @param  length: 內容長度，必須是 4 的倍數且不超過 TLM_MAX_PAYLOAD
+ * @retval HAL狀態，輸出緩衝區不足時回傳 HAL_BUSY（序號仍會遞增）
+ */
+HAL_StatusTypeDef Telemetry_Send(uint8_t type, const void *payload, uint16_t length)
+{
+    if ((length & 3U) != 0 || length > TLM_MAX_PAYLOAD || (payload == NULL && length != 0))
+        return HAL_ERROR;
+
+    Tlm_Header_t *header = (Tlm_Header_t *)tlm_raw;
+    header->type = type;
+    header->version = TLM_PROTOCOL_VERSION;
+    header->seq = tlm_seq++;
+    header->time_ms = HAL_GetTick();
+
+    uint32_t words = (sizeof(Tlm_Header_t) + length) / 4;
+    memcpy(&tlm_raw[sizeof(Tlm_Header_t) / 4], payload, length);
+    tlm_raw[words] = HwCrc_Compute(tlm_raw, words);
+
+    tlm_encoded[0] = TLM_DELIMITER;
+    uint32_t encoded = 1 + Telemetry_CobsEncode((const uint8_t *)tlm_raw, (words + 1) * 4, &tlm_encoded[1]);
+    tlm_encoded[encoded++] = TLM_DELIMITER;
+
+    // 主機開啟 USB 序列埠時遙測改走 USB，UART 只留文字
+    uint32_t written = UsbStream_IsOpen() ? UsbStream_Write(tlm_encoded, encoded)
+                                          : UartLog_Write(tlm_encoded, encoded);
+    if (written == 0) {
+        tlm_stats.dropped++;
+        return HAL_BUSY;
+    }
+
+    tlm_stats.frames++;
+    tlm_stats.bytes += encoded;
+    return HAL_OK;
+}
+
+/**
+ * @brief  加入一個電流樣本，滿 TLM_MAX_SAMPLES 個時送出一筆 SAMPLES 紀錄
+ * @param  value: 電流 (A)
+ * @param  period_ms: 樣本間隔
+ * @retval None
+ */
+void Telemetry_AddSample(float value, uint16_t period_ms)
+{
+    if (!tlm_enabled)
+        return;
+
+    if (tlm_samples.count == 0) {
+        tlm_samples.first_index = tlm_sample_index;
+        tlm_samples.period_ms = period_ms;
+    }
+
+    tlm_samples.value[tlm_samples.count++] = value;
+    tlm_sample_index++;
+
+    if (tlm_samples.count >= TLM_MAX_SAMPLES)
+        Telemetry_FlushSamples();
+}
+
+// 送出目前累積的樣本
+void Telemetry_FlushSamples(void)
+{
+    if (tlm_samples.count == 0)
+        return;
+
+    uint16_t length = (uint16_t)(sizeof(Tlm_Samples_t) - sizeof(tlm_samples.value) +
+                                 tlm_samples.count * sizeof(float));
+    Telemetry_Send(TLM_REC_SAMPLES, &tlm_samples, length);
+    tlm_samples.count = 0;
+}
+
+/**
+ * @brief  送出監控統計（取代 CurrentMonitor_Display 的文字報告）
+ * @param  monitor: 監控結構指標
+ * @retval None
+ */
+void Telemetry_SendStats(const Current_Monitor_t *monitor)
+{
+    if (monitor == NULL)
+        return;
+
+    Tlm_Stats_t record;
+
+    Telemetry_FillStats(monitor, &record);
+    Telemetry_Send(TLM_REC_STATS, &record, sizeof(record));
+}
+
+/**
+ * @brief  填入監控統計紀錄（USB HID 狀態報告也使用）
+ * @param  monitor: 監控結構指標
+ * @param  record: 輸出
+ * @retval None
+ */
+void Telemetry_FillStats(const Current_Monitor_t *monitor, Tlm_Stats_t *record)
+{
+    if (monitor == NULL || record == NULL)
+        return;
+
+    record->current_now = monitor->current_now;
+    record->current_rms = monitor->stats.rms_current;
+    record->current_max = monitor->stats.max_current;
+    record->current_min = monitor->stats.min_current;
+    record->voltage = monitor->voltage;
+    record->power = monitor->power;
+    record->sample_count = monitor->stats.sample_count;
+    record->load_state = (uint8_t)CurrentMonitor_GetLoadState(monitor);
+    record->monitor_status = (uint8_t)monitor->status;
+    record->reserved = 0;
+}
+
+// 送出狀態轉換
+void Telemetry_SendState(uint8_t domain, uint8_t from, uint8_t to)
+{
+    Tlm_State_t record = { domain, from, to, 0 };
+
+    Telemetry_Send(TLM_REC_STATE, &record, sizeof(record));
+}
+
+/**
+ * @brief  每個排程器任務送一筆 PROFILE 紀錄
+ * @retval None
+ */
+void Telemetry_SendProfile(void)
+{
+    Sched_TaskStats_t stats;
+    Tlm_Profile_t record;
+    uint16_t load = Scheduler_GetCpuLoad();
+
+    for (uint8_t id = 0; id < Scheduler_GetTaskCount(); id++) {
+        if (Scheduler_GetStats((Sched_TaskId_t)id, &stats) != HAL_OK)
+            continue;
+
+        memset(&record, 0, sizeof(record));
+        record.task_id = id;
+        record.priority = (uint8_t)stats.priority;
+        record.cpu_load = load;
+        if (stats.name != NULL)
+            strncpy(record.name, stats.name, TLM_TASK_NAME_LEN);
+        record.runs = stats.runs;
+        record.last_cycles = stats.last_cycles;
+        record.max_cycles = stats.max_cycles;
+        record.avg_cycles = stats.runs ? (uint32_t)(stats.total_cycles / stats.runs) : 0;
+        record.deadline_misses = stats.deadline_misses;
+        record.overruns = stats.overruns;
+
+        Telemetry_Send(TLM_REC_PROFILE, &record, sizeof(record));
+    }
+}
+
+void Telemetry_GetStats(Telemetry_Stats_t *stats)
+{
+    if (stats == NULL)
+        return;
+
+    *stats = tlm_stats;
+}
+
+/**
+ * @brief  COBS 編碼（不含結尾 0x00）
+ * @param  src: 原始資料
+ * @param  length: 原始長度
+ * @param  dst: 輸出，至少 length + length / 254 + 1 bytes
+ * @retval 編碼後長度
+ */
+static uint32_t Telemetry_CobsEncode(const uint8_t *src, uint32_t length, uint8_t *dst)
+{
+    uint32_t code_index = 0;
+    uint32_t out = 1;
+    uint8_t code = 1;
+
+    for (uint32_t i = 0; i < length; i++) {
+        if (src[i] != 0) {
+            dst[out++] = src[i];
+            code++;
+        }
+
+        // 遇到 0 或區塊已滿 254 個非零位元組時結束目前區塊
+        if (src[i] == 0 || code == 0xFF) {
+            dst[code_index] = code;
+            code_index = out++;
+            code = 1;
+        }
+    }
+
+    dst[code_index] = code;
+    return out;
+}
@@ -0,0 +1,207 @@
+/*
+ * trend_graph.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  OLED 即時電流趨勢圖
+ *
+ *  取樣任務呼叫 TrendGraph_AddSample，每 samples_per_column 個樣本抽取成一行
+ *  （最小/最大值），存進環形行緩衝區；顯示任務呼叫 TrendGraph_Render 把新的行畫進
+ *  畫面緩衝區再 ssd1306_UpdateScreen。
+ *
+ *  畫面不捲動，而是掃描：第 n 行畫在 n % width，前方 TREND_GRAPH_GAP 行清空標示
+ *  目前位置。每個新行只改變一、兩行像素，差異更新只送出這幾個 byte，
+ *  100 Hz 取樣、每行 4 個樣本時 25 行/秒也只佔極少的 I2C 頻寬。
+ *  （SSD1306 的水平捲動由面板自己的 frame 時脈推進，無法和取樣同步，
+ *  捲動後面板內容也會和驅動程式保存的副本不一致，所以不使用。）
+ */
+#include "trend_graph.h"
+#include <string.h>
+
+/* 私有函數 */
+static uint8_t TrendGraph_CheckRange(int32_t min_milli, int32_t max_milli);
+static int16_t TrendGraph_Clamp16(int32_t milli);
+static uint8_t TrendGraph_Row(const TrendGraph_t *graph, int32_t milli);
+static void TrendGraph_ClearColumn(const TrendGraph_t *graph, uint8_t pos);
+static void TrendGraph_DrawColumn(const TrendGraph_t *graph, uint32_t index);
+static void TrendGraph_DrawGap(const TrendGraph_t *graph);
+
+/**
+ * @brief  初始化趨勢圖（不畫圖，顯示時先呼叫 TrendGraph_Redraw）
+ * @param  graph: 趨勢圖
+ * @param  x, y, width, height: 畫面上的區域
+ * @param  min_milli, max_milli: 底部/頂部對應的電流 (mA)
+ * @param  samples_per_column: 每行抽取的樣本數
+ * @retval HAL狀態
+ */
+HAL_StatusTypeDef TrendGraph_Init(TrendGraph_t *graph, uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+                                  int32_t min_milli, int32_t max_milli, uint16_t samples_per_column)
+{
+    if (graph == NULL || samples_per_column == 0)
+        return HAL_ERROR;
+
+    if (width <= TREND_GRAPH_GAP || width > TREND_GRAPH_MAX_WIDTH || x + width > SSD1306_WIDTH ||
+        height < 2 || y + height > SSD1306_HEIGHT)
+        return HAL_ERROR;
+
+    memset(graph, 0, sizeof(*graph));
+    graph->x = x;
+    graph->y = y;
+    graph->width = width;
+    graph->height = height;
+    graph->samples_per_column = samples_per_column;
+
+    if (!TrendGraph_CheckRange(min_milli, max_milli))
+        return HAL_ERROR;
+
+    graph->min_milli = min_milli;
+    graph->max_milli = max_milli;
+    return HAL_OK;
+}
+
+/**
+ * @brief  設定刻度（不畫圖，顯示中時接著呼叫 TrendGraph_Redraw）
+ * @param  graph: 趨勢圖
+ * @param  min_milli, max_milli: 底部/頂部對應的電流 (mA)
+ * @retval HAL狀態
+ */
+HAL_StatusTypeDef TrendGraph_SetRange(TrendGraph_t *graph, int32_t min_milli, int32_t max_milli)
+{
+    if (graph == NULL || !TrendGraph_CheckRange(min_milli, max_milli))
+        return HAL_ERROR;
+
+    graph->min_milli = min_milli;
+    graph->max_milli = max_milli;
+    return HAL_OK;
+}
+
+/**
+ * @brief  加入一個樣本，湊滿一行時存進環形緩衝區
+ * @param  graph: 趨勢圖
+ * @param  milli: 電流 (mA)
+ * @retval None
+ */
+void TrendGraph_AddSample(TrendGraph_t *graph, int32_t milli)
+{
+    if (graph == NULL)
+        return;
+
+    if (graph->acc_count == 0 || milli < graph->acc_min)
+        graph->acc_min = milli;
+    if (graph->acc_count == 0 || milli > graph->acc_max)
+        graph->acc_max = milli;
+
+    if (++graph->acc_count < graph->samples_per_column)
+        return;
+
+    uint8_t pos = graph->written % graph->width;
+    graph->col_min[pos] = TrendGraph_Clamp16(graph->acc_min);
+    graph->col_max[pos] = TrendGraph_Clamp16(graph->acc_max);
+    graph->written++;
+    graph->acc_count = 0;
+}
+
+/**
+ * @brief  把新的行畫進畫面緩衝區（之後由呼叫者 ssd1306_UpdateScreen）
+ * @param  graph: 趨勢圖
+ * @retval 畫了幾行
+ */
+uint8_t TrendGraph_Render(TrendGraph_t *graph)
+{
+    if (graph == NULL || graph->drawn == graph->written)
+        return 0;
+
+    uint32_t pending = graph->written - graph->drawn;
+    if (pending > (uint32_t)(graph->width - TREND_GRAPH_GAP)) {
+        // 落後超過一圈，環形緩衝區已被覆寫
+        TrendGraph_Redraw(graph);
+        return graph->width;
+    }
+
+    for (; graph->drawn != graph->written; graph->drawn++)
+        TrendGraph_DrawColumn(graph, graph->drawn);
+    TrendGraph_DrawGap(graph);
+
+    return (uint8_t)pending;
+}
+
+/**
+ * @brief  清除整個區域，依環形緩衝區重畫所有行
+ * @param  graph: 趨勢圖
+ * @retval None
+ */
+void TrendGraph_Redraw(TrendGraph_t *graph)
+{
+    if (graph == NULL)
+        return;
+
+    for (uint8_t pos = 0; pos < graph->width; pos++)
+        TrendGraph_ClearColumn(graph, pos);
+
+    // 最多一圈減掉空隙
+    uint32_t count = graph->width - TREND_GRAPH_GAP;
+    if (count > graph->written)
+        count = graph->written;
+
+    for (uint32_t index = graph->written - count; index != graph->written; index++)
+        TrendGraph_DrawColumn(graph, index);
+
+    graph->drawn = graph->written;
+}
+
+// 刻度要在 int16_t 範圍內且 min < max
+static uint8_t TrendGraph_CheckRange(int32_t min_milli, int32_t max_milli)
+{
+    return min_milli < max_milli && min_milli >= INT16_MIN && max_milli <= INT16_MAX;
+}
+
+// int16_t 範圍內的 mA
+static int16_t TrendGraph_Clamp16(int32_t milli)
+{
+    if (milli > INT16_MAX)
+        return INT16_MAX;
+    if (milli < INT16_MIN)
+        return INT16_MIN;
+    return (int16_t)milli;
+}
+
+// 電流對應的像素列，超出刻度時貼齊上下緣
+static uint8_t TrendGraph_Row(const TrendGraph_t *graph, int32_t milli)
+{
+    if (milli < graph->min_milli)
+        milli = graph->min_milli;
+    if (milli > graph->max_milli)
+        milli = graph->max_milli;
+
+    int32_t span = graph->max_milli - graph->min_milli;
+    int32_t level = ((milli - graph->min_milli) * (graph->height - 1) + span / 2) / span;
+    return (uint8_t)(graph->y + graph->height - 1 - level);
+}
+
+// 清空一行，零電流在刻度內時每隔一行畫一點當基準線
+static void TrendGraph_ClearColumn(const TrendGraph_t *graph, uint8_t pos)
+{
+    uint8_t x = graph->x + pos;
+
+    ssd1306_DrawVLine(x, graph->y, graph->y + graph->height - 1, Black);
+    if (graph->min_milli < 0 && graph->max_milli > 0 && (x & 1) == 0)
+        ssd1306_DrawPixel(x, TrendGraph_Row(graph, 0), White);
+}
+
+// 畫第 index 行：最小到最大之間的垂直線
+static void TrendGraph_DrawColumn(const TrendGraph_t *graph, uint32_t index)
+{
+    uint8_t pos = index % graph->width;
+
+    TrendGraph_ClearColumn(graph, pos);
+    ssd1306_DrawVLine(graph->x + pos, TrendGraph_Row(graph, graph->col_max[pos]),
+                      TrendGraph_Row(graph, graph->col_min[pos]), White);
+}
+
+// 清空掃描位置前方的行
+static void TrendGraph_DrawGap(const TrendGraph_t *graph)
+{
+    for (uint8_t i = 0; i < TREND_GRAPH_GAP; i++)
+        TrendGraph_ClearColumn(graph, (uint8_t)((graph->written + i) % graph->width));
+}
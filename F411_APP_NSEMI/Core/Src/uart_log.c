@@ -0,0 +1,214 @@
+/*
+ * uart_log.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  非阻塞 UART 輸出
+ *
+ *  _write 原本直接呼叫 HAL_UART_Transmit，115200 baud 下一份 CurrentMonitor_Display
+ *  報告會卡住 CPU 約 60 ms，10 ms 逾時還會截斷輸出。
+ *
+ *  現在 _write 只把資料複製進環形緩衝區，由 USART6 TX DMA 在背景送出，
+ *  每次傳輸完成中斷再接著送下一段。緩衝區放不下時整筆丟棄並計數，不會等待。
+ *
+ *  單一生產者（主程式）/ 單一消費者（傳輸完成中斷）：head 只由主程式前進，
+ *  tail 只由中斷前進，資料本身不需要上鎖。中斷內的輸出直接丟棄並計數。
+ *  每次 Write 要嘛整筆放入、要嘛整筆丟棄，二進位封包也可以共用這個緩衝區。
+ *
+ *  UartLog_Suspend 之後 uart_log 不再啟動新的傳輸，其他模組（raw_stream）可以
+ *  直接使用 UART；暫停期間的輸出留在緩衝區，UartLog_Resume 後再送出。
+ */
+#include "main.h"
+#include "usart.h"
+#include "uart_log.h"
+#include <string.h>
+
+#define UART_LOG_MASK           (UART_LOG_RING_SIZE - 1)
+
+#if (UART_LOG_RING_SIZE & UART_LOG_MASK) != 0
+#error "UART_LOG_RING_SIZE must be a power of two"
+#endif
+
+/* 私有變數 */
+static uint8_t log_ring[UART_LOG_RING_SIZE];
+static volatile uint32_t log_head = 0;      // 寫入計數（只由主程式修改）
+static volatile uint32_t log_tail = 0;      // 送出計數（只由傳輸完成中斷修改）
+static volatile uint32_t log_tx_len = 0;    // 目前 DMA 傳送中的長度
+static volatile uint8_t log_tx_busy = 0;
+static volatile uint8_t log_suspended = 0;
+static UartLog_Stats_t log_stats;
+
+/* 私有函數 */
+static void UartLog_Kick(void);
+static void UartLog_StartNext(void);
+
+/**
+ * @brief  把一筆資料放進輸出緩衝區
+ * @param  data: 資料
+ * @param  len: 長度
+ * @retval 放入的長度；緩衝區不足或在中斷中呼叫時為 0（整筆丟棄）
+ */
+uint32_t UartLog_Write(const uint8_t *data, uint32_t len)
+{
+    if (data == NULL || len == 0)
+        return 0;
+
+    // 只允許主程式寫入，維持單一生產者
+    if (__get_IPSR() != 0) {
+        log_stats.isr_drops++;
+        return 0;
+    }
+
+    uint32_t head = log_head;
+    uint32_t used = head - log_tail;
+
+    if (len > UART_LOG_RING_SIZE - used) {
+        log_stats.dropped_msgs++;
+        log_stats.dropped_bytes += len;
+        return 0;
+    }
+
+    // 可能跨過緩衝區尾端，分兩段複製
+    uint32_t index = head & UART_LOG_MASK;
+    uint32_t first = UART_LOG_RING_SIZE - index;
+    if (first > len)
+        first = len;
+
+    memcpy(&log_ring[index], data, first);
+    memcpy(&log_ring[0], data + first, len - first);
+
+    // 資料寫完才更新 head
+    __DMB();
+    log_head = head + len;
+
+    log_stats.bytes += len;
+    if (used + len > log_stats.max_used) {
+        log_stats.max_used = used + len;
+    }
+
+    UartLog_Kick();
+    return len;
+}
+
+// 目前可寫入的位元組數
+uint32_t UartLog_Free(void)
+{
+    return UART_LOG_RING_SIZE - (log_head - log_tail);
+}
+
+// 1 = 緩衝區已全部送出
+uint8_t UartLog_IsIdle(void)
+{
+    return (!log_tx_busy && log_head == log_tail) ? 1 : 0;
+}
+
+/**
+ * @brief  暫停輸出並等待目前的 DMA 傳輸結束，之後呼叫端可以獨占 UART
+ * @param  timeout_ms: 最長等待時間，0 = 不等待（傳輸中時直接回傳 HAL_TIMEOUT）
+ * @retval HAL狀態，逾時回傳 HAL_TIMEOUT（不會暫停）
+ */
+HAL_StatusTypeDef UartLog_Suspend(uint32_t timeout_ms)
+{
+    uint32_t start = HAL_GetTick();
+
+    log_suspended = 1;
+
+    // 傳輸完成回呼在 TC 中斷才呼叫，busy 清除時最後一個位元組已經送出
+    while (log_tx_busy) {
+        if (HAL_GetTick() - start >= timeout_ms) {
+            log_suspended = 0;
+            return HAL_TIMEOUT;
+        }
+    }
+
+    return HAL_OK;
+}
+
+// 恢復輸出，送出暫停期間累積的資料
+void UartLog_Resume(void)
+{
+    log_suspended = 0;
+    UartLog_Kick();
+}
+
+void UartLog_GetStats(UartLog_Stats_t *stats)
+{
+    if (stats == NULL)
+        return;
+
+    *stats = log_stats;
+}
+
+/**
+ * @brief  傳輸完成：釋放已送出的區段並接著送下一段（由 HAL_UART_TxCpltCallback 呼叫）
+ * @param  huart: UART handle
+ * @retval None
+ */
+void UartLog_TxComplete(UART_HandleTypeDef *huart)
+{
+    if (huart != DEBUG_UART_PORT || !log_tx_busy) {
+        UartLog_TxCpltCallback(huart);
+        return;
+    }
+
+    log_tail += log_tx_len;
+    log_tx_busy = 0;
+    UartLog_StartNext();
+}
+
+/**
+ * @brief  DMA 閒置時開始傳送（主程式呼叫，短暫遮蔽中斷避免和完成中斷同時啟動）
+ * @retval None
+ */
+static void UartLog_Kick(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (!log_tx_busy) {
+        UartLog_StartNext();
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  送出從 tail 開始的連續區段（跨過尾端時分兩次送）
+ * @retval None
+ */
+static void UartLog_StartNext(void)
+{
+    uint32_t tail = log_tail;
+    uint32_t used = log_head - tail;
+
+    if (used == 0 || log_suspended)
+        return;
+
+    uint32_t index = tail & UART_LOG_MASK;
+    uint32_t chunk = UART_LOG_RING_SIZE - index;
+    if (chunk > used)
+        chunk = used;
+
+    log_tx_len = chunk;
+    log_tx_busy = 1;
+
+    if (HAL_UART_Transmit_DMA(DEBUG_UART_PORT, &log_ring[index], (uint16_t)chunk) != HAL_OK) {
+        log_tx_busy = 0;
+        log_stats.dma_errors++;
+    }
+}
+
+/**
+ * @brief  不是 uart_log 發起的傳輸完成回呼（暫停期間借用 UART 的使用者覆寫此函數）
+ * @param  huart: UART handle
+ * @retval None
+ */
+__weak void UartLog_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    UNUSED(huart);
+}
+
+// UART 傳輸完成回呼
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    UartLog_TxComplete(huart);
+}
@@ -0,0 +1,352 @@
+/*
+ * ui_widget.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  OLED 保留模式元件
+ *
+ *  原本的顯示每次都 ssd1306_Fill(Black)、snprintf 整個畫面再全部重畫，數值沒變也一樣，
+ *  差異更新雖然只送出改變的 byte，CPU 還是每次重新格式化、重畫每個字。
+ *  這裡每個元件保存上一次畫出的內容：
+ *    - 標籤：文字相同就不動
+ *    - 數值：定點數值相同就不格式化；不同時只重畫改變的字元格
+ *    - 長條圖：只畫增加或減少的那幾行
+ *    - 圖示：狀態相同就不動
+ *  畫圖函數本身會標記髒區，只畫到的範圍會被送出；Set 回傳 1 表示有畫，
+ *  全部元件都回傳 0 時呼叫者可以不呼叫 ssd1306_UpdateScreen。
+ *
+ *  元件不清除整個畫面。畫面被其他程式覆蓋（切換顯示模式、ssd1306_Fill）後，
+ *  呼叫 UiWidget_Invalidate，下一次 Set 會重畫整個元件。
+ */
+#include "ui_widget.h"
+#include "fixfmt.h"
+#include <string.h>
+
+/* 私有函數 */
+static HAL_StatusTypeDef UiWidget_InitBase(UiWidget_t *widget, uint8_t x, uint8_t y,
+                                           uint8_t width, uint8_t height);
+static void UiNumber_DrawCell(const UiNumber_t *number, uint8_t index, char ch);
+static void UiBar_FillColumns(const UiBar_t *bar, uint8_t from, uint8_t to, SSD1306_COLOR color);
+
+/**
+ * @brief  下一次 Set 時整個重畫（畫面被覆蓋後呼叫）
+ * @param  widget: 元件（&xxx.base）
+ * @retval None
+ */
+void UiWidget_Invalidate(UiWidget_t *widget)
+{
+    if (widget != NULL)
+        widget->valid = 0;
+}
+
+/**
+ * @brief  清除元件區域，並在下一次 Set 時整個重畫
+ * @param  widget: 元件（&xxx.base）
+ * @retval None
+ */
+void UiWidget_Clear(UiWidget_t *widget)
+{
+    if (widget == NULL)
+        return;
+
+    ssd1306_FillRectangle(widget->x, widget->y, widget->x + widget->width - 1,
+                          widget->y + widget->height - 1, Black);
+    widget->valid = 0;
+}
+
+/**
+ * @brief  初始化文字標籤
+ * @param  label: 標籤
+ * @param  x, y: 左上角
+ * @param  width: 區域寬度（像素），換文字時清除這個範圍
+ * @param  font: 字型
+ * @retval HAL狀態
+ */
+HAL_StatusTypeDef UiLabel_Init(UiLabel_t *label, uint8_t x, uint8_t y, uint8_t width,
+                               const SSD1306_GlyphFont_t *font)
+{
+    if (label == NULL || font == NULL)
+        return HAL_ERROR;
+
+    memset(label, 0, sizeof(*label));
+    label->font = font;
+    return UiWidget_InitBase(&label->base, x, y, width, font->height);
+}
+
+/**
+ * @brief  設定文字，和上一次相同時不重畫
+ * @param  label: 標籤
+ * @param  text: 文字（UTF-8，超過 UI_LABEL_MAX_CHARS bytes 的部分不顯示）
+ * @retval 1 = 有重畫
+ */
+uint8_t UiLabel_Set(UiLabel_t *label, const char *text)
+{
+    if (label == NULL || text == NULL)
+        return 0;
+
+    if (label->base.valid && strncmp(label->text, text, UI_LABEL_MAX_CHARS) == 0)
+        return 0;
+
+    strncpy(label->text, text, UI_LABEL_MAX_CHARS);
+    label->text[UI_LABEL_MAX_CHARS] = '\0';
+
+    UiWidget_Clear(&label->base);
+    ssd1306_SetCursor(label->base.x, label->base.y);
+    ssd1306_WriteStringUtf8(label->text, label->font, White);
+    label->base.valid = 1;
+    return 1;
+}
+
+/**
+ * @brief  初始化數值欄位
+ * @param  number: 數值欄位
+ * @param  x, y: 左上角
+ * @param  chars: 欄位字元數（含負號與小數點，1 ~ UI_NUMBER_MAX_CHARS）
+ * @param  decimals: 小數位數（0 ~ FIXFMT_MAX_DECIMALS）
+ * @param  font: 字型
+ * @retval HAL狀態
+ */
+HAL_StatusTypeDef UiNumber_Init(UiNumber_t *number, uint8_t x, uint8_t y, uint8_t chars,
+                                uint8_t decimals, const SSD1306_GlyphFont_t *font)
+{
+    if (number == NULL || font == NULL || chars == 0 || chars > UI_NUMBER_MAX_CHARS ||
+        decimals > FIXFMT_MAX_DECIMALS)
+        return HAL_ERROR;
+
+    memset(number, 0, sizeof(*number));
+    number->font = font;
+    number->chars = chars;
+    number->decimals = decimals;
+
+    // 比例字型也要對齊：每格用最寬的字
+    for (uint16_t i = 0; i < font->count; i++) {
+        if (font->widths[i] > number->cell)
+            number->cell = font->widths[i];
+    }
+
+    if (number->cell == 0 || chars * number->cell > SSD1306_WIDTH)
+        return HAL_ERROR;
+
+    return UiWidget_InitBase(&number->base, x, y, chars * number->cell, font->height);
+}
+
+/**
+ * @brief  設定定點數值，只重畫改變的字元
+ * @param  number: 數值欄位
+ * @param  value: 數值 x 10^decimals
+ * @retval 1 = 有重畫
+ */
+uint8_t UiNumber_Set(UiNumber_t *number, int32_t value)
+{
+    if (number == NULL)
+        return 0;
+
+    // 數值沒變就不需要格式化
+    if (number->base.valid && value == number->value)
+        return 0;
+
+    FixFmt_Buf_t digits;
+    char text[UI_NUMBER_MAX_CHARS + 1];
+    uint8_t length = FixFmt_Fixed(digits, value, number->decimals);
+
+    // 靠右對齊；放不下時整欄顯示 '?'
+    if (length > number->chars) {
+        memset(text, '?', number->chars);
+    } else {
+        memset(text, ' ', number->chars - length);
+        memcpy(&text[number->chars - length], digits, length);
+    }
+    text[number->chars] = '\0';
+
+    uint8_t changed = 0;
+    for (uint8_t i = 0; i < number->chars; i++) {
+        if (!number->base.valid || text[i] != number->text[i]) {
+            UiNumber_DrawCell(number, i, text[i]);
+            changed = 1;
+        }
+    }
+
+    memcpy(number->text, text, sizeof(text));
+    number->value = value;
+    number->base.valid = 1;
+    return changed;
+}
+
+/**
+ * @brief  設定浮點數值（先依小數位數四捨五入成定點數值）
+ * @param  number: 數值欄位
+ * @param  value: 數值
+ * @retval 1 = 有重畫
+ */
+uint8_t UiNumber_SetFloat(UiNumber_t *number, float value)
+{
+    if (number == NULL)
+        return 0;
+
+    return UiNumber_Set(number, FixFmt_Scale(value, number->decimals));
+}
+
+/**
+ * @brief  初始化長條圖
+ * @param  bar: 長條圖
+ * @param  x, y, width, height: 區域（含 1 像素外框）
+ * @param  min, max: 空/滿對應的數值
+ * @retval HAL狀態
+ */
+HAL_StatusTypeDef UiBar_Init(UiBar_t *bar, uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+                             int32_t min, int32_t max)
+{
+    if (bar == NULL || width < 3 || height < 3)
+        return HAL_ERROR;
+
+    memset(bar, 0, sizeof(*bar));
+    if (UiBar_SetRange(bar, min, max) != HAL_OK)
+        return HAL_ERROR;
+
+    return UiWidget_InitBase(&bar->base, x, y, width, height);
+}
+
+/**
+ * @brief  設定刻度，下一次 Set 依新刻度畫出增減的部分
+ * @param  bar: 長條圖
+ * @param  min, max: 空/滿對應的數值
+ * @retval HAL狀態
+ */
+HAL_StatusTypeDef UiBar_SetRange(UiBar_t *bar, int32_t min, int32_t max)
+{
+    if (bar == NULL || min >= max)
+        return HAL_ERROR;
+
+    bar->min = min;
+    bar->max = max;
+    return HAL_OK;
+}
+
+/**
+ * @brief  設定數值，只畫填滿長度的變化
+ * @param  bar: 長條圖
+ * @param  value: 數值，超出刻度時貼齊兩端
+ * @retval 1 = 有重畫
+ */
+uint8_t UiBar_Set(UiBar_t *bar, int32_t value)
+{
+    if (bar == NULL)
+        return 0;
+
+    const uint8_t inner = bar->base.width - 2;
+    uint8_t fill;
+
+    if (value <= bar->min) {
+        fill = 0;
+    } else if (value >= bar->max) {
+        fill = inner;
+    } else {
+        // 64 位元避免 mA 乘上寬度溢位
+        fill = (uint8_t)(((int64_t)(value - bar->min) * inner) / ((int64_t)bar->max - bar->min));
+    }
+
+    if (!bar->base.valid) {
+        ssd1306_DrawRectangle(bar->base.x, bar->base.y, bar->base.x + bar->base.width - 1,
+                              bar->base.y + bar->base.height - 1, White);
+        UiBar_FillColumns(bar, 0, inner, Black);
+        UiBar_FillColumns(bar, 0, fill, White);
+        bar->fill = fill;
+        bar->base.valid = 1;
+        return 1;
+    }
+
+    if (fill == bar->fill)
+        return 0;
+
+    if (fill > bar->fill)
+        UiBar_FillColumns(bar, bar->fill, fill, White);
+    else
+        UiBar_FillColumns(bar, fill, bar->fill, Black);
+
+    bar->fill = fill;
+    return 1;
+}
+
+/**
+ * @brief  初始化狀態圖示
+ * @param  icon: 圖示
+ * @param  x, y: 左上角
+ * @param  images: 每個狀態一張點陣圖
+ * @param  count: 狀態數
+ * @retval HAL狀態
+ */
+HAL_StatusTypeDef UiIcon_Init(UiIcon_t *icon, uint8_t x, uint8_t y,
+                              const uint8_t (*images)[UI_ICON_SIZE], uint8_t count)
+{
+    if (icon == NULL || images == NULL || count == 0)
+        return HAL_ERROR;
+
+    memset(icon, 0, sizeof(*icon));
+    icon->images = images;
+    icon->count = count;
+    return UiWidget_InitBase(&icon->base, x, y, UI_ICON_SIZE, UI_ICON_SIZE);
+}
+
+/**
+ * @brief  設定狀態，和上一次相同時不重畫
+ * @param  icon: 圖示
+ * @param  state: 狀態（0 ~ count - 1，超出時視為最後一個）
+ * @retval 1 = 有重畫
+ */
+uint8_t UiIcon_Set(UiIcon_t *icon, uint8_t state)
+{
+    if (icon == NULL)
+        return 0;
+
+    if (state >= icon->count)
+        state = icon->count - 1;
+
+    if (icon->base.valid && state == icon->state)
+        return 0;
+
+    UiWidget_Clear(&icon->base);
+    ssd1306_DrawBitmap(icon->base.x, icon->base.y, icon->images[state], UI_ICON_SIZE, UI_ICON_SIZE, White);
+    icon->state = state;
+    icon->base.valid = 1;
+    return 1;
+}
+
+// 檢查區域在畫面內
+static HAL_StatusTypeDef UiWidget_InitBase(UiWidget_t *widget, uint8_t x, uint8_t y,
+                                           uint8_t width, uint8_t height)
+{
+    if (width == 0 || height == 0 || x + width > SSD1306_WIDTH || y + height > SSD1306_HEIGHT)
+        return HAL_ERROR;
+
+    widget->x = x;
+    widget->y = y;
+    widget->width = width;
+    widget->height = height;
+    widget->valid = 0;
+    return HAL_OK;
+}
+
+// 畫第 index 格：清除整格再畫字（比例字型的字可能比格子窄）
+static void UiNumber_DrawCell(const UiNumber_t *number, uint8_t index, char ch)
+{
+    uint8_t x = number->base.x + index * number->cell;
+
+    ssd1306_FillRectangle(x, number->base.y, x + number->cell - 1,
+                          number->base.y + number->base.height - 1, Black);
+    if (ch == ' ')
+        return;
+
+    ssd1306_SetCursor(x, number->base.y);
+    ssd1306_WriteGlyph((uint8_t)ch, number->font, White);
+}
+
+// 填滿內部第 from ~ to - 1 行
+static void UiBar_FillColumns(const UiBar_t *bar, uint8_t from, uint8_t to, SSD1306_COLOR color)
+{
+    if (from >= to)
+        return;
+
+    ssd1306_FillRectangle(bar->base.x + 1 + from, bar->base.y + 1, bar->base.x + to,
+                          bar->base.y + bar->base.height - 2, color);
+}
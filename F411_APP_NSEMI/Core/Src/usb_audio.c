@@ -0,0 +1,302 @@
+/*
+ * usb_audio.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  USB 音訊輸入（UAC1 麥克風）
+ *
+ *  技術人員直接用電腦上的錄音/頻譜軟體看電流波形，不需要另外的主機程式。
+ *  主機選擇串流介面（開始錄音）時，USB 中斷以 Scheduler_Signal 觸發 audioctl 事件任務，
+ *  在主迴圈停用監控任務後以 USBD_AUDIO_IN_FREQ 啟動取樣；停止錄音時還原。
+ *  （不用 Scheduler_Defer：處理函數會 printf、啟動 ADC，不能在 PendSV 執行）
+ *
+ *  資料流：取樣區塊回呼（ADC DMA 中斷）把 12 位元樣本去掉中點、放大成 16 位元
+ *  PCM，寫進環形緩衝區（位置 = 全域樣本索引）；每個 SOF（USB 中斷，1 ms）
+ *  由 UsbAudio_Fill 取出下一個封包。兩個中斷同優先權，不需要關中斷。
+ *
+ *  速率配合（非同步端點）：取樣時脈來自本機晶振，和主機的 SOF 時脈差幾十 ppm，
+ *  固定每 frame 48 個樣本時，長時間錄音會慢慢多出或少掉樣本。
+ *    - 每 2^USB_AUDIO_FB_WINDOW_LOG2 個 SOF 讀一次 DMA 位置（精確到單一樣本），
+ *      視窗內的樣本數就是以 SOF 量到的每 frame 樣本數（16.16），
+ *      封包長度依此累加小數，平均剛好等於實際取樣速度（47/48/49 個樣本）。
+ *    - 水位（已取樣未送出，含 DMA 還在寫的半區）偏離目標超過 USB_AUDIO_TRIM_BAND
+ *      時多送/少送一個樣本，修正量測誤差與啟動時的偏移。
+ *  主機漏收的封包由 class 在下一個 SOF 重送，樣本不重複也不遺失；只有主機
+ *  長時間不收（環形緩衝區滿）時才會丟棄最舊的樣本，計入 overflows。
+ */
+#include "main.h"
+#include "usb_audio.h"
+#include "usbd_audio_in_if.h"
+#include "scheduler.h"
+#include <string.h>
+
+#define USB_AUDIO_RING_MASK     (USB_AUDIO_RING_FRAMES - 1)
+// 水位修正的死區（樣本數）
+#define USB_AUDIO_TRIM_BAND     8
+// 12 位元 ADC 中點（ACS712 零電流輸出約在 VCC/2）
+#define USB_AUDIO_ADC_MID       2048
+// 12 位元放大到 16 位元
+#define USB_AUDIO_GAIN          16
+// 標稱每 frame 樣本數，16.16
+#define USB_AUDIO_NOMINAL_FB    (((USBD_AUDIO_IN_FREQ / 1000U) << 16) + \
+                                 (((USBD_AUDIO_IN_FREQ % 1000U) << 16) / 1000U))
+
+/* 私有變數 */
+static int16_t audio_ring[USB_AUDIO_RING_FRAMES * USBD_AUDIO_IN_CHANNELS];
+static uint32_t audio_write = 0;                // 已寫入的下一個全域樣本索引
+static uint32_t audio_read = 0;                 // 下一個要送出的全域樣本索引
+static uint32_t audio_fb = USB_AUDIO_NOMINAL_FB;
+static uint32_t audio_fb_acc = 0;               // 封包長度的小數累加
+static uint32_t audio_fb_index = 0;             // 量測視窗起點的樣本索引
+static uint16_t audio_fb_sofs = 0;
+static uint8_t audio_primed = 0;                // 水位到達目標後才開始送資料
+static volatile uint8_t audio_configured = 0;
+static volatile uint8_t audio_active = 0;
+static volatile uint8_t audio_streaming = 0;
+static volatile uint8_t audio_control_pending = 0;
+static UsbAudio_Handler_t audio_handler = NULL;
+static Sched_TaskId_t audio_control_task = SCHED_INVALID_TASK;
+static UsbAudio_Stats_t audio_stats;
+
+/* 私有函數 */
+static void UsbAudio_Consumer(const Acq_Block_t *block, void *context);
+static void UsbAudio_ControlTask(void *context);
+
+/**
+ * @brief  初始化
+ * @param  handler: 主機開始/停止錄音時的處理函數（audioctl 事件任務在主迴圈呼叫）
+ * @retval HAL狀態
+ */
+HAL_StatusTypeDef UsbAudio_Init(UsbAudio_Handler_t handler)
+{
+    if (handler == NULL)
+        return HAL_ERROR;
+
+    audio_handler = handler;
+    memset(&audio_stats, 0, sizeof(audio_stats));
+
+    audio_control_task = Scheduler_AddEvent("audioctl", UsbAudio_ControlTask, NULL,
+                                            SCHED_PRIO_NORMAL, USB_AUDIO_CONTROL_DEADLINE_MS);
+    if (audio_control_task == SCHED_INVALID_TASK)
+        return HAL_ERROR;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief  以 USBD_AUDIO_IN_FREQ 開始取樣，資料交給 SOF 送出
+ * @retval HAL狀態，已在取樣時回傳 HAL_BUSY
+ */
+HAL_StatusTypeDef UsbAudio_Start(void)
+{
+    if (audio_streaming)
+        return HAL_BUSY;
+
+    Acq_Config_t config;
+    Acquisition_GetDefaultConfig(&config);
+    config.sample_rate_hz = USBD_AUDIO_IN_FREQ;
+    config.channels = USBD_AUDIO_IN_CHANNELS;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    audio_write = 0;
+    audio_read = 0;
+    audio_fb = USB_AUDIO_NOMINAL_FB;
+    audio_fb_acc = 0;
+    audio_fb_index = 0;
+    audio_fb_sofs = 0;
+    audio_primed = 0;
+    audio_stats.frames = 0;
+    audio_stats.underruns = 0;
+    audio_stats.overflows = 0;
+    audio_stats.trims = 0;
+    audio_streaming = 1;
+    __set_PRIMASK(primask);
+
+    if (Acquisition_Register(UsbAudio_Consumer, NULL) != HAL_OK ||
+        Acquisition_Start(&config) != HAL_OK) {
+        UsbAudio_Stop();
+        return HAL_ERROR;
+    }
+
+    return HAL_OK;
+}
+
+/**
+ * @brief  停止取樣；之後的 SOF 送零長度封包
+ * @retval None
+ */
+void UsbAudio_Stop(void)
+{
+    if (!audio_streaming)
+        return;
+
+    Acquisition_Unregister(UsbAudio_Consumer);
+    Acquisition_Stop();
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    audio_streaming = 0;
+    __set_PRIMASK(primask);
+}
+
+uint8_t UsbAudio_IsStreaming(void)
+{
+    return audio_streaming;
+}
+
+void UsbAudio_GetStats(UsbAudio_Stats_t *stats)
+{
+    if (stats == NULL)
+        return;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *stats = audio_stats;
+    uint32_t fb = audio_fb;
+    __set_PRIMASK(primask);
+
+    stats->configured = audio_configured;
+    stats->active = audio_active;
+    stats->streaming = audio_streaming;
+    // 每 frame 樣本數 (16.16) x 1000 frame/s，換成 0.001 Hz
+    stats->rate_milli_hz = (uint32_t)(((uint64_t)fb * 1000000U) >> 16);
+    AUDIO_IN_GetCounters_FS(&stats->packets, &stats->resent);
+}
+
+/**
+ * @brief  USB 設定/取消設定（AUDIO_IN Init/DeInit，USB 中斷）
+ * @param  configured: 1 = 已設定
+ * @retval None
+ */
+void UsbAudio_SetConfigured(uint8_t configured)
+{
+    audio_configured = configured;
+    if (!configured)
+        UsbAudio_SetActive(0);
+}
+
+/**
+ * @brief  主機切換串流介面（USB 中斷）：啟動/停止交給 audioctl 事件任務
+ * @param  active: 1 = 開始錄音
+ * @retval None
+ */
+void UsbAudio_SetActive(uint8_t active)
+{
+    audio_active = active;
+
+    // 任務執行時以最新狀態為準，連續切換只需要排一次
+    if (audio_control_pending || audio_control_task == SCHED_INVALID_TASK)
+        return;
+
+    audio_control_pending = 1;
+    Scheduler_Signal(audio_control_task);
+}
+
+/**
+ * @brief  填下一個封包（SOF，USB 中斷）
+ * @param  buffer: 封包緩衝區
+ * @param  max_len: 緩衝區大小
+ * @retval 封包長度 (bytes)，尚未取樣或水位未到時為 0
+ */
+uint16_t UsbAudio_Fill(uint8_t *buffer, uint16_t max_len)
+{
+    if (!audio_streaming)
+        return 0;
+
+    uint32_t index = Acquisition_GetSampleIndex();
+
+    // 以 SOF 量測：一個視窗內的樣本數 / SOF 數 = 每 frame 樣本數
+    if (++audio_fb_sofs >= (1U << USB_AUDIO_FB_WINDOW_LOG2)) {
+        audio_fb = (index - audio_fb_index) << (16 - USB_AUDIO_FB_WINDOW_LOG2);
+        audio_fb_index = index;
+        audio_fb_sofs = 0;
+    }
+
+    uint32_t level = index - audio_read;
+    audio_stats.level = (uint16_t)level;
+    if (!audio_primed) {
+        if (level < USB_AUDIO_TARGET_FRAMES)
+            return 0;
+        audio_primed = 1;
+    }
+
+    audio_fb_acc += audio_fb;
+    uint32_t frames = audio_fb_acc >> 16;
+    audio_fb_acc &= 0xFFFF;
+
+    if (level > USB_AUDIO_TARGET_FRAMES + USB_AUDIO_TRIM_BAND) {
+        frames++;
+        audio_stats.trims++;
+    } else if (level + USB_AUDIO_TRIM_BAND < USB_AUDIO_TARGET_FRAMES && frames > 0) {
+        frames--;
+        audio_stats.trims++;
+    }
+
+    if (frames > max_len / AUDIO_IN_FRAME_SIZE)
+        frames = max_len / AUDIO_IN_FRAME_SIZE;
+
+    uint32_t available = audio_write - audio_read;
+    if (frames > available) {
+        frames = available;
+        audio_stats.underruns++;
+    }
+
+    // 環形緩衝區可能折返，分兩段複製
+    uint32_t start = audio_read & USB_AUDIO_RING_MASK;
+    uint32_t first = USB_AUDIO_RING_FRAMES - start;
+    if (first > frames)
+        first = frames;
+    memcpy(buffer, &audio_ring[start * USBD_AUDIO_IN_CHANNELS], first * AUDIO_IN_FRAME_SIZE);
+    memcpy(buffer + first * AUDIO_IN_FRAME_SIZE, audio_ring, (frames - first) * AUDIO_IN_FRAME_SIZE);
+
+    audio_read += frames;
+    audio_stats.frames += frames;
+    return (uint16_t)(frames * AUDIO_IN_FRAME_SIZE);
+}
+
+/**
+ * @brief  取樣區塊回呼（ADC DMA 中斷）：轉成 16 位元 PCM 寫進環形緩衝區
+ * @param  block: 取樣區塊
+ * @param  context: 未使用
+ * @retval None
+ */
+static void UsbAudio_Consumer(const Acq_Block_t *block, void *context)
+{
+    (void)context;
+
+    if (!audio_streaming || block->channels != USBD_AUDIO_IN_CHANNELS)
+        return;
+
+    const uint16_t *src = block->data;
+    for (uint16_t i = 0; i < block->samples; i++) {
+        int16_t *dst = &audio_ring[((block->first_index + i) & USB_AUDIO_RING_MASK) * USBD_AUDIO_IN_CHANNELS];
+        for (uint8_t c = 0; c < USBD_AUDIO_IN_CHANNELS; c++)
+            dst[c] = (int16_t)(((int32_t)*src++ - USB_AUDIO_ADC_MID) * USB_AUDIO_GAIN);
+    }
+
+    audio_write = block->first_index + block->samples;
+
+    // 主機太久沒收：最舊的樣本已被覆寫，讀取位置跟上
+    if (audio_write - audio_read > USB_AUDIO_RING_FRAMES) {
+        audio_stats.overflows += audio_write - USB_AUDIO_RING_FRAMES - audio_read;
+        audio_read = audio_write - USB_AUDIO_RING_FRAMES;
+    }
+}
+
+/**
+ * @brief  依主機目前的介面設定啟動/停止取樣（audioctl 事件任務，主迴圈）
+ * @param  context: 未使用
+ * @retval None
+ */
+static void UsbAudio_ControlTask(void *context)
+{
+    (void)context;
+
+    audio_control_pending = 0;
+
+    uint8_t want = audio_configured && audio_active;
+    if (want != audio_streaming && audio_handler != NULL)
+        audio_handler(want);
+}
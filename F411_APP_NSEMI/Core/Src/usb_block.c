@@ -0,0 +1,167 @@
+/*
+ * usb_block.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  USB 取樣區塊佇列（usb_stream.c 與 usb_hid.c 共用）
+ *
+ *  取樣區塊回呼（ADC DMA 中斷）只填 header，樣本不打包也不複製，傳送直接讀
+ *  乒乓緩衝區剛完成的那一半。兩個槽位對應乒乓緩衝區的兩半：DMA 開始覆寫某一半時，
+ *  還在佇列中的區塊直接丟棄，已經在傳送的計為 torn，並累加進下一個 header 的
+ *  overruns，接收端可以知道哪段資料不可信。
+ *
+ *  每筆傳送先送 header，傳送完成中斷再接著送樣本。端點上還有其他資料（遙測、
+ *  狀態報告、bench）由呼叫端決定先後，這裡只處理區塊本身。
+ *  除了 Clear / Cancel 以外都只能在 USB / ADC DMA 中斷或遮蔽中斷時呼叫。
+ */
+#include "main.h"
+#include "usb_block.h"
+#include "usbd_def.h"
+#include <string.h>
+
+/**
+ * @brief  開始串流：清除槽位與統計
+ * @param  queue: 區塊佇列
+ * @retval None
+ */
+void UsbBlock_Clear(UsbBlock_Queue_t *queue)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    memset(queue->slots, 0, sizeof(queue->slots));
+    queue->blocks = 0;
+    queue->dropped = 0;
+    queue->torn = 0;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  停止串流：丟棄還在等待的區塊，傳送中的會送完（取樣已停，資料不會再變）
+ * @param  queue: 區塊佇列
+ * @retval None
+ */
+void UsbBlock_Cancel(UsbBlock_Queue_t *queue)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    for (uint8_t i = 0; i < 2; i++) {
+        if (queue->slots[i].state == USB_BLOCK_QUEUED)
+            queue->slots[i].state = USB_BLOCK_FREE;
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  USB 設定/取消設定：進行中的傳送已被 USB 核心捨棄，釋放所有槽位
+ * @param  queue: 區塊佇列
+ * @retval None
+ */
+void UsbBlock_Abort(UsbBlock_Queue_t *queue)
+{
+    queue->slots[0].state = USB_BLOCK_FREE;
+    queue->slots[1].state = USB_BLOCK_FREE;
+}
+
+/**
+ * @brief  取樣區塊回呼內呼叫：填 header 並排入佇列，呼叫端接著啟動傳送
+ * @param  queue: 區塊佇列
+ * @param  block: 取樣區塊
+ * @retval None
+ */
+void UsbBlock_Put(UsbBlock_Queue_t *queue, const Acq_Block_t *block)
+{
+    UsbBlock_Slot_t *slot = &queue->slots[block->sequence & 1U];
+    UsbBlock_Slot_t *prev = &queue->slots[(block->sequence + 1U) & 1U];
+    Acq_Status_t status;
+
+    // DMA 現在開始覆寫上一個區塊所在的那一半
+    if (prev->state == USB_BLOCK_QUEUED) {
+        prev->state = USB_BLOCK_FREE;
+        queue->dropped++;
+    } else if (prev->state == USB_BLOCK_SENDING) {
+        queue->torn++;
+    }
+
+    // 前前一個區塊還沒送完（主機沒有在讀）
+    if (slot->state != USB_BLOCK_FREE) {
+        queue->dropped++;
+        return;
+    }
+
+    Acquisition_GetStatus(&status);
+
+    Tlm_StreamHeader_t *header = &slot->header;
+    header->sync = TLM_STREAM_SYNC;
+    header->channels = block->channels;
+    header->bits = TLM_STREAM_BITS_RAW;
+    header->sequence = block->sequence;
+    header->first_index = block->first_index;
+    header->sample_rate_hz = status.sample_rate_hz;
+    header->samples = block->samples;
+    header->payload_bytes = (uint16_t)(block->samples * block->channels * sizeof(uint16_t));
+    header->dropped = (uint16_t)queue->dropped;
+    header->overruns = (uint16_t)(status.overruns + queue->torn);
+
+    slot->data = block->data;
+    slot->bytes = header->payload_bytes;
+    slot->state = USB_BLOCK_QUEUED;
+}
+
+// 是否有區塊等待傳送
+uint8_t UsbBlock_Pending(const UsbBlock_Queue_t *queue)
+{
+    return (queue->slots[0].state == USB_BLOCK_QUEUED ||
+            queue->slots[1].state == USB_BLOCK_QUEUED) ? 1 : 0;
+}
+
+/**
+ * @brief  送出下一個區塊的 header，兩個槽位都在等待時先送序號小的
+ * @param  queue: 區塊佇列
+ * @retval 1 = 已開始傳送，0 = 沒有區塊或端點還在忙（區塊留在佇列，下一次再試）
+ */
+uint8_t UsbBlock_SendHeader(UsbBlock_Queue_t *queue)
+{
+    uint8_t s = queue->send_slot;
+    if (queue->slots[s].state != USB_BLOCK_QUEUED ||
+        (queue->slots[s ^ 1U].state == USB_BLOCK_QUEUED &&
+         (int32_t)(queue->slots[s ^ 1U].header.sequence - queue->slots[s].header.sequence) < 0)) {
+        s ^= 1U;
+    }
+
+    UsbBlock_Slot_t *slot = &queue->slots[s];
+    if (slot->state != USB_BLOCK_QUEUED)
+        return 0;
+
+    queue->send_slot = s;
+    slot->state = USB_BLOCK_SENDING;
+    if (queue->transmit((uint8_t *)&slot->header, queue->header_len) == USBD_OK)
+        return 1;
+
+    slot->state = USB_BLOCK_QUEUED;
+    return 0;
+}
+
+/**
+ * @brief  header 傳送完成：接著送樣本
+ * @param  queue: 區塊佇列
+ * @retval 1 = 已開始傳送，0 = 失敗（區塊計為 dropped）
+ */
+uint8_t UsbBlock_SendData(UsbBlock_Queue_t *queue)
+{
+    UsbBlock_Slot_t *slot = &queue->slots[queue->send_slot];
+
+    if (queue->transmit((uint8_t *)slot->data, slot->bytes) == USBD_OK)
+        return 1;
+
+    slot->state = USB_BLOCK_FREE;
+    queue->dropped++;
+    return 0;
+}
+
+// 樣本傳送完成：釋放槽位
+void UsbBlock_Sent(UsbBlock_Queue_t *queue)
+{
+    queue->slots[queue->send_slot].state = USB_BLOCK_FREE;
+    queue->blocks++;
+}
@@ -0,0 +1,364 @@
+/*
+ * usb_hid.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  USB 通用 HID
+ *
+ *  產線電腦常常不能安裝 CDC 驅動，vendor-defined HID 由作業系統內建驅動處理，
+ *  主機程式以 hidapi 之類的函式庫直接讀寫報告。報告固定 64 bytes、bInterval = 1 ms，
+ *  每個方向每 1 ms 一個報告，上限 64 KB/s。
+ *
+ *  IN 區塊：和 usb_stream.c 共用 usb_block.c 的佇列，取樣區塊回呼（ADC DMA 中斷）
+ *  只填 header 報告（補滿 64 bytes），樣本不打包也不複製，接著以一次多封包的
+ *  interrupt 傳輸直接讀乒乓緩衝區（64 個樣本 = 2 個報告）。一個區塊佔
+ *  1 + 2 * channels 個 frame，單通道最高約 21 kHz；取樣更快時多出的區塊計為 dropped。
+ *
+ *  IN 狀態：hid 任務（SCHED_PRIO_LOW）依設定間隔填 Tlm_HidStatus_t，
+ *  優先於下一個區塊送出。
+ *
+ *  OUT 指令：USB 中斷只把報告複製出來，以 Scheduler_Signal 觸發 hidcmd 事件任務，
+ *  在主迴圈處理（不用 Scheduler_Defer：PendSV 內 printf 會被丟棄，也不能等待
+ *  USB 傳輸）。START / STOP 由 main.c 的處理函數執行（要同時停用輪詢 ADC 的監控任務）。
+ *
+ *  複合裝置（usbd_conf.h 的 USBD_APP_COMPOSITE）：CDC 埠開啟時區塊走 CDC bulk，
+ *  HID 端點只剩狀態與指令，兩者有各自的 TX FIFO，控制路徑不會排在串流後面。
+ */
+#include "main.h"
+#include "usb_hid.h"
+#include "usbd_hid_if.h"
+#include "usb_block.h"
+#include "scheduler.h"
+#include "telemetry.h"
+#include "usb_stream.h"
+#include <string.h>
+
+// 狀態報告狀態
+#define USB_HID_FREE            0
+#define USB_HID_QUEUED          1
+#define USB_HID_SENDING         2
+
+// 正在傳送的內容
+#define USB_HID_TX_NONE         0
+#define USB_HID_TX_HEADER       1
+#define USB_HID_TX_DATA         2
+#define USB_HID_TX_STATUS       3
+
+/* 私有變數 */
+static UsbBlock_Queue_t hid_blocks = USB_BLOCK_QUEUE_INIT(HID_Transmit_FS, TLM_HID_REPORT_SIZE);
+static Tlm_HidStatus_t hid_status;
+static volatile uint8_t hid_status_state = USB_HID_FREE;
+static Tlm_HidCommand_t hid_command;
+static volatile uint8_t hid_command_pending = 0;
+static volatile uint8_t hid_tx = USB_HID_TX_NONE;
+static volatile uint8_t hid_configured = 0;
+static volatile uint8_t hid_streaming = 0;
+static uint8_t hid_last_cmd = 0;
+static uint8_t hid_last_tag = 0;
+static uint8_t hid_last_result = 0;
+static uint16_t hid_status_ticks = USB_HID_STATUS_MS / USB_HID_TICK_MS;
+static uint16_t hid_status_count = 0;
+static const Current_Monitor_t *hid_monitor = NULL;
+static UsbHid_Handler_t hid_handler = NULL;
+static Sched_TaskId_t hid_command_task = SCHED_INVALID_TASK;
+static UsbHid_Stats_t hid_stats;
+
+/* 私有函數 */
+static void UsbHid_Consumer(const Acq_Block_t *block, void *context);
+static void UsbHid_StatusTask(void *context);
+static void UsbHid_CommandTask(void *context);
+static void UsbHid_Kick(void);
+
+TLM_STATIC_ASSERT((ACQ_BLOCK_SAMPLES * sizeof(uint16_t)) % TLM_HID_REPORT_SIZE == 0,
+                  "sample blocks must fill whole HID reports");
+
+/**
+ * @brief  初始化：建立狀態任務與指令事件任務
+ * @param  monitor: 狀態報告使用的監控結構（必須一直有效）
+ * @param  handler: START / STOP 指令處理函數
+ * @retval HAL狀態
+ * @note   必須在 Scheduler_Init 之後呼叫
+ */
+HAL_StatusTypeDef UsbHid_Init(const Current_Monitor_t *monitor, UsbHid_Handler_t handler)
+{
+    if (monitor == NULL || handler == NULL)
+        return HAL_ERROR;
+
+    hid_monitor = monitor;
+    hid_handler = handler;
+    memset(&hid_stats, 0, sizeof(hid_stats));
+
+    if (Scheduler_AddPeriodic("hid", UsbHid_StatusTask, NULL, SCHED_PRIO_LOW,
+                              USB_HID_TICK_MS, 9) == SCHED_INVALID_TASK)
+        return HAL_ERROR;
+
+    hid_command_task = Scheduler_AddEvent("hidcmd", UsbHid_CommandTask, NULL,
+                                          SCHED_PRIO_NORMAL, USB_HID_COMMAND_DEADLINE_MS);
+    if (hid_command_task == SCHED_INVALID_TASK)
+        return HAL_ERROR;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief  開始區塊串流（主機必須已設定裝置）
+ * @param  config: 取樣設定
+ * @retval HAL狀態，未設定或已在串流時回傳 HAL_BUSY
+ */
+HAL_StatusTypeDef UsbHid_Start(const Acq_Config_t *config)
+{
+    if (config == NULL)
+        return HAL_ERROR;
+    if (!hid_configured || hid_streaming)
+        return HAL_BUSY;
+
+    UsbBlock_Clear(&hid_blocks);
+    hid_streaming = 1;
+
+    if (Acquisition_Register(UsbHid_Consumer, NULL) != HAL_OK ||
+        Acquisition_Start(config) != HAL_OK) {
+        UsbHid_Stop();
+        return HAL_ERROR;
+    }
+
+    return HAL_OK;
+}
+
+/**
+ * @brief  停止區塊串流；傳送中的區塊會送完（取樣已停，資料不會再變）
+ * @retval None
+ */
+void UsbHid_Stop(void)
+{
+    if (!hid_streaming)
+        return;
+
+    Acquisition_Unregister(UsbHid_Consumer);
+    Acquisition_Stop();
+
+    UsbBlock_Cancel(&hid_blocks);
+    hid_streaming = 0;
+}
+
+uint8_t UsbHid_IsStreaming(void)
+{
+    return hid_streaming;
+}
+
+void UsbHid_GetStats(UsbHid_Stats_t *stats)
+{
+    if (stats == NULL)
+        return;
+
+    *stats = hid_stats;
+    stats->blocks = hid_blocks.blocks;
+    stats->dropped = hid_blocks.dropped;
+    stats->torn = hid_blocks.torn;
+    stats->configured = hid_configured;
+    stats->streaming = hid_streaming;
+}
+
+/**
+ * @brief  USB 設定/取消設定（HID Init/DeInit，USB 中斷）：進行中的傳送已被 USB 核心捨棄
+ * @param  configured: 1 = 已設定
+ * @retval None
+ */
+void UsbHid_SetConfigured(uint8_t configured)
+{
+    hid_tx = USB_HID_TX_NONE;
+    UsbBlock_Abort(&hid_blocks);
+    hid_status_state = USB_HID_FREE;
+    hid_configured = configured;
+}
+
+/**
+ * @brief  收到 OUT 報告（USB 中斷）：複製後觸發 hidcmd 任務在主迴圈處理
+ * @param  report: 報告（回傳後端點會重新接收，不能保留指標）
+ * @param  len: 長度
+ * @retval None
+ */
+void UsbHid_Received(const uint8_t *report, uint16_t len)
+{
+    hid_stats.commands++;
+
+    if (hid_command_pending || len == 0) {
+        hid_stats.command_drops++;
+        return;
+    }
+
+    if (len > sizeof(hid_command))
+        len = sizeof(hid_command);
+    memset(&hid_command, 0, sizeof(hid_command));
+    memcpy(&hid_command, report, len);
+
+    if (hid_command_task == SCHED_INVALID_TASK) {
+        hid_stats.command_drops++;
+        return;
+    }
+
+    hid_command_pending = 1;
+    Scheduler_Signal(hid_command_task);
+}
+
+/**
+ * @brief  IN 傳輸完成（USB 中斷）：區塊 header 之後接著送樣本
+ * @retval None
+ */
+void UsbHid_TxComplete(void)
+{
+    uint8_t done = hid_tx;
+
+    hid_tx = USB_HID_TX_NONE;
+
+    switch (done) {
+    case USB_HID_TX_HEADER:
+        hid_tx = USB_HID_TX_DATA;
+        if (UsbBlock_SendData(&hid_blocks))
+            return;
+        hid_tx = USB_HID_TX_NONE;
+        break;
+
+    case USB_HID_TX_DATA:
+        UsbBlock_Sent(&hid_blocks);
+        break;
+
+    case USB_HID_TX_STATUS:
+        hid_status_state = USB_HID_FREE;
+        hid_stats.status_reports++;
+        break;
+
+    default:
+        break;
+    }
+
+    UsbHid_Kick();
+}
+
+/**
+ * @brief  取樣區塊回呼（ADC DMA 中斷）：區塊排入佇列後啟動傳送
+ * @param  block: 取樣區塊
+ * @param  context: 未使用
+ * @retval None
+ */
+static void UsbHid_Consumer(const Acq_Block_t *block, void *context)
+{
+    (void)context;
+
+    UsbBlock_Put(&hid_blocks, block);
+    UsbHid_Kick();
+}
+
+/**
+ * @brief  狀態任務：到了報告間隔且上一個狀態報告已送出時填入新的報告
+ * @param  context: 未使用
+ * @retval None
+ */
+static void UsbHid_StatusTask(void *context)
+{
+    (void)context;
+
+    if (!hid_configured || hid_status_ticks == 0)
+        return;
+    if (++hid_status_count < hid_status_ticks)
+        return;
+    if (hid_status_state != USB_HID_FREE)
+        return;
+
+    hid_status_count = 0;
+
+    Acq_Status_t acq;
+    Acquisition_GetStatus(&acq);
+
+    memset(&hid_status, 0, sizeof(hid_status));
+    hid_status.sync = TLM_HID_SYNC_STATUS;
+    hid_status.last_cmd = hid_last_cmd;
+    hid_status.last_tag = hid_last_tag;
+    hid_status.last_result = hid_last_result;
+    hid_status.time_ms = HAL_GetTick();
+    Telemetry_FillStats(hid_monitor, &hid_status.stats);
+    hid_status.commands = hid_stats.commands;
+    if (UsbStream_GetMode() == USB_STREAM_SAMPLES) {
+        UsbStream_Stats_t usb;
+        UsbStream_GetStats(&usb);
+        hid_status.streaming = TLM_HID_STREAM_CDC;
+        hid_status.blocks = usb.blocks;
+        hid_status.dropped = usb.dropped;
+        hid_status.torn = usb.torn;
+        hid_status.sample_rate_hz = acq.sample_rate_hz;
+    } else {
+        hid_status.streaming = hid_streaming ? TLM_HID_STREAM_HID : TLM_HID_STREAM_NONE;
+        hid_status.blocks = hid_blocks.blocks;
+        hid_status.dropped = hid_blocks.dropped;
+        hid_status.torn = hid_blocks.torn;
+        hid_status.sample_rate_hz = hid_streaming ? acq.sample_rate_hz : 0;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    hid_status_state = USB_HID_QUEUED;
+    UsbHid_Kick();
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  處理 OUT 指令（hidcmd 事件任務，主迴圈）
+ * @param  context: 未使用
+ * @retval None
+ */
+static void UsbHid_CommandTask(void *context)
+{
+    (void)context;
+
+    Tlm_HidCommand_t command = hid_command;
+    HAL_StatusTypeDef result = HAL_OK;
+
+    hid_command_pending = 0;
+
+    switch (command.cmd) {
+    case TLM_HID_CMD_START:
+    case TLM_HID_CMD_STOP:
+        result = hid_handler(&command);
+        break;
+
+    case TLM_HID_CMD_STATUS:
+        // 以任務週期為單位，不足一個週期的進位
+        hid_status_ticks = (uint16_t)((command.arg + USB_HID_TICK_MS - 1) / USB_HID_TICK_MS);
+        hid_status_count = 0;
+        break;
+
+    default:
+        result = HAL_ERROR;
+        break;
+    }
+
+    hid_last_cmd = command.cmd;
+    hid_last_tag = command.tag;
+    hid_last_result = (uint8_t)result;
+}
+
+/**
+ * @brief  端點閒置時啟動下一筆傳送：狀態報告優先，其次是取樣區塊
+ * @retval None
+ * @note   只能在 USB / ADC DMA 中斷或遮蔽中斷時呼叫
+ */
+static void UsbHid_Kick(void)
+{
+    if (hid_tx != USB_HID_TX_NONE || !hid_configured)
+        return;
+
+    if (hid_status_state == USB_HID_QUEUED) {
+        hid_status_state = USB_HID_SENDING;
+        hid_tx = USB_HID_TX_STATUS;
+        if (HID_Transmit_FS((uint8_t *)&hid_status, sizeof(hid_status)) == USBD_OK)
+            return;
+
+        // 端點還在忙（reset 之後），下一次再試
+        hid_tx = USB_HID_TX_NONE;
+        hid_status_state = USB_HID_QUEUED;
+    } else if (UsbBlock_Pending(&hid_blocks)) {
+        hid_tx = USB_HID_TX_HEADER;
+        if (!UsbBlock_SendHeader(&hid_blocks))
+            hid_tx = USB_HID_TX_NONE;
+    }
+}
@@ -0,0 +1,343 @@
+/*
+ * usb_stream.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  USB CDC-ACM 串流
+ *
+ *  USB FS 原本只註冊了用不到的 HID 滑鼠類別。現在改成 CDC-ACM（虛擬序列埠），
+ *  資料走 64 bytes bulk IN 端點，一個 1 ms frame 最多可送 19 個封包，
+ *  實際約 1 MB/s，是 USART6 raw_stream（2.25 Mbaud）的四倍以上，而且不必換鮑率。
+ *
+ *  取樣模式：取樣區塊回呼（ADC DMA 中斷）只填一個 24 bytes 的 header，
+ *  樣本不打包也不複製，bulk 傳輸直接讀乒乓緩衝區剛完成的那一半
+ *  （OTG FS 沒有 DMA，由 OTG 中斷把資料寫進端點 FIFO）。槽位、丟棄與 torn 的處理
+ *  在 usb_block.c，和 usb_hid.c 共用。
+ *
+ *  平常模式：Telemetry_Send 在主機開啟序列埠（DTR）時把 COBS 訊框寫進這裡的
+ *  環形緩衝區，傳送完成中斷接著送出，UART 只剩文字 log。
+ *
+ *  bench 模式：重複送出環形緩衝區（測試樣式），量測實際吞吐量。
+ *
+ *  所有 USB 傳送都在 USB 中斷或遮蔽中斷下啟動；ADC DMA 與 OTG FS 中斷同為優先權 0，
+ *  不會互相搶佔。格式見 telemetry_protocol.h（bits = TLM_STREAM_BITS_RAW）。
+ */
+#include "main.h"
+#include "usb_stream.h"
+#include "usb_block.h"
+#include "usbd_cdc_if.h"
+#include "telemetry_protocol.h"
+#include <string.h>
+
+// 正在傳送的內容
+#define USB_TX_NONE             0
+#define USB_TX_HEADER           1
+#define USB_TX_DATA             2
+#define USB_TX_RING             3
+#define USB_TX_BENCH            4
+
+#define USB_RING_MASK           (USB_STREAM_RING_SIZE - 1U)
+
+/* 私有變數 */
+static UsbBlock_Queue_t usb_blocks = USB_BLOCK_QUEUE_INIT(CDC_Transmit_FS, sizeof(Tlm_StreamHeader_t));
+static uint8_t usb_ring[USB_STREAM_RING_SIZE];
+static volatile uint32_t usb_ring_head = 0;     // 主程式寫入（自由遞增）
+static volatile uint32_t usb_ring_tail = 0;     // 傳送完成時推進
+static uint32_t usb_ring_inflight = 0;
+static volatile uint8_t usb_tx = USB_TX_NONE;
+static volatile uint8_t usb_host_open = 0;
+static volatile uint8_t usb_mode = USB_STREAM_IDLE;
+static uint32_t usb_bench_start;
+static uint32_t usb_bench_duration;
+static UsbStream_Stats_t usb_stats;
+
+/* 私有函數 */
+static void UsbStream_Consumer(const Acq_Block_t *block, void *context);
+static void UsbStream_Kick(void);
+static void UsbStream_KickLocked(void);
+
+TLM_STATIC_ASSERT((USB_STREAM_RING_SIZE & (USB_STREAM_RING_SIZE - 1)) == 0,
+                  "USB_STREAM_RING_SIZE must be a power of 2");
+
+/**
+ * @brief  開始取樣串流（主機必須已開啟序列埠）
+ * @param  config: 取樣設定
+ * @retval HAL狀態，序列埠未開啟或正在 bench 時回傳 HAL_BUSY
+ */
+HAL_StatusTypeDef UsbStream_Start(const Acq_Config_t *config)
+{
+    if (config == NULL)
+        return HAL_ERROR;
+    if (!usb_host_open || usb_mode != USB_STREAM_IDLE)
+        return HAL_BUSY;
+
+    // 不等待剩下的遙測：UsbStream_Kick 會先把環形緩衝區送完才送區塊
+    UsbBlock_Clear(&usb_blocks);
+    usb_mode = USB_STREAM_SAMPLES;
+
+    if (Acquisition_Register(UsbStream_Consumer, NULL) != HAL_OK ||
+        Acquisition_Start(config) != HAL_OK) {
+        UsbStream_Stop();
+        return HAL_ERROR;
+    }
+
+    return HAL_OK;
+}
+
+/**
+ * @brief  停止取樣串流，回到遙測模式；傳送中的區塊會送完（取樣已停，資料不會再變）
+ * @retval None
+ */
+void UsbStream_Stop(void)
+{
+    if (usb_mode != USB_STREAM_SAMPLES)
+        return;
+
+    Acquisition_Unregister(UsbStream_Consumer);
+    Acquisition_Stop();
+
+    UsbBlock_Cancel(&usb_blocks);
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    usb_mode = USB_STREAM_IDLE;
+    UsbStream_Kick();
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  吞吐量測試：持續送出測試樣式，時間到後結果見 UsbStream_GetStats
+ * @param  duration_ms: 測試時間
+ * @retval HAL狀態，序列埠未開啟、正在串流或遙測尚未送完時回傳 HAL_BUSY
+ */
+HAL_StatusTypeDef UsbStream_StartBench(uint32_t duration_ms)
+{
+    if (duration_ms == 0)
+        return HAL_ERROR;
+    if (!usb_host_open || usb_mode != USB_STREAM_IDLE || usb_ring_head != usb_ring_tail)
+        return HAL_BUSY;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    // 環形緩衝區已空，直接拿來當測試樣式
+    for (uint32_t i = 0; i < USB_STREAM_RING_SIZE; i++) {
+        usb_ring[i] = (uint8_t)i;
+    }
+    usb_stats.bench_bytes = 0;
+    usb_stats.bench_ms = 0;
+    usb_bench_start = HAL_GetTick();
+    usb_bench_duration = duration_ms;
+    usb_mode = USB_STREAM_BENCH;
+    UsbStream_Kick();
+    __set_PRIMASK(primask);
+
+    return HAL_OK;
+}
+
+// 遙測是否走 USB：主機已開啟序列埠且不在串流/bench 中
+uint8_t UsbStream_IsOpen(void)
+{
+    return (usb_host_open && usb_mode == USB_STREAM_IDLE) ? 1 : 0;
+}
+
+UsbStream_Mode_t UsbStream_GetMode(void)
+{
+    return (UsbStream_Mode_t)usb_mode;
+}
+
+/**
+ * @brief  寫入遙測資料，整筆放得下才寫入，不等待（只能在主程式呼叫）
+ * @param  data: 資料
+ * @param  len: 長度
+ * @retval 寫入的位元組，0 = 未開啟或緩衝區不足（整筆丟棄）
+ */
+uint32_t UsbStream_Write(const uint8_t *data, uint32_t len)
+{
+    if (data == NULL || len == 0 || __get_IPSR() != 0 || !UsbStream_IsOpen())
+        return 0;
+
+    if (len > USB_STREAM_RING_SIZE - (usb_ring_head - usb_ring_tail)) {
+        usb_stats.tlm_drops++;
+        return 0;
+    }
+
+    uint32_t offset = usb_ring_head & USB_RING_MASK;
+    uint32_t first = USB_STREAM_RING_SIZE - offset;
+    if (first > len)
+        first = len;
+    memcpy(&usb_ring[offset], data, first);
+    memcpy(usb_ring, data + first, len - first);
+
+    __DMB();
+    usb_ring_head += len;
+    UsbStream_KickLocked();
+    return len;
+}
+
+void UsbStream_GetStats(UsbStream_Stats_t *stats)
+{
+    if (stats == NULL)
+        return;
+
+    *stats = usb_stats;
+    stats->blocks = usb_blocks.blocks;
+    stats->dropped = usb_blocks.dropped;
+    stats->torn = usb_blocks.torn;
+    stats->mode = usb_mode;
+    stats->host_open = usb_host_open;
+}
+
+/**
+ * @brief  USB 設定/取消設定（CDC Init/DeInit，USB 中斷）：進行中的傳送已被 USB 核心捨棄
+ * @retval None
+ */
+void UsbStream_Reset(void)
+{
+    usb_tx = USB_TX_NONE;
+    usb_ring_inflight = 0;
+    usb_host_open = 0;
+    UsbBlock_Abort(&usb_blocks);
+
+    if (usb_mode == USB_STREAM_BENCH) {
+        usb_mode = USB_STREAM_IDLE;
+        usb_ring_tail = usb_ring_head;
+    }
+}
+
+/**
+ * @brief  主機開啟/關閉序列埠（SET_CONTROL_LINE_STATE 的 DTR，USB 中斷）
+ * @param  open: 1 = 開啟
+ * @retval None
+ */
+void UsbStream_SetHostOpen(uint8_t open)
+{
+    usb_host_open = open;
+    if (open)
+        UsbStream_Kick();
+}
+
+// 主機送來的資料（USB 中斷），串流是單向的，只計數
+void UsbStream_Received(const uint8_t *data, uint32_t len)
+{
+    (void)data;
+    usb_stats.rx_bytes += len;
+}
+
+/**
+ * @brief  bulk IN 傳輸完成（含 ZLP，USB 中斷）：區塊 header 之後接著送樣本
+ * @retval None
+ */
+void UsbStream_TxComplete(void)
+{
+    uint8_t done = usb_tx;
+
+    usb_tx = USB_TX_NONE;
+
+    switch (done) {
+    case USB_TX_HEADER:
+        usb_tx = USB_TX_DATA;
+        if (UsbBlock_SendData(&usb_blocks))
+            return;
+        usb_tx = USB_TX_NONE;
+        break;
+
+    case USB_TX_DATA:
+        UsbBlock_Sent(&usb_blocks);
+        break;
+
+    case USB_TX_RING:
+        usb_ring_tail += usb_ring_inflight;
+        usb_stats.tlm_bytes += usb_ring_inflight;
+        usb_ring_inflight = 0;
+        break;
+
+    case USB_TX_BENCH:
+        usb_stats.bench_bytes += USB_STREAM_MAX_XFER;
+        break;
+
+    default:
+        break;
+    }
+
+    UsbStream_Kick();
+}
+
+/**
+ * @brief  取樣區塊回呼（ADC DMA 中斷）：區塊排入佇列後啟動傳送
+ * @param  block: 取樣區塊
+ * @param  context: 未使用
+ * @retval None
+ */
+static void UsbStream_Consumer(const Acq_Block_t *block, void *context)
+{
+    (void)context;
+
+    UsbBlock_Put(&usb_blocks, block);
+    UsbStream_Kick();
+}
+
+/**
+ * @brief  端點閒置時啟動下一筆傳送：取樣開始前剩下的遙測優先，其次是取樣區塊或 bench
+ * @retval None
+ * @note   只能在 USB / ADC DMA 中斷或遮蔽中斷時呼叫
+ */
+static void UsbStream_Kick(void)
+{
+    uint8_t *buf = NULL;
+    uint16_t len = 0;
+    uint8_t what = USB_TX_NONE;
+
+    if (usb_tx != USB_TX_NONE)
+        return;
+
+    // 取樣模式不再寫入環形緩衝區，裡面只剩開始前的遙測：先送完再送區塊，兩者不會混在一起
+    uint32_t used = usb_ring_head - usb_ring_tail;
+
+    if (used != 0 && usb_host_open && usb_mode != USB_STREAM_BENCH) {
+        uint32_t offset = usb_ring_tail & USB_RING_MASK;
+        if (used > USB_STREAM_RING_SIZE - offset)
+            used = USB_STREAM_RING_SIZE - offset;
+        usb_ring_inflight = used;
+        buf = &usb_ring[offset];
+        len = (uint16_t)used;
+        what = USB_TX_RING;
+    } else if (UsbBlock_Pending(&usb_blocks)) {
+        // 端點還在忙時區塊留在佇列，下一次再試
+        usb_tx = USB_TX_HEADER;
+        if (!UsbBlock_SendHeader(&usb_blocks))
+            usb_tx = USB_TX_NONE;
+        return;
+    } else if (usb_mode == USB_STREAM_BENCH) {
+        uint32_t elapsed = HAL_GetTick() - usb_bench_start;
+        if (elapsed >= usb_bench_duration) {
+            usb_stats.bench_ms = elapsed;
+            usb_ring_tail = usb_ring_head;
+            usb_mode = USB_STREAM_IDLE;
+            return;
+        }
+        buf = usb_ring;
+        len = USB_STREAM_MAX_XFER;
+        what = USB_TX_BENCH;
+    }
+
+    if (buf == NULL)
+        return;
+
+    usb_tx = what;
+    if (CDC_Transmit_FS(buf, len) == USBD_OK)
+        return;
+
+    // 尚未設定完成或類別還在傳送（reset 之後），下一次再試
+    usb_tx = USB_TX_NONE;
+    usb_ring_inflight = 0;
+}
+
+// 主程式呼叫 Kick 前遮蔽中斷
+static void UsbStream_KickLocked(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    UsbStream_Kick();
+    __set_PRIMASK(primask);
+}
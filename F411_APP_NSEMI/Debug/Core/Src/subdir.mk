@@ -6,73 +6,133 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
 ../Core/Src/ACS712.c \
+../Core/Src/acquisition.c \
 ../Core/Src/adc.c \
+../Core/Src/autotune.c \
 ../Core/Src/current_monitor.c \
 ../Core/Src/dma.c \
+../Core/Src/fixfmt.c \
 ../Core/Src/gpio.c \
 ../Core/Src/handpiece.c \
+../Core/Src/hw_crc.c \
 ../Core/Src/i2c.c \
+../Core/Src/itm_trace.c \
+../Core/Src/logid.c \
 ../Core/Src/main.c \
+../Core/Src/param_store.c \
+../Core/Src/pwm_hr.c \
+../Core/Src/raw_stream.c \
+../Core/Src/scheduler.c \
+../Core/Src/shell.c \
 ../Core/Src/ssd1306.c \
 ../Core/Src/ssd1306_fonts.c \
+../Core/Src/ssd1306_fonts_ui.c \
 ../Core/Src/ssd1306_tests.c \
 ../Core/Src/stm32f4xx_hal_msp.c \
 ../Core/Src/stm32f4xx_it.c \
 ../Core/Src/syscalls.c \
 ../Core/Src/sysmem.c \
 ../Core/Src/system_stm32f4xx.c \
+../Core/Src/telemetry.c \
 ../Core/Src/tim.c \
-../Core/Src/usart.c 
+../Core/Src/trend_graph.c \
+../Core/Src/uart_log.c \
+../Core/Src/ui_widget.c \
+../Core/Src/usart.c \
+../Core/Src/usb_audio.c \
+../Core/Src/usb_block.c \
+../Core/Src/usb_hid.c \
+../Core/Src/usb_stream.c 
 
 OBJS += \
 ./Core/Src/ACS712.o \
+./Core/Src/acquisition.o \
 ./Core/Src/adc.o \
+./Core/Src/autotune.o \
 ./Core/Src/current_monitor.o \
 ./Core/Src/dma.o \
+./Core/Src/fixfmt.o \
 ./Core/Src/gpio.o \
 ./Core/Src/handpiece.o \
+./Core/Src/hw_crc.o \
 ./Core/Src/i2c.o \
+./Core/Src/itm_trace.o \
+./Core/Src/logid.o \
 ./Core/Src/main.o \
+./Core/Src/param_store.o \
+./Core/Src/pwm_hr.o \
+./Core/Src/raw_stream.o \
+./Core/Src/scheduler.o \
+./Core/Src/shell.o \
 ./Core/Src/ssd1306.o \
 ./Core/Src/ssd1306_fonts.o \
+./Core/Src/ssd1306_fonts_ui.o \
 ./Core/Src/ssd1306_tests.o \
 ./Core/Src/stm32f4xx_hal_msp.o \
 ./Core/Src/stm32f4xx_it.o \
 ./Core/Src/syscalls.o \
 ./Core/Src/sysmem.o \
 ./Core/Src/system_stm32f4xx.o \
+./Core/Src/telemetry.o \
 ./Core/Src/tim.o \
-./Core/Src/usart.o 
+./Core/Src/trend_graph.o \
+./Core/Src/uart_log.o \
+./Core/Src/ui_widget.o \
+./Core/Src/usart.o \
+./Core/Src/usb_audio.o \
+./Core/Src/usb_block.o \
+./Core/Src/usb_hid.o \
+./Core/Src/usb_stream.o 
 
 C_DEPS += \
 ./Core/Src/ACS712.d \
+./Core/Src/acquisition.d \
 ./Core/Src/adc.d \
+./Core/Src/autotune.d \
 ./Core/Src/current_monitor.d \
 ./Core/Src/dma.d \
+./Core/Src/fixfmt.d \
 ./Core/Src/gpio.d \
 ./Core/Src/handpiece.d \
+./Core/Src/hw_crc.d \
 ./Core/Src/i2c.d \
+./Core/Src/itm_trace.d \
+./Core/Src/logid.d \
 ./Core/Src/main.d \
+./Core/Src/param_store.d \
+./Core/Src/pwm_hr.d \
+./Core/Src/raw_stream.d \
+./Core/Src/scheduler.d \
+./Core/Src/shell.d \
 ./Core/Src/ssd1306.d \
 ./Core/Src/ssd1306_fonts.d \
+./Core/Src/ssd1306_fonts_ui.d \
 ./Core/Src/ssd1306_tests.d \
 ./Core/Src/stm32f4xx_hal_msp.d \
 ./Core/Src/stm32f4xx_it.d \
 ./Core/Src/syscalls.d \
 ./Core/Src/sysmem.d \
 ./Core/Src/system_stm32f4xx.d \
+./Core/Src/telemetry.d \
 ./Core/Src/tim.d \
-./Core/Src/usart.d 
+./Core/Src/trend_graph.d \
+./Core/Src/uart_log.d \
+./Core/Src/ui_widget.d \
+./Core/Src/usart.d \
+./Core/Src/usb_audio.d \
+./Core/Src/usb_block.d \
+./Core/Src/usb_hid.d \
+./Core/Src/usb_stream.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
 Core/Src/%.o Core/Src/%.su Core/Src/%.cyclo: ../Core/Src/%.c Core/Src/subdir.mk
-	arm-none-eabi-gcc "$<" -mcpu=cortex-m4 -std=gnu11 -g3 -DDEBUG -DUSE_HAL_DRIVER -DSTM32F411xE -c -I../Core/Inc -I../USB_DEVICE/App -I../USB_DEVICE/Target -I../Drivers/STM32F4xx_HAL_Driver/Inc -I../Drivers/STM32F4xx_HAL_Driver/Inc/Legacy -I../Middlewares/ST/STM32_USB_Device_Library/Core/Inc -I../Middlewares/ST/STM32_USB_Device_Library/Class/HID/Inc -I../Drivers/CMSIS/Device/ST/STM32F4xx/Include -I../Drivers/CMSIS/Include -O0 -ffunction-sections -fdata-sections -Wall -fstack-usage -fcyclomatic-complexity -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" --specs=nano.specs -mfpu=fpv4-sp-d16 -mfloat-abi=hard -mthumb -o "$@"
+	arm-none-eabi-gcc "$<" -mcpu=cortex-m4 -std=gnu11 -g3 -DDEBUG -DUSE_HAL_DRIVER -DSTM32F411xE -c -I../Core/Inc -I../USB_DEVICE/App -I../USB_DEVICE/Target -I../Drivers/STM32F4xx_HAL_Driver/Inc -I../Drivers/STM32F4xx_HAL_Driver/Inc/Legacy -I../Middlewares/ST/STM32_USB_Device_Library/Core/Inc -I../Middlewares/ST/STM32_USB_Device_Library/Class/HID/Inc -I../Middlewares/ST/STM32_USB_Device_Library/Class/CDC/Inc -I../Middlewares/ST/STM32_USB_Device_Library/Class/CompositeBuilder/Inc -I../Middlewares/ST/STM32_USB_Device_Library/Class/AUDIO_IN/Inc -I../Drivers/CMSIS/Device/ST/STM32F4xx/Include -I../Drivers/CMSIS/Include -O0 -ffunction-sections -fdata-sections -Wall -fstack-usage -fcyclomatic-complexity -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" --specs=nano.specs -mfpu=fpv4-sp-d16 -mfloat-abi=hard -mthumb -o "$@"
 
 clean: clean-Core-2f-Src
 
 clean-Core-2f-Src:
-	-$(RM) ./Core/Src/ACS712.cyclo ./Core/Src/ACS712.d ./Core/Src/ACS712.o ./Core/Src/ACS712.su ./Core/Src/adc.cyclo ./Core/Src/adc.d ./Core/Src/adc.o ./Core/Src/adc.su ./Core/Src/current_monitor.cyclo ./Core/Src/current_monitor.d ./Core/Src/current_monitor.o ./Core/Src/current_monitor.su ./Core/Src/dma.cyclo ./Core/Src/dma.d ./Core/Src/dma.o ./Core/Src/dma.su ./Core/Src/gpio.cyclo ./Core/Src/gpio.d ./Core/Src/gpio.o ./Core/Src/gpio.su ./Core/Src/handpiece.cyclo ./Core/Src/handpiece.d ./Core/Src/handpiece.o ./Core/Src/handpiece.su ./Core/Src/i2c.cyclo ./Core/Src/i2c.d ./Core/Src/i2c.o ./Core/Src/i2c.su ./Core/Src/main.cyclo ./Core/Src/main.d ./Core/Src/main.o ./Core/Src/main.su ./Core/Src/ssd1306.cyclo ./Core/Src/ssd1306.d ./Core/Src/ssd1306.o ./Core/Src/ssd1306.su ./Core/Src/ssd1306_fonts.cyclo ./Core/Src/ssd1306_fonts.d ./Core/Src/ssd1306_fonts.o ./Core/Src/ssd1306_fonts.su ./Core/Src/ssd1306_tests.cyclo ./Core/Src/ssd1306_tests.d ./Core/Src/ssd1306_tests.o ./Core/Src/ssd1306_tests.su ./Core/Src/stm32f4xx_hal_msp.cyclo ./Core/Src/stm32f4xx_hal_msp.d ./Core/Src/stm32f4xx_hal_msp.o ./Core/Src/stm32f4xx_hal_msp.su ./Core/Src/stm32f4xx_it.cyclo ./Core/Src/stm32f4xx_it.d ./Core/Src/stm32f4xx_it.o ./Core/Src/stm32f4xx_it.su ./Core/Src/syscalls.cyclo ./Core/Src/syscalls.d ./Core/Src/syscalls.o ./Core/Src/syscalls.su ./Core/Src/sysmem.cyclo ./Core/Src/sysmem.d ./Core/Src/sysmem.o ./Core/Src/sysmem.su ./Core/Src/system_stm32f4xx.cyclo ./Core/Src/system_stm32f4xx.d ./Core/Src/system_stm32f4xx.o ./Core/Src/system_stm32f4xx.su ./Core/Src/tim.cyclo ./Core/Src/tim.d ./Core/Src/tim.o ./Core/Src/tim.su ./Core/Src/usart.cyclo ./Core/Src/usart.d ./Core/Src/usart.o ./Core/Src/usart.su
+	-$(RM) ./Core/Src/ACS712.cyclo ./Core/Src/ACS712.d ./Core/Src/ACS712.o ./Core/Src/ACS712.su ./Core/Src/acquisition.cyclo ./Core/Src/acquisition.d ./Core/Src/acquisition.o ./Core/Src/acquisition.su ./Core/Src/adc.cyclo ./Core/Src/adc.d ./Core/Src/adc.o ./Core/Src/adc.su ./Core/Src/autotune.cyclo ./Core/Src/autotune.d ./Core/Src/autotune.o ./Core/Src/autotune.su ./Core/Src/current_monitor.cyclo ./Core/Src/current_monitor.d ./Core/Src/current_monitor.o ./Core/Src/current_monitor.su ./Core/Src/dma.cyclo ./Core/Src/dma.d ./Core/Src/dma.o ./Core/Src/dma.su ./Core/Src/fixfmt.cyclo ./Core/Src/fixfmt.d ./Core/Src/fixfmt.o ./Core/Src/fixfmt.su ./Core/Src/gpio.cyclo ./Core/Src/gpio.d ./Core/Src/gpio.o ./Core/Src/gpio.su ./Core/Src/handpiece.cyclo ./Core/Src/handpiece.d ./Core/Src/handpiece.o ./Core/Src/handpiece.su ./Core/Src/hw_crc.cyclo ./Core/Src/hw_crc.d ./Core/Src/hw_crc.o ./Core/Src/hw_crc.su ./Core/Src/i2c.cyclo ./Core/Src/i2c.d ./Core/Src/i2c.o ./Core/Src/i2c.su ./Core/Src/itm_trace.cyclo ./Core/Src/itm_trace.d ./Core/Src/itm_trace.o ./Core/Src/itm_trace.su ./Core/Src/logid.cyclo ./Core/Src/logid.d ./Core/Src/logid.o ./Core/Src/logid.su ./Core/Src/main.cyclo ./Core/Src/main.d ./Core/Src/main.o ./Core/Src/main.su ./Core/Src/param_store.cyclo ./Core/Src/param_store.d ./Core/Src/param_store.o ./Core/Src/param_store.su ./Core/Src/pwm_hr.cyclo ./Core/Src/pwm_hr.d ./Core/Src/pwm_hr.o ./Core/Src/pwm_hr.su ./Core/Src/raw_stream.cyclo ./Core/Src/raw_stream.d ./Core/Src/raw_stream.o ./Core/Src/raw_stream.su ./Core/Src/scheduler.cyclo ./Core/Src/scheduler.d ./Core/Src/scheduler.o ./Core/Src/scheduler.su ./Core/Src/shell.cyclo ./Core/Src/shell.d ./Core/Src/shell.o ./Core/Src/shell.su ./Core/Src/ssd1306.cyclo ./Core/Src/ssd1306.d ./Core/Src/ssd1306.o ./Core/Src/ssd1306.su ./Core/Src/ssd1306_fonts.cyclo ./Core/Src/ssd1306_fonts.d ./Core/Src/ssd1306_fonts.o ./Core/Src/ssd1306_fonts.su ./Core/Src/ssd1306_fonts_ui.cyclo ./Core/Src/ssd1306_fonts_ui.d ./Core/Src/ssd1306_fonts_ui.o ./Core/Src/ssd1306_fonts_ui.su ./Core/Src/ssd1306_tests.cyclo ./Core/Src/ssd1306_tests.d ./Core/Src/ssd1306_tests.o ./Core/Src/ssd1306_tests.su ./Core/Src/stm32f4xx_hal_msp.cyclo ./Core/Src/stm32f4xx_hal_msp.d ./Core/Src/stm32f4xx_hal_msp.o ./Core/Src/stm32f4xx_hal_msp.su ./Core/Src/stm32f4xx_it.cyclo ./Core/Src/stm32f4xx_it.d ./Core/Src/stm32f4xx_it.o ./Core/Src/stm32f4xx_it.su ./Core/Src/syscalls.cyclo ./Core/Src/syscalls.d ./Core/Src/syscalls.o ./Core/Src/syscalls.su ./Core/Src/sysmem.cyclo ./Core/Src/sysmem.d ./Core/Src/sysmem.o ./Core/Src/sysmem.su ./Core/Src/system_stm32f4xx.cyclo ./Core/Src/system_stm32f4xx.d ./Core/Src/system_stm32f4xx.o ./Core/Src/system_stm32f4xx.su ./Core/Src/telemetry.cyclo ./Core/Src/telemetry.d ./Core/Src/telemetry.o ./Core/Src/telemetry.su ./Core/Src/tim.cyclo ./Core/Src/tim.d ./Core/Src/tim.o ./Core/Src/tim.su ./Core/Src/trend_graph.cyclo ./Core/Src/trend_graph.d ./Core/Src/trend_graph.o ./Core/Src/trend_graph.su ./Core/Src/uart_log.cyclo ./Core/Src/uart_log.d ./Core/Src/uart_log.o ./Core/Src/uart_log.su ./Core/Src/ui_widget.cyclo ./Core/Src/ui_widget.d ./Core/Src/ui_widget.o ./Core/Src/ui_widget.su ./Core/Src/usart.cyclo ./Core/Src/usart.d ./Core/Src/usart.o ./Core/Src/usart.su ./Core/Src/usb_audio.cyclo ./Core/Src/usb_audio.d ./Core/Src/usb_audio.o ./Core/Src/usb_audio.su ./Core/Src/usb_block.cyclo ./Core/Src/usb_block.d ./Core/Src/usb_block.o ./Core/Src/usb_block.su ./Core/Src/usb_hid.cyclo ./Core/Src/usb_hid.d ./Core/Src/usb_hid.o ./Core/Src/usb_hid.su ./Core/Src/usb_stream.cyclo ./Core/Src/usb_stream.d ./Core/Src/usb_stream.o ./Core/Src/usb_stream.su
 
 .PHONY: clean-Core-2f-Src
 
@@ -0,0 +1,27 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+# Toolchain: GNU Tools for STM32 (13.3.rel1)
+################################################################################
+
+# Add inputs and outputs from these tool invocations to the build variables 
+C_SRCS += \
+../Middlewares/ST/STM32_USB_Device_Library/Class/AUDIO_IN/Src/usbd_audio_in.c 
+
+OBJS += \
+./Middlewares/ST/STM32_USB_Device_Library/Class/AUDIO_IN/Src/usbd_audio_in.o 
+
+C_DEPS += \
+./Middlewares/ST/STM32_USB_Device_Library/Class/AUDIO_IN/Src/usbd_audio_in.d 
+
+
+# Each subdirectory must supply rules for building sources it contributes
+Middlewares/ST/STM32_USB_Device_Library/Class/AUDIO_IN/Src/%.o Middlewares/ST/STM32_USB_Device_Library/Class/AUDIO_IN/Src/%.su Middlewares/ST/STM32_USB_Device_Library/Class/AUDIO_IN/Src/%.cyclo: ../Middlewares/ST/STM32_USB_Device_Library/Class/AUDIO_IN/Src/%.c Middlewares/ST/STM32_USB_Device_Library/Class/AUDIO_IN/Src/subdir.mk
+	arm-none-eabi-gcc "$<" -mcpu=cortex-m4 -std=gnu11 -g3 -DDEBUG -DUSE_HAL_DRIVER -DSTM32F411xE -c -I../Core/Inc -I../USB_DEVICE/App -I../USB_DEVICE/Target -I../Drivers/STM32F4xx_HAL_Driver/Inc -I../Drivers/STM32F4xx_HAL_Driver/Inc/Legacy -I../Middlewares/ST/STM32_USB_Device_Library/Core/Inc -I../Middlewares/ST/STM32_USB_Device_Library/Class/HID/Inc -I../Middlewares/ST/STM32_USB_Device_Library/Class/CDC/Inc -I../Middlewares/ST/STM32_USB_Device_Library/Class/CompositeBuilder/Inc -I../Middlewares/ST/STM32_USB_Device_Library/Class/AUDIO_IN/Inc -I../Drivers/CMSIS/Device/ST/STM32F4xx/Include -I../Drivers/CMSIS/Include -O0 -ffunction-sections -fdata-sections -Wall -fstack-usage -fcyclomatic-complexity -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" --specs=nano.specs -mfpu=fpv4-sp-d16 -mfloat-abi=hard -mthumb -o "$@"
+
+clean: clean-Middlewares-2f-ST-2f-STM32_USB_Device_Library-2f-Class-2f-AUDIO_IN-2f-Src
+
+clean-Middlewares-2f-ST-2f-STM32_USB_Device_Library-2f-Class-2f-AUDIO_IN-2f-Src:
+	-$(RM) ./Middlewares/ST/STM32_USB_Device_Library/Class/AUDIO_IN/Src/usbd_audio_in.cyclo ./Middlewares/ST/STM32_USB_Device_Library/Class/AUDIO_IN/Src/usbd_audio_in.d ./Middlewares/ST/STM32_USB_Device_Library/Class/AUDIO_IN/Src/usbd_audio_in.o ./Middlewares/ST/STM32_USB_Device_Library/Class/AUDIO_IN/Src/usbd_audio_in.su
+
+.PHONY: clean-Middlewares-2f-ST-2f-STM32_USB_Device_Library-2f-Class-2f-AUDIO_IN-2f-Src
+
@@ -0,0 +1,181 @@
+/**
+  ******************************************************************************
+  * @file    usbd_audio_in.h
+  * @author  MCD Application Team
+  * @brief   header file for the usbd_audio_in.c file.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2015 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __USB_AUDIO_IN_H
+#define __USB_AUDIO_IN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include  "usbd_ioreq.h"
+
+/** @addtogroup STM32_USB_DEVICE_LIBRARY
+  * @{
+  */
+
+/** @defgroup USBD_AUDIO_IN
+  * @brief This file is the Header file for usbd_audio_in.c
+  * @{
+  */
+
+
+/** @defgroup USBD_AUDIO_IN_Exported_Defines
+  * @{
+  */
+#ifndef USBD_AUDIO_IN_FREQ
+#define USBD_AUDIO_IN_FREQ                            48000U
+#endif /* USBD_AUDIO_IN_FREQ */
+
+#ifndef USBD_AUDIO_IN_CHANNELS
+#define USBD_AUDIO_IN_CHANNELS                        1U
+#endif /* USBD_AUDIO_IN_CHANNELS */
+
+#ifndef AUDIO_IN_EP
+#define AUDIO_IN_EP                                   0x81U
+#endif /* AUDIO_IN_EP */
+
+/* 16-bit PCM: two bytes per sample, one sample per channel in each frame */
+#define AUDIO_IN_SUBFRAME_SIZE                        2U
+#define AUDIO_IN_FRAME_SIZE                           (AUDIO_IN_SUBFRAME_SIZE * USBD_AUDIO_IN_CHANNELS)
+
+/* Nominal number of frames per 1 ms USB frame, and the largest packet:
+   the asynchronous endpoint sends one extra frame when the sample clock
+   runs ahead of the host SOF clock */
+#define AUDIO_IN_FRAMES_PER_PACKET                    (USBD_AUDIO_IN_FREQ / 1000U)
+#define AUDIO_IN_MAX_PACKET_FRAMES                    (AUDIO_IN_FRAMES_PER_PACKET + 1U)
+#define AUDIO_IN_PACKET_SZE                           (AUDIO_IN_MAX_PACKET_FRAMES * AUDIO_IN_FRAME_SIZE)
+
+#define USB_AUDIO_IN_CONFIG_DESC_SIZ                  100U
+
+#define AUDIO_IN_AC_INTERFACE                         0x00U
+#define AUDIO_IN_AS_INTERFACE                         0x01U
+
+#define AUDIO_INTERFACE_DESC_SIZE                     0x09U
+#define AUDIO_STANDARD_ENDPOINT_DESC_SIZE             0x09U
+#define AUDIO_STREAMING_ENDPOINT_DESC_SIZE            0x07U
+
+#define AUDIO_DESCRIPTOR_TYPE                         0x21U
+#define USB_DEVICE_CLASS_AUDIO                        0x01U
+#define AUDIO_SUBCLASS_AUDIOCONTROL                   0x01U
+#define AUDIO_SUBCLASS_AUDIOSTREAMING                 0x02U
+#define AUDIO_PROTOCOL_UNDEFINED                      0x00U
+#define AUDIO_STREAMING_GENERAL                       0x01U
+#define AUDIO_STREAMING_FORMAT_TYPE                   0x02U
+
+/* Audio Descriptor Types */
+#define AUDIO_INTERFACE_DESCRIPTOR_TYPE               0x24U
+#define AUDIO_ENDPOINT_DESCRIPTOR_TYPE                0x25U
+
+/* Audio Control Interface Descriptor Subtypes */
+#define AUDIO_CONTROL_HEADER                          0x01U
+#define AUDIO_CONTROL_INPUT_TERMINAL                  0x02U
+#define AUDIO_CONTROL_OUTPUT_TERMINAL                 0x03U
+
+#define AUDIO_INPUT_TERMINAL_DESC_SIZE                0x0CU
+#define AUDIO_OUTPUT_TERMINAL_DESC_SIZE               0x09U
+#define AUDIO_STREAMING_INTERFACE_DESC_SIZE           0x07U
+#define AUDIO_FORMAT_TYPE_I_DESC_SIZE                 0x0BU
+
+#define AUDIO_FORMAT_TYPE_I                           0x01U
+#define AUDIO_ENDPOINT_GENERAL                        0x01U
+
+/* Audio class requests */
+#define AUDIO_REQ_GET_CUR                             0x81U
+#define AUDIO_REQ_SET_CUR                             0x01U
+
+/* Endpoint control selectors */
+#define AUDIO_EP_SAMPLING_FREQ_CONTROL                0x01U
+
+#define AUDIO_SAMPLE_FREQ(frq) \
+  (uint8_t)(frq), (uint8_t)((frq) >> 8), (uint8_t)((frq) >> 16)
+/**
+  * @}
+  */
+
+
+/** @defgroup USBD_CORE_Exported_TypesDefinitions
+  * @{
+  */
+typedef struct
+{
+  uint32_t alt_setting;
+  uint8_t tx_pending;                                   /* packet queued for the next frame */
+  uint8_t resend;                                       /* last packet missed its frame, send it again */
+  uint16_t tx_length;
+  uint32_t packets;                                     /* packets sent */
+  uint32_t resent;                                      /* packets sent again after an incomplete ISO IN frame */
+  uint8_t ctl_data[4];                                  /* SET_CUR data stage */
+  uint32_t buffer[(AUDIO_IN_PACKET_SZE + 3U) / 4U];     /* Force 32-bit alignment */
+} USBD_AUDIO_IN_HandleTypeDef;
+
+typedef struct
+{
+  int8_t (*Init)(void);
+  int8_t (*DeInit)(void);
+  int8_t (*Start)(void);                                /* host selected the streaming alternate setting */
+  int8_t (*Stop)(void);                                 /* host went back to the zero-bandwidth setting */
+  uint16_t (*Fill)(uint8_t *pbuf, uint16_t max_len);    /* called once per SOF, returns the packet length */
+} USBD_AUDIO_IN_ItfTypeDef;
+/**
+  * @}
+  */
+
+
+
+/** @defgroup USBD_CORE_Exported_Macros
+  * @{
+  */
+
+/**
+  * @}
+  */
+
+/** @defgroup USBD_CORE_Exported_Variables
+  * @{
+  */
+
+extern USBD_ClassTypeDef USBD_AUDIO_IN;
+#define USBD_AUDIO_IN_CLASS &USBD_AUDIO_IN
+/**
+  * @}
+  */
+
+/** @defgroup USB_CORE_Exported_Functions
+  * @{
+  */
+uint8_t USBD_AUDIO_IN_RegisterInterface(USBD_HandleTypeDef *pdev, USBD_AUDIO_IN_ItfTypeDef *fops);
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* __USB_AUDIO_IN_H */
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,679 @@
+/**
+  ******************************************************************************
+  * @file    usbd_audio_in.c
+  * @author  MCD Application Team
+  * @brief   This file provides the Audio input (microphone) core functions.
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2015 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  * @verbatim
+  *
+  *          ===================================================================
+  *                                AUDIO IN Class  Description
+  *          ===================================================================
+  *           This driver manages the Audio Class 1.0 following the "USB Device Class Definition for
+  *           Audio Devices V1.0 Mar 18, 98".
+  *           This driver implements the following aspects of the specification:
+  *             - Device descriptor management
+  *             - Configuration descriptor management
+  *             - Standard AC Interface Descriptor management
+  *             - 1 Audio Streaming Interface (with single channel or stereo, PCM, 16-bit)
+  *             - 1 Audio Streaming Endpoint (isochronous IN, asynchronous)
+  *             - 1 Audio Terminal Input (Microphone)
+  *             - 1 Audio Terminal Output (USB streaming)
+  *             - Audio Class-Specific AC Interfaces
+  *             - Audio Class-Specific AS Interfaces
+  *             - AudioControl Requests: none (no Feature Unit)
+  *             - Audio Synchronization type: Asynchronous
+  *             - Single fixed audio sampling rate (USBD_AUDIO_IN_FREQ)
+  *
+  *           Rate matching: the samples come from the device clock. At each SOF
+  *           the interface Fill callback decides how many frames go in the next
+  *           packet (nominal, one less or one more), so the packet sizes follow
+  *           the sample clock as measured against the host SOF clock.
+  *           A packet the host did not collect in its frame (incomplete ISO IN)
+  *           is sent again at the next SOF, so no sample is dropped on the bus.
+  *
+  * @note     Full-speed only; the class is not part of the composite builder.
+  *
+  *  @endverbatim
+  *
+  ******************************************************************************
+  */
+
+/* BSPDependencies
+- None
+EndBSPDependencies */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbd_audio_in.h"
+#include "usbd_ctlreq.h"
+
+
+/** @addtogroup STM32_USB_DEVICE_LIBRARY
+  * @{
+  */
+
+
+/** @defgroup USBD_AUDIO_IN
+  * @brief usbd core module
+  * @{
+  */
+
+/** @defgroup USBD_AUDIO_IN_Private_TypesDefinitions
+  * @{
+  */
+/**
+  * @}
+  */
+
+
+/** @defgroup USBD_AUDIO_IN_Private_Defines
+  * @{
+  */
+#if (USBD_AUDIO_IN_CHANNELS == 2U)
+#define AUDIO_IN_CHANNEL_CONFIG                       0x0003U   /* Left Front, Right Front */
+#else
+#define AUDIO_IN_CHANNEL_CONFIG                       0x0000U   /* No predefined spatial location */
+#endif /* USBD_AUDIO_IN_CHANNELS */
+
+/* Class-specific AC interface: header + input terminal + output terminal */
+#define AUDIO_IN_AC_TOTAL_SIZE                        (0x09U + AUDIO_INPUT_TERMINAL_DESC_SIZE + \
+                                                       AUDIO_OUTPUT_TERMINAL_DESC_SIZE)
+/**
+  * @}
+  */
+
+
+/** @defgroup USBD_AUDIO_IN_Private_Macros
+  * @{
+  */
+/**
+  * @}
+  */
+
+
+/** @defgroup USBD_AUDIO_IN_Private_FunctionPrototypes
+  * @{
+  */
+static uint8_t USBD_AUDIO_IN_Init(USBD_HandleTypeDef *pdev, uint8_t cfgidx);
+static uint8_t USBD_AUDIO_IN_DeInit(USBD_HandleTypeDef *pdev, uint8_t cfgidx);
+static uint8_t USBD_AUDIO_IN_Setup(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req);
+static uint8_t USBD_AUDIO_IN_EP0_RxReady(USBD_HandleTypeDef *pdev);
+static uint8_t USBD_AUDIO_IN_DataIn(USBD_HandleTypeDef *pdev, uint8_t epnum);
+static uint8_t USBD_AUDIO_IN_SOF(USBD_HandleTypeDef *pdev);
+static uint8_t USBD_AUDIO_IN_IsoINIncomplete(USBD_HandleTypeDef *pdev, uint8_t epnum);
+static uint8_t *USBD_AUDIO_IN_GetCfgDesc(uint16_t *length);
+static uint8_t *USBD_AUDIO_IN_GetDeviceQualifierDesc(uint16_t *length);
+/**
+  * @}
+  */
+
+/** @defgroup USBD_AUDIO_IN_Private_Variables
+  * @{
+  */
+
+USBD_ClassTypeDef USBD_AUDIO_IN =
+{
+  USBD_AUDIO_IN_Init,
+  USBD_AUDIO_IN_DeInit,
+  USBD_AUDIO_IN_Setup,
+  NULL,                           /* EP0_TxSent */
+  USBD_AUDIO_IN_EP0_RxReady,      /* EP0_RxReady */
+  USBD_AUDIO_IN_DataIn,           /* DataIn */
+  NULL,                           /* DataOut */
+  USBD_AUDIO_IN_SOF,              /* SOF */
+  USBD_AUDIO_IN_IsoINIncomplete,
+  NULL,
+  USBD_AUDIO_IN_GetCfgDesc,
+  USBD_AUDIO_IN_GetCfgDesc,
+  USBD_AUDIO_IN_GetCfgDesc,
+  USBD_AUDIO_IN_GetDeviceQualifierDesc,
+};
+
+/* USB AUDIO IN device Configuration Descriptor */
+__ALIGN_BEGIN static uint8_t USBD_AUDIO_IN_CfgDesc[USB_AUDIO_IN_CONFIG_DESC_SIZ] __ALIGN_END =
+{
+  /* Configuration 1 */
+  0x09,                                 /* bLength */
+  USB_DESC_TYPE_CONFIGURATION,          /* bDescriptorType */
+  LOBYTE(USB_AUDIO_IN_CONFIG_DESC_SIZ), /* wTotalLength */
+  HIBYTE(USB_AUDIO_IN_CONFIG_DESC_SIZ),
+  0x02,                                 /* bNumInterfaces */
+  0x01,                                 /* bConfigurationValue */
+  0x00,                                 /* iConfiguration */
+#if (USBD_SELF_POWERED == 1U)
+  0xC0,                                 /* bmAttributes: Self Powered according to user configuration */
+#else
+  0x80,                                 /* bmAttributes: Bus Powered according to user configuration */
+#endif /* USBD_SELF_POWERED */
+  USBD_MAX_POWER,                       /* MaxPower (mA) */
+  /* 09 byte*/
+
+  /* USB Microphone Standard AC Interface Descriptor */
+  AUDIO_INTERFACE_DESC_SIZE,            /* bLength */
+  USB_DESC_TYPE_INTERFACE,              /* bDescriptorType */
+  AUDIO_IN_AC_INTERFACE,                /* bInterfaceNumber */
+  0x00,                                 /* bAlternateSetting */
+  0x00,                                 /* bNumEndpoints */
+  USB_DEVICE_CLASS_AUDIO,               /* bInterfaceClass */
+  AUDIO_SUBCLASS_AUDIOCONTROL,          /* bInterfaceSubClass */
+  AUDIO_PROTOCOL_UNDEFINED,             /* bInterfaceProtocol */
+  0x00,                                 /* iInterface */
+  /* 09 byte*/
+
+  /* USB Microphone Class-specific AC Interface Descriptor */
+  0x09,                                 /* bLength */
+  AUDIO_INTERFACE_DESCRIPTOR_TYPE,      /* bDescriptorType */
+  AUDIO_CONTROL_HEADER,                 /* bDescriptorSubtype */
+  0x00,          /* 1.00 */             /* bcdADC */
+  0x01,
+  LOBYTE(AUDIO_IN_AC_TOTAL_SIZE),       /* wTotalLength */
+  HIBYTE(AUDIO_IN_AC_TOTAL_SIZE),
+  0x01,                                 /* bInCollection */
+  AUDIO_IN_AS_INTERFACE,                /* baInterfaceNr */
+  /* 09 byte*/
+
+  /* USB Microphone Input Terminal Descriptor */
+  AUDIO_INPUT_TERMINAL_DESC_SIZE,       /* bLength */
+  AUDIO_INTERFACE_DESCRIPTOR_TYPE,      /* bDescriptorType */
+  AUDIO_CONTROL_INPUT_TERMINAL,         /* bDescriptorSubtype */
+  0x01,                                 /* bTerminalID */
+  0x01,                                 /* wTerminalType AUDIO_TERMINAL_MICROPHONE 0x0201 */
+  0x02,
+  0x00,                                 /* bAssocTerminal */
+  USBD_AUDIO_IN_CHANNELS,               /* bNrChannels */
+  LOBYTE(AUDIO_IN_CHANNEL_CONFIG),      /* wChannelConfig */
+  HIBYTE(AUDIO_IN_CHANNEL_CONFIG),
+  0x00,                                 /* iChannelNames */
+  0x00,                                 /* iTerminal */
+  /* 12 byte*/
+
+  /* USB Microphone Output Terminal Descriptor */
+  AUDIO_OUTPUT_TERMINAL_DESC_SIZE,      /* bLength */
+  AUDIO_INTERFACE_DESCRIPTOR_TYPE,      /* bDescriptorType */
+  AUDIO_CONTROL_OUTPUT_TERMINAL,        /* bDescriptorSubtype */
+  0x02,                                 /* bTerminalID */
+  0x01,                                 /* wTerminalType AUDIO_TERMINAL_USB_STREAMING 0x0101 */
+  0x01,
+  0x00,                                 /* bAssocTerminal */
+  0x01,                                 /* bSourceID */
+  0x00,                                 /* iTerminal */
+  /* 09 byte*/
+
+  /* USB Microphone Standard AS Interface Descriptor - Audio Streaming Zero Bandwidth */
+  /* Interface 1, Alternate Setting 0                                             */
+  AUDIO_INTERFACE_DESC_SIZE,            /* bLength */
+  USB_DESC_TYPE_INTERFACE,              /* bDescriptorType */
+  AUDIO_IN_AS_INTERFACE,                /* bInterfaceNumber */
+  0x00,                                 /* bAlternateSetting */
+  0x00,                                 /* bNumEndpoints */
+  USB_DEVICE_CLASS_AUDIO,               /* bInterfaceClass */
+  AUDIO_SUBCLASS_AUDIOSTREAMING,        /* bInterfaceSubClass */
+  AUDIO_PROTOCOL_UNDEFINED,             /* bInterfaceProtocol */
+  0x00,                                 /* iInterface */
+  /* 09 byte*/
+
+  /* USB Microphone Standard AS Interface Descriptor - Audio Streaming Operational */
+  /* Interface 1, Alternate Setting 1                                           */
+  AUDIO_INTERFACE_DESC_SIZE,            /* bLength */
+  USB_DESC_TYPE_INTERFACE,              /* bDescriptorType */
+  AUDIO_IN_AS_INTERFACE,                /* bInterfaceNumber */
+  0x01,                                 /* bAlternateSetting */
+  0x01,                                 /* bNumEndpoints */
+  USB_DEVICE_CLASS_AUDIO,               /* bInterfaceClass */
+  AUDIO_SUBCLASS_AUDIOSTREAMING,        /* bInterfaceSubClass */
+  AUDIO_PROTOCOL_UNDEFINED,             /* bInterfaceProtocol */
+  0x00,                                 /* iInterface */
+  /* 09 byte*/
+
+  /* USB Microphone Audio Streaming Interface Descriptor */
+  AUDIO_STREAMING_INTERFACE_DESC_SIZE,  /* bLength */
+  AUDIO_INTERFACE_DESCRIPTOR_TYPE,      /* bDescriptorType */
+  AUDIO_STREAMING_GENERAL,              /* bDescriptorSubtype */
+  0x02,                                 /* bTerminalLink */
+  0x01,                                 /* bDelay */
+  0x01,                                 /* wFormatTag AUDIO_FORMAT_PCM  0x0001 */
+  0x00,
+  /* 07 byte*/
+
+  /* USB Microphone Audio Type I Format Interface Descriptor */
+  AUDIO_FORMAT_TYPE_I_DESC_SIZE,        /* bLength */
+  AUDIO_INTERFACE_DESCRIPTOR_TYPE,      /* bDescriptorType */
+  AUDIO_STREAMING_FORMAT_TYPE,          /* bDescriptorSubtype */
+  AUDIO_FORMAT_TYPE_I,                  /* bFormatType */
+  USBD_AUDIO_IN_CHANNELS,               /* bNrChannels */
+  AUDIO_IN_SUBFRAME_SIZE,               /* bSubFrameSize: 2 Bytes per frame (16bits) */
+  16,                                   /* bBitResolution (16-bits per sample) */
+  0x01,                                 /* bSamFreqType only one frequency supported */
+  AUDIO_SAMPLE_FREQ(USBD_AUDIO_IN_FREQ), /* Audio sampling frequency coded on 3 bytes */
+  /* 11 byte*/
+
+  /* Endpoint 1 - Standard Descriptor */
+  AUDIO_STANDARD_ENDPOINT_DESC_SIZE,    /* bLength */
+  USB_DESC_TYPE_ENDPOINT,               /* bDescriptorType */
+  AUDIO_IN_EP,                          /* bEndpointAddress 1 in endpoint */
+  0x05,                                 /* bmAttributes: Isochronous, Asynchronous */
+  LOBYTE(AUDIO_IN_PACKET_SZE),          /* wMaxPacketSize in Bytes (Freq/1000 + 1) * Channels * 2 */
+  HIBYTE(AUDIO_IN_PACKET_SZE),
+  0x01,                                 /* bInterval */
+  0x00,                                 /* bRefresh */
+  0x00,                                 /* bSynchAddress */
+  /* 09 byte*/
+
+  /* Endpoint - Audio Streaming Descriptor */
+  AUDIO_STREAMING_ENDPOINT_DESC_SIZE,   /* bLength */
+  AUDIO_ENDPOINT_DESCRIPTOR_TYPE,       /* bDescriptorType */
+  AUDIO_ENDPOINT_GENERAL,               /* bDescriptor */
+  0x00,                                 /* bmAttributes: fixed rate, no sampling frequency control */
+  0x00,                                 /* bLockDelayUnits */
+  0x00,                                 /* wLockDelay */
+  0x00,
+  /* 07 byte*/
+};
+
+/* USB Standard Device Descriptor */
+__ALIGN_BEGIN static uint8_t USBD_AUDIO_IN_DeviceQualifierDesc[USB_LEN_DEV_QUALIFIER_DESC] __ALIGN_END =
+{
+  USB_LEN_DEV_QUALIFIER_DESC,
+  USB_DESC_TYPE_DEVICE_QUALIFIER,
+  0x00,
+  0x02,
+  0x00,
+  0x00,
+  0x00,
+  0x40,
+  0x01,
+  0x00,
+};
+
+/* Current sampling frequency, returned by GET_CUR on the endpoint */
+__ALIGN_BEGIN static uint8_t USBD_AUDIO_IN_Freq[3] __ALIGN_END =
+{
+  AUDIO_SAMPLE_FREQ(USBD_AUDIO_IN_FREQ)
+};
+
+/**
+  * @}
+  */
+
+/** @defgroup USBD_AUDIO_IN_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  USBD_AUDIO_IN_Init
+  *         Initialize the AUDIO IN interface
+  * @param  pdev: device instance
+  * @param  cfgidx: Configuration index
+  * @retval status
+  */
+static uint8_t USBD_AUDIO_IN_Init(USBD_HandleTypeDef *pdev, uint8_t cfgidx)
+{
+  UNUSED(cfgidx);
+  USBD_AUDIO_IN_HandleTypeDef *haudio;
+
+  /* Allocate Audio structure */
+  haudio = (USBD_AUDIO_IN_HandleTypeDef *)USBD_malloc(sizeof(USBD_AUDIO_IN_HandleTypeDef));
+
+  if (haudio == NULL)
+  {
+    pdev->pClassDataCmsit[pdev->classId] = NULL;
+    return (uint8_t)USBD_EMEM;
+  }
+
+  (void)USBD_memset(haudio, 0, sizeof(USBD_AUDIO_IN_HandleTypeDef));
+
+  pdev->pClassDataCmsit[pdev->classId] = (void *)haudio;
+  pdev->pClassData = pdev->pClassDataCmsit[pdev->classId];
+
+  pdev->ep_in[AUDIO_IN_EP & 0xFU].bInterval = 1U;
+
+  /* Open EP IN */
+  (void)USBD_LL_OpenEP(pdev, AUDIO_IN_EP, USBD_EP_TYPE_ISOC, AUDIO_IN_PACKET_SZE);
+  pdev->ep_in[AUDIO_IN_EP & 0xFU].is_used = 1U;
+
+  if (pdev->pUserData[pdev->classId] != NULL)
+  {
+    /* Initialize the Audio input Hardware layer */
+    if (((USBD_AUDIO_IN_ItfTypeDef *)pdev->pUserData[pdev->classId])->Init() != 0)
+    {
+      return (uint8_t)USBD_FAIL;
+    }
+  }
+
+  return (uint8_t)USBD_OK;
+}
+
+/**
+  * @brief  USBD_AUDIO_IN_DeInit
+  *         DeInitialize the AUDIO IN layer
+  * @param  pdev: device instance
+  * @param  cfgidx: Configuration index
+  * @retval status
+  */
+static uint8_t USBD_AUDIO_IN_DeInit(USBD_HandleTypeDef *pdev, uint8_t cfgidx)
+{
+  UNUSED(cfgidx);
+  USBD_AUDIO_IN_HandleTypeDef *haudio = (USBD_AUDIO_IN_HandleTypeDef *)pdev->pClassDataCmsit[pdev->classId];
+
+  /* Close EP IN */
+  (void)USBD_LL_CloseEP(pdev, AUDIO_IN_EP);
+  pdev->ep_in[AUDIO_IN_EP & 0xFU].is_used = 0U;
+  pdev->ep_in[AUDIO_IN_EP & 0xFU].bInterval = 0U;
+
+  /* DeInit physical Interface components */
+  if (haudio != NULL)
+  {
+    if (pdev->pUserData[pdev->classId] != NULL)
+    {
+      if (haudio->alt_setting != 0U)
+      {
+        ((USBD_AUDIO_IN_ItfTypeDef *)pdev->pUserData[pdev->classId])->Stop();
+      }
+      ((USBD_AUDIO_IN_ItfTypeDef *)pdev->pUserData[pdev->classId])->DeInit();
+    }
+    (void)USBD_free(pdev->pClassDataCmsit[pdev->classId]);
+    pdev->pClassDataCmsit[pdev->classId] = NULL;
+    pdev->pClassData = NULL;
+  }
+
+  return (uint8_t)USBD_OK;
+}
+
+/**
+  * @brief  USBD_AUDIO_IN_Setup
+  *         Handle the AUDIO IN specific requests
+  * @param  pdev: instance
+  * @param  req: usb requests
+  * @retval status
+  */
+static uint8_t USBD_AUDIO_IN_Setup(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req)
+{
+  USBD_AUDIO_IN_HandleTypeDef *haudio = (USBD_AUDIO_IN_HandleTypeDef *)pdev->pClassDataCmsit[pdev->classId];
+  USBD_AUDIO_IN_ItfTypeDef *itf = (USBD_AUDIO_IN_ItfTypeDef *)pdev->pUserData[pdev->classId];
+  USBD_StatusTypeDef ret = USBD_OK;
+  uint16_t status_info = 0U;
+
+  if (haudio == NULL)
+  {
+    return (uint8_t)USBD_FAIL;
+  }
+
+  switch (req->bmRequest & USB_REQ_TYPE_MASK)
+  {
+    case USB_REQ_TYPE_CLASS:
+      /* Only the endpoint sampling frequency control is answered: the rate is fixed,
+         GET_CUR returns it and SET_CUR data is accepted and ignored */
+      if (((req->bmRequest & USB_REQ_RECIPIENT_MASK) == USB_REQ_RECIPIENT_ENDPOINT) &&
+          (HIBYTE(req->wValue) == AUDIO_EP_SAMPLING_FREQ_CONTROL) && (req->wLength != 0U))
+      {
+        if (req->bRequest == AUDIO_REQ_GET_CUR)
+        {
+          (void)USBD_CtlSendData(pdev, USBD_AUDIO_IN_Freq, MIN(req->wLength, 3U));
+          break;
+        }
+        if (req->bRequest == AUDIO_REQ_SET_CUR)
+        {
+          (void)USBD_CtlPrepareRx(pdev, haudio->ctl_data, MIN(req->wLength, 3U));
+          break;
+        }
+      }
+      USBD_CtlError(pdev, req);
+      ret = USBD_FAIL;
+      break;
+
+    case USB_REQ_TYPE_STANDARD:
+      switch (req->bRequest)
+      {
+        case USB_REQ_GET_STATUS:
+          if (pdev->dev_state == USBD_STATE_CONFIGURED)
+          {
+            (void)USBD_CtlSendData(pdev, (uint8_t *)&status_info, 2U);
+          }
+          else
+          {
+            USBD_CtlError(pdev, req);
+            ret = USBD_FAIL;
+          }
+          break;
+
+        case USB_REQ_GET_INTERFACE:
+          if (pdev->dev_state == USBD_STATE_CONFIGURED)
+          {
+            (void)USBD_CtlSendData(pdev, (uint8_t *)&haudio->alt_setting, 1U);
+          }
+          else
+          {
+            USBD_CtlError(pdev, req);
+            ret = USBD_FAIL;
+          }
+          break;
+
+        case USB_REQ_SET_INTERFACE:
+          if (pdev->dev_state != USBD_STATE_CONFIGURED)
+          {
+            USBD_CtlError(pdev, req);
+            ret = USBD_FAIL;
+            break;
+          }
+
+          if (LOBYTE(req->wIndex) == AUDIO_IN_AC_INTERFACE)
+          {
+            /* The control interface has a single alternate setting */
+            if ((uint8_t)(req->wValue) != 0U)
+            {
+              USBD_CtlError(pdev, req);
+              ret = USBD_FAIL;
+            }
+            break;
+          }
+
+          if ((uint8_t)(req->wValue) > 1U)
+          {
+            /* Call the error management function (command will be NAKed */
+            USBD_CtlError(pdev, req);
+            ret = USBD_FAIL;
+            break;
+          }
+
+          if ((uint8_t)(req->wValue) != haudio->alt_setting)
+          {
+            haudio->alt_setting = (uint8_t)(req->wValue);
+            (void)USBD_LL_FlushEP(pdev, AUDIO_IN_EP);
+            haudio->tx_pending = 0U;
+            haudio->resend = 0U;
+
+            if (itf != NULL)
+            {
+              if (haudio->alt_setting == 1U)
+              {
+                itf->Start();
+              }
+              else
+              {
+                itf->Stop();
+              }
+            }
+          }
+          break;
+
+        case USB_REQ_CLEAR_FEATURE:
+          break;
+
+        default:
+          USBD_CtlError(pdev, req);
+          ret = USBD_FAIL;
+          break;
+      }
+      break;
+
+    default:
+      USBD_CtlError(pdev, req);
+      ret = USBD_FAIL;
+      break;
+  }
+
+  return (uint8_t)ret;
+}
+
+/**
+  * @brief  USBD_AUDIO_IN_EP0_RxReady
+  *         handle EP0 Rx Ready event (SET_CUR data stage, ignored)
+  * @param  pdev: device instance
+  * @retval status
+  */
+static uint8_t USBD_AUDIO_IN_EP0_RxReady(USBD_HandleTypeDef *pdev)
+{
+  UNUSED(pdev);
+
+  return (uint8_t)USBD_OK;
+}
+
+/**
+  * @brief  USBD_AUDIO_IN_DataIn
+  *         handle data IN Stage: the packet was collected by the host
+  * @param  pdev: device instance
+  * @param  epnum: endpoint index
+  * @retval status
+  */
+static uint8_t USBD_AUDIO_IN_DataIn(USBD_HandleTypeDef *pdev, uint8_t epnum)
+{
+  USBD_AUDIO_IN_HandleTypeDef *haudio = (USBD_AUDIO_IN_HandleTypeDef *)pdev->pClassDataCmsit[pdev->classId];
+
+  if ((haudio == NULL) || (epnum != (AUDIO_IN_EP & 0x7FU)))
+  {
+    return (uint8_t)USBD_FAIL;
+  }
+
+  haudio->tx_pending = 0U;
+  haudio->packets++;
+
+  return (uint8_t)USBD_OK;
+}
+
+/**
+  * @brief  USBD_AUDIO_IN_SOF
+  *         handle SOF event: queue the packet for the next frame
+  * @param  pdev: device instance
+  * @retval status
+  */
+static uint8_t USBD_AUDIO_IN_SOF(USBD_HandleTypeDef *pdev)
+{
+  USBD_AUDIO_IN_HandleTypeDef *haudio = (USBD_AUDIO_IN_HandleTypeDef *)pdev->pClassDataCmsit[pdev->classId];
+  USBD_AUDIO_IN_ItfTypeDef *itf = (USBD_AUDIO_IN_ItfTypeDef *)pdev->pUserData[pdev->classId];
+
+  if ((haudio == NULL) || (itf == NULL) || (haudio->alt_setting != 1U) || (haudio->tx_pending != 0U))
+  {
+    return (uint8_t)USBD_OK;
+  }
+
+  if (haudio->resend != 0U)
+  {
+    haudio->resend = 0U;
+    haudio->resent++;
+  }
+  else
+  {
+    haudio->tx_length = itf->Fill((uint8_t *)haudio->buffer, AUDIO_IN_PACKET_SZE);
+  }
+
+  /* The core schedules an ISO IN transfer for the frame following the current one */
+  haudio->tx_pending = 1U;
+  (void)USBD_LL_Transmit(pdev, AUDIO_IN_EP, (uint8_t *)haudio->buffer, haudio->tx_length);
+
+  return (uint8_t)USBD_OK;
+}
+
+/**
+  * @brief  USBD_AUDIO_IN_IsoINIncomplete
+  *         handle data ISO IN Incomplete event: the host skipped the frame,
+  *         the endpoint was disabled and the same packet goes out at the next SOF
+  * @param  pdev: device instance
+  * @param  epnum: endpoint index
+  * @retval status
+  */
+static uint8_t USBD_AUDIO_IN_IsoINIncomplete(USBD_HandleTypeDef *pdev, uint8_t epnum)
+{
+  USBD_AUDIO_IN_HandleTypeDef *haudio = (USBD_AUDIO_IN_HandleTypeDef *)pdev->pClassDataCmsit[pdev->classId];
+
+  if ((haudio == NULL) || (epnum != (AUDIO_IN_EP & 0x7FU)))
+  {
+    return (uint8_t)USBD_FAIL;
+  }
+
+  if (haudio->tx_pending != 0U)
+  {
+    (void)USBD_LL_FlushEP(pdev, AUDIO_IN_EP);
+    haudio->tx_pending = 0U;
+    haudio->resend = 1U;
+  }
+
+  return (uint8_t)USBD_OK;
+}
+
+/**
+  * @brief  USBD_AUDIO_IN_GetCfgDesc
+  *         return configuration descriptor (full-speed only)
+  * @param  length : pointer data length
+  * @retval pointer to descriptor buffer
+  */
+static uint8_t *USBD_AUDIO_IN_GetCfgDesc(uint16_t *length)
+{
+  *length = (uint16_t)sizeof(USBD_AUDIO_IN_CfgDesc);
+
+  return USBD_AUDIO_IN_CfgDesc;
+}
+
+/**
+  * @brief  DeviceQualifierDescriptor
+  *         return Device Qualifier descriptor
+  * @param  length : pointer data length
+  * @retval pointer to descriptor buffer
+  */
+static uint8_t *USBD_AUDIO_IN_GetDeviceQualifierDesc(uint16_t *length)
+{
+  *length = (uint16_t)sizeof(USBD_AUDIO_IN_DeviceQualifierDesc);
+
+  return USBD_AUDIO_IN_DeviceQualifierDesc;
+}
+
+/**
+  * @brief  USBD_AUDIO_IN_RegisterInterface
+  * @param  pdev: device instance
+  * @param  fops: Audio input interface callback
+  * @retval status
+  */
+uint8_t USBD_AUDIO_IN_RegisterInterface(USBD_HandleTypeDef *pdev, USBD_AUDIO_IN_ItfTypeDef *fops)
+{
+  if (fops == NULL)
+  {
+    return (uint8_t)USBD_FAIL;
+  }
+
+  pdev->pUserData[pdev->classId] = fops;
+
+  return (uint8_t)USBD_OK;
+}
+/**
+  * @}
+  */
+
+
+/**
+  * @}
+  */
+
+
+/**
+  * @}
+  */
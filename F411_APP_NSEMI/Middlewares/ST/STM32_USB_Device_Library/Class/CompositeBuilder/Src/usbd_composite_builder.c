@@ -0,0 +1,683 @@
+/**
+  ******************************************************************************
+  * @file    usbd_composite_builder.c
+  * @author  MCD Application Team
+  * @brief   This file provides all the composite builder functions.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  * @verbatim
+  *
+  *          ===================================================================
+  *                                Composite Builder  Description
+  *          ===================================================================
+  *
+  *           The composite builder builds the configuration descriptors based on
+  *           the selection of classes by user.
+  *           It includes all USB Device classes in order to instantiate their
+  *           descriptors, but for better management, it is possible to optimize
+  *           footprint by removing unused classes. It is possible to do so by
+  *           commenting the relative define in usbd_conf.h.
+  *
+  *           This copy is trimmed to the classes linked in this project:
+  *             - CDC ACM, preceded by an Interface Association Descriptor
+  *             - HID, vendor-defined generic HID with interrupt IN and OUT
+  *               endpoints (see usbd_hid.c)
+  *           Only the full-speed configuration descriptor is built.
+  *
+  *  @endverbatim
+  *
+  ******************************************************************************
+  */
+
+/* BSPDependencies
+- None
+EndBSPDependencies */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbd_composite_builder.h"
+
+#ifdef USE_USBD_COMPOSITE
+
+#ifdef USE_USB_HS
+#error "The trimmed composite builder only supports full-speed devices"
+#endif /* USE_USB_HS */
+
+/** @addtogroup STM32_USB_DEVICE_LIBRARY
+  * @{
+  */
+
+
+/** @defgroup CMPSIT_CORE
+  * @brief Composite builder module
+  * @{
+  */
+
+/** @defgroup CMPSIT_CORE_Private_TypesDefinitions
+  * @{
+  */
+/**
+  * @}
+  */
+
+
+/** @defgroup CMPSIT_CORE_Private_Defines
+  * @{
+  */
+
+/**
+  * @}
+  */
+
+
+/** @defgroup CMPSIT_CORE_Private_Macros
+  * @{
+  */
+/**
+  * @}
+  */
+
+
+/** @defgroup CMPSIT_CORE_Private_FunctionPrototypes
+  * @{
+  */
+/* uint8_t  USBD_CMPSIT_Init (USBD_HandleTypeDef *pdev, uint8_t cfgidx); */
+/* uint8_t  USBD_CMPSIT_DeInit (USBD_HandleTypeDef *pdev, uint8_t cfgidx); */
+/* uint8_t  USBD_CMPSIT_Setup (USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req); */
+/* uint8_t  USBD_CMPSIT_DataIn (USBD_HandleTypeDef *pdev, uint8_t epnum); */
+/* uint8_t  USBD_CMPSIT_DataOut (USBD_HandleTypeDef *pdev, uint8_t epnum); */
+
+static uint8_t  *USBD_CMPSIT_GetHSCfgDesc(uint16_t *length);
+static uint8_t  *USBD_CMPSIT_GetFSCfgDesc(uint16_t *length);
+static uint8_t  *USBD_CMPSIT_GetOtherSpeedCfgDesc(uint16_t *length);
+static uint8_t  *USBD_CMPSIT_GetDeviceQualifierDescriptor(uint16_t *length);
+
+static uint8_t USBD_CMPSIT_FindFreeIFNbr(USBD_HandleTypeDef *pdev);
+
+static void  USBD_CMPSIT_AddConfDesc(uint32_t Conf, __IO uint32_t *pSze);
+
+static void  USBD_CMPSIT_AssignEp(USBD_HandleTypeDef *pdev, uint8_t Add, uint8_t Type, uint32_t Sze);
+
+
+#if USBD_CMPSIT_ACTIVATE_HID == 1U
+static void  USBD_CMPSIT_HIDDesc(USBD_HandleTypeDef *pdev, uint32_t pConf, __IO uint32_t *Sze, uint8_t speed);
+#endif /* USBD_CMPSIT_ACTIVATE_HID == 1U */
+
+#if USBD_CMPSIT_ACTIVATE_CDC == 1U
+static void  USBD_CMPSIT_CDCDesc(USBD_HandleTypeDef *pdev, uint32_t pConf, __IO uint32_t *Sze, uint8_t speed);
+#endif /* USBD_CMPSIT_ACTIVATE_CDC == 1U */
+
+/**
+  * @}
+  */
+
+
+/** @defgroup CMPSIT_CORE_Private_Variables
+  * @{
+  */
+/* This structure is used only for the Configuration descriptors and Device Qualifier */
+USBD_ClassTypeDef  USBD_CMPSIT =
+{
+  NULL, /* Init, */
+  NULL, /*DeInit, */
+  NULL, /*Setup, */
+  NULL, /*EP0_TxSent, */
+  NULL, /*EP0_RxReady, */
+  NULL, /*DataIn, */
+  NULL, /*DataOut, */
+  NULL, /*SOF,  */
+  NULL,
+  NULL,
+  USBD_CMPSIT_GetHSCfgDesc,
+  USBD_CMPSIT_GetFSCfgDesc,
+  USBD_CMPSIT_GetOtherSpeedCfgDesc,
+  USBD_CMPSIT_GetDeviceQualifierDescriptor,
+#if (USBD_SUPPORT_USER_STRING_DESC == 1U)
+  NULL,
+#endif /* USBD_SUPPORT_USER_STRING_DESC */
+};
+
+/* The generic configuration descriptor buffer that will be filled by builder
+   Size of the buffer is the maximum possible configuration descriptor size. */
+__ALIGN_BEGIN static uint8_t USBD_CMPSIT_FSCfgDesc[USBD_CMPST_MAX_CONFDESC_SZ]  __ALIGN_END = {0};
+static uint8_t *pCmpstFSConfDesc = USBD_CMPSIT_FSCfgDesc;
+/* Variable that dynamically holds the current size of the configuration descriptor */
+static __IO uint32_t CurrFSConfDescSz = 0U;
+
+/* USB Standard Device Descriptor */
+__ALIGN_BEGIN static uint8_t USBD_CMPSIT_DeviceQualifierDesc[USB_LEN_DEV_QUALIFIER_DESC]  __ALIGN_END =
+{
+  USB_LEN_DEV_QUALIFIER_DESC,
+  USB_DESC_TYPE_DEVICE_QUALIFIER,
+  0x00,
+  0x02,
+  0x00,
+  0x00,
+  0x00,
+  0x40,
+  0x01,
+  0x00,
+};
+
+/**
+  * @}
+  */
+
+
+/** @defgroup CMPSIT_CORE_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  USBD_CMPSIT_AddClass
+  *         Register a class in the class builder
+  * @param  pdev: device instance
+  * @param  pclass: pointer to the class structure to be added
+  * @param  class: type of the class to be added (from USBD_CompositeClassTypeDef)
+  * @param  cfgidx: configuration index
+  * @retval status
+  */
+uint8_t  USBD_CMPSIT_AddClass(USBD_HandleTypeDef *pdev,
+                              USBD_ClassTypeDef *pclass,
+                              USBD_CompositeClassTypeDef class,
+                              uint8_t cfgidx)
+{
+  if ((pdev->classId < USBD_MAX_SUPPORTED_CLASS) && (pdev->tclasslist[pdev->classId].Active == 0U))
+  {
+    /* Store the class parameters in the global tab */
+    pdev->pClass[pdev->classId] = pclass;
+    pdev->tclasslist[pdev->classId].ClassId = pdev->classId;
+    pdev->tclasslist[pdev->classId].Active = 1U;
+    pdev->tclasslist[pdev->classId].ClassType = class;
+
+    /* Call configuration descriptor builder and endpoint configuration builder */
+    if (USBD_CMPSIT_AddToConfDesc(pdev) != (uint8_t)USBD_OK)
+    {
+      return (uint8_t)USBD_FAIL;
+    }
+  }
+
+  UNUSED(cfgidx);
+
+  return (uint8_t)USBD_OK;
+}
+
+
+/**
+  * @brief  USBD_CMPSIT_AddToConfDesc
+  *         Add a new class to the configuration descriptor
+  * @param  pdev: device instance
+  * @retval status
+  */
+uint8_t  USBD_CMPSIT_AddToConfDesc(USBD_HandleTypeDef *pdev)
+{
+  uint8_t idxIf = 0U;
+  uint8_t iEp = 0U;
+
+  /* For the first class instance, start building the config descriptor common part */
+  if (pdev->classId == 0U)
+  {
+    /* Add configuration and IAD descriptors */
+    USBD_CMPSIT_AddConfDesc((uint32_t)pCmpstFSConfDesc, &CurrFSConfDescSz);
+  }
+
+  switch (pdev->tclasslist[pdev->classId].ClassType)
+  {
+#if USBD_CMPSIT_ACTIVATE_HID == 1
+    case CLASS_TYPE_HID:
+      /* Setup Max packet sizes (for HID, no dependency on USB Speed, both HS/FS have same packet size) */
+      pdev->tclasslist[pdev->classId].CurrPcktSze = HID_EPIN_SIZE;
+
+      /* Find the first available interface slot and Assign number of interfaces */
+      idxIf = USBD_CMPSIT_FindFreeIFNbr(pdev);
+      pdev->tclasslist[pdev->classId].NumIf = 1U;
+      pdev->tclasslist[pdev->classId].Ifs[0] = idxIf;
+
+      /* Assign endpoint numbers */
+      pdev->tclasslist[pdev->classId].NumEps = 2U; /* EP_IN, EP_OUT */
+
+      /* Set IN endpoint slot */
+      iEp = pdev->tclasslist[pdev->classId].EpAdd[0];
+
+      /* Assign IN Endpoint */
+      USBD_CMPSIT_AssignEp(pdev, iEp, USBD_EP_TYPE_INTR, pdev->tclasslist[pdev->classId].CurrPcktSze);
+
+      /* Set OUT endpoint slot */
+      iEp = pdev->tclasslist[pdev->classId].EpAdd[1];
+
+      /* Assign OUT Endpoint */
+      USBD_CMPSIT_AssignEp(pdev, iEp, USBD_EP_TYPE_INTR, HID_EPOUT_SIZE);
+
+      /* Configure and Append the Descriptor */
+      USBD_CMPSIT_HIDDesc(pdev, (uint32_t)pCmpstFSConfDesc, &CurrFSConfDescSz, (uint8_t)USBD_SPEED_FULL);
+
+      break;
+#endif /* USBD_CMPSIT_ACTIVATE_HID */
+
+#if USBD_CMPSIT_ACTIVATE_CDC == 1
+    case CLASS_TYPE_CDC:
+      /* Setup default Max packet size for FS device */
+      pdev->tclasslist[pdev->classId].CurrPcktSze = CDC_DATA_FS_MAX_PACKET_SIZE;
+
+      /* Find the first available interface slot and Assign number of interfaces */
+      idxIf = USBD_CMPSIT_FindFreeIFNbr(pdev);
+      pdev->tclasslist[pdev->classId].NumIf = 2U;
+      pdev->tclasslist[pdev->classId].Ifs[0] = idxIf;
+      pdev->tclasslist[pdev->classId].Ifs[1] = (uint8_t)(idxIf + 1U);
+
+      /* Assign endpoint numbers */
+      pdev->tclasslist[pdev->classId].NumEps = 3U;  /* EP1_IN, EP1_OUT,CMD_EP2 */
+
+      /* Set IN endpoint slot */
+      iEp = pdev->tclasslist[pdev->classId].EpAdd[0];
+
+      /* Assign IN Endpoint */
+      USBD_CMPSIT_AssignEp(pdev, iEp, USBD_EP_TYPE_BULK, pdev->tclasslist[pdev->classId].CurrPcktSze);
+
+      /* Set OUT endpoint slot */
+      iEp = pdev->tclasslist[pdev->classId].EpAdd[1];
+
+      /* Assign OUT Endpoint */
+      USBD_CMPSIT_AssignEp(pdev, iEp, USBD_EP_TYPE_BULK, pdev->tclasslist[pdev->classId].CurrPcktSze);
+
+      /* Set the second IN endpoint slot */
+      iEp = pdev->tclasslist[pdev->classId].EpAdd[2];
+
+      /* Assign CMD Endpoint */
+      USBD_CMPSIT_AssignEp(pdev, iEp, USBD_EP_TYPE_INTR, CDC_CMD_PACKET_SIZE);
+
+      /* Configure and Append the Descriptor */
+      USBD_CMPSIT_CDCDesc(pdev, (uint32_t)pCmpstFSConfDesc, &CurrFSConfDescSz, (uint8_t)USBD_SPEED_FULL);
+
+      break;
+#endif /* USBD_CMPSIT_ACTIVATE_CDC */
+
+    default:
+      UNUSED(idxIf);
+      UNUSED(iEp);
+      return (uint8_t)USBD_FAIL;
+  }
+
+  return (uint8_t)USBD_OK;
+}
+
+/**
+  * @brief  USBD_CMPSIT_GetFSCfgDesc
+  *         return configuration descriptor for both FS and HS modes
+  * @param  length : pointer data length
+  * @retval pointer to descriptor buffer
+  */
+uint8_t  *USBD_CMPSIT_GetFSCfgDesc(uint16_t *length)
+{
+  *length = (uint16_t)CurrFSConfDescSz;
+
+  return USBD_CMPSIT_FSCfgDesc;
+}
+
+/**
+  * @brief  USBD_CMPSIT_GetHSCfgDesc
+  *         return configuration descriptor for both FS and HS modes
+  *         (full-speed only device: same descriptor as FS)
+  * @param  length : pointer data length
+  * @retval pointer to descriptor buffer
+  */
+uint8_t  *USBD_CMPSIT_GetHSCfgDesc(uint16_t *length)
+{
+  *length = (uint16_t)CurrFSConfDescSz;
+
+  return USBD_CMPSIT_FSCfgDesc;
+}
+
+/**
+  * @brief  USBD_CMPSIT_GetOtherSpeedCfgDesc
+  *         return other speed configuration descriptor
+  * @param  length : pointer data length
+  * @retval pointer to descriptor buffer
+  */
+uint8_t  *USBD_CMPSIT_GetOtherSpeedCfgDesc(uint16_t *length)
+{
+  *length = (uint16_t)CurrFSConfDescSz;
+
+  return USBD_CMPSIT_FSCfgDesc;
+}
+
+/**
+  * @brief  DeviceQualifierDescriptor
+  *         return Device Qualifier descriptor
+  * @param  length : pointer data length
+  * @retval pointer to descriptor buffer
+  */
+uint8_t  *USBD_CMPSIT_GetDeviceQualifierDescriptor(uint16_t *length)
+{
+  *length = (uint16_t)(sizeof(USBD_CMPSIT_DeviceQualifierDesc));
+  return USBD_CMPSIT_DeviceQualifierDesc;
+}
+
+/**
+  * @brief  USBD_CMPSIT_FindFreeIFNbr
+  *         Find the first interface available slot
+  * @param  pdev: device instance
+  * @retval The interface number to be used
+  */
+static uint8_t USBD_CMPSIT_FindFreeIFNbr(USBD_HandleTypeDef *pdev)
+{
+  uint32_t idx = 0U;
+
+  /* Unroll all already activated classes */
+  for (uint32_t i = 0U; i < pdev->NumClasses; i++)
+  {
+    /* Unroll each class interfaces */
+    for (uint32_t j = 0U; j < pdev->tclasslist[i].NumIf; j++)
+    {
+      /* Increment the interface counter index */
+      idx++;
+    }
+  }
+
+  /* Return the first available interface slot */
+  return (uint8_t)idx;
+}
+
+/**
+  * @brief  USBD_CMPSIT_AddConfDesc
+  *         Add a new class to the configuration descriptor
+  * @param  Conf: configuration descriptor
+  * @param  pSze: pointer to the configuration descriptor size
+  * @retval none
+  */
+static void  USBD_CMPSIT_AddConfDesc(uint32_t Conf, __IO uint32_t *pSze)
+{
+  /* Intermediate variable to comply with MISRA-C Rule 11.3 */
+  USBD_ConfigDescTypeDef *ptr = (USBD_ConfigDescTypeDef *)Conf;
+
+  ptr->bLength = (uint8_t)sizeof(USBD_ConfigDescTypeDef);
+  ptr->bDescriptorType = USB_DESC_TYPE_CONFIGURATION;
+  ptr->wTotalLength = 0U;
+  ptr->bNumInterfaces = 0U;
+  ptr->bConfigurationValue = 1U;
+  ptr->iConfiguration = USBD_CONFIG_STR_DESC_IDX;
+  ptr->bmAttributes = USBD_CONFIG_BMATTRIBUTES;
+  ptr->bMaxPower = USBD_CONFIG_MAXPOWER;
+  *pSze += sizeof(USBD_ConfigDescTypeDef);
+}
+
+/**
+  * @brief  USBD_CMPSIT_AssignEp
+  *         Assign and endpoint
+  * @param  pdev: device instance
+  * @param  Add: Endpoint address
+  * @param  Type: Endpoint type
+  * @param  Sze: Endpoint max packet size
+  * @retval none
+  */
+static void  USBD_CMPSIT_AssignEp(USBD_HandleTypeDef *pdev, uint8_t Add, uint8_t Type, uint32_t Sze)
+{
+  uint32_t idx = 0U;
+
+  /* Find the first available endpoint slot */
+  while (((idx < (pdev->tclasslist[pdev->classId]).NumEps) && \
+          ((pdev->tclasslist[pdev->classId].Eps[idx].is_used) != 0U)))
+  {
+    /* Increment the index */
+    idx++;
+  }
+
+  /* Configure the endpoint */
+  pdev->tclasslist[pdev->classId].Eps[idx].add = Add;
+  pdev->tclasslist[pdev->classId].Eps[idx].type = Type;
+  pdev->tclasslist[pdev->classId].Eps[idx].size = (uint8_t)Sze;
+  pdev->tclasslist[pdev->classId].Eps[idx].is_used = 1U;
+}
+
+#if USBD_CMPSIT_ACTIVATE_HID == 1
+/**
+  * @brief  USBD_CMPSIT_HIDDesc
+  *         Configure and Append the HID Descriptor
+  *         (vendor-defined generic HID: no boot subclass, IN and OUT report endpoints)
+  * @param  pdev: device instance
+  * @param  pConf: Configuration descriptor pointer
+  * @param  Sze: pointer to the current configuration descriptor size
+  * @retval None
+  */
+static void  USBD_CMPSIT_HIDDesc(USBD_HandleTypeDef *pdev, uint32_t pConf,
+                                 __IO uint32_t *Sze, uint8_t speed)
+{
+  static USBD_IfDescTypeDef *pIfDesc;
+  static USBD_EpDescTypeDef *pEpDesc;
+  static USBD_HIDDescTypeDef *pHidDesc;
+
+  /* Append HID Interface descriptor to Configuration descriptor */
+  __USBD_CMPSIT_SET_IF(pdev->tclasslist[pdev->classId].Ifs[0], 0U, \
+                       (uint8_t)(pdev->tclasslist[pdev->classId].NumEps), 0x03U, 0x00U, 0x00U, 0U);
+
+  /* Append HID Functional descriptor to Configuration descriptor */
+  pHidDesc = ((USBD_HIDDescTypeDef *)(pConf + *Sze));
+  pHidDesc->bLength = (uint8_t)sizeof(USBD_HIDDescTypeDef);
+  pHidDesc->bDescriptorType = HID_DESCRIPTOR_TYPE;
+  pHidDesc->bcdHID = 0x0111U;
+  pHidDesc->bCountryCode = 0x00U;
+  pHidDesc->bNumDescriptors = 0x01U;
+  pHidDesc->bHIDDescriptorType = 0x22U;
+  pHidDesc->wItemLength = HID_GENERIC_REPORT_DESC_SIZE;
+  *Sze += (uint32_t)sizeof(USBD_HIDDescTypeDef);
+
+  /* Append Endpoint descriptors to Configuration descriptor */
+  __USBD_CMPSIT_SET_EP(pdev->tclasslist[pdev->classId].Eps[0].add, USBD_EP_TYPE_INTR, HID_EPIN_SIZE, \
+                       HID_HS_BINTERVAL, HID_FS_BINTERVAL);
+  __USBD_CMPSIT_SET_EP(pdev->tclasslist[pdev->classId].Eps[1].add, USBD_EP_TYPE_INTR, HID_EPOUT_SIZE, \
+                       HID_HS_BINTERVAL, HID_FS_BINTERVAL);
+
+  /* Update Config Descriptor and IAD descriptor */
+  ((USBD_ConfigDescTypeDef *)pConf)->bNumInterfaces += 1U;
+  ((USBD_ConfigDescTypeDef *)pConf)->wTotalLength  = (uint16_t)(*Sze);
+}
+#endif /* USBD_CMPSIT_ACTIVATE_HID == 1 */
+
+#if USBD_CMPSIT_ACTIVATE_CDC == 1
+/**
+  * @brief  USBD_CMPSIT_CDCDesc
+  *         Configure and Append the CDC Descriptor
+  * @param  pdev: device instance
+  * @param  pConf: Configuration descriptor pointer
+  * @param  Sze: pointer to the current configuration descriptor size
+  * @retval None
+  */
+static void USBD_CMPSIT_CDCDesc(USBD_HandleTypeDef *pdev, uint32_t pConf, __IO uint32_t *Sze, uint8_t speed)
+{
+  static USBD_IfDescTypeDef               *pIfDesc;
+  static USBD_EpDescTypeDef               *pEpDesc;
+  static USBD_CDCHeaderFuncDescTypeDef    *pHeadDesc;
+  static USBD_CDCCallMgmFuncDescTypeDef    *pCallMgmDesc;
+  static USBD_CDCACMFuncDescTypeDef       *pACMDesc;
+  static USBD_CDCUnionFuncDescTypeDef     *pUnionDesc;
+  static USBD_IadDescTypeDef              *pIadDesc;
+
+  /* Append the Interface Association Descriptor, required by hosts to bind
+     the two CDC interfaces to one function */
+  pIadDesc = ((USBD_IadDescTypeDef *)(pConf + *Sze));
+  pIadDesc->bLength = (uint8_t)sizeof(USBD_IadDescTypeDef);
+  pIadDesc->bDescriptorType = USB_DESC_TYPE_IAD; /* IAD descriptor */
+  pIadDesc->bFirstInterface = pdev->tclasslist[pdev->classId].Ifs[0];
+  pIadDesc->bInterfaceCount = 2U;    /* 2 interfaces */
+  pIadDesc->bFunctionClass = 0x02U;
+  pIadDesc->bFunctionSubClass = 0x02U;
+  pIadDesc->bFunctionProtocol = 0x01U;
+  pIadDesc->iFunction = 0; /* String Index */
+  *Sze += (uint32_t)sizeof(USBD_IadDescTypeDef);
+
+  /* Control Interface Descriptor */
+  __USBD_CMPSIT_SET_IF(pdev->tclasslist[pdev->classId].Ifs[0], 0U, 1U, 0x02, 0x02U, 0x01U, 0U);
+
+  /* Control interface headers */
+  pHeadDesc = ((USBD_CDCHeaderFuncDescTypeDef *)((uint32_t)pConf + *Sze));
+  /* Header Functional Descriptor*/
+  pHeadDesc->bLength = 0x05U;
+  pHeadDesc->bDescriptorType = 0x24U;
+  pHeadDesc->bDescriptorSubtype = 0x00U;
+  pHeadDesc->bcdCDC = 0x0110;
+  *Sze += (uint32_t)sizeof(USBD_CDCHeaderFuncDescTypeDef);
+
+  /* Call Management Functional Descriptor*/
+  pCallMgmDesc = ((USBD_CDCCallMgmFuncDescTypeDef *)((uint32_t)pConf + *Sze));
+  pCallMgmDesc->bFunctionLength = 0x05U;
+  pCallMgmDesc->bDescriptorType = 0x24U;
+  pCallMgmDesc->bDescriptorSubtype = 0x01U;
+  pCallMgmDesc->bmCapabilities = 0x00U;
+  pCallMgmDesc->bDataInterface = pdev->tclasslist[pdev->classId].Ifs[1];
+  *Sze += (uint32_t)sizeof(USBD_CDCCallMgmFuncDescTypeDef);
+
+  /* ACM Functional Descriptor*/
+  pACMDesc = ((USBD_CDCACMFuncDescTypeDef *)((uint32_t)pConf + *Sze));
+  pACMDesc->bFunctionLength = 0x04U;
+  pACMDesc->bDescriptorType = 0x24U;
+  pACMDesc->bDescriptorSubtype = 0x02U;
+  pACMDesc->bmCapabilities = 0x02;
+  *Sze += (uint32_t)sizeof(USBD_CDCACMFuncDescTypeDef);
+
+  /* Union Functional Descriptor*/
+  pUnionDesc = ((USBD_CDCUnionFuncDescTypeDef *)((uint32_t)pConf + *Sze));
+  pUnionDesc->bFunctionLength = 0x05U;
+  pUnionDesc->bDescriptorType = 0x24U;
+  pUnionDesc->bDescriptorSubtype = 0x06U;
+  pUnionDesc->bMasterInterface = pdev->tclasslist[pdev->classId].Ifs[0];
+  pUnionDesc->bSlaveInterface = pdev->tclasslist[pdev->classId].Ifs[1];
+  *Sze += (uint32_t)sizeof(USBD_CDCUnionFuncDescTypeDef);
+
+  /* Append Endpoint descriptor to Configuration descriptor */
+  __USBD_CMPSIT_SET_EP(pdev->tclasslist[pdev->classId].Eps[2].add, \
+                       USBD_EP_TYPE_INTR, CDC_CMD_PACKET_SIZE, CDC_HS_BINTERVAL, CDC_FS_BINTERVAL);
+
+  /* Data Interface Descriptor */
+  __USBD_CMPSIT_SET_IF(pdev->tclasslist[pdev->classId].Ifs[1], 0U, 2U, 0x0A, 0U, 0U, 0U);
+
+  /* Append Endpoint descriptor to Configuration descriptor */
+  __USBD_CMPSIT_SET_EP((pdev->tclasslist[pdev->classId].Eps[1].add), \
+                       (USBD_EP_TYPE_BULK), (pdev->tclasslist[pdev->classId].CurrPcktSze), (0U), (0U));
+
+  /* Append Endpoint descriptor to Configuration descriptor */
+  __USBD_CMPSIT_SET_EP((pdev->tclasslist[pdev->classId].Eps[0].add), \
+                       (USBD_EP_TYPE_BULK), (pdev->tclasslist[pdev->classId].CurrPcktSze), (0U), (0U));
+
+  /* Update Config Descriptor and IAD descriptor */
+  ((USBD_ConfigDescTypeDef *)pConf)->bNumInterfaces += 2U;
+  ((USBD_ConfigDescTypeDef *)pConf)->wTotalLength  = (uint16_t)(*Sze);
+}
+#endif /* USBD_CMPSIT_ACTIVATE_CDC == 1 */
+
+/**
+  * @brief  USBD_CMPSIT_SetClassID
+  *         Find and set the class ID relative to selected class type and instance
+  * @param  pdev: device instance
+  * @param  Class: Class type, can be CLASS_TYPE_NONE if requested to find class from setup request
+  * @param  Instance: Instance number of the class (0 if first/unique instance)
+  * @retval The Class ID, The pdev->classId is set with the value of the selected class ID.
+  */
+uint32_t  USBD_CMPSIT_SetClassID(USBD_HandleTypeDef *pdev, USBD_CompositeClassTypeDef Class, uint32_t Instance)
+{
+  uint32_t idx;
+  uint32_t inst = 0U;
+
+  /* Unroll all already activated classes */
+  for (idx = 0U; idx < pdev->NumClasses; idx++)
+  {
+    /* Check if the class correspond to the requested type and if it is active */
+    if ((pdev->tclasslist[idx].ClassType == Class) && (pdev->tclasslist[idx].Active == 1U))
+    {
+      if (inst == Instance)
+      {
+        /* Set the new class ID */
+        pdev->classId = idx;
+
+        /* Return the class ID value */
+        return (pdev->classId);
+      }
+      else
+      {
+        /* Increment instance index and look for next instance */
+        inst++;
+      }
+    }
+  }
+
+  /* No class found, return 0xFF */
+  return 0xFFU;
+}
+
+/**
+  * @brief  USBD_CMPSIT_GetClassID
+  *         Returns the class ID relative to selected class type and instance
+  * @param  pdev: device instance
+  * @param  Class: Class type, can be CLASS_TYPE_NONE if requested to find class from setup request
+  * @param  Instance: Instance number of the class (0 if first/unique instance)
+  * @retval The Class ID (this function does not set the pdev->classId field.
+  */
+uint32_t  USBD_CMPSIT_GetClassID(USBD_HandleTypeDef *pdev, USBD_CompositeClassTypeDef Class, uint32_t Instance)
+{
+  uint32_t idx;
+  uint32_t inst = 0U;
+
+  /* Unroll all already activated classes */
+  for (idx = 0U; idx < pdev->NumClasses; idx++)
+  {
+    /* Check if the class correspond to the requested type and if it is active */
+    if ((pdev->tclasslist[idx].ClassType == Class) && (pdev->tclasslist[idx].Active == 1U))
+    {
+      if (inst == Instance)
+      {
+        /* Return the class ID value */
+        return (idx);
+      }
+      else
+      {
+        /* Increment instance index and look for next instance */
+        inst++;
+      }
+    }
+  }
+
+  /* No class found, return 0xFF */
+  return 0xFFU;
+}
+
+/**
+  * @brief  USBD_CMPST_ClearConfDesc
+  *         Reset the configuration descriptor
+  * @param  pdev: device instance (reserved for future use)
+  * @retval Status.
+  */
+uint8_t USBD_CMPST_ClearConfDesc(USBD_HandleTypeDef *pdev)
+{
+  UNUSED(pdev);
+
+  /* Reset the configuration descriptor pointer to default value and its size to zero */
+  pCmpstFSConfDesc = USBD_CMPSIT_FSCfgDesc;
+  CurrFSConfDescSz = 0U;
+
+  /* All done, can't fail */
+  return (uint8_t)USBD_OK;
+}
+
+/**
+  * @}
+  */
+
+
+/**
+  * @}
+  */
+
+
+/**
+  * @}
+  */
+
+#endif /* USE_USBD_COMPOSITE */
+
@@ -43,11 +43,15 @@ extern "C" {
 #ifndef HID_EPIN_ADDR
 #define HID_EPIN_ADDR                              0x81U
 #endif /* HID_EPIN_ADDR */
-#define HID_EPIN_SIZE                              0x04U
+#define HID_EPIN_SIZE                              0x40U
+#ifndef HID_EPOUT_ADDR
+#define HID_EPOUT_ADDR                             0x01U
+#endif /* HID_EPOUT_ADDR */
+#define HID_EPOUT_SIZE                             0x40U
 
-#define USB_HID_CONFIG_DESC_SIZ                    34U
+#define USB_HID_CONFIG_DESC_SIZ                    41U
 #define USB_HID_DESC_SIZ                           9U
-#define HID_MOUSE_REPORT_DESC_SIZE                 74U
+#define HID_GENERIC_REPORT_DESC_SIZE               34U
 
 #define HID_DESCRIPTOR_TYPE                        0x21U
 #define HID_REPORT_DESC                            0x22U
@@ -57,7 +61,7 @@ extern "C" {
 #endif /* HID_HS_BINTERVAL */
 
 #ifndef HID_FS_BINTERVAL
-#define HID_FS_BINTERVAL                           0x0AU
+#define HID_FS_BINTERVAL                           0x01U
 #endif /* HID_FS_BINTERVAL */
 
 #define USBD_HID_REQ_SET_PROTOCOL                       0x0BU
@@ -89,8 +93,17 @@ typedef struct
   uint32_t IdleState;
   uint32_t AltSetting;
   USBD_HID_StateTypeDef state;
+  uint32_t OutReport[HID_EPOUT_SIZE / 4U];              /* Force 32-bit alignment */
 } USBD_HID_HandleTypeDef;
 
+typedef struct _USBD_HID_Itf
+{
+  int8_t (* Init)(void);
+  int8_t (* DeInit)(void);
+  int8_t (* OutEvent)(uint8_t *report, uint16_t length);
+  int8_t (* InCplt)(void);
+} USBD_HID_ItfTypeDef;
+
 /*
  * HID Class specification version 1.1
  * 6.2.1 HID Descriptor
@@ -140,6 +153,7 @@ uint8_t USBD_HID_SendReport(USBD_HandleTypeDef *pdev, uint8_t *report, uint16_t
 uint8_t USBD_HID_SendReport(USBD_HandleTypeDef *pdev, uint8_t *report, uint16_t len);
 #endif /* USE_USBD_COMPOSITE */
 uint32_t USBD_HID_GetPollingInterval(USBD_HandleTypeDef *pdev);
+uint8_t USBD_HID_RegisterInterface(USBD_HandleTypeDef *pdev, USBD_HID_ItfTypeDef *fops);
 
 /**
   * @}
@@ -0,0 +1,699 @@
+/*
+ * font_gen.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  分頁字型產生器：讀取 ssd1306_fonts.c 的列優先 uint16_t 字型表，轉成和 SSD1306
+ *  顯示記憶體相同的排列（每個 byte 是一行 8 個垂直像素，bit0 在上），
+ *  產生 ssd1306_fonts_paged.c / .h 給 ssd1306_WriteCharPaged 整個 byte 寫入。
+ *
+ *  每個字元 pages x width 個 byte，依頁排列：第 p 頁第 x 行在 [p * width + x]，
+ *  寬度一律用字型的最大寬度；比例字型另外輸出每個字元的寬度表。
+ *
+ *  用法: font_gen ssd1306_fonts.c ssd1306_fonts_paged.c ssd1306_fonts_paged.h
+ *        通常由 CMake 的 fonts 目標執行，輸出寫回 Core/Src 與 Core/Inc
+ *
+ *  字型編譯（-f）：只取字元集檔案裡用到的字元（UTF-8，可含中文），輸出
+ *  SSD1306_GlyphFont_t：依 Unicode 排序的碼點表、字寬、位移與頁排列的字元資料，
+ *  每個字元只存自己的寬度。加上 ,rle 時每個字元各自做 run-length 壓縮，
+ *  韌體畫字時解到 glyph cache。
+ *
+ *  用法: font_gen -c charset.txt -f 名稱=來源[,rle] [-c ... -f ...] output.c output.h
+ *        來源: ssd1306_fonts.c:Font_6x8（內建字型表）或 BDF 點陣字型檔
+ *        -c 套用到之後的 -f；字元集一律加上空白與 '?'（缺字時顯示）
+ */
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int kFirstChar = 32;
+constexpr int kGlyphs = 95;             // ' ' .. '~'
+
+struct Font {
+    std::string name;                   // Font_6x8
+    std::string guard;                  // SSD1306_INCLUDE_FONT_6x8
+    int width = 0;
+    int height = 0;
+    std::vector<uint16_t> rows;         // 原始字型表，每字元 height 列
+    std::vector<uint8_t> widths;        // 比例字型的字元寬度，等寬字型為空
+};
+
+// 去掉 C 註解，保留換行
+std::string StripComments(const std::string &src)
+{
+    std::string out;
+    out.reserve(src.size());
+
+    for (size_t i = 0; i < src.size(); i++) {
+        if (src.compare(i, 2, "//") == 0) {
+            while (i < src.size() && src[i] != '\n')
+                i++;
+            if (i < src.size())
+                out.push_back('\n');
+        } else if (src.compare(i, 2, "/*") == 0) {
+            size_t end = src.find("*/", i + 2);
+            i = (end == std::string::npos) ? src.size() : end + 1;
+        } else {
+            out.push_back(src[i]);
+        }
+    }
+
+    return out;
+}
+
+std::vector<unsigned long> ParseNumbers(const std::string &body)
+{
+    std::vector<unsigned long> values;
+    static const std::regex number(R"(0[xX][0-9a-fA-F]+|\d+)");
+
+    for (auto it = std::sregex_iterator(body.begin(), body.end(), number); it != std::sregex_iterator(); ++it)
+        values.push_back(std::stoul(it->str(), nullptr, 0));
+
+    return values;
+}
+
+// 讀出所有字型表與 SSD1306_Font_t 定義
+bool LoadFonts(const std::string &path, std::vector<Font> &fonts)
+{
+    std::ifstream file(path);
+    if (!file) {
+        std::fprintf(stderr, "cannot open %s\n", path.c_str());
+        return false;
+    }
+    std::string src = StripComments(std::string((std::istreambuf_iterator<char>(file)),
+                                                std::istreambuf_iterator<char>()));
+
+    std::map<std::string, std::vector<unsigned long>> tables;
+    static const std::regex table(R"(static\s+const\s+uint(?:8|16)_t\s+(\w+)\s*\[\]\s*=\s*\{([^}]*)\})");
+    for (auto it = std::sregex_iterator(src.begin(), src.end(), table); it != std::sregex_iterator(); ++it)
+        tables[(*it)[1]] = ParseNumbers((*it)[2]);
+
+    static const std::regex def(R"(const\s+SSD1306_Font_t\s+(Font_(\w+))\s*=\s*\{\s*(\d+)\s*,\s*(\d+)\s*,\s*(\w+)\s*,\s*(\w+)\s*\})");
+    for (auto it = std::sregex_iterator(src.begin(), src.end(), def); it != std::sregex_iterator(); ++it) {
+        Font font;
+        font.name = (*it)[1];
+        font.guard = "SSD1306_INCLUDE_FONT_" + (*it)[2].str();
+        font.width = std::stoi((*it)[3]);
+        font.height = std::stoi((*it)[4]);
+
+        auto rows = tables.find((*it)[5]);
+        if (rows == tables.end() || rows->second.size() < static_cast<size_t>(kGlyphs * font.height) ||
+            font.width < 1 || font.width > 16 || font.height < 1) {
+            std::fprintf(stderr, "%s: missing or short table %s\n", font.name.c_str(), (*it)[5].str().c_str());
+            return false;
+        }
+        font.rows.assign(rows->second.begin(), rows->second.begin() + kGlyphs * font.height);
+
+        if ((*it)[6] != "NULL") {
+            auto widths = tables.find((*it)[6]);
+            if (widths == tables.end() || widths->second.size() < static_cast<size_t>(kGlyphs)) {
+                std::fprintf(stderr, "%s: missing width table %s\n", font.name.c_str(), (*it)[6].str().c_str());
+                return false;
+            }
+            font.widths.assign(widths->second.begin(), widths->second.begin() + kGlyphs);
+        }
+
+        fonts.push_back(font);
+    }
+
+    if (fonts.empty()) {
+        std::fprintf(stderr, "%s: no SSD1306_Font_t definitions\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+// 一個字元轉成頁排列：原始表每列 bit15 是第 0 行
+std::vector<uint8_t> PageGlyph(const Font &font, int glyph)
+{
+    const int pages = (font.height + 7) / 8;
+    std::vector<uint8_t> out(static_cast<size_t>(pages * font.width), 0);
+
+    for (int y = 0; y < font.height; y++) {
+        uint16_t row = font.rows[static_cast<size_t>(glyph * font.height + y)];
+        for (int x = 0; x < font.width; x++) {
+            if (row & (0x8000u >> x))
+                out[static_cast<size_t>((y / 8) * font.width + x)] |= static_cast<uint8_t>(1u << (y % 8));
+        }
+    }
+
+    return out;
+}
+
+std::string CharComment(int glyph)
+{
+    char ch = static_cast<char>(kFirstChar + glyph);
+    if (ch == ' ')
+        return "sp";
+    if (ch == '\\')
+        return "backslash";
+    return std::string(1, ch);
+}
+
+void WriteSource(std::ostream &out, const std::vector<Font> &fonts, const std::string &input,
+                 const std::string &source, const std::string &header)
+{
+    out << "/*\n"
+           " * " << source << "\n"
+           " *\n"
+           " *  Generated by Tools/font_gen from " << input << ", do not edit.\n"
+           " *  Glyphs in SSD1306 page layout: pages x width bytes per character,\n"
+           " *  byte [p * width + x] holds column x of page p, bit 0 on top.\n"
+           " */\n"
+           "#include \"" << header << "\"\n";
+
+    for (const Font &font : fonts) {
+        const std::string base = font.name.substr(0, 4) + font.name.substr(5);   // Font6x8
+        const int pages = (font.height + 7) / 8;
+
+        out << "\n#ifdef " << font.guard << "\n";
+        out << "static const uint8_t " << base << "_Paged [] = {\n";
+        for (int g = 0; g < kGlyphs; g++) {
+            std::vector<uint8_t> bytes = PageGlyph(font, g);
+            for (size_t i = 0; i < bytes.size(); i++) {
+                char hex[8];
+                std::snprintf(hex, sizeof(hex), "0x%02X,", bytes[i]);
+                out << hex;
+                if (i + 1 < bytes.size())
+                    out << ((i + 1) % static_cast<size_t>(font.width) == 0 ? "  " : " ");
+            }
+            out << "  // " << CharComment(g) << "\n";
+        }
+        out << "};\n";
+
+        std::string widths = "NULL";
+        if (!font.widths.empty()) {
+            widths = base + "_Paged_width";
+            out << "\nstatic const uint8_t " << widths << " [] = {\n";
+            for (int g = 0; g < kGlyphs; g++)
+                out << (g % 16 == 0 ? "" : " ") << static_cast<unsigned>(font.widths[static_cast<size_t>(g)]) << ","
+                    << (g % 16 == 15 || g + 1 == kGlyphs ? "\n" : "");
+            out << "};\n";
+        }
+
+        out << "\nconst SSD1306_PagedFont_t " << font.name << "_Paged = {"
+            << font.width << ", " << font.height << ", " << pages << ", "
+            << base << "_Paged, " << widths << "};\n";
+        out << "#endif\n";
+    }
+}
+
+void WriteHeader(std::ostream &out, const std::vector<Font> &fonts, const std::string &input,
+                 const std::string &header)
+{
+    out << "/*\n"
+           " * " << header << "\n"
+           " *\n"
+           " *  Generated by Tools/font_gen from " << input << ", do not edit.\n"
+           " */\n"
+           "#ifndef __SSD1306_FONTS_PAGED_H__\n"
+           "#define __SSD1306_FONTS_PAGED_H__\n"
+           "\n"
+           "#include \"ssd1306.h\"\n";
+
+    for (const Font &font : fonts) {
+        out << "\n#ifdef " << font.guard << "\n"
+            << "extern const SSD1306_PagedFont_t " << font.name << "_Paged;\n"
+            << "#endif";
+    }
+
+    out << "\n\n#endif // __SSD1306_FONTS_PAGED_H__\n";
+}
+
+std::string BaseName(const std::string &path);
+void Usage();
+
+/* ---- 字型編譯 ---- */
+
+struct Glyph {
+    uint8_t width = 0;
+    std::vector<uint8_t> bytes;         // pages x width，頁排列
+};
+
+struct GlyphFont {
+    std::string name;
+    int height = 0;
+    bool rle = false;
+    std::map<uint32_t, Glyph> glyphs;   // 依碼點排序
+};
+
+// 字元集檔案裡的所有碼點（UTF-8），換行與 tab 不算
+bool LoadCharset(const std::string &path, std::set<uint32_t> &codes)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::fprintf(stderr, "cannot open %s\n", path.c_str());
+        return false;
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    codes.clear();
+    for (size_t i = 0; i < text.size();) {
+        uint8_t c = static_cast<uint8_t>(text[i]);
+        int extra = (c < 0x80) ? 0 : ((c & 0xE0) == 0xC0) ? 1 : ((c & 0xF0) == 0xE0) ? 2 : ((c & 0xF8) == 0xF0) ? 3 : -1;
+        if (extra < 0 || i + static_cast<size_t>(extra) >= text.size()) {
+            std::fprintf(stderr, "%s: invalid UTF-8 at byte %zu\n", path.c_str(), i);
+            return false;
+        }
+        uint32_t code = (extra == 0) ? c : (c & (0x3F >> extra));
+        for (int k = 1; k <= extra; k++)
+            code = (code << 6) | (static_cast<uint8_t>(text[i + static_cast<size_t>(k)]) & 0x3F);
+        i += static_cast<size_t>(extra) + 1;
+
+        if (code != '\n' && code != '\r' && code != '\t' && code != 0xFEFF)
+            codes.insert(code);
+    }
+
+    codes.insert(' ');
+    codes.insert('?');
+    return true;
+}
+
+// 從 ssd1306_fonts.c 取一個字型（"檔案:Font_6x8"）
+bool LoadTableGlyphs(const std::string &path, const std::string &font_name, GlyphFont &out)
+{
+    std::vector<Font> fonts;
+    if (!LoadFonts(path, fonts))
+        return false;
+
+    for (const Font &font : fonts) {
+        if (font.name != font_name)
+            continue;
+
+        out.height = font.height;
+        for (int g = 0; g < kGlyphs; g++) {
+            Glyph glyph;
+            glyph.width = font.widths.empty() ? static_cast<uint8_t>(font.width) : font.widths[static_cast<size_t>(g)];
+
+            // 去掉比例字型右側不畫的行
+            std::vector<uint8_t> full = PageGlyph(font, g);
+            const int pages = (font.height + 7) / 8;
+            for (int p = 0; p < pages; p++)
+                for (int x = 0; x < glyph.width; x++)
+                    glyph.bytes.push_back(full[static_cast<size_t>(p * font.width + x)]);
+
+            out.glyphs[static_cast<uint32_t>(kFirstChar + g)] = glyph;
+        }
+        return true;
+    }
+
+    std::fprintf(stderr, "%s: no font %s\n", path.c_str(), font_name.c_str());
+    return false;
+}
+
+// BDF 點陣字型：字元高度 = FONT_ASCENT + FONT_DESCENT，基線在 FONT_ASCENT
+bool LoadBdfGlyphs(const std::string &path, GlyphFont &out)
+{
+    std::ifstream file(path);
+    if (!file) {
+        std::fprintf(stderr, "cannot open %s\n", path.c_str());
+        return false;
+    }
+
+    int ascent = -1;
+    int descent = -1;
+    int code = -1;
+    int dwidth = 0;
+    int bbw = 0, bbh = 0, bbx = 0, bby = 0;
+    std::vector<std::string> bitmap;
+    bool in_bitmap = false;
+    std::string line;
+
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        std::istringstream words(line);
+        std::string key;
+        words >> key;
+
+        if (in_bitmap) {
+            if (key != "ENDCHAR") {
+                bitmap.push_back(key);
+                continue;
+            }
+            in_bitmap = false;
+            if (code < 0 || code > 0xFFFF || ascent < 0 || descent < 0)
+                continue;
+
+            out.height = ascent + descent;
+            const int pages = (out.height + 7) / 8;
+            Glyph glyph;
+            glyph.width = static_cast<uint8_t>(std::min(std::max(dwidth, bbx + bbw), 255));
+            glyph.bytes.assign(static_cast<size_t>(pages * glyph.width), 0);
+
+            // BBX 的下緣在基線上方 bby 列
+            const int top = ascent - (bby + bbh);
+            for (int r = 0; r < bbh && r < static_cast<int>(bitmap.size()); r++) {
+                const int y = top + r;
+                if (y < 0 || y >= out.height)
+                    continue;
+                const std::string &hex = bitmap[static_cast<size_t>(r)];
+                for (int c = 0; c < bbw; c++) {
+                    const size_t digit = static_cast<size_t>(c / 4);
+                    if (digit >= hex.size())
+                        break;
+                    const int nibble = std::stoi(hex.substr(digit, 1), nullptr, 16);
+                    const int x = bbx + c;
+                    if ((nibble & (8 >> (c % 4))) && x >= 0 && x < glyph.width)
+                        glyph.bytes[static_cast<size_t>((y / 8) * glyph.width + x)] |= static_cast<uint8_t>(1u << (y % 8));
+                }
+            }
+            out.glyphs[static_cast<uint32_t>(code)] = glyph;
+        } else if (key == "FONT_ASCENT") {
+            words >> ascent;
+        } else if (key == "FONT_DESCENT") {
+            words >> descent;
+        } else if (key == "STARTCHAR") {
+            code = -1;
+            dwidth = 0;
+            bbw = bbh = bbx = bby = 0;
+        } else if (key == "ENCODING") {
+            words >> code;
+        } else if (key == "DWIDTH") {
+            words >> dwidth;
+        } else if (key == "BBX") {
+            words >> bbw >> bbh >> bbx >> bby;
+        } else if (key == "BITMAP") {
+            bitmap.clear();
+            in_bitmap = true;
+        }
+    }
+
+    if (out.glyphs.empty() || ascent < 0 || descent < 0) {
+        std::fprintf(stderr, "%s: no glyphs or missing FONT_ASCENT/FONT_DESCENT\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+// 只留下字元集裡的字，缺的字列出來
+void Subset(GlyphFont &font, const std::set<uint32_t> &codes)
+{
+    std::map<uint32_t, Glyph> kept;
+
+    for (uint32_t code : codes) {
+        auto it = font.glyphs.find(code);
+        if (it != font.glyphs.end())
+            kept[code] = it->second;
+        else
+            std::fprintf(stderr, "%s: no glyph for U+%04X\n", font.name.c_str(), static_cast<unsigned>(code));
+    }
+
+    font.glyphs.swap(kept);
+}
+
+// Run-length：控制字元 bit7=1 時下一個 byte 重複 (n & 0x7F) + 1 次，否則接著 n + 1 個原始 byte
+std::vector<uint8_t> RleEncode(const std::vector<uint8_t> &in)
+{
+    std::vector<uint8_t> out;
+    size_t i = 0;
+
+    while (i < in.size()) {
+        size_t run = 1;
+        while (i + run < in.size() && in[i + run] == in[i] && run < 128)
+            run++;
+
+        if (run >= 3) {
+            out.push_back(static_cast<uint8_t>(0x80 | (run - 1)));
+            out.push_back(in[i]);
+            i += run;
+            continue;
+        }
+
+        // 原始 byte 一直收到下一段 3 個以上的重複為止
+        size_t start = i;
+        while (i < in.size() && i - start < 128) {
+            if (i + 2 < in.size() && in[i] == in[i + 1] && in[i] == in[i + 2])
+                break;
+            i++;
+        }
+        out.push_back(static_cast<uint8_t>(i - start - 1));
+        out.insert(out.end(), in.begin() + static_cast<std::ptrdiff_t>(start), in.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+
+    return out;
+}
+
+std::string CodeComment(uint32_t code)
+{
+    if (code == ' ')
+        return "sp";
+    if (code == '\\')
+        return "backslash";
+
+    std::string utf8;
+    if (code < 0x80) {
+        utf8.push_back(static_cast<char>(code));
+    } else if (code < 0x800) {
+        utf8.push_back(static_cast<char>(0xC0 | (code >> 6)));
+        utf8.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else {
+        utf8.push_back(static_cast<char>(0xE0 | (code >> 12)));
+        utf8.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        utf8.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+    return utf8;
+}
+
+bool WriteGlyphSource(std::ostream &out, const std::vector<GlyphFont> &fonts, const std::string &source,
+                      const std::string &header)
+{
+    out << "/*\n"
+           " * " << source << "\n"
+           " *\n"
+           " *  Generated by Tools/font_gen, do not edit.\n"
+           " *  Subset fonts: sorted code points, glyph widths and offsets into the glyph\n"
+           " *  data (SSD1306 page layout, run-length encoded for SSD1306_GLYPH_RLE fonts).\n"
+           " */\n"
+           "#include \"" << header << "\"\n";
+
+    for (const GlyphFont &font : fonts) {
+        const int pages = (font.height + 7) / 8;
+        std::vector<uint16_t> offsets;
+        std::vector<std::vector<uint8_t>> data;
+        size_t raw = 0;
+        size_t total = 0;
+        size_t largest = 0;
+
+        for (const auto &entry : font.glyphs) {
+            offsets.push_back(static_cast<uint16_t>(total));
+            data.push_back(font.rle ? RleEncode(entry.second.bytes) : entry.second.bytes);
+            raw += entry.second.bytes.size();
+            largest = std::max(largest, entry.second.bytes.size());
+            total += data.back().size();
+            if (total > 0xFFFF) {
+                std::fprintf(stderr, "%s: glyph data over 64 KB\n", font.name.c_str());
+                return false;
+            }
+        }
+        offsets.push_back(static_cast<uint16_t>(total));
+
+        out << "\n/* " << font.name << ": " << font.glyphs.size() << " glyphs, " << total << " bytes";
+        if (font.rle)
+            out << " (" << raw << " before RLE), largest glyph " << largest
+                << " bytes, must fit SSD1306_GLYPH_CACHE_BYTES";
+        out << " */\n";
+
+        out << "static const uint16_t " << font.name << "_codes [] = {\n";
+        size_t n = 0;
+        for (const auto &entry : font.glyphs) {
+            char hex[16];
+            std::snprintf(hex, sizeof(hex), "0x%04X,", static_cast<unsigned>(entry.first));
+            out << (n % 12 == 0 ? "" : " ") << hex << (n % 12 == 11 || n + 1 == font.glyphs.size() ? "\n" : "");
+            n++;
+        }
+        out << "};\n\n";
+
+        out << "static const uint8_t " << font.name << "_widths [] = {\n";
+        n = 0;
+        for (const auto &entry : font.glyphs) {
+            out << (n % 16 == 0 ? "" : " ") << static_cast<unsigned>(entry.second.width) << ","
+                << (n % 16 == 15 || n + 1 == font.glyphs.size() ? "\n" : "");
+            n++;
+        }
+        out << "};\n\n";
+
+        out << "static const uint16_t " << font.name << "_offsets [] = {\n";
+        for (size_t i = 0; i < offsets.size(); i++)
+            out << (i % 12 == 0 ? "" : " ") << offsets[i] << "," << (i % 12 == 11 || i + 1 == offsets.size() ? "\n" : "");
+        out << "};\n\n";
+
+        out << "static const uint8_t " << font.name << "_data [] = {\n";
+        n = 0;
+        for (const auto &entry : font.glyphs) {
+            const std::vector<uint8_t> &bytes = data[n++];
+            for (size_t i = 0; i < bytes.size(); i++) {
+                char hex[8];
+                std::snprintf(hex, sizeof(hex), "0x%02X,", bytes[i]);
+                out << (i == 0 ? "" : " ") << hex;
+            }
+            out << "  // " << CodeComment(entry.first) << "\n";
+        }
+        out << "};\n\n";
+
+        out << "const SSD1306_GlyphFont_t " << font.name << " = {"
+            << font.height << ", " << pages << ", " << (font.rle ? "SSD1306_GLYPH_RLE" : "0") << ", "
+            << font.glyphs.size() << ", " << font.name << "_codes, " << font.name << "_widths, "
+            << font.name << "_offsets, " << font.name << "_data};\n";
+    }
+
+    return true;
+}
+
+void WriteGlyphHeader(std::ostream &out, const std::vector<GlyphFont> &fonts, const std::string &header)
+{
+    std::string guard = "__";
+    for (char c : header)
+        guard.push_back(std::isalnum(static_cast<unsigned char>(c)) ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : '_');
+    guard += "__";
+
+    out << "/*\n"
+           " * " << header << "\n"
+           " *\n"
+           " *  Generated by Tools/font_gen, do not edit.\n"
+           " */\n"
+           "#ifndef " << guard << "\n"
+           "#define " << guard << "\n"
+           "\n"
+           "#include \"ssd1306.h\"\n"
+           "\n";
+
+    // 可選的字型（例如需要 BDF 來源的 Font_UI_CJK）以 SSD1306_HAVE_<名稱> 判斷是否產生
+    for (const GlyphFont &font : fonts) {
+        std::string have = "SSD1306_HAVE_";
+        for (char c : font.name)
+            have.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+        out << "#define " << have << "\n";
+        out << "extern const SSD1306_GlyphFont_t " << font.name << ";\n";
+    }
+
+    out << "\n#endif // " << guard << "\n";
+}
+
+// -c charset -f 名稱=來源[,rle] ... output.c output.h
+int CompileFonts(const std::vector<std::string> &args)
+{
+    std::vector<GlyphFont> fonts;
+    std::set<uint32_t> charset;
+    bool have_charset = false;
+    std::vector<std::string> outputs;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        if (args[i] == "-c" && i + 1 < args.size()) {
+            if (!LoadCharset(args[++i], charset))
+                return 1;
+            have_charset = true;
+        } else if (args[i] == "-f" && i + 1 < args.size()) {
+            std::string spec = args[++i];
+            size_t eq = spec.find('=');
+            if (eq == std::string::npos || !have_charset) {
+                Usage();
+                return 2;
+            }
+
+            GlyphFont font;
+            font.name = spec.substr(0, eq);
+            std::string source = spec.substr(eq + 1);
+            if (source.size() > 4 && source.compare(source.size() - 4, 4, ",rle") == 0) {
+                font.rle = true;
+                source.resize(source.size() - 4);
+            }
+
+            size_t colon = source.rfind(':');
+            bool table = colon != std::string::npos && source.compare(colon + 1, 5, "Font_") == 0;
+            if (table ? !LoadTableGlyphs(source.substr(0, colon), source.substr(colon + 1), font)
+                      : !LoadBdfGlyphs(source, font))
+                return 1;
+
+            Subset(font, charset);
+            fonts.push_back(font);
+        } else {
+            outputs.push_back(args[i]);
+        }
+    }
+
+    if (fonts.empty() || outputs.size() != 2) {
+        Usage();
+        return 2;
+    }
+
+    std::ofstream c_file(outputs[0]);
+    std::ofstream h_file(outputs[1]);
+    if (!c_file || !h_file) {
+        std::fprintf(stderr, "cannot create %s / %s\n", outputs[0].c_str(), outputs[1].c_str());
+        return 1;
+    }
+    if (!WriteGlyphSource(c_file, fonts, BaseName(outputs[0]), BaseName(outputs[1])))
+        return 1;
+    WriteGlyphHeader(h_file, fonts, BaseName(outputs[1]));
+
+    for (const GlyphFont &font : fonts)
+        std::fprintf(stderr, "%s: %zu glyphs\n", font.name.c_str(), font.glyphs.size());
+    return 0;
+}
+
+std::string BaseName(const std::string &path)
+{
+    return path.substr(path.find_last_of("/\\") + 1);
+}
+
+void Usage()
+{
+    std::fprintf(stderr, "usage: font_gen ssd1306_fonts.c output.c output.h\n"
+                         "       font_gen -c charset.txt -f name=source[,rle] [-c ... -f ...] output.c output.h\n"
+                         "       source: ssd1306_fonts.c:Font_6x8 or a BDF file\n");
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    std::vector<std::string> args;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            Usage();
+            return 0;
+        }
+        args.push_back(arg);
+    }
+    if (!args.empty() && args[0] == "-c")
+        return CompileFonts(args);
+    if (args.size() != 3) {
+        Usage();
+        return 2;
+    }
+
+    std::vector<Font> fonts;
+    if (!LoadFonts(args[0], fonts))
+        return 1;
+
+    const std::string input = BaseName(args[0]);
+    const std::string source = BaseName(args[1]);
+    const std::string header = BaseName(args[2]);
+
+    std::ofstream c_file(args[1]);
+    std::ofstream h_file(args[2]);
+    if (!c_file || !h_file) {
+        std::fprintf(stderr, "cannot create %s / %s\n", args[1].c_str(), args[2].c_str());
+        return 1;
+    }
+    WriteSource(c_file, fonts, input, source, header);
+    WriteHeader(h_file, fonts, input, header);
+
+    std::fprintf(stderr, "%zu fonts\n", fonts.size());
+    return 0;
+}
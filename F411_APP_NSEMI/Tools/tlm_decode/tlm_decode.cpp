@@ -0,0 +1,550 @@
+/*
+ * tlm_decode.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  遙測解碼：讀取 USART6 擷取的原始串流（檔案或 stdin），依 telemetry_protocol.h
+ *  拆出訊框、檢查 CRC 與序號，每種紀錄輸出一個 CSV 檔。
+ *
+ *  用法: tlm_decode [-o prefix] [-e firmware.elf] [capture.bin]
+ *        產生 prefix_samples.csv / prefix_stats.csv / prefix_state.csv / prefix_profile.csv
+ *        夾在訊框之間的 printf 文字與 LOGID 紀錄輸出到 stderr，最後印出統計。
+ *        LOGID 的格式字串從 ELF 的 .logstr section 讀取，沒有 -e 時只印 ID 與參數。
+ */
+#include "telemetry_protocol.h"
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+// 與 STM32 硬體 CRC 單元相同：CRC-32/MPEG-2，每個 little-endian 字從最高位元開始
+uint32_t Crc32Words(const uint8_t *data, size_t words)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+
+    for (size_t w = 0; w < words; w++) {
+        uint32_t word = static_cast<uint32_t>(data[4 * w]) |
+                        static_cast<uint32_t>(data[4 * w + 1]) << 8 |
+                        static_cast<uint32_t>(data[4 * w + 2]) << 16 |
+                        static_cast<uint32_t>(data[4 * w + 3]) << 24;
+        crc ^= word;
+        for (int bit = 0; bit < 32; bit++) {
+            crc = (crc & 0x80000000u) ? (crc << 1) ^ 0x04C11DB7u : (crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+// COBS 解碼，格式錯誤時回傳 false
+bool CobsDecode(const std::vector<uint8_t> &in, std::vector<uint8_t> &out)
+{
+    out.clear();
+    size_t i = 0;
+
+    while (i < in.size()) {
+        uint8_t code = in[i++];
+        if (code == 0 || i + code - 1 > in.size())
+            return false;
+
+        for (uint8_t k = 1; k < code; k++) {
+            out.push_back(in[i++]);
+        }
+        if (code != 0xFF && i < in.size())
+            out.push_back(0);
+    }
+
+    return true;
+}
+
+template <typename T>
+T ReadLe(const std::vector<uint8_t> &data, size_t offset)
+{
+    T value{};
+    for (size_t i = 0; i < sizeof(T); i++) {
+        value |= static_cast<T>(static_cast<T>(data[offset + i]) << (8 * i));
+    }
+    return value;
+}
+
+// 從 32 位元 little-endian ELF 取出指定 section 的內容
+bool LoadElfSection(const std::string &path, const std::string &name, std::vector<uint8_t> &out)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::vector<uint8_t> elf((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (elf.size() < 52 || std::memcmp(elf.data(), "\x7F" "ELF", 4) != 0 ||
+        elf[4] != 1 || elf[5] != 1)
+        return false;
+
+    uint32_t shoff = ReadLe<uint32_t>(elf, 32);
+    uint16_t shentsize = ReadLe<uint16_t>(elf, 46);
+    uint16_t shnum = ReadLe<uint16_t>(elf, 48);
+    uint16_t shstrndx = ReadLe<uint16_t>(elf, 50);
+    if (shstrndx >= shnum || shoff + static_cast<size_t>(shnum) * shentsize > elf.size())
+        return false;
+
+    uint32_t names = ReadLe<uint32_t>(elf, shoff + shstrndx * shentsize + 16);
+    for (uint16_t i = 0; i < shnum; i++) {
+        size_t header = shoff + static_cast<size_t>(i) * shentsize;
+        uint32_t name_offset = ReadLe<uint32_t>(elf, header);
+        uint32_t offset = ReadLe<uint32_t>(elf, header + 16);
+        uint32_t size = ReadLe<uint32_t>(elf, header + 20);
+
+        if (names + name_offset >= elf.size() ||
+            name != reinterpret_cast<const char *>(&elf[names + name_offset]))
+            continue;
+        if (static_cast<size_t>(offset) + size > elf.size())
+            return false;
+
+        out.assign(elf.begin() + offset, elf.begin() + offset + size);
+        return true;
+    }
+
+    return false;
+}
+
+// 依 printf 格式字串與 LOGID 參數還原文字
+std::string FormatLog(const std::string &format, const Tlm_Log_t &r)
+{
+    std::string text;
+    uint32_t offset = 0;
+    uint8_t index = 0;
+    char buf[128];
+
+    for (size_t i = 0; i < format.size(); i++) {
+        if (format[i] != '%') {
+            text.push_back(format[i]);
+            continue;
+        }
+        if (i + 1 < format.size() && format[i + 1] == '%') {
+            text.push_back('%');
+            i++;
+            continue;
+        }
+
+        // 保留旗標/寬度/精度，去掉長度修飾字，另外補上對應的型態
+        std::string spec = "%";
+        size_t j = i + 1;
+        for (; j < format.size() && std::strchr("-+ #0123456789.*", format[j]); j++)
+            spec.push_back(format[j]);
+        while (j < format.size() && std::strchr("hlLqjzt", format[j]))
+            j++;
+        if (j >= format.size())
+            break;
+        char conversion = format[j];
+        i = j;
+
+        if (index >= r.arg_count) {
+            text += "<?>";
+            continue;
+        }
+
+        uint8_t type = (r.arg_types >> (2 * index)) & 3;
+        uint32_t size = (type == TLM_LOG_ARG_STRING) ? 1U + r.args[offset] : 4U;
+        if (offset + size > r.arg_length) {
+            text += "<?>";
+            index = r.arg_count;
+            continue;
+        }
+        index++;
+
+        if (type == TLM_LOG_ARG_STRING) {
+            uint8_t length = r.args[offset];
+            std::string value(reinterpret_cast<const char *>(&r.args[offset + 1]), length);
+            offset += 1 + length;
+            std::snprintf(buf, sizeof(buf), (spec + 's').c_str(), value.c_str());
+            text += buf;
+            continue;
+        }
+
+        uint32_t word;
+        std::memcpy(&word, &r.args[offset], sizeof(word));
+        offset += 4;
+
+        double real;
+        long long integer;
+        if (type == TLM_LOG_ARG_FLOAT) {
+            float f;
+            std::memcpy(&f, &word, sizeof(f));
+            real = f;
+            integer = static_cast<long long>(f);
+        } else if (type == TLM_LOG_ARG_I32) {
+            integer = static_cast<int32_t>(word);
+            real = static_cast<double>(integer);
+        } else {
+            integer = word;
+            real = word;
+        }
+
+        switch (conversion) {
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+            std::snprintf(buf, sizeof(buf), (spec + conversion).c_str(), real);
+            break;
+        case 'd': case 'i':
+            std::snprintf(buf, sizeof(buf), (spec + "lld").c_str(),
+                          type == TLM_LOG_ARG_U32 ? static_cast<long long>(static_cast<int32_t>(word)) : integer);
+            break;
+        case 'u': case 'x': case 'X': case 'o':
+            std::snprintf(buf, sizeof(buf), (spec + "ll" + conversion).c_str(),
+                          static_cast<unsigned long long>(static_cast<uint32_t>(integer)));
+            break;
+        case 'c':
+            std::snprintf(buf, sizeof(buf), (spec + 'c').c_str(), static_cast<int>(integer));
+            break;
+        case 'p':
+            std::snprintf(buf, sizeof(buf), "0x%08" PRIx32, word);
+            break;
+        default:
+            std::snprintf(buf, sizeof(buf), "<%%%c?>", conversion);
+            break;
+        }
+        text += buf;
+    }
+
+    return text;
+}
+
+const char *AppPhaseName(uint8_t value)
+{
+    switch (value) {
+    case TLM_APP_CAL_ZERO:   return "CAL_ZERO";
+    case TLM_APP_CAL_MANUAL: return "CAL_MANUAL";
+    case TLM_APP_RUNNING:    return "RUNNING";
+    default:                 return "?";
+    }
+}
+
+const char *LoadStateName(uint8_t value)
+{
+    switch (value) {
+    case TLM_LOAD_STOPPED:  return "STOPPED";
+    case TLM_LOAD_NOISE:    return "NOISE";
+    case TLM_LOAD_WEAK:     return "WEAK";
+    case TLM_LOAD_DETECTED: return "DETECTED";
+    case TLM_LOAD_STARTING: return "STARTING";
+    case TLM_LOAD_RUNNING:  return "RUNNING";
+    default:                return "?";
+    }
+}
+
+const char *StateName(uint8_t domain, uint8_t value)
+{
+    return (domain == TLM_DOMAIN_APP) ? AppPhaseName(value) : LoadStateName(value);
+}
+
+class Decoder {
+public:
+    explicit Decoder(const std::string &prefix)
+        : samples_(prefix + "_samples.csv"),
+          stats_(prefix + "_stats.csv"),
+          state_(prefix + "_state.csv"),
+          profile_(prefix + "_profile.csv")
+    {
+        samples_ << "time_ms,seq,index,current_a\n";
+        stats_ << "time_ms,seq,current_now_a,current_rms_a,current_max_a,current_min_a,"
+                  "voltage_v,power_w,sample_count,load_state,monitor_status\n";
+        state_ << "time_ms,seq,domain,from,to\n";
+        profile_ << "time_ms,seq,task_id,name,priority,cpu_load_permille,runs,"
+                    "last_cycles,max_cycles,avg_cycles,deadline_misses,overruns\n";
+    }
+
+    // 載入 LOGID 格式字串表
+    void SetLogStrings(std::vector<uint8_t> strings)
+    {
+        log_strings_ = std::move(strings);
+    }
+
+    bool IsOpen() const
+    {
+        return samples_.good() && stats_.good() && state_.good() && profile_.good();
+    }
+
+    // 處理兩個 0x00 之間的一段資料
+    void Feed(const std::vector<uint8_t> &chunk)
+    {
+        if (chunk.empty())
+            return;
+
+        if (!CobsDecode(chunk, raw_) || !CheckFrame()) {
+            ReportText(chunk);
+            return;
+        }
+
+        Tlm_Header_t header;
+        std::memcpy(&header, raw_.data(), sizeof(header));
+        const uint8_t *payload = raw_.data() + sizeof(header);
+        size_t length = raw_.size() - sizeof(header) - 4;
+
+        if (have_seq_) {
+            uint16_t gap = static_cast<uint16_t>(header.seq - static_cast<uint16_t>(last_seq_ + 1));
+            lost_ += gap;
+        }
+        have_seq_ = true;
+        last_seq_ = header.seq;
+        frames_++;
+
+        switch (header.type) {
+        case TLM_REC_SAMPLES: WriteSamples(header, payload, length); break;
+        case TLM_REC_STATS:   WriteStats(header, payload, length); break;
+        case TLM_REC_STATE:   WriteState(header, payload, length); break;
+        case TLM_REC_PROFILE: WriteProfile(header, payload, length); break;
+        case TLM_REC_LOG:     WriteLog(header, payload, length); break;
+        default:              unknown_++; break;
+        }
+    }
+
+    void PrintSummary()
+    {
+        if (!log_line_.empty()) {
+            std::fprintf(stderr, "%s\n", log_line_.c_str());
+            log_line_.clear();
+        }
+
+        std::fprintf(stderr, "frames %lu, lost %lu, bad %lu, unknown %lu, text lines %lu, log records %lu\n",
+                     frames_, lost_, bad_, unknown_, text_, logs_);
+    }
+
+private:
+    bool CheckFrame()
+    {
+        if (raw_.size() < sizeof(Tlm_Header_t) + 4 || (raw_.size() & 3) != 0)
+            return false;
+
+        size_t words = raw_.size() / 4 - 1;
+        uint32_t crc;
+        std::memcpy(&crc, raw_.data() + words * 4, sizeof(crc));
+        if (Crc32Words(raw_.data(), words) != crc)
+            return false;
+
+        return raw_[1] == TLM_PROTOCOL_VERSION;
+    }
+
+    // 不是有效訊框：可讀文字交給 stderr，其餘算壞訊框
+    void ReportText(const std::vector<uint8_t> &chunk)
+    {
+        std::string text;
+        for (uint8_t c : chunk) {
+            if (c == '\r')
+                continue;
+            if (c != '\n' && c != '\t' && (c < 0x20 || c > 0x7E) && c < 0x80) {
+                bad_++;
+                return;
+            }
+            text.push_back(static_cast<char>(c));
+        }
+
+        for (size_t start = 0; start < text.size();) {
+            size_t end = text.find('\n', start);
+            if (end == std::string::npos)
+                end = text.size();
+            if (end > start) {
+                std::fprintf(stderr, "# %s\n", text.substr(start, end - start).c_str());
+                text_++;
+            }
+            start = end + 1;
+        }
+    }
+
+    void WriteSamples(const Tlm_Header_t &h, const uint8_t *p, size_t length)
+    {
+        Tlm_Samples_t r{};
+        const size_t fixed = sizeof(r) - sizeof(r.value);
+        if (length < fixed || length > sizeof(r)) {
+            bad_++;
+            return;
+        }
+        std::memcpy(&r, p, length);
+        if (r.count > TLM_MAX_SAMPLES || fixed + r.count * sizeof(float) != length) {
+            bad_++;
+            return;
+        }
+
+        // 紀錄時間是最後一個樣本的時間，往前推算其餘樣本
+        for (uint16_t i = 0; i < r.count; i++) {
+            int64_t t = static_cast<int64_t>(h.time_ms) -
+                        static_cast<int64_t>(r.count - 1 - i) * r.period_ms;
+            samples_ << t << ',' << h.seq << ',' << (r.first_index + i) << ','
+                     << r.value[i] << '\n';
+        }
+    }
+
+    void WriteStats(const Tlm_Header_t &h, const uint8_t *p, size_t length)
+    {
+        Tlm_Stats_t r;
+        if (length != sizeof(r)) {
+            bad_++;
+            return;
+        }
+        std::memcpy(&r, p, sizeof(r));
+
+        stats_ << h.time_ms << ',' << h.seq << ',' << r.current_now << ',' << r.current_rms << ','
+               << r.current_max << ',' << r.current_min << ',' << r.voltage << ',' << r.power << ','
+               << r.sample_count << ',' << LoadStateName(r.load_state) << ','
+               << static_cast<unsigned>(r.monitor_status) << '\n';
+    }
+
+    void WriteState(const Tlm_Header_t &h, const uint8_t *p, size_t length)
+    {
+        Tlm_State_t r;
+        if (length != sizeof(r)) {
+            bad_++;
+            return;
+        }
+        std::memcpy(&r, p, sizeof(r));
+
+        state_ << h.time_ms << ',' << h.seq << ','
+               << (r.domain == TLM_DOMAIN_APP ? "APP" : "LOAD") << ','
+               << StateName(r.domain, r.from) << ',' << StateName(r.domain, r.to) << '\n';
+    }
+
+    void WriteProfile(const Tlm_Header_t &h, const uint8_t *p, size_t length)
+    {
+        Tlm_Profile_t r;
+        if (length != sizeof(r)) {
+            bad_++;
+            return;
+        }
+        std::memcpy(&r, p, sizeof(r));
+
+        std::string name(r.name, strnlen(r.name, TLM_TASK_NAME_LEN));
+        profile_ << h.time_ms << ',' << h.seq << ',' << static_cast<unsigned>(r.task_id) << ','
+                 << name << ',' << static_cast<unsigned>(r.priority) << ',' << r.cpu_load << ','
+                 << r.runs << ',' << r.last_cycles << ',' << r.max_cycles << ','
+                 << r.avg_cycles << ',' << r.deadline_misses << ',' << r.overruns << '\n';
+    }
+
+    void WriteLog(const Tlm_Header_t &h, const uint8_t *p, size_t length)
+    {
+        Tlm_Log_t r{};
+        const size_t fixed = sizeof(r) - sizeof(r.args);
+        if (length < fixed || length > sizeof(r)) {
+            bad_++;
+            return;
+        }
+        std::memcpy(&r, p, length);
+        if (r.arg_count > TLM_LOG_MAX_ARGS || fixed + r.arg_length > length) {
+            bad_++;
+            return;
+        }
+        logs_++;
+
+        if (r.id >= log_strings_.size()) {
+            std::fprintf(stderr, "[%8" PRIu32 "] <log id 0x%04x, %u args>\n",
+                         h.time_ms, r.id, r.arg_count);
+            return;
+        }
+
+        const char *format = reinterpret_cast<const char *>(&log_strings_[r.id]);
+        std::string text = FormatLog(std::string(format, strnlen(format, log_strings_.size() - r.id)), r);
+
+        // 一筆紀錄可能有多行，也可能只是一行的一部分
+        for (char c : text) {
+            if (c == '\r')
+                continue;
+            if (c == '\n') {
+                std::fprintf(stderr, "[%8" PRIu32 "] %s\n", h.time_ms, log_line_.c_str());
+                log_line_.clear();
+            } else {
+                log_line_.push_back(c);
+            }
+        }
+    }
+
+    std::ofstream samples_;
+    std::ofstream stats_;
+    std::ofstream state_;
+    std::ofstream profile_;
+    std::vector<uint8_t> raw_;
+    std::vector<uint8_t> log_strings_;
+    std::string log_line_;
+    bool have_seq_ = false;
+    uint16_t last_seq_ = 0;
+    unsigned long frames_ = 0;
+    unsigned long lost_ = 0;
+    unsigned long bad_ = 0;
+    unsigned long unknown_ = 0;
+    unsigned long text_ = 0;
+    unsigned long logs_ = 0;
+};
+
+void Usage()
+{
+    std::fprintf(stderr, "usage: tlm_decode [-o prefix] [-e firmware.elf] [capture.bin]\n");
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    std::string prefix = "tlm";
+    std::string input;
+    std::string elf;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            prefix = argv[++i];
+        } else if (arg == "-e" && i + 1 < argc) {
+            elf = argv[++i];
+        } else if (arg == "-h" || arg == "--help") {
+            Usage();
+            return 0;
+        } else if (input.empty() && arg[0] != '-') {
+            input = arg;
+        } else {
+            Usage();
+            return 2;
+        }
+    }
+
+    std::ifstream file;
+    std::istream *in = &std::cin;
+    if (!input.empty()) {
+        file.open(input, std::ios::binary);
+        if (!file) {
+            std::fprintf(stderr, "cannot open %s\n", input.c_str());
+            return 1;
+        }
+        in = &file;
+    }
+
+    Decoder decoder(prefix);
+    if (!decoder.IsOpen()) {
+        std::fprintf(stderr, "cannot create %s_*.csv\n", prefix.c_str());
+        return 1;
+    }
+
+    if (!elf.empty()) {
+        std::vector<uint8_t> strings;
+        if (!LoadElfSection(elf, ".logstr", strings)) {
+            std::fprintf(stderr, "no .logstr section in %s\n", elf.c_str());
+            return 1;
+        }
+        decoder.SetLogStrings(std::move(strings));
+    }
+
+    std::vector<uint8_t> chunk;
+    char c;
+    while (in->get(c)) {
+        if (static_cast<uint8_t>(c) == TLM_DELIMITER) {
+            decoder.Feed(chunk);
+            chunk.clear();
+        } else {
+            chunk.push_back(static_cast<uint8_t>(c));
+        }
+    }
+    decoder.Feed(chunk);
+
+    decoder.PrintSummary();
+    return 0;
+}
@@ -0,0 +1,192 @@
+/*
+ * tlm_stream.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: User
+ *
+ *  原始波形串流解碼：讀取 RawStream 模式下 USART6 擷取的串流（2.25 Mbaud），
+ *  依 Tlm_StreamHeader_t 找出區塊、檢查 Fletcher-16，解開 12 位元樣本輸出 CSV。
+ *  USB CDC 串流（usb stream start）的 16 位元區塊沒有檢查碼，同樣可以解碼。
+ *
+ *  用法: tlm_stream [-o samples.csv] [capture.bin]
+ *        每列一個樣本：index,ch0[,ch1]；以 first_index 的跳號統計遺失的樣本。
+ */
+#include "telemetry_protocol.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+uint16_t Fletcher16(const uint8_t *data, size_t length)
+{
+    uint32_t sum1 = 0;
+    uint32_t sum2 = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        sum1 = (sum1 + data[i]) % 255;
+        sum2 = (sum2 + sum1) % 255;
+    }
+
+    return static_cast<uint16_t>((sum2 << 8) | sum1);
+}
+
+// 解開 12 位元打包樣本
+std::vector<uint16_t> Unpack(const uint8_t *src, size_t count)
+{
+    std::vector<uint16_t> out;
+    out.reserve(count);
+
+    for (size_t i = 0; i < count; i += 2) {
+        const uint8_t *p = src + (i / 2) * 3;
+        out.push_back(static_cast<uint16_t>(p[0] | ((p[1] & 0x0F) << 8)));
+        if (i + 1 < count)
+            out.push_back(static_cast<uint16_t>((p[1] >> 4) | (p[2] << 4)));
+    }
+
+    return out;
+}
+
+// 16 位元 little-endian 樣本（USB 串流）
+std::vector<uint16_t> Raw16(const uint8_t *src, size_t count)
+{
+    std::vector<uint16_t> out;
+    out.reserve(count);
+
+    for (size_t i = 0; i < count; i++)
+        out.push_back(static_cast<uint16_t>(src[i * 2] | (src[i * 2 + 1] << 8)));
+
+    return out;
+}
+
+size_t PayloadBytes(size_t values, bool raw)
+{
+    if (raw)
+        return values * 2;
+    return (((values * 3 + 1) / 2) + 3) & ~static_cast<size_t>(3);
+}
+
+void Usage()
+{
+    std::fprintf(stderr, "usage: tlm_stream [-o samples.csv] [capture.bin]\n");
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    std::string output = "stream.csv";
+    std::string input;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            output = argv[++i];
+        } else if (arg == "-h" || arg == "--help") {
+            Usage();
+            return 0;
+        } else if (input.empty() && arg[0] != '-') {
+            input = arg;
+        } else {
+            Usage();
+            return 2;
+        }
+    }
+
+    std::ifstream file;
+    std::istream *in = &std::cin;
+    if (!input.empty()) {
+        file.open(input, std::ios::binary);
+        if (!file) {
+            std::fprintf(stderr, "cannot open %s\n", input.c_str());
+            return 1;
+        }
+        in = &file;
+    }
+
+    std::ofstream csv(output);
+    if (!csv) {
+        std::fprintf(stderr, "cannot create %s\n", output.c_str());
+        return 1;
+    }
+
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(*in)), std::istreambuf_iterator<char>());
+
+    unsigned long blocks = 0;
+    unsigned long bad = 0;
+    unsigned long long lost = 0;
+    uint64_t expected = 0;
+    bool have_index = false;
+    uint8_t channels = 0;
+    uint32_t rate = 0;
+    Tlm_StreamHeader_t last{};
+
+    size_t pos = 0;
+    while (pos + sizeof(Tlm_StreamHeader_t) <= data.size()) {
+        Tlm_StreamHeader_t h;
+        std::memcpy(&h, &data[pos], sizeof(h));
+
+        bool raw = (h.bits == TLM_STREAM_BITS_RAW);
+        size_t values = static_cast<size_t>(h.samples) * h.channels;
+        size_t frame = sizeof(h) + h.payload_bytes + (raw ? 0 : 4);
+        if (h.sync != TLM_STREAM_SYNC || (h.bits != TLM_STREAM_BITS && !raw) || h.channels == 0 ||
+            h.payload_bytes != PayloadBytes(values, raw)) {
+            pos++;
+            continue;
+        }
+        if (pos + frame > data.size())
+            break;
+
+        if (!raw) {
+            uint16_t checksum = static_cast<uint16_t>(data[pos + sizeof(h) + h.payload_bytes] |
+                                                      data[pos + sizeof(h) + h.payload_bytes + 1] << 8);
+            if (Fletcher16(&data[pos], sizeof(h) + h.payload_bytes) != checksum) {
+                bad++;
+                pos++;
+                continue;
+            }
+        }
+
+        if (channels == 0) {
+            channels = h.channels;
+            rate = h.sample_rate_hz;
+            csv << "index";
+            for (uint8_t c = 0; c < channels; c++)
+                csv << ",ch" << static_cast<unsigned>(c);
+            csv << '\n';
+        }
+
+        // first_index 只有 32 位元，以上一筆為基準展開
+        uint64_t index = (expected & ~0xFFFFFFFFull) | h.first_index;
+        if (have_index && index < expected)
+            index += 0x100000000ull;
+        if (have_index && index > expected)
+            lost += index - expected;
+        have_index = true;
+        expected = index + h.samples;
+
+        std::vector<uint16_t> samples = raw ? Raw16(&data[pos + sizeof(h)], values)
+                                            : Unpack(&data[pos + sizeof(h)], values);
+        for (uint16_t s = 0; s < h.samples; s++) {
+            csv << (index + s);
+            for (uint8_t c = 0; c < h.channels; c++)
+                csv << ',' << samples[s * h.channels + c];
+            csv << '\n';
+        }
+
+        last = h;
+        blocks++;
+        pos += frame;
+    }
+
+    std::fprintf(stderr, "blocks %lu, rate %u Hz, channels %u, lost samples %llu, bad blocks %lu, "
+                 "device drops %u, overruns %u\n",
+                 blocks, rate, channels, lost, bad, last.dropped, last.overruns);
+    return 0;
+}
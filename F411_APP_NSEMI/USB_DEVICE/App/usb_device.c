@@ -23,19 +23,37 @@
 #include "usb_device.h"
 #include "usbd_core.h"
 #include "usbd_desc.h"
+#include "usbd_cdc.h"
+#include "usbd_cdc_if.h"
 #include "usbd_hid.h"
+#include "usbd_hid_if.h"
 
 /* USER CODE BEGIN Includes */
+#include "usbd_audio_in.h"
+#include "usbd_audio_in_if.h"
+#if (USBD_APP_CLASS == USBD_APP_COMPOSITE)
+#include "usbd_composite_builder.h"
+#endif /* USBD_APP_CLASS */
 
 /* USER CODE END Includes */
 
 /* USER CODE BEGIN PV */
 /* Private variables ---------------------------------------------------------*/
+#if (USBD_APP_CLASS == USBD_APP_COMPOSITE)
+/* 各類別實例的 class id（usbd_cdc_if.c / usbd_hid_if.c 用來取 pClassDataCmsit） */
+uint8_t CDC_InstID = 0;
+uint8_t HID_InstID = 0;
+
+/* 端點分配：CDC {IN, OUT, CMD}、HID {IN, OUT}，各 IN 端點有自己的 TX FIFO（usbd_conf.c） */
+static uint8_t CDC_EpAdd_Inst[3] = {CDC_CMPSIT_IN_EP, CDC_CMPSIT_OUT_EP, CDC_CMPSIT_CMD_EP};
+static uint8_t HID_EpAdd_Inst[2] = {HID_CMPSIT_IN_EP, HID_CMPSIT_OUT_EP};
+#endif /* USBD_APP_CLASS */
 
 /* USER CODE END PV */
 
 /* USER CODE BEGIN PFP */
 /* Private function prototypes -----------------------------------------------*/
+static void USB_DEVICE_InitApp(void);
 
 /* USER CODE END PFP */
 
@@ -53,6 +71,78 @@ USBD_HandleTypeDef hUsbDeviceFS;
  * -- Insert your external function declaration here --
  */
 /* USER CODE BEGIN 1 */
+/**
+  * CubeMX 只產生單一類別（CDC）的初始化，USBD_APP_CLASS 選擇的類別在這裡註冊，
+  * 並在啟動前套用該類別的 FIFO 配置（usbd_conf.c USBD_LL_InitFifo）
+  * @retval None
+  */
+static void USB_DEVICE_InitApp(void)
+{
+  if (USBD_Init(&hUsbDeviceFS, &FS_Desc, DEVICE_FS) != USBD_OK)
+  {
+    Error_Handler();
+  }
+  USBD_LL_InitFifo();
+#if (USBD_APP_CLASS == USBD_APP_COMPOSITE)
+  /* CDC 先註冊（interface 0/1），HID 接在後面（interface 2） */
+  CDC_InstID = hUsbDeviceFS.classId;
+  if (USBD_RegisterClassComposite(&hUsbDeviceFS, &USBD_CDC, CLASS_TYPE_CDC, CDC_EpAdd_Inst) != USBD_OK)
+  {
+    Error_Handler();
+  }
+  HID_InstID = hUsbDeviceFS.classId;
+  if (USBD_RegisterClassComposite(&hUsbDeviceFS, &USBD_HID, CLASS_TYPE_HID, HID_EpAdd_Inst) != USBD_OK)
+  {
+    Error_Handler();
+  }
+  /* RegisterInterface 存到 pUserData[classId]，先切回對應的實例 */
+  if (USBD_CMPSIT_SetClassID(&hUsbDeviceFS, CLASS_TYPE_CDC, 0) != 0xFFU)
+  {
+    if (USBD_CDC_RegisterInterface(&hUsbDeviceFS, &USBD_Interface_fops_FS) != USBD_OK)
+    {
+      Error_Handler();
+    }
+  }
+  if (USBD_CMPSIT_SetClassID(&hUsbDeviceFS, CLASS_TYPE_HID, 0) != 0xFFU)
+  {
+    if (USBD_HID_RegisterInterface(&hUsbDeviceFS, &USBD_HID_fops_FS) != USBD_OK)
+    {
+      Error_Handler();
+    }
+  }
+#elif (USBD_APP_CLASS == USBD_APP_AUDIO)
+  if (USBD_RegisterClass(&hUsbDeviceFS, &USBD_AUDIO_IN) != USBD_OK)
+  {
+    Error_Handler();
+  }
+  if (USBD_AUDIO_IN_RegisterInterface(&hUsbDeviceFS, &USBD_AUDIO_IN_fops_FS) != USBD_OK)
+  {
+    Error_Handler();
+  }
+#elif (USBD_APP_CLASS == USBD_APP_HID)
+  if (USBD_RegisterClass(&hUsbDeviceFS, &USBD_HID) != USBD_OK)
+  {
+    Error_Handler();
+  }
+  if (USBD_HID_RegisterInterface(&hUsbDeviceFS, &USBD_HID_fops_FS) != USBD_OK)
+  {
+    Error_Handler();
+  }
+#else
+  if (USBD_RegisterClass(&hUsbDeviceFS, &USBD_CDC) != USBD_OK)
+  {
+    Error_Handler();
+  }
+  if (USBD_CDC_RegisterInterface(&hUsbDeviceFS, &USBD_Interface_fops_FS) != USBD_OK)
+  {
+    Error_Handler();
+  }
+#endif /* USBD_APP_CLASS */
+  if (USBD_Start(&hUsbDeviceFS) != USBD_OK)
+  {
+    Error_Handler();
+  }
+}
 
 /* USER CODE END 1 */
 
@@ -63,6 +153,8 @@ USBD_HandleTypeDef hUsbDeviceFS;
 void MX_USB_DEVICE_Init(void)
 {
   /* USER CODE BEGIN USB_DEVICE_Init_PreTreatment */
+  USB_DEVICE_InitApp();
+  return;
 
   /* USER CODE END USB_DEVICE_Init_PreTreatment */
 
@@ -71,10 +163,25 @@ void MX_USB_DEVICE_Init(void)
   {
     Error_Handler();
   }
+#if (USBD_APP_CLASS == USBD_APP_HID)
   if (USBD_RegisterClass(&hUsbDeviceFS, &USBD_HID) != USBD_OK)
   {
     Error_Handler();
   }
+  if (USBD_HID_RegisterInterface(&hUsbDeviceFS, &USBD_HID_fops_FS) != USBD_OK)
+  {
+    Error_Handler();
+  }
+#else
+  if (USBD_RegisterClass(&hUsbDeviceFS, &USBD_CDC) != USBD_OK)
+  {
+    Error_Handler();
+  }
+  if (USBD_CDC_RegisterInterface(&hUsbDeviceFS, &USBD_Interface_fops_FS) != USBD_OK)
+  {
+    Error_Handler();
+  }
+#endif /* USBD_APP_CLASS */
   if (USBD_Start(&hUsbDeviceFS) != USBD_OK)
   {
     Error_Handler();
@@ -0,0 +1,181 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : usbd_audio_in_if.c
+  * @version        : v1.0_Cube
+  * @brief          : Usb device for audio input (microphone).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbd_audio_in_if.h"
+
+/* USER CODE BEGIN INCLUDE */
+#include "usb_audio.h"
+/* USER CODE END INCLUDE */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+
+/* USER CODE BEGIN PV */
+/* Private variables ---------------------------------------------------------*/
+
+/* USER CODE END PV */
+
+/** @addtogroup STM32_USB_OTG_DEVICE_LIBRARY
+  * @brief Usb device library.
+  * @{
+  */
+
+/** @addtogroup USBD_AUDIO_IN_IF
+  * @{
+  */
+
+/** @defgroup USBD_AUDIO_IN_IF_Exported_Variables USBD_AUDIO_IN_IF_Exported_Variables
+  * @brief Public variables.
+  * @{
+  */
+
+extern USBD_HandleTypeDef hUsbDeviceFS;
+
+/* USER CODE BEGIN EXPORTED_VARIABLES */
+
+/* USER CODE END EXPORTED_VARIABLES */
+
+/**
+  * @}
+  */
+
+/** @defgroup USBD_AUDIO_IN_IF_Private_FunctionPrototypes USBD_AUDIO_IN_IF_Private_FunctionPrototypes
+  * @brief Private functions declaration.
+  * @{
+  */
+
+static int8_t AUDIO_IN_Init_FS(void);
+static int8_t AUDIO_IN_DeInit_FS(void);
+static int8_t AUDIO_IN_Start_FS(void);
+static int8_t AUDIO_IN_Stop_FS(void);
+static uint16_t AUDIO_IN_Fill_FS(uint8_t *pbuf, uint16_t max_len);
+
+/* USER CODE BEGIN PRIVATE_FUNCTIONS_DECLARATION */
+
+/* USER CODE END PRIVATE_FUNCTIONS_DECLARATION */
+
+/**
+  * @}
+  */
+
+USBD_AUDIO_IN_ItfTypeDef USBD_AUDIO_IN_fops_FS =
+{
+  AUDIO_IN_Init_FS,
+  AUDIO_IN_DeInit_FS,
+  AUDIO_IN_Start_FS,
+  AUDIO_IN_Stop_FS,
+  AUDIO_IN_Fill_FS
+};
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Initializes the AUDIO input media low layer over the FS USB IP
+  * @retval USBD_OK if all operations are OK else USBD_FAIL
+  */
+static int8_t AUDIO_IN_Init_FS(void)
+{
+  /* USER CODE BEGIN 3 */
+  UsbAudio_SetConfigured(1);
+  return (USBD_OK);
+  /* USER CODE END 3 */
+}
+
+/**
+  * @brief  DeInitializes the AUDIO input media low layer
+  * @retval USBD_OK if all operations are OK else USBD_FAIL
+  */
+static int8_t AUDIO_IN_DeInit_FS(void)
+{
+  /* USER CODE BEGIN 4 */
+  UsbAudio_SetConfigured(0);
+  return (USBD_OK);
+  /* USER CODE END 4 */
+}
+
+/**
+  * @brief  The host selected the streaming alternate setting
+  * @retval USBD_OK if all operations are OK else USBD_FAIL
+  */
+static int8_t AUDIO_IN_Start_FS(void)
+{
+  /* USER CODE BEGIN 5 */
+  UsbAudio_SetActive(1);
+  return (USBD_OK);
+  /* USER CODE END 5 */
+}
+
+/**
+  * @brief  The host went back to the zero-bandwidth alternate setting
+  * @retval USBD_OK if all operations are OK else USBD_FAIL
+  */
+static int8_t AUDIO_IN_Stop_FS(void)
+{
+  /* USER CODE BEGIN 6 */
+  UsbAudio_SetActive(0);
+  return (USBD_OK);
+  /* USER CODE END 6 */
+}
+
+/**
+  * @brief  AUDIO_IN_Fill_FS
+  *         Fill the packet for the next frame (called at each SOF)
+  * @param  pbuf: Packet buffer
+  * @param  max_len: Buffer size (in bytes)
+  * @retval Packet length (in bytes), a multiple of AUDIO_IN_FRAME_SIZE
+  */
+static uint16_t AUDIO_IN_Fill_FS(uint8_t *pbuf, uint16_t max_len)
+{
+  /* USER CODE BEGIN 7 */
+  return UsbAudio_Fill(pbuf, max_len);
+  /* USER CODE END 7 */
+}
+
+/* USER CODE BEGIN PRIVATE_FUNCTIONS_IMPLEMENTATION */
+/**
+  * @brief  AUDIO_IN_GetCounters_FS
+  *         Packet counters of the isochronous endpoint
+  * @param  packets: Packets collected by the host
+  * @param  resent: Packets sent again after the host skipped a frame
+  * @retval None
+  */
+void AUDIO_IN_GetCounters_FS(uint32_t *packets, uint32_t *resent)
+{
+  USBD_AUDIO_IN_HandleTypeDef *haudio = NULL;
+
+  if (hUsbDeviceFS.pClass[0] == &USBD_AUDIO_IN)
+  {
+    haudio = (USBD_AUDIO_IN_HandleTypeDef*)hUsbDeviceFS.pClassData;
+  }
+
+  *packets = (haudio != NULL) ? haudio->packets : 0;
+  *resent = (haudio != NULL) ? haudio->resent : 0;
+}
+/* USER CODE END PRIVATE_FUNCTIONS_IMPLEMENTATION */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
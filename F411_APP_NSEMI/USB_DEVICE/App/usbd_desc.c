@@ -65,10 +65,40 @@
 #define USBD_VID     0x0EFF
 #define USBD_LANGID_STRING     1033
 #define USBD_MANUFACTURER_STRING     "EETI_HID_DEVICE"
-#define USBD_PID_FS     0xC000
+#if (USBD_APP_CLASS == USBD_APP_COMPOSITE)
+/* 複合裝置：CDC 前面有 IAD，裝置類別用 Miscellaneous / Common Class / IAD */
+#define USBD_PID_FS     0xC003
+#define USBD_DEVICE_CLASS     0xEF
+#define USBD_DEVICE_SUBCLASS     0x02
+#define USBD_DEVICE_PROTOCOL     0x01
+#define USBD_PRODUCT_STRING_FS     "EETI_CDC_HID_DEVICE"
+#define USBD_CONFIGURATION_STRING_FS     "CDC HID Config"
+#define USBD_INTERFACE_STRING_FS     "CDC HID Interface"
+#elif (USBD_APP_CLASS == USBD_APP_AUDIO)
+#define USBD_PID_FS     0xC004
+#define USBD_DEVICE_CLASS     0x00
+#define USBD_DEVICE_SUBCLASS     0x00
+#define USBD_DEVICE_PROTOCOL     0x00
+#define USBD_PRODUCT_STRING_FS     "EETI_AUDIO_DEVICE"
+#define USBD_CONFIGURATION_STRING_FS     "AUDIO Config"
+#define USBD_INTERFACE_STRING_FS     "AUDIO Interface"
+#elif (USBD_APP_CLASS == USBD_APP_HID)
+#define USBD_PID_FS     0xC002
+#define USBD_DEVICE_CLASS     0x00
+#define USBD_DEVICE_SUBCLASS     0x00
+#define USBD_DEVICE_PROTOCOL     0x00
 #define USBD_PRODUCT_STRING_FS     "EETI_HID_DEVICE"
 #define USBD_CONFIGURATION_STRING_FS     "HID Config"
 #define USBD_INTERFACE_STRING_FS     "HID Interface"
+#else
+#define USBD_PID_FS     0xC001
+#define USBD_DEVICE_CLASS     0x02
+#define USBD_DEVICE_SUBCLASS     0x00
+#define USBD_DEVICE_PROTOCOL     0x00
+#define USBD_PRODUCT_STRING_FS     "EETI_CDC_DEVICE"
+#define USBD_CONFIGURATION_STRING_FS     "CDC Config"
+#define USBD_INTERFACE_STRING_FS     "CDC Interface"
+#endif /* USBD_APP_CLASS */
 
 #define USB_SIZ_BOS_DESC            0x0C
 
@@ -164,9 +194,9 @@ __ALIGN_BEGIN uint8_t USBD_FS_DeviceDesc[USB_LEN_DEV_DESC] __ALIGN_END =
   0x00,                       /*bcdUSB */
 #endif /* (USBD_LPM_ENABLED == 1) */
   0x02,
-  0x00,                       /*bDeviceClass*/
-  0x00,                       /*bDeviceSubClass*/
-  0x00,                       /*bDeviceProtocol*/
+  USBD_DEVICE_CLASS,          /*bDeviceClass*/
+  USBD_DEVICE_SUBCLASS,       /*bDeviceSubClass*/
+  USBD_DEVICE_PROTOCOL,       /*bDeviceProtocol*/
   USB_MAX_EP0_SIZE,           /*bMaxPacketSize*/
   LOBYTE(USBD_VID),           /*idVendor*/
   HIBYTE(USBD_VID),           /*idVendor*/
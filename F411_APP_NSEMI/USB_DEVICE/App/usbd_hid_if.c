@@ -0,0 +1,188 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : usbd_hid_if.c
+  * @version        : v1.0_Cube
+  * @brief          : Usb device for generic (vendor-defined) HID.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbd_hid_if.h"
+
+/* USER CODE BEGIN INCLUDE */
+#include "usb_hid.h"
+/* USER CODE END INCLUDE */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+
+/* USER CODE BEGIN PV */
+/* Private variables ---------------------------------------------------------*/
+
+/* USER CODE END PV */
+
+/** @addtogroup STM32_USB_OTG_DEVICE_LIBRARY
+  * @brief Usb device library.
+  * @{
+  */
+
+/** @addtogroup USBD_HID_IF
+  * @{
+  */
+
+/** @defgroup USBD_HID_IF_Exported_Variables USBD_HID_IF_Exported_Variables
+  * @brief Public variables.
+  * @{
+  */
+
+extern USBD_HandleTypeDef hUsbDeviceFS;
+
+/* USER CODE BEGIN EXPORTED_VARIABLES */
+
+/* USER CODE END EXPORTED_VARIABLES */
+
+/**
+  * @}
+  */
+
+/** @defgroup USBD_HID_IF_Private_FunctionPrototypes USBD_HID_IF_Private_FunctionPrototypes
+  * @brief Private functions declaration.
+  * @{
+  */
+
+static int8_t HID_Init_FS(void);
+static int8_t HID_DeInit_FS(void);
+static int8_t HID_OutEvent_FS(uint8_t *report, uint16_t length);
+static int8_t HID_InCplt_FS(void);
+
+/* USER CODE BEGIN PRIVATE_FUNCTIONS_DECLARATION */
+
+/* USER CODE END PRIVATE_FUNCTIONS_DECLARATION */
+
+/**
+  * @}
+  */
+
+USBD_HID_ItfTypeDef USBD_HID_fops_FS =
+{
+  HID_Init_FS,
+  HID_DeInit_FS,
+  HID_OutEvent_FS,
+  HID_InCplt_FS
+};
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Initializes the HID media low layer over the FS USB IP
+  * @retval USBD_OK if all operations are OK else USBD_FAIL
+  */
+static int8_t HID_Init_FS(void)
+{
+  /* USER CODE BEGIN 3 */
+  // 設定完成（或 USB reset 後重新設定），清掉上一次連線留下的傳送狀態
+  UsbHid_SetConfigured(1);
+  return (USBD_OK);
+  /* USER CODE END 3 */
+}
+
+/**
+  * @brief  DeInitializes the HID media low layer
+  * @retval USBD_OK if all operations are OK else USBD_FAIL
+  */
+static int8_t HID_DeInit_FS(void)
+{
+  /* USER CODE BEGIN 4 */
+  UsbHid_SetConfigured(0);
+  return (USBD_OK);
+  /* USER CODE END 4 */
+}
+
+/**
+  * @brief  Manage the HID OUT reports
+  *
+  *         @note
+  *         The report buffer is re-armed for reception as soon as this
+  *         function returns, the data must be consumed (copied) here.
+  *
+  * @param  report: Received report
+  * @param  length: Report length (in bytes)
+  * @retval USBD_OK if all operations are OK else USBD_FAIL
+  */
+static int8_t HID_OutEvent_FS(uint8_t *report, uint16_t length)
+{
+  /* USER CODE BEGIN 5 */
+  UsbHid_Received(report, length);
+  return (USBD_OK);
+  /* USER CODE END 5 */
+}
+
+/**
+  * @brief  HID_InCplt_FS
+  *         IN report transmitted callback
+  * @retval USBD_OK if all operations are OK else USBD_FAIL
+  */
+static int8_t HID_InCplt_FS(void)
+{
+  /* USER CODE BEGIN 6 */
+  UsbHid_TxComplete();
+  return (USBD_OK);
+  /* USER CODE END 6 */
+}
+
+/**
+  * @brief  HID_Transmit_FS
+  *         Send IN report(s) over the interrupt endpoint. A length above
+  *         HID_EPIN_SIZE is sent as consecutive reports, one per polling interval.
+  * @param  Buf: Buffer of data to be sent
+  * @param  Len: Number of data to be sent (in bytes), a multiple of HID_EPIN_SIZE
+  * @retval USBD_OK if all operations are OK else USBD_FAIL or USBD_BUSY
+  */
+uint8_t HID_Transmit_FS(uint8_t* Buf, uint16_t Len)
+{
+  uint8_t result = USBD_OK;
+  /* USER CODE BEGIN 7 */
+#ifdef USE_USBD_COMPOSITE
+  USBD_HID_HandleTypeDef *hhid = (USBD_HID_HandleTypeDef*)hUsbDeviceFS.pClassDataCmsit[HID_InstID];
+#else
+  USBD_HID_HandleTypeDef *hhid = (USBD_HID_HandleTypeDef*)hUsbDeviceFS.pClassData;
+#endif /* USE_USBD_COMPOSITE */
+  if (hhid == NULL || hUsbDeviceFS.dev_state != USBD_STATE_CONFIGURED){
+    return USBD_FAIL;
+  }
+  if (hhid->state != USBD_HID_IDLE){
+    return USBD_BUSY;
+  }
+#ifdef USE_USBD_COMPOSITE
+  result = USBD_HID_SendReport(&hUsbDeviceFS, Buf, Len, HID_InstID);
+#else
+  result = USBD_HID_SendReport(&hUsbDeviceFS, Buf, Len);
+#endif /* USE_USBD_COMPOSITE */
+  /* USER CODE END 7 */
+  return result;
+}
+
+/* USER CODE BEGIN PRIVATE_FUNCTIONS_IMPLEMENTATION */
+
+/* USER CODE END PRIVATE_FUNCTIONS_IMPLEMENTATION */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
@@ -27,6 +27,13 @@
 #include "usbd_hid.h"
 
 /* USER CODE BEGIN Includes */
+#include "usbd_cdc.h"
+#include "usbd_audio_in.h"
+
+/* usbd_conf.h 把 USBD_static_malloc/free 換成下面的 USBD_App_Malloc/Free，
+   這裡取消改名，產生的單一配置函式保留原名（不會被呼叫） */
+#undef USBD_static_malloc
+#undef USBD_static_free
 
 /* USER CODE END Includes */
 
@@ -36,6 +43,24 @@
 
 /* USER CODE BEGIN PV */
 /* Private variables ---------------------------------------------------------*/
+/* 類別資料的靜態配置：複合裝置每個類別一個槽位，其他版本一個 */
+#if (USBD_APP_CLASS == USBD_APP_COMPOSITE)
+#define USBD_APP_MEM_SLOTS      USBD_MAX_SUPPORTED_CLASS
+#define USBD_APP_MEM_SIZE       ((sizeof(USBD_CDC_HandleTypeDef) > sizeof(USBD_HID_HandleTypeDef)) ? \
+                                 sizeof(USBD_CDC_HandleTypeDef) : sizeof(USBD_HID_HandleTypeDef))
+#elif (USBD_APP_CLASS == USBD_APP_AUDIO)
+#define USBD_APP_MEM_SLOTS      1U
+#define USBD_APP_MEM_SIZE       sizeof(USBD_AUDIO_IN_HandleTypeDef)
+#elif (USBD_APP_CLASS == USBD_APP_HID)
+#define USBD_APP_MEM_SLOTS      1U
+#define USBD_APP_MEM_SIZE       sizeof(USBD_HID_HandleTypeDef)
+#else
+#define USBD_APP_MEM_SLOTS      1U
+#define USBD_APP_MEM_SIZE       sizeof(USBD_CDC_HandleTypeDef)
+#endif /* USBD_APP_CLASS */
+
+static uint32_t USBD_App_Mem[USBD_APP_MEM_SLOTS][(USBD_APP_MEM_SIZE / 4U) + 1U];/* On 32-bit boundary */
+static uint8_t USBD_App_MemUsed[USBD_APP_MEM_SLOTS];
 
 /* USER CODE END PV */
 
@@ -58,6 +83,90 @@ USBD_StatusTypeDef USBD_Get_USB_Status(HAL_StatusTypeDef hal_status);
 /* Private functions ---------------------------------------------------------*/
 
 /* USER CODE BEGIN 1 */
+/**
+  * @brief  Sets the FIFO layout of the application class.
+  *         USBD_LL_Init only writes the CubeMX (single class) layout; call this
+  *         after USBD_Init and before USBD_Start, while the core is disconnected.
+  * @retval None
+  */
+void USBD_LL_InitFifo(void)
+{
+#if (USBD_APP_CLASS == USBD_APP_COMPOSITE)
+  /* FIFO sizes in 32-bit words, 320 words total on the F411 OTG FS core.
+     Every IN endpoint has its own TX FIFO, so a full CDC stream FIFO never
+     holds back a HID report (no head-of-line blocking between the two paths):
+     RX 64 (EP0 + CDC bulk OUT + HID interrupt OUT), EP0 TX 16,
+     EP1 CDC data IN 160 (ten 64-byte packets queued back to back),
+     EP2 CDC command IN 16, EP3 HID IN 32 (two 64-byte reports, so the next
+     status/command reply is loaded while the current one waits for its poll).
+     32 words are left unused. */
+  HAL_PCDEx_SetRxFiFo(&hpcd_USB_OTG_FS, 0x40);
+  HAL_PCDEx_SetTxFiFo(&hpcd_USB_OTG_FS, 0, 0x10);
+  HAL_PCDEx_SetTxFiFo(&hpcd_USB_OTG_FS, 1, 0xA0);
+  HAL_PCDEx_SetTxFiFo(&hpcd_USB_OTG_FS, 2, 0x10);
+  HAL_PCDEx_SetTxFiFo(&hpcd_USB_OTG_FS, 3, 0x20);
+#elif (USBD_APP_CLASS == USBD_APP_AUDIO)
+  /* FIFO sizes in 32-bit words: RX 64 (EP0 only), EP0 TX 32,
+     EP1 isochronous IN 64: one packet per frame, at most
+     AUDIO_IN_PACKET_SZE = 196 bytes (49 words) in stereo. */
+  HAL_PCDEx_SetRxFiFo(&hpcd_USB_OTG_FS, 0x40);
+  HAL_PCDEx_SetTxFiFo(&hpcd_USB_OTG_FS, 0, 0x20);
+  HAL_PCDEx_SetTxFiFo(&hpcd_USB_OTG_FS, 1, 0x40);
+#else
+  /* FIFO sizes in 32-bit words, 320 words total on the F411 OTG FS core:
+     RX 64 (EP0 + bulk OUT), EP0 TX 32, CDC data IN 128 (eight 64-byte packets,
+     so the next packets are already queued while the host reads the current one),
+     CDC command IN 16. 80 words are left unused.
+     The HID build uses the same layout: EP1 IN carries the 64-byte input reports,
+     the interrupt OUT reports share the RX FIFO and TX2 stays unused. */
+  HAL_PCDEx_SetRxFiFo(&hpcd_USB_OTG_FS, 0x40);
+  HAL_PCDEx_SetTxFiFo(&hpcd_USB_OTG_FS, 0, 0x20);
+  HAL_PCDEx_SetTxFiFo(&hpcd_USB_OTG_FS, 1, 0x80);
+  HAL_PCDEx_SetTxFiFo(&hpcd_USB_OTG_FS, 2, 0x10);
+#endif /* USBD_APP_CLASS */
+}
+
+/**
+  * @brief  Static allocation of the class data (one slot per class).
+  * @param  size: Size of allocated memory
+  * @retval Pointer to the slot, NULL when none fits or is free
+  */
+void *USBD_App_Malloc(uint32_t size)
+{
+  uint32_t i;
+
+  if (size > sizeof(USBD_App_Mem[0]))
+  {
+    return NULL;
+  }
+  for (i = 0; i < USBD_APP_MEM_SLOTS; i++)
+  {
+    if (USBD_App_MemUsed[i] == 0U)
+    {
+      USBD_App_MemUsed[i] = 1U;
+      return USBD_App_Mem[i];
+    }
+  }
+  return NULL;
+}
+
+/**
+  * @brief  Static memory free
+  * @param  p: Pointer to allocated  memory address
+  * @retval None
+  */
+void USBD_App_Free(void *p)
+{
+  uint32_t i;
+
+  for (i = 0; i < USBD_APP_MEM_SLOTS; i++)
+  {
+    if (p == (void *)USBD_App_Mem[i])
+    {
+      USBD_App_MemUsed[i] = 0U;
+    }
+  }
+}
 
 /* USER CODE END 1 */
 
@@ -72,6 +181,10 @@ void HAL_PCD_MspInit(PCD_HandleTypeDef* pcdHandle)
   if(pcdHandle->Instance==USB_OTG_FS)
   {
   /* USER CODE BEGIN USB_OTG_FS_MspInit 0 */
+  /* HAL_PCD_Init 在核心初始化前呼叫這裡：音訊類別每個 SOF 送一個等時封包 */
+#if (USBD_APP_CLASS == USBD_APP_AUDIO)
+  pcdHandle->Init.Sof_enable = ENABLE;
+#endif /* USBD_APP_CLASS */
 
   /* USER CODE END USB_OTG_FS_MspInit 0 */
 
@@ -35,6 +35,45 @@
 #include "stm32f4xx_hal.h"
 
 /* USER CODE BEGIN INCLUDE */
+/* CubeMX（.ioc）只設定單一 CDC 類別，應用程式的類別選擇與相關設定放在這裡 */
+
+/*---------- Application class, selected at build time -----------*/
+#define USBD_APP_CDC     0U
+#define USBD_APP_HID     1U
+#define USBD_APP_COMPOSITE     2U
+#define USBD_APP_AUDIO     3U
+#ifndef USBD_APP_CLASS
+#define USBD_APP_CLASS     USBD_APP_COMPOSITE
+#endif /* USBD_APP_CLASS */
+
+/* HID reports polled every frame */
+#define HID_FS_BINTERVAL     0x1U
+
+/*---------- Composite: CDC bulk stream + HID control/status -----------*/
+#if (USBD_APP_CLASS == USBD_APP_COMPOSITE)
+#define USE_USBD_COMPOSITE
+#define USBD_MAX_SUPPORTED_CLASS     2U
+#define USBD_CMPSIT_ACTIVATE_CDC     1U
+#define USBD_CMPSIT_ACTIVATE_HID     1U
+/* CDC: data EP1 IN/OUT, notification EP2 IN; HID: EP3 IN, EP2 OUT */
+#define CDC_CMPSIT_IN_EP     0x81U
+#define CDC_CMPSIT_OUT_EP     0x01U
+#define CDC_CMPSIT_CMD_EP     0x82U
+#define HID_CMPSIT_IN_EP     0x83U
+#define HID_CMPSIT_OUT_EP     0x02U
+#endif /* USBD_APP_CLASS == USBD_APP_COMPOSITE */
+
+/*---------- Audio input (UAC1 microphone): ACS712, optionally VC -----------*/
+#define USBD_AUDIO_IN_FREQ     48000U
+/* 1U = ACS712 only, 2U = ACS712 + VC (stereo) */
+#define USBD_AUDIO_IN_CHANNELS     1U
+
+/* 類別資料改用 usbd_conf.c USER CODE 的槽位配置（複合裝置需要每個類別一塊），
+   產生的 USBD_malloc/USBD_free 巨集因此指向 USBD_App_Malloc/USBD_App_Free */
+#define USBD_static_malloc     USBD_App_Malloc
+#define USBD_static_free     USBD_App_Free
+
+void USBD_LL_InitFifo(void);
 
 /* USER CODE END INCLUDE */
 
@@ -63,7 +102,7 @@
   */
 
 /*---------- -----------*/
-#define USBD_MAX_NUM_INTERFACES     1U
+#define USBD_MAX_NUM_INTERFACES     3U
 /*---------- -----------*/
 #define USBD_MAX_NUM_CONFIGURATION     1U
 /*---------- -----------*/
@@ -74,8 +113,6 @@
 #define USBD_LPM_ENABLED     0U
 /*---------- -----------*/
 #define USBD_SELF_POWERED     1U
-/*---------- -----------*/
-#define HID_FS_BINTERVAL     0xAU
 
 /****************************************/
 /* #define for FS and HS identification */